@@ -0,0 +1,173 @@
+/// @file flatMapBenchmark.cpp
+/// @brief compares bEngineFlatMap against std::unordered_map for inserting, looking up (hits and misses) and
+/// iterating 64 bit keys at 1K to 10M entries
+
+#include <bEngineApp.h>     // for access to the bEngineApp class and creation function
+#include <bEngineFlatMap.h> // for the flat map being measured
+
+#include <algorithm>     // for shuffling the keys
+#include <chrono>        // for timing the operations
+#include <cstddef>       // for size_t
+#include <cstdint>       // for the keys/values
+#include <format>        // for formatting the results
+#include <iostream>      // for printing the results, in every configuration
+#include <random>        // for generating the keys
+#include <unordered_map> // for the map being compared against
+#include <vector>        // for the keys
+
+namespace
+{
+    /// @brief the number of entries in the smallest map measured; each following map has ten times as many
+    constexpr std::size_t s_minEntryCount{1000};
+
+    /// @brief the number of entries in the largest map measured
+    constexpr std::size_t s_maxEntryCount{10000000};
+
+    /// @brief the (minimum) number of operations timed per measurement, so the small maps are measured over several
+    /// repetitions rather than a handful of microseconds
+    constexpr std::size_t s_minOperationCount{10000000};
+
+    /// @brief the time each operation took on average, in nanoseconds
+    struct Timings
+    {
+        /// @brief the time to insert an entry (into a map which wasn't reserved)
+        double m_insert{0.0};
+
+        /// @brief the time to find an entry which is in the map
+        double m_hit{0.0};
+
+        /// @brief the time to look up a key which isn't in the map
+        double m_miss{0.0};
+
+        /// @brief the time to visit an entry while iterating over the map
+        double m_iterate{0.0};
+
+        /// @brief the sum of every value found/visited, which keeps the work from being optimized away and lets the
+        /// two maps' results be compared
+        std::uint64_t m_checksum{0};
+    };
+
+    /// @brief measures a map type over a set of keys
+    /// @tparam Map the type of the map
+    /// @param keys the keys to insert, and then to look up, in a random order
+    /// @param missingKeys keys which aren't in the map, to time unsuccessful lookups with
+    /// @return the average time of each operation
+    template <typename Map>
+    const Timings measure(const std::vector<std::uint64_t> &keys, const std::vector<std::uint64_t> &missingKeys)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const auto repetitions{std::max<std::size_t>(1, s_minOperationCount / keys.size())};
+        const auto operations{static_cast<double>(repetitions * keys.size())};
+        const auto nanoseconds{[&operations](const Clock::time_point start) {
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / operations;
+        }};
+
+        Timings timings{};
+        Map     map;
+
+        // insert; rebuilt every repetition so every insertion pays for its share of growing the map
+        auto start{Clock::now()};
+        for (std::size_t repetition{0}; repetition < repetitions; ++repetition)
+        {
+            map = Map{};
+            for (const auto key : keys)
+                map.emplace(key, key * 3);
+        }
+        timings.m_insert = nanoseconds(start);
+
+        start = Clock::now();
+        for (std::size_t repetition{0}; repetition < repetitions; ++repetition)
+        {
+            for (const auto key : keys)
+                timings.m_checksum += map.find(key)->second;
+        }
+        timings.m_hit = nanoseconds(start);
+
+        start = Clock::now();
+        for (std::size_t repetition{0}; repetition < repetitions; ++repetition)
+        {
+            for (const auto key : missingKeys)
+                timings.m_checksum += map.find(key) == map.end() ? 0 : 1;
+        }
+        timings.m_miss = nanoseconds(start);
+
+        start = Clock::now();
+        for (std::size_t repetition{0}; repetition < repetitions; ++repetition)
+        {
+            for (const auto &[key, value] : map)
+                timings.m_checksum += value;
+        }
+        timings.m_iterate = nanoseconds(start);
+
+        return timings;
+    }
+
+    /// @brief prints the timings of one operation for both maps
+    /// @param operation the name of the operation
+    /// @param flat the time the operation took with the bEngineFlatMap, in nanoseconds
+    /// @param node the time the operation took with the std::unordered_map, in nanoseconds
+    void report(const char *const operation, const double flat, const double node)
+    {
+        std::cout << std::format("    {:<8}{:8.2f} vs {:8.2f} ({:.2f}x)\n", operation, flat, node, node / flat);
+    }
+} // namespace
+
+/// @brief measures both maps at every size and prints the results
+///
+/// nothing is left to run once this returns, so the application exits straight away
+/// @return true if both maps found/visited the same values
+const bool initialize(bEngine::bEngineApp *const /*app*/)
+{
+    std::mt19937_64 random{1234};
+    auto            isOk{true};
+    for (auto entryCount{s_minEntryCount}; entryCount <= s_maxEntryCount; entryCount *= 10)
+    {
+        // odd keys are inserted and even keys are missed, so every lookup is decided by the map rather than the keys
+        std::vector<std::uint64_t> keys(entryCount);
+        std::vector<std::uint64_t> missingKeys(entryCount);
+        for (std::size_t i{0}; i < entryCount; ++i)
+        {
+            const auto key{random()};
+            keys[i]        = key | 1;
+            missingKeys[i] = key & ~std::uint64_t{1};
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        std::shuffle(keys.begin(), keys.end(), random);
+        missingKeys.resize(keys.size());
+
+        const auto flat{measure<bEngine::bEngineFlatMap<std::uint64_t, std::uint64_t>>(keys, missingKeys)};
+        const auto node{measure<std::unordered_map<std::uint64_t, std::uint64_t>>(keys, missingKeys)};
+        if (flat.m_checksum != node.m_checksum)
+        {
+            std::cerr << std::format(
+                "The maps disagree at {} entries ({} vs {})!\n",
+                keys.size(),
+                flat.m_checksum,
+                node.m_checksum);
+            isOk = false;
+        }
+
+        std::cout << std::format("{} entries (ns per entry, bEngineFlatMap vs std::unordered_map):\n", keys.size());
+        report("insert", flat.m_insert, node.m_insert);
+        report("hit", flat.m_hit, node.m_hit);
+        report("miss", flat.m_miss, node.m_miss);
+        report("iterate", flat.m_iterate, node.m_iterate);
+    }
+    return isOk;
+}
+
+namespace bEngine
+{
+    /// @brief store an instance of the app statically
+    bEngineApp app{bEngineApp::create_app("Flat Map Benchmark", initialize, nullptr, 1.0 / 60.0, nullptr, nullptr)};
+
+    /// @brief returns an instance of the application class so the library can access the user-defined/configured
+    /// application
+    /// @return a reference to the benchmark application
+    bEngineApp &get_app()
+    {
+        return app;
+    }
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,388 @@
+/// @file mdiBenchmark.cpp
+/// @brief a benchmark scene which draws tens of thousands of small meshes and alternates between submitting them with
+/// a draw call per mesh and with a single multi-draw indirect, reporting the cost of each
+
+#include <bEngineApp.h>           // for access to the bEngineApp class and creation function
+#include <bEngineCommandBuffer.h> // for recording the scene's draws
+#include <bEngineGLMultiDraw.h>   // for the mesh pool and the multi-draw batch
+#include <bEngineUtilities.h>     // for printing the program's info log and asserting it linked
+#include <bEngineWindow.h>        // for access to the bEngineWindow class and creation function
+
+#include <glad\gl.h> // for the values of the GL enums passed to the GL wrappers
+
+#include <algorithm>  // for min/max when splitting work between threads
+#include <barrier>    // for handing each frame's work to the worker threads
+#include <chrono>     // for timing each frame
+#include <cmath>      // for building the meshes
+#include <format>     // for formatting the results
+#include <functional> // for the worker threads' job
+#include <iostream>   // for printing the results, in every configuration
+#include <memory>     // for the lazily created scene
+#include <thread>     // for building the draws on multiple threads
+#include <vector>     // for the scene's draws and the worker threads
+
+namespace
+{
+    /// @brief the number of meshes drawn every frame
+    constexpr std::uint32_t s_drawCount{20000};
+
+    /// @brief the number of different meshes in the pool (regular polygons with 3, 4, ... sides)
+    constexpr std::uint32_t s_meshCount{8};
+
+    /// @brief the number of frames rendered with each submission mode before switching to the other
+    constexpr unsigned int s_framesPerMode{300};
+
+    /// @brief the data of a single draw, as laid out in the shader storage block (std430)
+    struct DrawData
+    {
+        /// @brief the rectangle the mesh is drawn in (min x, min y, max x, max y) in clip space
+        float m_rect[4];
+
+        /// @brief the color of the mesh
+        float m_color[4];
+    };
+
+    /// @brief the vertex shader, which finds each draw's data with gl_BaseInstance (which both modes set to the index
+    /// of the draw)
+    constexpr const char *s_vertexShader{R"(#version 460 core
+layout(location = 0) in vec2 a_position;
+
+struct DrawData
+{
+    vec4 m_rect;
+    vec4 m_color;
+};
+layout(std430, binding = 0) readonly buffer Draws
+{
+    DrawData u_draws[];
+};
+
+out vec4 v_color;
+
+void main()
+{
+    const DrawData draw = u_draws[gl_BaseInstance];
+    v_color             = draw.m_color;
+    gl_Position         = vec4(mix(draw.m_rect.xy, draw.m_rect.zw, a_position), 0.0, 1.0);
+}
+)"};
+
+    /// @brief the fragment shader, which just outputs each draw's color
+    constexpr const char *s_fragmentShader{R"(#version 460 core
+in vec4 v_color;
+
+out vec4 o_color;
+
+void main()
+{
+    o_color = v_color;
+}
+)"};
+
+    /// @brief a set of threads which is created once and runs a job over the scene's draws (split evenly between the
+    /// threads, including the calling one) every time it's asked to, so no threads are created during a frame
+    class WorkerPool
+    {
+        // private data
+      private:
+        /// @brief the number of threads the draws are split between, including the calling thread
+        const std::uint32_t m_threadCount;
+
+        /// @brief the job being run, called with the range of draws [first, last) each thread handles
+        std::function<void(const std::uint32_t, const std::uint32_t)> m_job;
+
+        /// @brief true once the workers should exit rather than run another job
+        bool m_isStopping{false};
+
+        /// @brief releases the workers to run the job (or exit); also publishes m_job/m_isStopping to them
+        std::barrier<> m_start;
+
+        /// @brief waits for every worker to finish the job
+        std::barrier<> m_finish;
+
+        /// @brief the worker threads (destroyed, and so joined, first)
+        std::vector<std::jthread> m_workers;
+
+        // private methods/functions
+      private:
+        /// @brief runs the job over one thread's share of the draws
+        /// @param threadIndex the index of the thread (0 for the calling thread)
+        void run_range(const std::uint32_t threadIndex) const
+        {
+            const auto rangeSize{(s_drawCount + m_threadCount - 1) / m_threadCount};
+            const auto first{std::min(threadIndex * rangeSize, s_drawCount)};
+            if (first < s_drawCount)
+                m_job(first, std::min(first + rangeSize, s_drawCount));
+        }
+
+        // public ctors/dtor
+      public:
+        /// @brief ctor which starts the worker threads
+        /// @param threadCount the number of threads the draws are split between, including the calling thread
+        explicit WorkerPool(const std::uint32_t threadCount)
+            : m_threadCount{threadCount},
+              m_start{threadCount},
+              m_finish{threadCount}
+        {
+            for (std::uint32_t threadIndex{1}; threadIndex < m_threadCount; ++threadIndex)
+            {
+                m_workers.emplace_back(
+                    [this, threadIndex]()
+                    {
+                        while (true)
+                        {
+                            m_start.arrive_and_wait();
+                            if (m_isStopping)
+                                return;
+                            run_range(threadIndex);
+                            m_finish.arrive_and_wait();
+                        }
+                    });
+            }
+        }
+
+        /// @brief dtor which stops (and joins) the worker threads
+        ~WorkerPool()
+        {
+            m_isStopping = true;
+            m_start.arrive_and_wait();
+        }
+
+        // public methods/functions
+      public:
+        /// @brief runs a function over the draws of the scene on every thread, returning once they're all handled
+        /// @param job the function which handles the draws [first, last)
+        void run(std::function<void(const std::uint32_t, const std::uint32_t)> job)
+        {
+            m_job = std::move(job);
+            m_start.arrive_and_wait();
+            run_range(0);
+            m_finish.arrive_and_wait();
+        }
+    };
+
+    /// @brief everything the scene draws with; created on the first render, since GL objects need the window's context
+    struct Scene
+    {
+        /// @brief the threads the draws are built on
+        WorkerPool m_workers{std::max(1u, std::thread::hardware_concurrency())};
+
+        /// @brief the stream buffer the per-frame draw data and indirect commands are written to
+        bEngine::bEngineGLStreamBuffer m_streamBuffer{
+            2 * s_drawCount * (sizeof(DrawData) + sizeof(bEngine::bEngineDrawIndirectCommand)) + 4096};
+
+        /// @brief the pool every mesh is packed into
+        bEngine::bEngineGLMeshPool m_meshPool{2 * sizeof(float), 128, 512};
+
+        /// @brief the multi-draw batch
+        bEngine::bEngineGLDrawBatch m_batch{m_streamBuffer, sizeof(DrawData)};
+
+        /// @brief the program every mesh is drawn with
+        bEngine::bEngineGLProgram m_program{
+            {GL_VERTEX_SHADER, s_vertexShader},
+            {GL_FRAGMENT_SHADER, s_fragmentShader}};
+
+        /// @brief the location of each mesh in the pool
+        std::vector<bEngine::bEngineMeshRange> m_meshes;
+
+        /// @brief the data of each draw
+        std::vector<DrawData> m_draws;
+    };
+
+    /// @brief the scene, created the first time the window renders (its GL objects are released with the window)
+    std::unique_ptr<Scene> s_scene{nullptr};
+
+    /// @brief the number of frames rendered
+    unsigned long long s_frameCount{0};
+
+    /// @brief the time spent building/recording the current mode's draws, in seconds
+    double s_recordSeconds{0.0};
+
+    /// @brief the time between the current mode's frames, in seconds
+    double s_frameSeconds{0.0};
+
+    /// @brief the time the last frame started
+    std::chrono::steady_clock::time_point s_lastFrameTime{};
+
+    /// @brief creates the scene: a pool of regular polygons, and a grid of draws which use them
+    void create_scene()
+    {
+        s_scene = std::make_unique<Scene>();
+        if (!s_scene->m_program.get_is_linked())
+        {
+            ERROR_MSG(s_scene->m_program.get_info_log());
+        }
+        bENGINE_ASSERT(s_scene->m_program.get_is_linked(), "Failed to build the benchmark's program!");
+
+        // each mesh is a triangle fan of a regular polygon in the unit square, as a triangle list
+        for (std::uint32_t mesh{0}; mesh < s_meshCount; ++mesh)
+        {
+            const auto                 sides{mesh + 3};
+            std::vector<float>         vertices{0.5f, 0.5f};
+            std::vector<std::uint32_t> indices;
+            for (std::uint32_t side{0}; side < sides; ++side)
+            {
+                const auto angle{6.2831853f * side / sides};
+                vertices.push_back(0.5f + 0.5f * std::cos(angle));
+                vertices.push_back(0.5f + 0.5f * std::sin(angle));
+                indices.insert(indices.end(), {0, side + 1, (side + 1) % sides + 1});
+            }
+            s_scene->m_meshes.push_back(s_scene->m_meshPool.add_mesh(
+                vertices.data(),
+                static_cast<std::uint32_t>(vertices.size() / 2),
+                indices.data(),
+                static_cast<std::uint32_t>(indices.size())));
+        }
+        s_scene->m_meshPool.get_vertex_array().set_attribute(0, 0, 2, GL_FLOAT, false, 0);
+
+        // lay the draws out in a grid covering the window
+        const auto columns{static_cast<std::uint32_t>(std::ceil(std::sqrt(s_drawCount * 16.0f / 9.0f)))};
+        const auto rows{(s_drawCount + columns - 1) / columns};
+        const auto width{2.0f / columns};
+        const auto height{2.0f / rows};
+        for (std::uint32_t draw{0}; draw < s_drawCount; ++draw)
+        {
+            const auto x{-1.0f + (draw % columns) * width};
+            const auto y{-1.0f + (draw / columns) * height};
+            const auto red{static_cast<float>(draw % columns) / columns};
+            const auto green{static_cast<float>(draw / columns) / rows};
+            s_scene->m_draws.push_back({{x, y, x + width, y + height}, {red, green, 0.5f, 1.0f}});
+        }
+    }
+
+    /// @brief gets the draw state shared by every mesh of the scene
+    /// @return the draw state shared by every mesh of the scene
+    bEngine::bEngineDrawItem get_scene_item()
+    {
+        bEngine::bEngineDrawItem item{};
+        item.m_program       = &s_scene->m_program;
+        item.m_vertexArray   = &s_scene->m_meshPool.get_vertex_array();
+        item.m_mode          = GL_TRIANGLES;
+        item.m_indexType     = GL_UNSIGNED_INT;
+        item.m_state.m_depth = bEngine::bEngineDepthMode::Disabled;
+        item.m_state.m_cull  = bEngine::bEngineCullMode::None;
+        return item;
+    }
+
+    /// @brief records every mesh with its own draw call, each thread recording its own command buffer
+    /// @param window the window being rendered
+    void record_per_draw(const bEngine::bEngineWindow *const window)
+    {
+        auto &streamBuffer{s_scene->m_streamBuffer};
+        auto  allocation{streamBuffer.allocate(s_drawCount * sizeof(DrawData), 256)};
+        if (!allocation.m_data)
+            return;
+
+        auto item{get_scene_item()};
+        item.m_storageBuffer = &streamBuffer.get_buffer();
+        item.m_storageOffset = allocation.m_offset;
+        item.m_storageSize   = allocation.m_size;
+
+        s_scene->m_workers.run(
+            [&](const std::uint32_t first, const std::uint32_t last)
+            {
+                bEngine::bEngineCommandBuffer commands;
+                commands.reserve(last - first);
+
+                auto drawItem{item};
+                for (std::uint32_t draw{first}; draw < last; ++draw)
+                {
+                    const auto &mesh{s_scene->m_meshes[draw % s_meshCount]};
+                    static_cast<DrawData *>(allocation.m_data)[draw] = s_scene->m_draws[draw];
+
+                    drawItem.m_first        = mesh.m_firstIndex;
+                    drawItem.m_count        = static_cast<int>(mesh.m_indexCount);
+                    drawItem.m_baseVertex   = mesh.m_baseVertex;
+                    drawItem.m_baseInstance = draw;
+                    commands.draw(bEngine::make_sort_key(1, 0, 0, 0, 0), drawItem);
+                }
+                window->submit_commands(std::move(commands));
+            });
+    }
+
+    /// @brief builds every mesh into a single multi-draw batch on multiple threads, then records it once
+    /// @param commands the window's command buffer
+    void record_multi_draw(bEngine::bEngineCommandBuffer &commands)
+    {
+        auto &batch{s_scene->m_batch};
+        if (!batch.begin(s_drawCount))
+            return;
+
+        s_scene->m_workers.run(
+            [&](const std::uint32_t first, const std::uint32_t last)
+            {
+                for (std::uint32_t draw{first}; draw < last; ++draw)
+                    batch.set_draw(draw, s_scene->m_meshes[draw % s_meshCount], &s_scene->m_draws[draw]);
+            });
+
+        batch.record(commands, bEngine::make_sort_key(1, 0, 0, 0, 0), get_scene_item());
+    }
+} // namespace
+
+/// @brief renders the scene with the current submission mode and reports each mode's average cost
+///
+/// the frame time covers everything between two renders, including executing the commands; the window presents
+/// immediately so it measures the submission cost rather than the refresh rate
+/// @param window the window being rendered
+/// @param commands the window's command buffer
+void render(const bEngine::bEngineWindow *const window, bEngine::bEngineCommandBuffer &commands)
+{
+    if (!s_scene)
+        create_scene();
+
+    const auto isMultiDraw{(s_frameCount / s_framesPerMode) % 2 == 1};
+    const auto frameStart{std::chrono::steady_clock::now()};
+    if (s_frameCount % s_framesPerMode != 0)
+        s_frameSeconds += std::chrono::duration<double>(frameStart - s_lastFrameTime).count();
+    s_lastFrameTime = frameStart;
+
+    commands.clear_color(bEngine::make_sort_key(0, 0, 0, 0, 0), nullptr, 0.1f, 0.1f, 0.1f, 1.0f);
+    if (isMultiDraw)
+        record_multi_draw(commands);
+    else
+        record_per_draw(window);
+    s_recordSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count();
+
+    // report the mode's averages once it's done
+    if (++s_frameCount % s_framesPerMode == 0)
+    {
+        std::cout << std::format(
+            "{}: {:.3f} ms recording, {:.3f} ms per frame ({} draws)\n",
+            isMultiDraw ? "multi-draw indirect" : "draw per mesh",
+            s_recordSeconds * 1000.0 / s_framesPerMode,
+            s_frameSeconds * 1000.0 / (s_framesPerMode - 1),
+            s_drawCount);
+        s_recordSeconds = 0.0;
+        s_frameSeconds  = 0.0;
+    }
+}
+
+/// @brief creates the benchmark's window, which presents without waiting for vsync
+/// @param app a reference to the application which is owned by the library
+/// @return true, since there's nothing which can fail
+const bool initialize(bEngine::bEngineApp *const app)
+{
+    std::cout << std::format(
+        "Drawing {} meshes, switching between a draw per mesh and multi-draw indirect every {} frames.\n",
+        s_drawCount,
+        s_framesPerMode);
+
+    auto window{bEngine::bEngineWindow::create_window(1280, 720, "MDI Benchmark", render)};
+    window->set_present_mode(bEngine::bEnginePresentMode::Immediate);
+    app->add_window(std::move(window));
+    return true;
+}
+
+namespace bEngine
+{
+    /// @brief store an instance of the app statically
+    bEngineApp app{bEngineApp::create_app("MDI Benchmark", initialize, nullptr, 1.0 / 60.0, nullptr, nullptr)};
+
+    /// @brief returns an instance of the application class so the library can access the user-defined/configured
+    /// application
+    /// @return a reference to the benchmark application
+    bEngineApp &get_app()
+    {
+        return app;
+    }
+} // namespace bEngine
\ No newline at end of file
@@ -33,9 +33,13 @@ local function set_example_project_defaults()
         runtime "Release"
     filter {}
 
-    -- include the bEngine public headers (we don't care about the implementation when we're building an app!)
+    -- include the bEngine public headers (we don't care about the implementation when we're building an app!) and
+    -- glad's header, which defines the values of the GL enums the GL wrappers take, and glm, which some of the public
+    -- headers describe geometry with
     includedirs {
-        "../../include/"
+        "../../include/",
+        "../../vendors/glad/include/",
+        "../../vendors/glm/include/"
     }
 
     -- link to bEngine
@@ -44,7 +48,43 @@ local function set_example_project_defaults()
     }
 end
 
+-- the benchmarks print their results to the console, and those results only mean anything in optimized builds, so
+-- they keep a console in every configuration; the library's release entry point is WinMain, so a release console
+-- benchmark has to start there rather than at main
+local function set_benchmark_project_defaults()
+    set_example_project_defaults()
+    kind "ConsoleApp"
+    filter "configurations:Release"
+        entrypoint "WinMainCRTStartup"
+    filter {}
+end
+
 project "hello-world"
     set_example_project_defaults()
     files { "../hello-world/**.*", }
     
+
+project "mdi-benchmark"
+    set_benchmark_project_defaults()
+    files { "../mdi-benchmark/**.*", }
+    
+
+project "sprite-benchmark"
+    set_benchmark_project_defaults()
+    files { "../sprite-benchmark/**.*", }
+    
+
+project "queue-benchmark"
+    set_benchmark_project_defaults()
+    files { "../queue-benchmark/**.*", }
+    
+
+project "soa-benchmark"
+    set_benchmark_project_defaults()
+    files { "../soa-benchmark/**.*", }
+    
+
+project "flat-map-benchmark"
+    set_benchmark_project_defaults()
+    files { "../flat-map-benchmark/**.*", }
+    
\ No newline at end of file
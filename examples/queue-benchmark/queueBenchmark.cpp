@@ -0,0 +1,416 @@
+/// @file queueBenchmark.cpp
+/// @brief stress tests the lock-free SPSC/MPMC queues for lost, duplicated or reordered elements, then measures their
+/// throughput across thread counts and their round-trip latency
+///
+/// the queues are header-only, so besides running this example normally the stress tests are worth running under
+/// ThreadSanitizer wherever it's available (e.g. clang's -fsanitize=thread); any failed check is printed to stderr and
+/// makes the application exit with a non-zero code
+
+#include <bEngineApp.h>    // for access to the bEngineApp class and creation function
+#include <bEngineQueues.h> // for the queues being tested
+
+#include <algorithm> // for sorting the round trip times
+#include <atomic>    // for starting the threads together and checking each element is popped exactly once
+#include <chrono>    // for timing the benchmarks
+#include <cstdint>   // for the elements pushed through the queues
+#include <format>    // for formatting the results
+#include <iostream>  // for printing the results and any failed checks, in every configuration
+#include <thread>    // for the producer/consumer threads
+#include <vector>    // for the threads, batches and results
+
+namespace
+{
+    /// @brief the number of elements pushed through the SPSC queue by each stress test
+    constexpr std::uint64_t s_spscStressCount{1000000};
+
+    /// @brief the number of elements pushed by each producer in the MPMC stress tests
+    constexpr std::uint64_t s_mpmcStressCountPerProducer{200000};
+
+    /// @brief the number of elements pushed through the queues by each throughput benchmark
+    constexpr std::uint64_t s_throughputCount{10000000};
+
+    /// @brief the number of round trips timed by the latency benchmarks
+    constexpr std::size_t s_roundTripCount{100000};
+
+    /// @brief the largest batch pushed/popped by the batch stress tests and benchmarks
+    constexpr std::size_t s_batchSize{64};
+
+    /// @brief a capacity small enough that the stress tests spend much of their time wrapping around a full queue
+    constexpr std::size_t s_stressCapacity{64};
+
+    /// @brief the capacity of the queues in the benchmarks
+    constexpr std::size_t s_benchmarkCapacity{4096};
+
+    /// @brief packs a producer's index and sequence number into a single element
+    /// @param producer the index of the producer
+    /// @param sequence the producer's sequence number for the element
+    /// @return the element
+    constexpr std::uint64_t make_element(const std::uint64_t producer, const std::uint64_t sequence)
+    {
+        return (producer << 40) | sequence;
+    }
+
+    /// @brief pushes elements 0..count-1 through an SPSC queue and checks the consumer sees every one of them, in order
+    /// @param isBatched true to push/pop batches of (varying sizes of) elements, false to push/pop one at a time
+    /// @return true if every element arrived exactly once and in order
+    const bool stress_spsc(const bool isBatched)
+    {
+        bEngine::bEngineSPSCQueue<std::uint64_t> queue{s_stressCapacity};
+        std::atomic<bool>                        isOk{true};
+
+        std::jthread producer{[&queue, isBatched]() {
+            std::vector<std::uint64_t> batch(s_batchSize);
+            std::uint64_t              next{0};
+            while (next < s_spscStressCount)
+            {
+                std::size_t pushed{0};
+                if (!isBatched)
+                    pushed = queue.try_push(next) ? 1 : 0;
+                else
+                {
+                    // vary the batch size so batches straddle the end of the buffer in different places
+                    const auto size{std::min<std::uint64_t>(1 + next % s_batchSize, s_spscStressCount - next)};
+                    for (std::uint64_t i{0}; i < size; ++i)
+                        batch[i] = next + i;
+                    pushed = queue.push_batch(batch.begin(), size);
+                }
+
+                // let the consumer catch up if there are more threads than cores (e.g. under a sanitizer)
+                if (pushed == 0)
+                    std::this_thread::yield();
+                next += pushed;
+            }
+        }};
+
+        std::vector<std::uint64_t> batch(s_batchSize);
+        std::uint64_t              expected{0};
+        while (expected < s_spscStressCount)
+        {
+            std::size_t popped{0};
+            if (isBatched)
+                popped = queue.pop_batch(batch.begin(), 1 + expected % s_batchSize);
+            else if (queue.try_pop(batch[0]))
+                popped = 1;
+            if (popped == 0)
+                std::this_thread::yield();
+
+            for (std::size_t i{0}; i < popped; ++i, ++expected)
+            {
+                if (batch[i] != expected)
+                {
+                    std::cerr << std::format("SPSC queue popped {} where {} was expected!\n", batch[i], expected);
+                    isOk = false;
+                    expected = batch[i];
+                }
+            }
+        }
+
+        producer.join();
+        std::uint64_t leftover{0};
+        if (queue.try_pop(leftover))
+        {
+            std::cerr << std::format("SPSC queue popped {} after every element was consumed!\n", leftover);
+            isOk = false;
+        }
+        return isOk;
+    }
+
+    /// @brief pushes elements from several producers through an MPMC queue and checks every element is popped exactly
+    /// once, and that each consumer sees each producer's elements in the order they were pushed
+    /// @param producerCount the number of producer threads
+    /// @param consumerCount the number of consumer threads
+    /// @param isBatched true to push/pop batches of elements, false to push/pop one at a time
+    /// @return true if every element arrived exactly once and no consumer saw a producer's elements out of order
+    const bool stress_mpmc(const std::size_t producerCount, const std::size_t consumerCount, const bool isBatched)
+    {
+        bEngine::bEngineMPMCQueue<std::uint64_t> queue{s_stressCapacity};
+        const auto                               total{producerCount * s_mpmcStressCountPerProducer};
+        std::vector<std::atomic<unsigned int>>   popCounts(total);
+        std::atomic<std::uint64_t>               poppedTotal{0};
+        std::atomic<bool>                        isOk{true};
+
+        std::vector<std::jthread> threads;
+        for (std::uint64_t p{0}; p < producerCount; ++p)
+        {
+            threads.emplace_back([&queue, isBatched, p]() {
+                std::vector<std::uint64_t> batch(s_batchSize);
+                std::uint64_t              next{0};
+                while (next < s_mpmcStressCountPerProducer)
+                {
+                    std::size_t pushed{0};
+                    if (!isBatched)
+                        pushed = queue.try_push(make_element(p, next)) ? 1 : 0;
+                    else
+                    {
+                        const auto size{
+                            std::min<std::uint64_t>(1 + next % s_batchSize, s_mpmcStressCountPerProducer - next)};
+                        for (std::uint64_t i{0}; i < size; ++i)
+                            batch[i] = make_element(p, next + i);
+                        pushed = queue.push_batch(batch.begin(), size);
+                    }
+
+                    if (pushed == 0)
+                        std::this_thread::yield();
+                    next += pushed;
+                }
+            });
+        }
+
+        for (std::size_t c{0}; c < consumerCount; ++c)
+        {
+            threads.emplace_back([&, isBatched]() {
+                std::vector<std::uint64_t> batch(s_batchSize);
+                std::vector<std::uint64_t> nextSequences(producerCount, 0);
+                while (poppedTotal.load(std::memory_order_relaxed) < total)
+                {
+                    std::size_t popped{0};
+                    if (isBatched)
+                        popped = queue.pop_batch(batch.begin(), s_batchSize);
+                    else if (queue.try_pop(batch[0]))
+                        popped = 1;
+                    if (popped == 0)
+                        std::this_thread::yield();
+
+                    for (std::size_t i{0}; i < popped; ++i)
+                    {
+                        const auto producer{batch[i] >> 40};
+                        const auto sequence{batch[i] & ((std::uint64_t{1} << 40) - 1)};
+                        if (producer >= producerCount || sequence >= s_mpmcStressCountPerProducer)
+                        {
+                            std::cerr << std::format("MPMC queue popped garbage ({:#x})!\n", batch[i]);
+                            isOk = false;
+                            continue;
+                        }
+                        if (sequence < nextSequences[producer])
+                        {
+                            std::cerr << std::format("MPMC queue popped producer {}'s element {} after element {}!\n",
+                                                     producer,
+                                                     sequence,
+                                                     nextSequences[producer] - 1);
+                            isOk = false;
+                        }
+                        nextSequences[producer] = sequence + 1;
+                        popCounts[producer * s_mpmcStressCountPerProducer + sequence].fetch_add(
+                            1, std::memory_order_relaxed);
+                    }
+                    poppedTotal.fetch_add(popped, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        for (auto &thread : threads)
+            thread.join();
+
+        for (std::size_t i{0}; i < total; ++i)
+        {
+            if (const auto count{popCounts[i].load()}; count != 1)
+            {
+                std::cerr << std::format("MPMC queue popped producer {}'s element {} {} times!\n",
+                                         i / s_mpmcStressCountPerProducer,
+                                         i % s_mpmcStressCountPerProducer,
+                                         count);
+                isOk = false;
+            }
+        }
+        return isOk;
+    }
+
+    /// @brief times pushing elements through an SPSC queue from one thread to another
+    /// @param isBatched true to push/pop batches of elements, false to push/pop one at a time
+    /// @return the throughput, in millions of elements per second
+    const double benchmark_spsc_throughput(const bool isBatched)
+    {
+        bEngine::bEngineSPSCQueue<std::uint64_t> queue{s_benchmarkCapacity};
+        const auto                               start{std::chrono::steady_clock::now()};
+
+        std::jthread producer{[&queue, isBatched]() {
+            std::vector<std::uint64_t> batch(s_batchSize);
+            std::uint64_t              next{0};
+            while (next < s_throughputCount)
+            {
+                if (isBatched)
+                    next += queue.push_batch(batch.begin(), std::min(s_batchSize, s_throughputCount - next));
+                else if (queue.try_push(next))
+                    ++next;
+            }
+        }};
+
+        std::vector<std::uint64_t> batch(s_batchSize);
+        std::uint64_t              popped{0};
+        while (popped < s_throughputCount)
+        {
+            if (isBatched)
+                popped += queue.pop_batch(batch.begin(), s_batchSize);
+            else if (queue.try_pop(batch[0]))
+                ++popped;
+        }
+
+        producer.join();
+        return s_throughputCount / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() /
+               1e6;
+    }
+
+    /// @brief times pushing elements through an MPMC queue from several producers to several consumers
+    /// @param threadCount the number of producers, and the number of consumers
+    /// @param isBatched true to push/pop batches of elements, false to push/pop one at a time
+    /// @return the throughput, in millions of elements per second
+    const double benchmark_mpmc_throughput(const std::size_t threadCount, const bool isBatched)
+    {
+        bEngine::bEngineMPMCQueue<std::uint64_t> queue{s_benchmarkCapacity};
+        const auto                               countPerProducer{s_throughputCount / threadCount};
+        const auto                               total{countPerProducer * threadCount};
+        std::atomic<std::uint64_t>               poppedTotal{0};
+        std::atomic<bool>                        isStarted{false};
+
+        std::vector<std::jthread> threads;
+        for (std::size_t p{0}; p < threadCount; ++p)
+        {
+            threads.emplace_back([&, isBatched]() {
+                std::vector<std::uint64_t> batch(s_batchSize);
+                isStarted.wait(false);
+                std::uint64_t next{0};
+                while (next < countPerProducer)
+                {
+                    if (isBatched)
+                        next += queue.push_batch(batch.begin(), std::min(s_batchSize, countPerProducer - next));
+                    else if (queue.try_push(next))
+                        ++next;
+                }
+            });
+            threads.emplace_back([&, isBatched]() {
+                std::vector<std::uint64_t> batch(s_batchSize);
+                isStarted.wait(false);
+                while (poppedTotal.load(std::memory_order_relaxed) < total)
+                {
+                    std::size_t popped{0};
+                    if (isBatched)
+                        popped = queue.pop_batch(batch.begin(), s_batchSize);
+                    else if (queue.try_pop(batch[0]))
+                        popped = 1;
+                    if (popped != 0)
+                        poppedTotal.fetch_add(popped, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        // start every thread at once so thread creation isn't timed
+        const auto start{std::chrono::steady_clock::now()};
+        isStarted = true;
+        isStarted.notify_all();
+        for (auto &thread : threads)
+            thread.join();
+
+        return total / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / 1e6;
+    }
+
+    /// @brief the round trip times measured by a latency benchmark
+    struct Latency
+    {
+        /// @brief the median round trip time, in nanoseconds
+        double m_median{0.0};
+
+        /// @brief the 99th percentile round trip time, in nanoseconds
+        double m_p99{0.0};
+    };
+
+    /// @brief times elements bouncing back and forth between two threads through a pair of queues
+    /// @tparam Queue the type of the queues
+    /// @return the median and 99th percentile round trip times
+    template <typename Queue>
+    const Latency benchmark_latency()
+    {
+        Queue ping{s_benchmarkCapacity};
+        Queue pong{s_benchmarkCapacity};
+
+        std::jthread echo{[&ping, &pong]() {
+            std::uint64_t value{0};
+            for (std::size_t i{0}; i < s_roundTripCount; ++i)
+            {
+                while (!ping.try_pop(value))
+                    ;
+                while (!pong.try_push(value))
+                    ;
+            }
+        }};
+
+        std::vector<double> roundTrips(s_roundTripCount);
+        std::uint64_t       value{0};
+        for (std::size_t i{0}; i < s_roundTripCount; ++i)
+        {
+            const auto start{std::chrono::steady_clock::now()};
+            while (!ping.try_push(i))
+                ;
+            while (!pong.try_pop(value))
+                ;
+            roundTrips[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        echo.join();
+        std::sort(roundTrips.begin(), roundTrips.end());
+        return {roundTrips[roundTrips.size() / 2], roundTrips[roundTrips.size() * 99 / 100]};
+    }
+} // namespace
+
+/// @brief runs the stress tests and then the benchmarks, printing the results
+///
+/// nothing is left to run once this returns, so the application exits straight away
+/// @return true if every stress test passed; otherwise the application exits with a non-zero code
+const bool initialize(bEngine::bEngineApp *const /*app*/)
+{
+    const auto hardwareThreads{std::max(std::thread::hardware_concurrency(), 2u)};
+
+    auto isOk{true};
+    for (const auto isBatched : {false, true})
+    {
+        const auto mode{isBatched ? "batched" : "single"};
+        isOk &= stress_spsc(isBatched);
+        std::cout << std::format("SPSC stress test ({}) done.\n", mode);
+        for (std::size_t threadCount{1}; threadCount * 2 <= hardwareThreads; threadCount *= 2)
+        {
+            isOk &= stress_mpmc(threadCount, threadCount, isBatched);
+            std::cout << std::format("MPMC stress test ({}, {}x{} threads) done.\n", mode, threadCount, threadCount);
+        }
+    }
+    if (!isOk)
+    {
+        std::cerr << "The queue stress tests failed; skipping the benchmarks.\n";
+        return false;
+    }
+
+    for (const auto isBatched : {false, true})
+    {
+        const auto mode{isBatched ? "batched" : "single"};
+        std::cout << std::format(
+            "SPSC throughput ({}): {:.1f} M elements/s\n", mode, benchmark_spsc_throughput(isBatched));
+        for (std::size_t threadCount{1}; threadCount * 2 <= hardwareThreads; threadCount *= 2)
+        {
+            std::cout << std::format("MPMC throughput ({}, {}x{} threads): {:.1f} M elements/s\n",
+                                     mode,
+                                     threadCount,
+                                     threadCount,
+                                     benchmark_mpmc_throughput(threadCount, isBatched));
+        }
+    }
+
+    const auto spscLatency{benchmark_latency<bEngine::bEngineSPSCQueue<std::uint64_t>>()};
+    std::cout << std::format(
+        "SPSC round trip: {:.0f} ns median, {:.0f} ns p99\n", spscLatency.m_median, spscLatency.m_p99);
+    const auto mpmcLatency{benchmark_latency<bEngine::bEngineMPMCQueue<std::uint64_t>>()};
+    std::cout << std::format(
+        "MPMC round trip: {:.0f} ns median, {:.0f} ns p99\n", mpmcLatency.m_median, mpmcLatency.m_p99);
+    return true;
+}
+
+namespace bEngine
+{
+    /// @brief store an instance of the app statically
+    bEngineApp app{bEngineApp::create_app("Queue Benchmark", initialize, nullptr, 1.0 / 60.0, nullptr, nullptr)};
+
+    /// @brief returns an instance of the application class so the library can access the user-defined/configured
+    /// application
+    /// @return a reference to the benchmark application
+    bEngineApp &get_app()
+    {
+        return app;
+    }
+} // namespace bEngine
\ No newline at end of file
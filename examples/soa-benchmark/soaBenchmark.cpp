@@ -0,0 +1,206 @@
+/// @file soaBenchmark.cpp
+/// @brief compares running the same transforms over 1M particles stored as an array of glm structs (AoS), as a
+/// bEngineSoaVector of glm fields, and as a bEngineSoaVector of scalar fields walked with padded, aligned loops
+
+#include <bEngineApp.h>       // for access to the bEngineApp class and creation function
+#include <bEngineSoaVector.h> // for the structure-of-arrays layouts
+
+#include <glm\glm.hpp> // for the particles' fields and the transform
+
+#include <chrono>   // for timing the kernels
+#include <cstddef>  // for size_t
+#include <format>   // for formatting the results
+#include <iostream> // for printing the results, in every configuration
+#include <random>   // for generating the particles
+#include <vector>   // for the AoS layout
+
+namespace
+{
+    /// @brief the number of particles in every layout
+    constexpr std::size_t s_particleCount{1000000};
+
+    /// @brief the number of times each kernel runs; the fastest run is reported
+    constexpr int s_runCount{20};
+
+    /// @brief the time step the particles are integrated with
+    constexpr float s_deltaTime{1.0f / 60.0f};
+
+    /// @brief a particle, as most of the engine's per-object data is stored today
+    struct Particle
+    {
+        /// @brief the position of the particle
+        glm::vec3 m_position{0.0f};
+
+        /// @brief the velocity of the particle
+        glm::vec3 m_velocity{0.0f};
+
+        /// @brief the color of the particle
+        glm::vec4 m_color{1.0f};
+
+        /// @brief the remaining lifetime of the particle, in seconds
+        float m_lifetime{0.0f};
+    };
+
+    /// @brief the particles as a structure of glm fields: position, velocity, color, lifetime
+    using GlmSoa = bEngine::bEngineSoaVector<glm::vec3, glm::vec3, glm::vec4, float>;
+
+    /// @brief the particles as a structure of scalar fields: position x/y/z, velocity x/y/z, color, lifetime
+    using ScalarSoa = bEngine::bEngineSoaVector<float, float, float, float, float, float, glm::vec4, float>;
+
+    /// @brief runs a kernel a number of times
+    /// @tparam Fn the type of the kernel
+    /// @param kernel the kernel
+    /// @return the duration of the fastest run, in milliseconds
+    template <typename Fn>
+    const double time_kernel(Fn &&kernel)
+    {
+        auto fastest{0.0};
+        for (int run{0}; run < s_runCount; ++run)
+        {
+            const auto start{std::chrono::steady_clock::now()};
+            kernel();
+            const auto milliseconds{
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()};
+            if (run == 0 || milliseconds < fastest)
+                fastest = milliseconds;
+        }
+        return fastest;
+    }
+
+    /// @brief prints the timings of one kernel over every layout
+    /// @param kernel the name of the kernel
+    /// @param aos the time taken with the AoS layout, in milliseconds
+    /// @param glmSoa the time taken with the SoA of glm fields, in milliseconds
+    /// @param scalarSoa the time taken with the SoA of scalar fields, in milliseconds
+    void report(const char *const kernel, const double aos, const double glmSoa, const double scalarSoa)
+    {
+        std::cout << std::format("{}: AoS {:.3f} ms, SoA (glm fields) {:.3f} ms ({:.2f}x), SoA (scalar fields) "
+                                 "{:.3f} ms ({:.2f}x)\n",
+                                 kernel,
+                                 aos,
+                                 glmSoa,
+                                 aos / glmSoa,
+                                 scalarSoa,
+                                 aos / scalarSoa);
+    }
+} // namespace
+
+/// @brief fills every layout with the same particles, then times the kernels over each of them
+///
+/// nothing is left to run once this returns, so the application exits straight away
+/// @return true, since there's nothing which can fail
+const bool initialize(bEngine::bEngineApp *const /*app*/)
+{
+    std::mt19937                          random{1234};
+    std::uniform_real_distribution<float> distribution{-1.0f, 1.0f};
+
+    std::vector<Particle> aos;
+    GlmSoa                glmSoa;
+    ScalarSoa             scalarSoa;
+    aos.reserve(s_particleCount);
+    glmSoa.reserve(s_particleCount);
+    scalarSoa.reserve(s_particleCount);
+    for (std::size_t i{0}; i < s_particleCount; ++i)
+    {
+        const glm::vec3 position{distribution(random), distribution(random), distribution(random)};
+        const glm::vec3 velocity{distribution(random), distribution(random), distribution(random)};
+        const glm::vec4 color{1.0f};
+        const auto      lifetime{distribution(random) + 2.0f};
+        aos.push_back({position, velocity, color, lifetime});
+        glmSoa.push_back(position, velocity, color, lifetime);
+        scalarSoa.push_back(position.x, position.y, position.z, velocity.x, velocity.y, velocity.z, color, lifetime);
+    }
+    std::cout << std::format(
+        "Running each kernel over {} particles {} times (fastest run shown).\n", s_particleCount, s_runCount);
+
+    // integrate: position += velocity * dt, which only touches two of the four fields
+    const auto integrateAos{time_kernel([&]() {
+        for (auto &particle : aos)
+            particle.m_position += particle.m_velocity * s_deltaTime;
+    })};
+    const auto integrateGlmSoa{time_kernel([&]() {
+        glmSoa.zip<0, 1>().for_each(
+            [](glm::vec3 &position, const glm::vec3 &velocity) { position += velocity * s_deltaTime; });
+    })};
+    const auto integrateScalarSoa{time_kernel([&]() {
+        // the padding past size() is value initialized, so the loop can run to padded_size() without a remainder
+        auto *const       px{scalarSoa.data<0>()};
+        auto *const       py{scalarSoa.data<1>()};
+        auto *const       pz{scalarSoa.data<2>()};
+        const auto *const vx{scalarSoa.data<3>()};
+        const auto *const vy{scalarSoa.data<4>()};
+        const auto *const vz{scalarSoa.data<5>()};
+        const auto        count{scalarSoa.padded_size()};
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            px[i] += vx[i] * s_deltaTime;
+            py[i] += vy[i] * s_deltaTime;
+            pz[i] += vz[i] * s_deltaTime;
+        }
+    })};
+    report("integrate", integrateAos, integrateGlmSoa, integrateScalarSoa);
+
+    // transform: position = rotation * position + translation, i.e. a glm affine transform of every position
+    const glm::mat3 rotation{0.36f, 0.48f, -0.8f, -0.8f, 0.6f, 0.0f, 0.48f, 0.64f, 0.6f};
+    const glm::vec3 translation{0.5f, -0.25f, 1.0f};
+    const auto      transformAos{time_kernel([&]() {
+        for (auto &particle : aos)
+            particle.m_position = rotation * particle.m_position + translation;
+    })};
+    const auto transformGlmSoa{time_kernel([&]() {
+        auto *const positions{glmSoa.data<0>()};
+        const auto  count{glmSoa.size()};
+        for (std::size_t i{0}; i < count; ++i)
+            positions[i] = rotation * positions[i] + translation;
+    })};
+    const auto transformScalarSoa{time_kernel([&]() {
+        auto *const px{scalarSoa.data<0>()};
+        auto *const py{scalarSoa.data<1>()};
+        auto *const pz{scalarSoa.data<2>()};
+        const auto  count{scalarSoa.padded_size()};
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            const auto x{px[i]};
+            const auto y{py[i]};
+            const auto z{pz[i]};
+            px[i] = rotation[0][0] * x + rotation[1][0] * y + rotation[2][0] * z + translation.x;
+            py[i] = rotation[0][1] * x + rotation[1][1] * y + rotation[2][1] * z + translation.y;
+            pz[i] = rotation[0][2] * x + rotation[1][2] * y + rotation[2][2] * z + translation.z;
+        }
+    })};
+    report("transform", transformAos, transformGlmSoa, transformScalarSoa);
+
+    // age: lifetime -= dt, which touches a single scalar field
+    const auto ageAos{time_kernel([&]() {
+        for (auto &particle : aos)
+            particle.m_lifetime -= s_deltaTime;
+    })};
+    const auto ageGlmSoa{time_kernel([&]() {
+        auto *const lifetimes{glmSoa.data<3>()};
+        const auto  count{glmSoa.padded_size()};
+        for (std::size_t i{0}; i < count; ++i)
+            lifetimes[i] -= s_deltaTime;
+    })};
+    const auto ageScalarSoa{time_kernel([&]() {
+        auto *const lifetimes{scalarSoa.data<7>()};
+        const auto  count{scalarSoa.padded_size()};
+        for (std::size_t i{0}; i < count; ++i)
+            lifetimes[i] -= s_deltaTime;
+    })};
+    report("age", ageAos, ageGlmSoa, ageScalarSoa);
+    return true;
+}
+
+namespace bEngine
+{
+    /// @brief store an instance of the app statically
+    bEngineApp app{bEngineApp::create_app("SoA Benchmark", initialize, nullptr, 1.0 / 60.0, nullptr, nullptr)};
+
+    /// @brief returns an instance of the application class so the library can access the user-defined/configured
+    /// application
+    /// @return a reference to the benchmark application
+    bEngineApp &get_app()
+    {
+        return app;
+    }
+} // namespace bEngine
\ No newline at end of file
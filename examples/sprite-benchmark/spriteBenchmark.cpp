@@ -0,0 +1,245 @@
+/// @file spriteBenchmark.cpp
+/// @brief a benchmark scene which moves 100K sprites around the window every frame and draws them with a sprite batch,
+/// reporting the cost of building and drawing them
+
+#include <bEngineApp.h>           // for access to the bEngineApp class and creation function
+#include <bEngineCommandBuffer.h> // for recording the scene's draws
+#include <bEngineSpriteBatch.h>   // for the sprite atlas and batch
+#include <bEngineUtilities.h>     // for asserting the sprite images were packed
+#include <bEngineWindow.h>        // for access to the bEngineWindow class and creation function
+
+#include <glad\gl.h>                    // for the values of the GL enums passed to the GL wrappers
+#include <glm\gtc\matrix_transform.hpp> // for the scene's orthographic projection
+
+#include <algorithm> // for clamping texels and frame times
+#include <chrono>    // for timing each frame
+#include <cmath>     // for generating the sprite images
+#include <cstdint>   // for the sprite images' texels
+#include <format>    // for formatting the results
+#include <iostream>  // for printing the results, in every configuration
+#include <memory>    // for the lazily created scene
+#include <random>    // for scattering the sprites
+#include <vector>    // for the scene's sprites
+
+namespace
+{
+    /// @brief the number of sprites drawn every frame
+    constexpr std::uint32_t s_spriteCount{100000};
+
+    /// @brief the number of different sprite images in the atlas
+    constexpr int s_imageCount{8};
+
+    /// @brief the width and height of each sprite image, in texels
+    constexpr int s_imageSize{32};
+
+    /// @brief the number of layers the sprites are spread over
+    constexpr std::uint8_t s_layerCount{4};
+
+    /// @brief the width of the scene (in the projection's units)
+    constexpr float s_sceneWidth{1280.0f};
+
+    /// @brief the height of the scene (in the projection's units)
+    constexpr float s_sceneHeight{720.0f};
+
+    /// @brief the number of frames the results are averaged over
+    constexpr unsigned int s_framesPerReport{300};
+
+    /// @brief the movement of a single sprite
+    struct Motion
+    {
+        /// @brief the velocity of the sprite (units per second)
+        glm::vec2 m_velocity{0.0f};
+
+        /// @brief the angular velocity of the sprite (radians per second)
+        float m_spin{0.0f};
+    };
+
+    /// @brief everything the scene draws with; created on the first render, since GL objects need the window's context
+    struct Scene
+    {
+        /// @brief the stream buffer the sprite instances are written to each frame
+        bEngine::bEngineGLStreamBuffer m_streamBuffer{s_spriteCount * 32 + 4096};
+
+        /// @brief the atlas every sprite image is packed into
+        bEngine::bEngineSpriteAtlas m_atlas{256, 1};
+
+        /// @brief the sprite batch
+        bEngine::bEngineSpriteBatch m_batch{m_streamBuffer};
+
+        /// @brief the sprites
+        std::vector<bEngine::bEngineSprite> m_sprites;
+
+        /// @brief the movement of each sprite
+        std::vector<Motion> m_motions;
+    };
+
+    /// @brief the scene, created the first time the window renders (its GL objects are released with the window)
+    std::unique_ptr<Scene> s_scene{nullptr};
+
+    /// @brief the number of frames rendered
+    unsigned long long s_frameCount{0};
+
+    /// @brief the time spent moving the sprites and recording them since the last report, in seconds
+    double s_recordSeconds{0.0};
+
+    /// @brief the time between frames since the last report, in seconds
+    double s_frameSeconds{0.0};
+
+    /// @brief the time the last frame started
+    std::chrono::steady_clock::time_point s_lastFrameTime{};
+
+    /// @brief generates one of the sprite images: a soft disc with a ring pattern which differs per image
+    /// @param image the index of the image
+    /// @return the image's texels as RGBA8
+    std::vector<std::uint32_t> generate_image(const int image)
+    {
+        std::vector<std::uint32_t> texels(s_imageSize * s_imageSize);
+        for (int y{0}; y < s_imageSize; ++y)
+        {
+            for (int x{0}; x < s_imageSize; ++x)
+            {
+                const auto u{(x + 0.5f) / s_imageSize * 2.0f - 1.0f};
+                const auto v{(y + 0.5f) / s_imageSize * 2.0f - 1.0f};
+                const auto distance{std::sqrt(u * u + v * v)};
+                const auto rings{0.5f + 0.5f * std::cos(distance * (image + 2) * 3.14159265f)};
+                const auto alpha{std::clamp(1.0f - distance, 0.0f, 1.0f) * 2.0f};
+                const auto toByte{[](const float value) {
+                    return static_cast<std::uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f);
+                }};
+                texels[y * s_imageSize + x] = toByte(0.5f + 0.5f * rings) | (toByte(rings) << 8) |
+                                              (toByte(1.0f - rings * 0.5f) << 16) | (toByte(alpha) << 24);
+            }
+        }
+        return texels;
+    }
+
+    /// @brief creates the scene: an atlas of sprite images, two materials and the sprites scattered over the scene
+    void create_scene()
+    {
+        s_scene = std::make_unique<Scene>();
+
+        std::vector<bEngine::bEngineSpriteImage> images(s_imageCount);
+        for (int image{0}; image < s_imageCount; ++image)
+        {
+            const auto texels{generate_image(image)};
+            const auto isAdded{s_scene->m_atlas.add_image(s_imageSize, s_imageSize, texels.data(), images[image])};
+            bENGINE_ASSERT(isAdded, "Failed to pack the benchmark's sprite images!");
+        }
+
+        const auto alpha{s_scene->m_batch.add_material({&s_scene->m_atlas, bEngine::bEngineBlendMode::Alpha})};
+        const auto additive{s_scene->m_batch.add_material({&s_scene->m_atlas, bEngine::bEngineBlendMode::Additive})};
+
+        std::mt19937                          random{1234};
+        std::uniform_real_distribution<float> unit{0.0f, 1.0f};
+        const auto                            tint{[&]() { return 0.5f + 0.5f * unit(random); }};
+        for (std::uint32_t sprite{0}; sprite < s_spriteCount; ++sprite)
+        {
+            bEngine::bEngineSprite item{};
+            item.m_position = {unit(random) * s_sceneWidth, unit(random) * s_sceneHeight};
+            item.m_scale    = glm::vec2{4.0f + 12.0f * unit(random)};
+            item.m_rotation = unit(random) * 6.2831853f;
+            item.m_color    = {tint(), tint(), tint(), 0.8f};
+            item.m_image    = images[sprite % s_imageCount];
+            item.m_material = sprite % 5 == 0 ? additive : alpha;
+            item.m_layer    = static_cast<std::uint8_t>(sprite % s_layerCount);
+            s_scene->m_sprites.push_back(item);
+
+            const auto angle{unit(random) * 6.2831853f};
+            const auto speed{20.0f + 80.0f * unit(random)};
+            s_scene->m_motions.push_back(
+                {{speed * std::cos(angle), speed * std::sin(angle)}, (unit(random) - 0.5f) * 4.0f});
+        }
+    }
+
+    /// @brief moves every sprite, bouncing them off the edges of the scene
+    /// @param seconds the time to move the sprites by, in seconds
+    void move_sprites(const float seconds)
+    {
+        for (std::uint32_t index{0}; index < s_spriteCount; ++index)
+        {
+            auto &sprite{s_scene->m_sprites[index]};
+            auto &motion{s_scene->m_motions[index]};
+            sprite.m_position += motion.m_velocity * seconds;
+            sprite.m_rotation = std::fmod(sprite.m_rotation + motion.m_spin * seconds, 6.2831853f);
+            if (sprite.m_position.x < 0.0f)
+                motion.m_velocity.x = std::abs(motion.m_velocity.x);
+            else if (sprite.m_position.x > s_sceneWidth)
+                motion.m_velocity.x = -std::abs(motion.m_velocity.x);
+            if (sprite.m_position.y < 0.0f)
+                motion.m_velocity.y = std::abs(motion.m_velocity.y);
+            else if (sprite.m_position.y > s_sceneHeight)
+                motion.m_velocity.y = -std::abs(motion.m_velocity.y);
+        }
+    }
+} // namespace
+
+/// @brief moves and draws the sprites and reports the average cost every few hundred frames
+///
+/// the frame time covers everything between two renders, including executing the commands; the window presents
+/// immediately so it measures the rendering cost rather than the refresh rate
+/// @param window the window being rendered
+/// @param commands the window's command buffer
+void render(const bEngine::bEngineWindow *const /*window*/, bEngine::bEngineCommandBuffer &commands)
+{
+    if (!s_scene)
+        create_scene();
+
+    const auto frameStart{std::chrono::steady_clock::now()};
+    const auto elapsedSeconds{
+        s_frameCount == 0 ? 0.0 : std::chrono::duration<double>(frameStart - s_lastFrameTime).count()};
+    if (s_frameCount % s_framesPerReport != 0)
+        s_frameSeconds += elapsedSeconds;
+    s_lastFrameTime = frameStart;
+
+    // the sprites move at the same speed regardless of the frame rate, but a hitch doesn't send them flying
+    move_sprites(static_cast<float>(std::min(elapsedSeconds, 0.1)));
+
+    auto &batch{s_scene->m_batch};
+    batch.begin();
+    batch.add_sprites(s_scene->m_sprites);
+    commands.clear_color(bEngine::make_sort_key(0, 0, 0, 0, 0), nullptr, 0.05f, 0.05f, 0.1f, 1.0f);
+    batch.record(commands, bEngine::make_sort_key(1, 0, 0, 0, 0), glm::ortho(0.0f, s_sceneWidth, 0.0f, s_sceneHeight));
+    s_recordSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count();
+
+    // report the averages once enough frames have been rendered
+    if (++s_frameCount % s_framesPerReport == 0)
+    {
+        const auto stats{batch.get_stats()};
+        std::cout << std::format(
+            "{:.3f} ms moving/recording, {:.3f} ms per frame ({} sprites in {} draws, {} dropped)\n",
+            s_recordSeconds * 1000.0 / s_framesPerReport,
+            s_frameSeconds * 1000.0 / (s_framesPerReport - 1),
+            stats.m_spriteCount,
+            stats.m_drawCount,
+            stats.m_droppedSprites);
+        s_recordSeconds = 0.0;
+        s_frameSeconds  = 0.0;
+    }
+}
+
+/// @brief creates the benchmark's window, which presents without waiting for vsync
+/// @param app a reference to the application which is owned by the library
+/// @return true, since there's nothing which can fail
+const bool initialize(bEngine::bEngineApp *const app)
+{
+    std::cout << std::format("Drawing {} moving sprites with a sprite batch.\n", s_spriteCount);
+
+    auto window{bEngine::bEngineWindow::create_window(1280, 720, "Sprite Benchmark", render)};
+    window->set_present_mode(bEngine::bEnginePresentMode::Immediate);
+    app->add_window(std::move(window));
+    return true;
+}
+
+namespace bEngine
+{
+    /// @brief store an instance of the app statically
+    bEngineApp app{bEngineApp::create_app("Sprite Benchmark", initialize, nullptr, 1.0 / 60.0, nullptr, nullptr)};
+
+    /// @brief returns an instance of the application class so the library can access the user-defined/configured
+    /// application
+    /// @return a reference to the benchmark application
+    bEngineApp &get_app()
+    {
+        return app;
+    }
+} // namespace bEngine
\ No newline at end of file
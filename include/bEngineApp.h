@@ -3,9 +3,10 @@
 /// @file bEngineApp.h
 /// @brief the interface for an app in the bEngine library
 
-#include <memory> // for access to unique_ptr which is used to store the bEngineWindows associated with the application
-#include <string> // for strings
-#include <vector> // for storing a collection of bEngineWindows which are managed by the application
+#include <cstddef> // for size_t
+#include <memory>  // for access to unique_ptr which is used to store the bEngineWindows associated with the application
+#include <string>  // for strings
+#include <vector>  // for storing a collection of bEngineWindows which are managed by the application
 
 /// @brief the bEngine namespace is used to organize the classes/structs/types/functions associated with the bEngine
 /// library
@@ -34,6 +35,9 @@ namespace bEngine
     // fwd declaration for the bEngineWindow class which the application stores a vector of unique_ptrs of
     class bEngineWindow;
 
+    // fwd declaration for the bEngineStateArena class which the application (optionally) owns to enable rewinding
+    class bEngineStateArena;
+
     /// @brief the bEngineApp class provides an interface for the library to run the application as well as a static
     /// method which is to be used to create an application by providing various function pointers which will be used by
     /// the framework
@@ -92,6 +96,25 @@ namespace bEngine
         /// @brief the windows owned/managed by the application
         std::vector<std::unique_ptr<bEngineWindow>> m_windows;
 
+        /// @brief the (optional) arena which holds all of the tick-mutable simulation state; when it exists it is
+        /// snapshotted after every tick so the application can rewind and resimulate
+        std::unique_ptr<bEngineStateArena> m_stateArena{nullptr};
+
+        /// @brief the number of ticks which have been simulated
+        unsigned long long m_currentTick{0};
+
+        /// @brief the tick the application has been asked to rewind to (only meaningful if m_isRewindRequested)
+        unsigned long long m_rewindTick{0};
+
+        /// @brief true if a rewind has been requested since the last frame's ticks
+        bool m_isRewindRequested{false};
+
+        /// @brief true while previously simulated ticks are being simulated again after a rewind
+        bool m_isResimulating{false};
+
+        /// @brief true if every window's presents are paced by the last window's (see bEngineWindow::render_windows())
+        bool m_isPresentationPaced{false};
+
         // private ctor
       private:
         /// @brief ctor which takes all of the arguments required to construct an application
@@ -114,8 +137,9 @@ namespace bEngine
         /// @brief default ctor is insufficient
         bEngineApp() = delete;
 
-        /// @brief default dtor is acceptable
-        ~bEngineApp() = default;
+        /// @brief dtor must be defined in the bEngineApp.cpp file where the full definition of the bEngineStateArena
+        /// class is known
+        ~bEngineApp();
 
         // public functions/methods
       public:
@@ -124,6 +148,46 @@ namespace bEngine
         /// @return the ID associated with the new window
         const unsigned int add_window(std::unique_ptr<bEngineWindow> &&newWindow);
 
+        /// @brief creates the application's state arena, replacing any existing arena
+        ///
+        /// all tick-mutable simulation state should be created in the arena (ideally during initialization); the
+        /// arena is then snapshotted after every tick, which is what allows request_rewind() to work
+        /// @param sizeInBytes the number of bytes the arena can hold
+        /// @param snapshotCount the number of ticks which are kept (and can therefore be rewound to)
+        /// @param numaNode the NUMA node the arena should live on, or -1 for no preference
+        /// @param useLargePages true to back the arena (and its snapshots) with large pages
+        /// @return a pointer to the new state arena, which is owned by the application
+        bEngineStateArena *const create_state_arena(
+            const std::size_t  sizeInBytes,
+            const unsigned int snapshotCount = 64,
+            const int          numaNode      = -1,
+            const bool         useLargePages = false);
+
+        /// @brief gets the application's state arena
+        /// @return a pointer to the application's state arena, or nullptr if one was never created
+        bEngineStateArena *const get_state_arena() const;
+
+        /// @brief gets the number of ticks which have been simulated
+        /// @return the number of ticks which have been simulated
+        const unsigned long long get_current_tick() const;
+
+        /// @brief checks whether the tick function is currently being called to resimulate a tick after a rewind
+        ///
+        /// useful for skipping side effects (sounds, particles, etc.) which already happened the first time the tick
+        /// was simulated
+        /// @return true if a tick is being resimulated, false if not
+        const bool get_is_resimulating() const;
+
+        /// @brief asks the application to rewind to the given tick and resimulate up to the current tick
+        ///
+        /// the rewind happens at the start of the next frame's ticks: the state arena is restored to its snapshot of
+        /// the given tick and the tick function is called (with get_is_resimulating() returning true) until the
+        /// simulation has caught up, all within that one frame
+        /// @param tick the tick to rewind to
+        /// @return true if the rewind was scheduled, false if there is no state arena, the tick is no longer in its
+        /// snapshot ring, or the request was made while resimulating
+        const bool request_rewind(const unsigned long long tick);
+
         /// @brief runs the (user-provided) initialization function and general application setup
         /// @return true if the user provided a initialization function and it succeeds OR if the user did NOT provide
         /// an initialization function and general initialization succeeds; returns false if the user-provided
@@ -146,6 +210,18 @@ namespace bEngine
         /// @param tickLength
         void set_tick_length(const double tickLength);
 
+        /// @brief sets whether the application's windows present paced by the last window added
+        ///
+        /// with paced presentation only the last window's present waits for the display (according to its present
+        /// mode) while every other window presents immediately, so several windows rendered from the main thread
+        /// don't each wait a whole refresh per frame
+        /// @param isPresentationPaced true to pace the windows' presents, false for each to follow its own present mode
+        void set_is_presentation_paced(const bool isPresentationPaced);
+
+        /// @brief checks whether the application's windows present paced by the last window added
+        /// @return true if the windows' presents are paced, false if each follows its own present mode
+        const bool get_is_presentation_paced() const;
+
         /// @brief runs the application's (user-provided) shutdown function
         void shutdown() const;
     };
@@ -0,0 +1,407 @@
+#pragma once
+
+/// @file bEngineCommandBuffer.h
+/// @brief the interface for render command buffers in the bEngine library
+///
+/// rather than making GL calls immediately, rendering code records commands (compact POD packets) into command
+/// buffers, each with a 64-bit sort key. Once per bEngineWindow::render() every command recorded for the window is
+/// radix sorted by key and executed on the thread which owns the window's context, so the order commands are recorded
+/// in doesn't matter: sorting groups commands which share state, which keeps the number of state changes minimal.
+///
+/// a command buffer is NOT thread-safe; each thread records into its own buffer(s) and submits them to the window
+/// (see bEngineWindow::submit_commands(), which is thread-safe).
+
+#include <cstddef> // for ptrdiff_t (the size of GLintptr/GLsizeiptr)
+#include <cstdint> // for fixed-width sort keys
+#include <vector>  // for the recorded keys/commands
+
+namespace bEngine
+{
+    // fwd declarations of the GL object wrappers which commands reference
+    class bEngineGLBuffer;
+    class bEngineGLFramebuffer;
+    class bEngineGLProgram;
+    class bEngineGLSampler;
+    class bEngineGLTexture;
+    class bEngineGLVertexArray;
+
+    /// @brief builds a sort key; commands are executed in increasing key order
+    ///
+    /// layout (most to least significant): layer (8 bits) | pass (8 bits) | shader (16 bits) | material (16 bits) |
+    /// depth (16 bits). Clears should use a lower layer/pass than the draws they precede; translucent draws should use
+    /// an inverted depth (see quantize_depth()) so they're drawn back to front.
+    /// @param layer the layer (e.g. world, UI)
+    /// @param pass the pass within the layer (e.g. clear, opaque, translucent)
+    /// @param shader an ID of the shader, so draws using the same program are adjacent
+    /// @param material an ID of the material (textures/uniforms), so draws using the same material are adjacent
+    /// @param depth the quantized depth of the draw
+    /// @return the sort key
+    constexpr std::uint64_t make_sort_key(
+        const std::uint8_t  layer,
+        const std::uint8_t  pass,
+        const std::uint16_t shader,
+        const std::uint16_t material,
+        const std::uint16_t depth)
+    {
+        return (static_cast<std::uint64_t>(layer) << 56) | (static_cast<std::uint64_t>(pass) << 48) |
+               (static_cast<std::uint64_t>(shader) << 32) | (static_cast<std::uint64_t>(material) << 16) | depth;
+    }
+
+    /// @brief quantizes a view depth into the depth field of a sort key
+    /// @param viewDepth the depth of the draw (e.g. the distance from the camera to the object)
+    /// @param nearDepth the depth which maps to 0
+    /// @param farDepth the depth which maps to the maximum
+    /// @param isBackToFront true to invert the depth, so further draws sort first (for translucent draws)
+    /// @return the quantized depth
+    constexpr std::uint16_t quantize_depth(
+        const float viewDepth,
+        const float nearDepth,
+        const float farDepth,
+        const bool  isBackToFront = false)
+    {
+        const float normalized{(viewDepth - nearDepth) / (farDepth - nearDepth)};
+        const float clamped{normalized < 0.0f ? 0.0f : (normalized > 1.0f ? 1.0f : normalized)};
+        const auto  quantized{static_cast<std::uint16_t>(clamped * 65535.0f)};
+        return isBackToFront ? static_cast<std::uint16_t>(65535 - quantized) : quantized;
+    }
+
+    /// @brief how a draw blends with what's already in the framebuffer
+    enum class bEngineBlendMode : unsigned char
+    {
+        Opaque,        ///< no blending
+        Alpha,         ///< source alpha blending (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)
+        Premultiplied, ///< premultiplied alpha blending (GL_ONE, GL_ONE_MINUS_SRC_ALPHA)
+        Additive       ///< additive blending (GL_SRC_ALPHA, GL_ONE)
+    };
+
+    /// @brief how a draw uses the depth buffer
+    enum class bEngineDepthMode : unsigned char
+    {
+        Disabled,     ///< no depth testing or writing
+        TestAndWrite, ///< depth test (GL_LEQUAL) and write
+        TestOnly      ///< depth test (GL_LEQUAL) without writing, e.g. for translucent draws
+    };
+
+    /// @brief which faces of a draw are culled
+    enum class bEngineCullMode : unsigned char
+    {
+        None,  ///< no culling
+        Back,  ///< back faces are culled
+        Front, ///< front faces are culled
+    };
+
+    /// @brief the fixed-function state a draw is executed with
+    struct bEngineRenderState
+    {
+        /// @brief how the draw blends
+        bEngineBlendMode m_blend{bEngineBlendMode::Opaque};
+
+        /// @brief how the draw uses the depth buffer
+        bEngineDepthMode m_depth{bEngineDepthMode::TestAndWrite};
+
+        /// @brief which faces of the draw are culled
+        bEngineCullMode m_cull{bEngineCullMode::Back};
+    };
+
+    /// @brief the rectangle of the target a draw is mapped to (glViewport), in pixels
+    ///
+    /// a zero width or height stands for the render's default viewport: the whole window (or the scaled part of it,
+    /// with dynamic resolution). Draws to framebuffers of a different size (e.g. a half resolution texture) have to
+    /// set the viewport to the framebuffer's size.
+    struct bEngineViewport
+    {
+        /// @brief the x coordinate of the viewport's lower left corner
+        int m_x{0};
+
+        /// @brief the y coordinate of the viewport's lower left corner
+        int m_y{0};
+
+        /// @brief the width of the viewport (0 for the render's default viewport)
+        int m_width{0};
+
+        /// @brief the height of the viewport (0 for the render's default viewport)
+        int m_height{0};
+    };
+
+    /// @brief the description of a single draw; every draw is self-contained (it carries all of the state it needs),
+    /// which is what allows draws to be reordered freely
+    struct bEngineDrawItem
+    {
+        /// @brief the number of texture (and sampler) units a draw can bind
+        static constexpr unsigned int s_textureCount{4};
+
+        /// @brief the program to draw with; while it's still being built its placeholder is drawn with instead, or the
+        /// draw is skipped if it has none
+        const bEngineGLProgram *m_program{nullptr};
+
+        /// @brief the vertex array to draw with
+        const bEngineGLVertexArray *m_vertexArray{nullptr};
+
+        /// @brief the framebuffer to draw to, or nullptr for the window
+        const bEngineGLFramebuffer *m_framebuffer{nullptr};
+
+        /// @brief the viewport to draw with; the render's default viewport unless it's given a size
+        bEngineViewport m_viewport{};
+
+        /// @brief the textures bound to units 0 through s_textureCount - 1 (nullptr for none)
+        const bEngineGLTexture *m_textures[s_textureCount]{};
+
+        /// @brief the samplers bound to units 0 through s_textureCount - 1 (nullptr to use the textures' parameters)
+        const bEngineGLSampler *m_samplers[s_textureCount]{};
+
+        /// @brief the buffer bound to uniform block binding 0 for the draw (e.g. per-draw data), or nullptr for none
+        const bEngineGLBuffer *m_uniformBuffer{nullptr};
+
+        /// @brief the offset of the uniform block's data in the uniform buffer, in bytes
+        std::ptrdiff_t m_uniformOffset{0};
+
+        /// @brief the size of the uniform block's data, in bytes (0 for the rest of the buffer)
+        std::ptrdiff_t m_uniformSize{0};
+
+        /// @brief the buffer bound to uniform block binding 1 for the draw (e.g. per-material data which persists
+        /// between frames), or nullptr for none
+        const bEngineGLBuffer *m_materialBuffer{nullptr};
+
+        /// @brief the offset of the material uniform block's data in the material buffer, in bytes
+        std::ptrdiff_t m_materialOffset{0};
+
+        /// @brief the size of the material uniform block's data, in bytes (0 for the rest of the buffer)
+        std::ptrdiff_t m_materialSize{0};
+
+        /// @brief the buffer bound to shader storage block binding 0 for the draw (e.g. per-draw data indexed by
+        /// gl_BaseInstance/gl_DrawID), or nullptr for none
+        const bEngineGLBuffer *m_storageBuffer{nullptr};
+
+        /// @brief the offset of the shader storage block's data in the storage buffer, in bytes
+        std::ptrdiff_t m_storageOffset{0};
+
+        /// @brief the size of the shader storage block's data, in bytes (0 for the rest of the buffer)
+        std::ptrdiff_t m_storageSize{0};
+
+        /// @brief the fixed-function state of the draw
+        bEngineRenderState m_state{};
+
+        /// @brief the primitive mode (e.g. GL_TRIANGLES, the default)
+        unsigned int m_mode{0x0004};
+
+        /// @brief the type of the indices in the vertex array's element buffer (e.g. GL_UNSIGNED_INT), or 0 for a
+        /// non-indexed draw
+        unsigned int m_indexType{0};
+
+        /// @brief the first vertex (non-indexed) or index (indexed) to draw
+        int m_first{0};
+
+        /// @brief the number of vertices (non-indexed) or indices (indexed) to draw
+        int m_count{0};
+
+        /// @brief the number of instances to draw
+        int m_instanceCount{1};
+
+        /// @brief the value added to each index before fetching vertices (indexed draws only)
+        int m_baseVertex{0};
+
+        /// @brief the first instance to draw (offsets instanced attributes and gl_BaseInstance)
+        unsigned int m_baseInstance{0};
+    };
+
+    /// @brief a single recorded command; a compact POD packet which references GL objects by name
+    struct bEngineRenderCommand
+    {
+        /// @brief the kinds of commands
+        enum class Type : unsigned char
+        {
+            ClearColor,
+            ClearDepth,
+            Draw,
+            MultiDrawIndirect
+        };
+
+        /// @brief the data of a draw command; see bEngineDrawItem for what each member means (objects are stored as
+        /// GL names, with 0 for none)
+        struct DrawData
+        {
+            /// @brief the program to draw with (or its placeholder, as of recording), with 0 skipping the draw
+            unsigned int m_program;
+
+            /// @brief the vertex array to draw with
+            unsigned int m_vertexArray;
+
+            /// @brief the textures bound to the first few texture units
+            unsigned int m_textures[bEngineDrawItem::s_textureCount];
+
+            /// @brief the samplers bound to the first few texture units
+            unsigned int m_samplers[bEngineDrawItem::s_textureCount];
+
+            /// @brief the buffer bound to uniform block binding 0
+            unsigned int m_uniformBuffer;
+
+            /// @brief the offset of the uniform block's data, in bytes
+            std::ptrdiff_t m_uniformOffset;
+
+            /// @brief the size of the uniform block's data, in bytes
+            std::ptrdiff_t m_uniformSize;
+
+            /// @brief the buffer bound to uniform block binding 1
+            unsigned int m_materialBuffer;
+
+            /// @brief the offset of the material uniform block's data, in bytes
+            std::ptrdiff_t m_materialOffset;
+
+            /// @brief the size of the material uniform block's data, in bytes
+            std::ptrdiff_t m_materialSize;
+
+            /// @brief the buffer bound to shader storage block binding 0
+            unsigned int m_storageBuffer;
+
+            /// @brief the offset of the shader storage block's data, in bytes
+            std::ptrdiff_t m_storageOffset;
+
+            /// @brief the size of the shader storage block's data, in bytes
+            std::ptrdiff_t m_storageSize;
+
+            /// @brief the buffer holding the indirect commands (multi-draws only)
+            unsigned int m_indirectBuffer;
+
+            /// @brief the offset of the first indirect command, in bytes (multi-draws only)
+            std::ptrdiff_t m_indirectOffset;
+
+            /// @brief the primitive mode
+            unsigned int m_mode;
+
+            /// @brief the type of the indices, or 0 for a non-indexed draw
+            unsigned int m_indexType;
+
+            /// @brief the first vertex/index to draw
+            int m_first;
+
+            /// @brief the number of vertices/indices to draw (or of indirect commands, for multi-draws)
+            int m_count;
+
+            /// @brief the number of instances to draw
+            int m_instanceCount;
+
+            /// @brief the value added to each index
+            int m_baseVertex;
+
+            /// @brief the first instance to draw
+            unsigned int m_baseInstance;
+        };
+
+        /// @brief the data of a clear command
+        struct ClearData
+        {
+            /// @brief the color to clear to (RGBA)
+            float m_color[4];
+
+            /// @brief the depth to clear to
+            float m_depth;
+        };
+
+        /// @brief the kind of command
+        Type m_type{Type::Draw};
+
+        /// @brief the fixed-function state of the command
+        bEngineRenderState m_state{};
+
+        /// @brief the framebuffer the command targets (0 for the window)
+        unsigned int m_framebuffer{0};
+
+        /// @brief the viewport the command draws with (a zero size for the render's default viewport)
+        bEngineViewport m_viewport{};
+
+        /// @brief the data of the command, depending on its type
+        union
+        {
+            DrawData  m_draw;
+            ClearData m_clear;
+        };
+    };
+
+    /// @brief a buffer of recorded render commands and their sort keys
+    class bEngineCommandBuffer
+    {
+        // private data
+      private:
+        /// @brief the sort key of each recorded command
+        std::vector<std::uint64_t> m_keys;
+
+        /// @brief the recorded commands
+        std::vector<bEngineRenderCommand> m_commands;
+
+        // private methods/functions
+      private:
+        /// @brief records a draw command
+        /// @param sortKey the sort key of the command
+        /// @param item the draw to record
+        /// @return a reference to the recorded command
+        bEngineRenderCommand &record_draw(const std::uint64_t sortKey, const bEngineDrawItem &item);
+
+        // public methods/functions
+      public:
+        /// @brief records a clear of a framebuffer's first color attachment
+        /// @param sortKey the sort key of the command
+        /// @param framebuffer the framebuffer to clear, or nullptr for the window
+        /// @param red the red component of the color to clear to
+        /// @param green the green component of the color to clear to
+        /// @param blue the blue component of the color to clear to
+        /// @param alpha the alpha component of the color to clear to
+        void clear_color(
+            const std::uint64_t         sortKey,
+            const bEngineGLFramebuffer *framebuffer,
+            const float                 red,
+            const float                 green,
+            const float                 blue,
+            const float                 alpha = 1.0f);
+
+        /// @brief records a clear of a framebuffer's depth attachment
+        /// @param sortKey the sort key of the command
+        /// @param framebuffer the framebuffer to clear, or nullptr for the window
+        /// @param depth the depth to clear to
+        void clear_depth(
+            const std::uint64_t         sortKey,
+            const bEngineGLFramebuffer *framebuffer,
+            const float                 depth = 1.0f);
+
+        /// @brief records a draw; only the GL names of the item's objects are recorded, so the wrappers don't have to
+        /// outlive the command buffer
+        /// @param sortKey the sort key of the command
+        /// @param item the draw to record
+        void draw(const std::uint64_t sortKey, const bEngineDrawItem &item);
+
+        /// @brief records an indexed multi-draw (glMultiDrawElementsIndirect), which submits a whole batch of draws
+        /// sharing the item's state with a single call
+        ///
+        /// the item's index type must be set; its first/count/instance/base members are ignored, since each
+        /// indirect command holds its own
+        /// @param sortKey the sort key of the command
+        /// @param item the state shared by every draw of the batch
+        /// @param indirectBuffer the buffer holding the indirect commands (see bEngineDrawIndirectCommand)
+        /// @param indirectOffset the offset of the first indirect command in the buffer, in bytes
+        /// @param drawCount the number of indirect commands
+        void multi_draw_indirect(
+            const std::uint64_t    sortKey,
+            const bEngineDrawItem &item,
+            const bEngineGLBuffer &indirectBuffer,
+            const std::ptrdiff_t   indirectOffset,
+            const int              drawCount);
+
+        /// @brief reserves space for a number of commands, to avoid reallocating while recording
+        /// @param commandCount the number of commands to reserve space for
+        void reserve(const std::size_t commandCount);
+
+        /// @brief removes every recorded command, keeping the buffer's memory for reuse
+        void reset();
+
+        /// @brief gets the number of recorded commands
+        /// @return the number of recorded commands
+        const std::size_t get_size() const;
+
+        /// @brief gets the sort keys of the recorded commands
+        /// @return the sort keys of the recorded commands, in recording order
+        const std::vector<std::uint64_t> &get_keys() const;
+
+        /// @brief gets the recorded commands
+        /// @return the recorded commands, in recording order
+        const std::vector<bEngineRenderCommand> &get_commands() const;
+    };
+} // namespace bEngine
\ No newline at end of file
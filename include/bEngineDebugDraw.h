@@ -0,0 +1,145 @@
+#pragma once
+
+/// @file bEngineDebugDraw.h
+/// @brief the interface for immediate-mode debug drawing in the bEngine library: lines, boxes, spheres, arrows and
+/// text labels which can be added from any thread and are drawn on top of every window; all of it compiles to nothing
+/// outside of debug builds, so debug draw calls should be made through the bENGINE_DEBUG_* macros
+
+#ifdef DEBUG
+
+#    include <glm\glm.hpp> // for the positions/colors debug geometry is described with
+
+#    include <string_view> // for text labels
+
+namespace bEngine
+{
+    // fwd declaration of the windows debug geometry is drawn in
+    class bEngineWindow;
+
+    /// @brief adds debug geometry to be drawn by every window
+    ///
+    /// each thread adds to its own buffer (so threads only contend with the collection of their buffer, not with each
+    /// other), and every shape is expanded into line segments as it's added. Once per frame, before windows render,
+    /// the threads' buffers are merged; each window then draws all of it with a single line draw, on top of (and
+    /// without depth testing against) whatever it drew.
+    ///
+    /// geometry is in world space and is transformed into clip space by the view projection set for each window
+    /// (identity until set). Text labels are anchored at a world position and drawn with a built-in stroke font at a
+    /// fixed pixel size, facing the screen. A duration of 0 draws the geometry in the next frame only; otherwise it's
+    /// drawn by every frame until the duration (in seconds) has passed.
+    class bEngineDebugDraw
+    {
+        // public static methods/functions
+      public:
+        /// @brief adds a line
+        /// @param from the start of the line
+        /// @param to the end of the line
+        /// @param color the color of the line
+        /// @param duration how long the line is drawn for, in seconds (0 for the next frame only)
+        static void add_line(
+            const glm::vec3 &from,
+            const glm::vec3 &to,
+            const glm::vec4 &color    = glm::vec4{1.0f},
+            const double     duration = 0.0);
+
+        /// @brief adds an axis aligned box
+        /// @param min the minimum corner of the box
+        /// @param max the maximum corner of the box
+        /// @param color the color of the box
+        /// @param duration how long the box is drawn for, in seconds (0 for the next frame only)
+        static void add_box(
+            const glm::vec3 &min,
+            const glm::vec3 &max,
+            const glm::vec4 &color    = glm::vec4{1.0f},
+            const double     duration = 0.0);
+
+        /// @brief adds an oriented box
+        /// @param transform the transform of a unit cube centered on the origin (i.e. from -0.5 to 0.5) into the box
+        /// @param color the color of the box
+        /// @param duration how long the box is drawn for, in seconds (0 for the next frame only)
+        static void add_box(
+            const glm::mat4 &transform,
+            const glm::vec4 &color    = glm::vec4{1.0f},
+            const double     duration = 0.0);
+
+        /// @brief adds a sphere, drawn as three circles around its axes
+        /// @param center the center of the sphere
+        /// @param radius the radius of the sphere
+        /// @param color the color of the sphere
+        /// @param duration how long the sphere is drawn for, in seconds (0 for the next frame only)
+        static void add_sphere(
+            const glm::vec3 &center,
+            const float      radius,
+            const glm::vec4 &color    = glm::vec4{1.0f},
+            const double     duration = 0.0);
+
+        /// @brief adds an arrow
+        /// @param from the tail of the arrow
+        /// @param to the head of the arrow
+        /// @param color the color of the arrow
+        /// @param duration how long the arrow is drawn for, in seconds (0 for the next frame only)
+        static void add_arrow(
+            const glm::vec3 &from,
+            const glm::vec3 &to,
+            const glm::vec4 &color    = glm::vec4{1.0f},
+            const double     duration = 0.0);
+
+        /// @brief adds a text label; the stroke font has digits, (upper case) letters and common punctuation, and
+        /// draws lower case letters as upper case
+        /// @param position the position the label is anchored at (the left end of its first line's baseline)
+        /// @param text the label (ASCII); lines are separated by '\n'
+        /// @param color the color of the label
+        /// @param pixelHeight the height of the label's letters, in pixels
+        /// @param duration how long the label is drawn for, in seconds (0 for the next frame only)
+        static void add_text(
+            const glm::vec3       &position,
+            const std::string_view text,
+            const glm::vec4       &color       = glm::vec4{1.0f},
+            const float            pixelHeight = 12.0f,
+            const double           duration    = 0.0);
+
+        /// @brief sets the matrix a window transforms debug geometry into clip space with
+        /// @param window the window
+        /// @param viewProjection the window's view projection matrix
+        static void set_view_projection(const bEngineWindow &window, const glm::mat4 &viewProjection);
+
+        /// @brief removes every piece of debug geometry, including any which hasn't reached the end of its duration
+        static void clear();
+    };
+} // namespace bEngine
+
+/// @brief adds a debug line (see bEngineDebugDraw::add_line()); compiles to nothing outside of debug builds
+#    define bENGINE_DEBUG_LINE(...) bEngine::bEngineDebugDraw::add_line(__VA_ARGS__)
+
+/// @brief adds a debug box (see bEngineDebugDraw::add_box()); compiles to nothing outside of debug builds
+#    define bENGINE_DEBUG_BOX(...) bEngine::bEngineDebugDraw::add_box(__VA_ARGS__)
+
+/// @brief adds a debug sphere (see bEngineDebugDraw::add_sphere()); compiles to nothing outside of debug builds
+#    define bENGINE_DEBUG_SPHERE(...) bEngine::bEngineDebugDraw::add_sphere(__VA_ARGS__)
+
+/// @brief adds a debug arrow (see bEngineDebugDraw::add_arrow()); compiles to nothing outside of debug builds
+#    define bENGINE_DEBUG_ARROW(...) bEngine::bEngineDebugDraw::add_arrow(__VA_ARGS__)
+
+/// @brief adds a debug text label (see bEngineDebugDraw::add_text()); compiles to nothing outside of debug builds
+#    define bENGINE_DEBUG_TEXT(...) bEngine::bEngineDebugDraw::add_text(__VA_ARGS__)
+
+/// @brief sets a window's debug view projection (see bEngineDebugDraw::set_view_projection()); compiles to nothing
+/// outside of debug builds
+#    define bENGINE_DEBUG_VIEW_PROJECTION(...) bEngine::bEngineDebugDraw::set_view_projection(__VA_ARGS__)
+
+/// @brief removes every piece of debug geometry (see bEngineDebugDraw::clear()); compiles to nothing outside of debug
+/// builds
+#    define bENGINE_DEBUG_CLEAR() bEngine::bEngineDebugDraw::clear()
+
+#else
+
+// debug drawing only exists in debug builds; elsewhere the macros (and their arguments) compile to nothing
+#    define bENGINE_DEBUG_LINE(...)
+#    define bENGINE_DEBUG_BOX(...)
+#    define bENGINE_DEBUG_SPHERE(...)
+#    define bENGINE_DEBUG_ARROW(...)
+#    define bENGINE_DEBUG_TEXT(...)
+#    define bENGINE_DEBUG_VIEW_PROJECTION(...)
+#    define bENGINE_DEBUG_CLEAR()
+
+#endif // DEBUG
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+/// @file bEngineDynamicResolution.h
+/// @brief the settings and statistics of dynamic resolution in the bEngine library (see
+/// bEngineWindow::set_dynamic_resolution())
+///
+/// with dynamic resolution a window renders into an offscreen target at a fraction (the render scale) of its size,
+/// which is then upscaled (bilinearly) into the window's framebuffer. The render scale is adjusted every time a new
+/// frame time is measured, by a PID controller steering the frame time towards a target: GPU time measured with
+/// GL_TIME_ELAPSED queries (read back a few frames later, without stalling) where the driver supports them, or the
+/// CPU time spent recording and executing the frame's commands otherwise.
+
+namespace bEngine
+{
+    /// @brief the settings of a window's dynamic resolution
+    struct bEngineDynamicResolutionSettings
+    {
+        /// @brief true to render at a dynamic resolution, false to render at the window's size
+        bool m_isEnabled{false};
+
+        /// @brief the frame time the controller steers towards, in seconds; a little under the frame budget (e.g. 15ms
+        /// for 60Hz) leaves headroom for the rest of the frame
+        double m_targetFrameSeconds{0.015};
+
+        /// @brief the smallest render scale (as a fraction of the window's width/height)
+        double m_minScale{0.5};
+
+        /// @brief the largest render scale (as a fraction of the window's width/height)
+        double m_maxScale{1.0};
+
+        /// @brief the gain of the controller's proportional term
+        double m_proportionalGain{0.2};
+
+        /// @brief the gain of the controller's integral term
+        double m_integralGain{0.02};
+
+        /// @brief the gain of the controller's derivative term
+        double m_derivativeGain{0.05};
+    };
+
+    /// @brief the statistics of a window's dynamic resolution (and the controller's decisions)
+    struct bEngineDynamicResolutionStats
+    {
+        /// @brief the current render scale (1 when dynamic resolution is disabled)
+        double m_scale{1.0};
+
+        /// @brief the width frames are rendered at, in pixels (i.e. the width of the viewport each render starts with)
+        int m_renderWidth{0};
+
+        /// @brief the height frames are rendered at, in pixels (i.e. the height of the viewport each render starts
+        /// with)
+        int m_renderHeight{0};
+
+        /// @brief true if frame times are measured on the GPU (GL_TIME_ELAPSED), false if they're measured on the CPU
+        bool m_isGpuTimed{false};
+
+        /// @brief the last measured frame time, in seconds
+        double m_lastFrameSeconds{0.0};
+
+        /// @brief the controller's last error: the last frame time's deviation from the target, relative to the target
+        /// (positive when over budget)
+        double m_lastError{0.0};
+
+        /// @brief the last change the controller made to the render scale
+        double m_lastAdjustment{0.0};
+
+        /// @brief the number of frame times the controller has been fed
+        unsigned long long m_sampleCount{0};
+
+        /// @brief the number of times the controller raised the render scale
+        unsigned long long m_increaseCount{0};
+
+        /// @brief the number of times the controller lowered the render scale
+        unsigned long long m_decreaseCount{0};
+    };
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,1044 @@
+#pragma once
+
+/// @file bEngineFlatMap.h
+/// @brief an open-addressing ("Swiss table" style) flat hash map which is used for engine lookups (resource caches,
+/// handle-to-name maps, input bindings, etc.) instead of std::unordered_map
+
+#include <algorithm>        // for std::max when sizing the table
+#include <bit>              // for bit_ceil/countr_zero when sizing the table and walking group match masks
+#include <cstddef>          // for size_t
+#include <cstdint>          // for the fixed width control bytes and group masks
+#include <cstring>          // for memset/memcpy of the control bytes
+#include <functional>       // for std::hash and the (transparent) std::equal_to<>
+#include <initializer_list> // for constructing a map from a list of values
+#include <iterator>         // for the forward iterator tag
+#include <memory>           // for allocator_traits, which is how all memory is requested
+#include <stdexcept>        // for std::out_of_range, thrown by at() to match the standard containers
+#include <string_view>      // for the transparent string hashing
+#include <tuple>            // for forward_as_tuple when constructing values in place
+#include <type_traits>      // for constraining the heterogeneous lookup overloads
+#include <utility>          // for pair/move/forward
+
+// the group probing uses SSE2 when it is available (which is always the case on x64) and falls back to a portable
+// "SIMD within a register" implementation otherwise (or when bENGINE_FLAT_MAP_NO_SIMD is defined)
+#if !defined(bENGINE_FLAT_MAP_NO_SIMD) &&                                                                             \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    include <emmintrin.h> // for the 16-wide byte comparisons
+#    define bENGINE_FLAT_MAP_SSE2
+#endif
+
+namespace bEngine
+{
+    /// @brief the default hasher used by the bEngineFlatMap
+    ///
+    /// string-like keys are hashed as std::string_view so a map keyed by std::string can be searched with a
+    /// std::string_view or a const char* without constructing a temporary std::string (i.e. heterogeneous lookup);
+    /// every other type is forwarded to std::hash
+    struct bEngineHash
+    {
+        /// @brief marks the hasher as transparent so the heterogeneous lookup overloads are enabled
+        using is_transparent = void;
+
+        /// @brief hashes any string-like value by its characters
+        /// @param str the string to be hashed
+        /// @return the hash of the characters of the string
+        std::size_t operator()(const std::string_view str) const noexcept
+        {
+            return std::hash<std::string_view>{}(str);
+        }
+
+        /// @brief hashes any (non string-like) value with std::hash
+        /// @tparam T the type of the value to be hashed
+        /// @param value the value to be hashed
+        /// @return the value's hash as reported by std::hash
+        template <typename T>
+            requires(!std::is_convertible_v<const T &, std::string_view>)
+        std::size_t operator()(const T &value) const noexcept(noexcept(std::hash<T>{}(value)))
+        {
+            return std::hash<T>{}(value);
+        }
+    };
+
+    /// @brief implementation details shared by the engine's (header-only) containers; not intended for use by the user
+    namespace Internal
+    {
+        /// @brief the type of a single control byte in the flat map
+        ///
+        /// a control byte is either one of the special (negative) values below, or a 7 bit fragment of the hash of the
+        /// key stored in the corresponding slot (which is how most mismatched slots are rejected without touching them)
+        using ctrl_t = std::int8_t;
+
+        /// @brief control byte of a slot which has never held a value (terminates a probe sequence)
+        inline constexpr ctrl_t s_ctrlEmpty{-128};
+
+        /// @brief control byte of a slot whose value was erased (does NOT terminate a probe sequence)
+        inline constexpr ctrl_t s_ctrlDeleted{-2};
+
+        /// @brief checks whether a control byte belongs to a slot which currently holds a value
+        /// @param ctrl the control byte to check
+        /// @return true if the slot holds a value, false if it is empty/deleted
+        inline constexpr bool is_full(const ctrl_t ctrl)
+        {
+            return ctrl >= 0;
+        }
+
+#ifdef bENGINE_FLAT_MAP_SSE2
+        /// @brief a group of 16 control bytes which are matched at once using SSE2
+        ///
+        /// every mask produced by a group has one bit per control byte (bit i corresponds to byte i)
+        struct FlatMapGroup
+        {
+            /// @brief the number of control bytes matched by one group
+            static constexpr std::size_t s_width{16};
+
+            /// @brief the number of bits to shift a trailing zero count by to get a byte index
+            static constexpr int s_shift{0};
+
+            /// @brief the 16 control bytes loaded from the control array
+            __m128i m_ctrl;
+
+            /// @brief loads (unaligned) a group of control bytes starting at the given position
+            /// @param ctrl the first control byte in the group
+            explicit FlatMapGroup(const ctrl_t *const ctrl)
+                : m_ctrl{_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))} { };
+
+            /// @brief finds the bytes which match the given hash fragment
+            /// @param h2 the 7 bit hash fragment to match
+            /// @return a mask of the matching bytes
+            std::uint64_t match(const ctrl_t h2) const
+            {
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+            }
+
+            /// @brief finds the empty bytes of the group
+            /// @return a mask of the empty bytes
+            std::uint64_t match_empty() const { return match(s_ctrlEmpty); }
+
+            /// @brief finds the bytes of the group which are either empty or deleted (i.e. not full)
+            /// @return a mask of the empty/deleted bytes
+            std::uint64_t match_empty_or_deleted() const
+            {
+                // only full control bytes are non-negative, so the sign bit is all we need
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(m_ctrl));
+            }
+
+            /// @brief finds the full bytes of the group
+            /// @return a mask of the full bytes
+            std::uint64_t match_full() const { return match_empty_or_deleted() ^ 0xFFFFu; }
+        };
+#else
+        /// @brief a group of 8 control bytes which are matched at once using plain 64 bit arithmetic
+        ///
+        /// every mask produced by a group has the most significant bit of byte i set when byte i matches; the masks
+        /// from match() may contain (rare) false positives which are rejected by the key comparison
+        struct FlatMapGroup
+        {
+            /// @brief the number of control bytes matched by one group
+            static constexpr std::size_t s_width{8};
+
+            /// @brief the number of bits to shift a trailing zero count by to get a byte index
+            static constexpr int s_shift{3};
+
+            /// @brief the least significant bit of every byte
+            static constexpr std::uint64_t s_lsbs{0x0101010101010101ull};
+
+            /// @brief the most significant bit of every byte
+            static constexpr std::uint64_t s_msbs{0x8080808080808080ull};
+
+            /// @brief the 8 control bytes loaded from the control array
+            std::uint64_t m_ctrl;
+
+            /// @brief loads (unaligned) a group of control bytes starting at the given position
+            /// @param ctrl the first control byte in the group
+            explicit FlatMapGroup(const ctrl_t *const ctrl) { std::memcpy(&m_ctrl, ctrl, sizeof(m_ctrl)); };
+
+            /// @brief finds the bytes which match the given hash fragment
+            /// @param h2 the 7 bit hash fragment to match
+            /// @return a mask of the matching bytes
+            std::uint64_t match(const ctrl_t h2) const
+            {
+                const std::uint64_t x{m_ctrl ^ (s_lsbs * static_cast<std::uint8_t>(h2))};
+                return (x - s_lsbs) & ~x & s_msbs;
+            }
+
+            /// @brief finds the empty bytes of the group
+            /// @return a mask of the empty bytes
+            std::uint64_t match_empty() const { return (m_ctrl & ~(m_ctrl << 6)) & s_msbs; }
+
+            /// @brief finds the bytes of the group which are either empty or deleted (i.e. not full)
+            /// @return a mask of the empty/deleted bytes
+            std::uint64_t match_empty_or_deleted() const { return m_ctrl & s_msbs; }
+
+            /// @brief finds the full bytes of the group
+            /// @return a mask of the full bytes
+            std::uint64_t match_full() const { return ~m_ctrl & s_msbs; }
+        };
+#endif
+
+        /// @brief gets the index (within a group) of the lowest set entry of a group mask
+        /// @param mask the (non-zero) mask produced by a FlatMapGroup
+        /// @return the index of the lowest matching control byte
+        inline std::size_t lowest_match(const std::uint64_t mask)
+        {
+            return static_cast<std::size_t>(std::countr_zero(mask)) >> FlatMapGroup::s_shift;
+        }
+
+        /// @brief mixes the bits of a (user) hash so the low bits used for probing and the high bits used as the
+        /// control byte fragment are both well distributed, even for identity hashes such as std::hash<int>
+        /// @param hash the hash to be mixed
+        /// @return the mixed hash
+        inline std::uint64_t mix_hash(const std::uint64_t hash)
+        {
+            const std::uint64_t mixed{hash * 0x9E3779B97F4A7C15ull};
+            return mixed ^ (mixed >> 32);
+        }
+    } // namespace Internal
+
+    /// @brief an open-addressing hash map which stores its values in one flat array, probing a group of control bytes
+    /// at a time (using SIMD where available) in the style of the "Swiss table"
+    ///
+    /// compared to std::unordered_map there is no per-entry node allocation and no pointer chasing; a lookup usually
+    /// touches a single group of control bytes and a single slot. The trade-off is that references/iterators are
+    /// invalidated by any insertion which causes a rehash (like std::vector), and erase() does not return an iterator.
+    ///
+    /// if both the Hash and the KeyEqual types are transparent (as the defaults are) then the lookup functions accept
+    /// any type which can be hashed/compared with the key type, e.g. a std::string_view for a std::string keyed map.
+    ///
+    /// all memory is requested through the (std-conforming) Allocator, so the map can be backed by an engine arena
+    /// @tparam Key the key type
+    /// @tparam Value the mapped type
+    /// @tparam Hash the hasher
+    /// @tparam KeyEqual the key comparison
+    /// @tparam Allocator the allocator used for the slot and control arrays (rebound as needed)
+    template <
+        typename Key,
+        typename Value,
+        typename Hash      = bEngineHash,
+        typename KeyEqual  = std::equal_to<>,
+        typename Allocator = std::allocator<std::pair<const Key, Value>>>
+    class bEngineFlatMap
+    {
+        // public types
+      public:
+        /// @brief the key type
+        using key_type = Key;
+
+        /// @brief the mapped type
+        using mapped_type = Value;
+
+        /// @brief the type of the values stored in the map
+        using value_type = std::pair<const Key, Value>;
+
+        /// @brief the type used for sizes/counts
+        using size_type = std::size_t;
+
+        /// @brief the hasher type
+        using hasher = Hash;
+
+        /// @brief the key comparison type
+        using key_equal = KeyEqual;
+
+        /// @brief the allocator type
+        using allocator_type = Allocator;
+
+        // private types/static data
+      private:
+        /// @brief storage for a single value; the mutable view is only used to move values on rehash so a
+        /// (potentially expensive) key is never copied just because it is const in value_type
+        union Slot
+        {
+            /// @brief ctor does nothing, lifetimes are managed by the map
+            Slot() { };
+
+            /// @brief dtor does nothing, lifetimes are managed by the map
+            ~Slot() { };
+
+            /// @brief the value as seen by the user
+            value_type m_value;
+
+            /// @brief the value as seen by the map when it is relocated
+            std::pair<Key, Value> m_mutableValue;
+        };
+
+        /// @brief the allocator traits of the user's allocator, used to rebind it to the internal arrays
+        using alloc_traits = std::allocator_traits<Allocator>;
+
+        /// @brief the allocator used for the slot array
+        using slot_allocator = typename alloc_traits::template rebind_alloc<Slot>;
+
+        /// @brief the allocator used for the control byte array
+        using ctrl_allocator = typename alloc_traits::template rebind_alloc<Internal::ctrl_t>;
+
+        /// @brief the traits of the slot allocator
+        using slot_traits = std::allocator_traits<slot_allocator>;
+
+        /// @brief the traits of the control byte allocator
+        using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+
+        /// @brief the number of control bytes matched at a time
+        static constexpr size_type s_groupWidth{Internal::FlatMapGroup::s_width};
+
+        /// @brief the smallest (non-zero) capacity; must be at least the group width so the cloned control bytes
+        /// never alias each other
+        static constexpr size_type s_minCapacity{16};
+
+        /// @brief true if heterogeneous lookups are allowed (both the hasher and key comparison are transparent)
+        static constexpr bool s_isTransparent{
+            requires { typename Hash::is_transparent; } && requires { typename KeyEqual::is_transparent; }};
+
+        /// @brief the maximum number of values which fit in a table of the given capacity (a 7/8 load factor)
+        /// @param capacity the capacity of the table
+        /// @return the number of values the table can hold before it must grow
+        static constexpr size_type max_load(const size_type capacity) { return capacity - capacity / 8; }
+
+        /// @brief a triangular probe sequence over the groups of a table, which visits every group exactly once when
+        /// the capacity is a power of two
+        struct ProbeSequence
+        {
+            /// @brief the capacity mask (capacity - 1)
+            size_type m_mask;
+
+            /// @brief the position of the first control byte of the current group
+            size_type m_offset;
+
+            /// @brief the distance (in control bytes) moved by the last step
+            size_type m_stride{0};
+
+            /// @brief moves to the next group in the sequence
+            void next()
+            {
+                m_stride += s_groupWidth;
+                m_offset = (m_offset + m_stride) & m_mask;
+            }
+        };
+
+        // public iterator
+      public:
+        /// @brief a forward iterator over the values of the map
+        /// @tparam IsConst true for a const_iterator, false for an iterator
+        template <bool IsConst>
+        class Iterator
+        {
+            friend class bEngineFlatMap;
+
+            // public types
+          public:
+            /// @brief the iterator category
+            using iterator_category = std::forward_iterator_tag;
+
+            /// @brief the value type
+            using value_type = typename bEngineFlatMap::value_type;
+
+            /// @brief the difference type
+            using difference_type = std::ptrdiff_t;
+
+            /// @brief the reference type
+            using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+
+            /// @brief the pointer type
+            using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+
+            // private data
+          private:
+            /// @brief the control byte of the current slot
+            const Internal::ctrl_t *m_ctrl{nullptr};
+
+            /// @brief the current slot
+            Slot *m_slot{nullptr};
+
+            /// @brief the control byte one past the last slot of the table
+            const Internal::ctrl_t *m_end{nullptr};
+
+            /// @brief ctor used by the map to position an iterator
+            /// @param ctrl the control byte of the slot to point to
+            /// @param slot the slot to point to
+            /// @param end the control byte one past the end of the table
+            Iterator(const Internal::ctrl_t *ctrl, Slot *slot, const Internal::ctrl_t *end)
+                : m_ctrl{ctrl},
+                  m_slot{slot},
+                  m_end{end} { };
+
+            /// @brief moves the iterator forward until it reaches a full slot or the end of the table, skipping a whole
+            /// group of control bytes at a time
+            void skip_to_full()
+            {
+                while (m_ctrl < m_end)
+                {
+                    const auto mask{Internal::FlatMapGroup{m_ctrl}.match_full()};
+                    const auto step{mask ? Internal::lowest_match(mask) : s_groupWidth};
+
+                    // the bytes read past the end of the table are clones of the first group, don't step onto them
+                    if (step >= static_cast<size_type>(m_end - m_ctrl))
+                    {
+                        m_slot += m_end - m_ctrl;
+                        m_ctrl = m_end;
+                        return;
+                    }
+
+                    m_ctrl += step;
+                    m_slot += step;
+                    if (mask)
+                        return;
+                }
+            }
+
+            // public ctors/operators
+          public:
+            /// @brief default ctor creates a singular iterator
+            Iterator() = default;
+
+            /// @brief allows an iterator to be converted into a const_iterator
+            /// @tparam OtherIsConst always false; a template so the implicit copy ctor is not suppressed
+            /// @param other the (mutable) iterator to convert
+            template <bool OtherIsConst>
+                requires(IsConst && !OtherIsConst)
+            Iterator(const Iterator<OtherIsConst> &other)
+                : m_ctrl{other.m_ctrl},
+                  m_slot{other.m_slot},
+                  m_end{other.m_end} { };
+
+            /// @brief dereferences the iterator
+            /// @return a reference to the current value
+            reference operator*() const { return m_slot->m_value; }
+
+            /// @brief accesses the current value
+            /// @return a pointer to the current value
+            pointer operator->() const { return &m_slot->m_value; }
+
+            /// @brief moves to the next value
+            /// @return this iterator
+            Iterator &operator++()
+            {
+                ++m_ctrl;
+                ++m_slot;
+                skip_to_full();
+                return *this;
+            }
+
+            /// @brief moves to the next value
+            /// @return a copy of the iterator before it moved
+            Iterator operator++(int)
+            {
+                auto copy{*this};
+                ++*this;
+                return copy;
+            }
+
+            /// @brief compares two iterators
+            /// @param other the iterator to compare against
+            /// @return true if both iterators point to the same slot
+            bool operator==(const Iterator &other) const { return m_ctrl == other.m_ctrl; }
+        };
+
+        /// @brief the (mutable) iterator type
+        using iterator = Iterator<false>;
+
+        /// @brief the const iterator type
+        using const_iterator = Iterator<true>;
+
+        // private data
+      private:
+        /// @brief the control bytes; capacity + group width bytes where the trailing bytes clone the first group so a
+        /// group can be loaded at any position without wrapping
+        Internal::ctrl_t *m_ctrl{nullptr};
+
+        /// @brief the slots which hold the values
+        Slot *m_slots{nullptr};
+
+        /// @brief the number of slots (always zero or a power of two no smaller than s_minCapacity)
+        size_type m_capacity{0};
+
+        /// @brief the number of values stored in the map
+        size_type m_size{0};
+
+        /// @brief the number of empty slots which may still be filled before the map must rehash (deleted slots are
+        /// not counted, they are only reclaimed by a rehash)
+        size_type m_growthLeft{0};
+
+        /// @brief the hasher
+        Hash m_hash;
+
+        /// @brief the key comparison
+        KeyEqual m_eq;
+
+        /// @brief the allocator used for the slot array
+        slot_allocator m_slotAlloc;
+
+        /// @brief the allocator used for the control byte array
+        ctrl_allocator m_ctrlAlloc;
+
+        // public ctors/dtor/assignment
+      public:
+        /// @brief default ctor creates an empty map which does not allocate until the first insertion
+        bEngineFlatMap() = default;
+
+        /// @brief ctor which creates an empty map with enough room for the given number of values
+        /// @param count the number of values to reserve room for
+        /// @param hash the hasher to use
+        /// @param eq the key comparison to use
+        /// @param alloc the allocator to use
+        explicit bEngineFlatMap(
+            const size_type  count,
+            const Hash      &hash  = Hash{},
+            const KeyEqual  &eq    = KeyEqual{},
+            const Allocator &alloc = Allocator{})
+            : m_hash{hash},
+              m_eq{eq},
+              m_slotAlloc{alloc},
+              m_ctrlAlloc{alloc}
+        {
+            reserve(count);
+        };
+
+        /// @brief ctor which creates an empty map using the given allocator (e.g. one backed by an engine arena)
+        /// @param alloc the allocator to use
+        explicit bEngineFlatMap(const Allocator &alloc)
+            : m_slotAlloc{alloc},
+              m_ctrlAlloc{alloc} { };
+
+        /// @brief ctor which creates a map from a list of values
+        /// @param values the values to insert (later duplicates of a key are ignored)
+        bEngineFlatMap(std::initializer_list<value_type> values)
+        {
+            reserve(values.size());
+            for (const auto &value : values)
+                insert(value);
+        };
+
+        /// @brief copy ctor copies every value into a table of the same capacity
+        /// @param other the map to copy
+        bEngineFlatMap(const bEngineFlatMap &other)
+            : m_hash{other.m_hash},
+              m_eq{other.m_eq},
+              m_slotAlloc{slot_traits::select_on_container_copy_construction(other.m_slotAlloc)},
+              m_ctrlAlloc{ctrl_traits::select_on_container_copy_construction(other.m_ctrlAlloc)}
+        {
+            reserve(other.m_size);
+            for (const auto &value : other)
+                insert_unique_unchecked(value);
+        };
+
+        /// @brief move ctor steals the other map's table, leaving it empty
+        /// @param other the map to move from
+        bEngineFlatMap(bEngineFlatMap &&other) noexcept
+            : m_ctrl{std::exchange(other.m_ctrl, nullptr)},
+              m_slots{std::exchange(other.m_slots, nullptr)},
+              m_capacity{std::exchange(other.m_capacity, 0)},
+              m_size{std::exchange(other.m_size, 0)},
+              m_growthLeft{std::exchange(other.m_growthLeft, 0)},
+              m_hash{std::move(other.m_hash)},
+              m_eq{std::move(other.m_eq)},
+              m_slotAlloc{std::move(other.m_slotAlloc)},
+              m_ctrlAlloc{std::move(other.m_ctrlAlloc)} { };
+
+        /// @brief copy assignment (copy and swap)
+        /// @param other the map to copy
+        /// @return this map
+        bEngineFlatMap &operator=(const bEngineFlatMap &other)
+        {
+            if (this != &other)
+            {
+                bEngineFlatMap copy{other};
+                swap(copy);
+            }
+            return *this;
+        }
+
+        /// @brief move assignment (move and swap)
+        /// @param other the map to move from
+        /// @return this map
+        bEngineFlatMap &operator=(bEngineFlatMap &&other) noexcept
+        {
+            if (this != &other)
+            {
+                bEngineFlatMap moved{std::move(other)};
+                swap(moved);
+            }
+            return *this;
+        }
+
+        /// @brief dtor destroys every value and frees the table
+        ~bEngineFlatMap()
+        {
+            destroy_values();
+            deallocate_table();
+        };
+
+        // public methods/functions
+      public:
+        /// @brief gets an iterator to the first value
+        /// @return an iterator to the first value, or end() if the map is empty
+        iterator begin()
+        {
+            iterator it{m_ctrl, m_slots, m_ctrl + m_capacity};
+            it.skip_to_full();
+            return it;
+        }
+
+        /// @brief gets an iterator one past the last value
+        /// @return an iterator one past the last value
+        iterator end() { return iterator{m_ctrl + m_capacity, m_slots + m_capacity, m_ctrl + m_capacity}; }
+
+        /// @brief gets a const iterator to the first value
+        /// @return a const iterator to the first value, or end() if the map is empty
+        const_iterator begin() const { return const_cast<bEngineFlatMap *>(this)->begin(); }
+
+        /// @brief gets a const iterator one past the last value
+        /// @return a const iterator one past the last value
+        const_iterator end() const { return const_cast<bEngineFlatMap *>(this)->end(); }
+
+        /// @brief gets a const iterator to the first value
+        /// @return a const iterator to the first value, or cend() if the map is empty
+        const_iterator cbegin() const { return begin(); }
+
+        /// @brief gets a const iterator one past the last value
+        /// @return a const iterator one past the last value
+        const_iterator cend() const { return end(); }
+
+        /// @brief checks whether the map is empty
+        /// @return true if the map holds no values
+        bool empty() const { return m_size == 0; }
+
+        /// @brief gets the number of values in the map
+        /// @return the number of values in the map
+        size_type size() const { return m_size; }
+
+        /// @brief gets the number of slots in the table
+        /// @return the number of slots in the table
+        size_type capacity() const { return m_capacity; }
+
+        /// @brief gets the current load factor
+        /// @return the ratio of values to slots
+        float load_factor() const { return m_capacity ? static_cast<float>(m_size) / m_capacity : 0.0f; }
+
+        /// @brief gets a copy of the hasher
+        /// @return a copy of the hasher
+        hasher hash_function() const { return m_hash; }
+
+        /// @brief gets a copy of the key comparison
+        /// @return a copy of the key comparison
+        key_equal key_eq() const { return m_eq; }
+
+        /// @brief gets a copy of the allocator
+        /// @return a copy of the allocator
+        allocator_type get_allocator() const { return allocator_type{m_slotAlloc}; }
+
+        /// @brief destroys every value but keeps the table so it can be refilled without reallocating
+        void clear()
+        {
+            destroy_values();
+            if (m_capacity)
+                std::memset(m_ctrl, static_cast<std::uint8_t>(Internal::s_ctrlEmpty), m_capacity + s_groupWidth);
+            m_size       = 0;
+            m_growthLeft = max_load(m_capacity);
+        }
+
+        /// @brief ensures the map can hold at least the given number of values without rehashing
+        /// @param count the number of values to make room for
+        void reserve(const size_type count)
+        {
+            if (count <= max_load(m_capacity))
+                return;
+
+            auto capacity{std::max(s_minCapacity, std::bit_ceil(count))};
+            while (max_load(capacity) < count)
+                capacity *= 2;
+            rehash_to(capacity);
+        }
+
+        /// @brief swaps the contents of two maps
+        /// @param other the map to swap with
+        void swap(bEngineFlatMap &other) noexcept
+        {
+            using std::swap;
+            swap(m_ctrl, other.m_ctrl);
+            swap(m_slots, other.m_slots);
+            swap(m_capacity, other.m_capacity);
+            swap(m_size, other.m_size);
+            swap(m_growthLeft, other.m_growthLeft);
+            swap(m_hash, other.m_hash);
+            swap(m_eq, other.m_eq);
+            swap(m_slotAlloc, other.m_slotAlloc);
+            swap(m_ctrlAlloc, other.m_ctrlAlloc);
+        }
+
+        /// @brief finds the value associated with a key
+        /// @param key the key to search for
+        /// @return an iterator to the value, or end() if the key is not in the map
+        iterator find(const key_type &key) { return iterator_at(find_index(key)); }
+
+        /// @brief finds the value associated with a key
+        /// @param key the key to search for
+        /// @return a const iterator to the value, or end() if the key is not in the map
+        const_iterator find(const key_type &key) const { return const_cast<bEngineFlatMap *>(this)->find(key); }
+
+        /// @brief finds the value associated with a key using a type which is not the key type (heterogeneous lookup)
+        /// @tparam K a type which the hasher/key comparison accept alongside the key type
+        /// @param key the key to search for
+        /// @return an iterator to the value, or end() if the key is not in the map
+        template <typename K>
+            requires s_isTransparent
+        iterator find(const K &key)
+        {
+            return iterator_at(find_index(key));
+        }
+
+        /// @brief finds the value associated with a key using a type which is not the key type (heterogeneous lookup)
+        /// @tparam K a type which the hasher/key comparison accept alongside the key type
+        /// @param key the key to search for
+        /// @return a const iterator to the value, or end() if the key is not in the map
+        template <typename K>
+            requires s_isTransparent
+        const_iterator find(const K &key) const
+        {
+            return const_cast<bEngineFlatMap *>(this)->find(key);
+        }
+
+        /// @brief checks whether a key is in the map
+        /// @param key the key to search for
+        /// @return true if the key is in the map
+        bool contains(const key_type &key) const { return find_index(key) != m_capacity; }
+
+        /// @brief checks whether a key is in the map using a type which is not the key type (heterogeneous lookup)
+        /// @tparam K a type which the hasher/key comparison accept alongside the key type
+        /// @param key the key to search for
+        /// @return true if the key is in the map
+        template <typename K>
+            requires s_isTransparent
+        bool contains(const K &key) const
+        {
+            return find_index(key) != m_capacity;
+        }
+
+        /// @brief counts the values associated with a key
+        /// @param key the key to search for
+        /// @return 1 if the key is in the map, 0 if not
+        size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+        /// @brief gets the value associated with a key, which must be in the map
+        /// @param key the key to search for
+        /// @return a reference to the value associated with the key
+        /// @throws std::out_of_range if the key is not in the map
+        mapped_type &at(const key_type &key)
+        {
+            const auto index{find_index(key)};
+            if (index == m_capacity)
+                throw std::out_of_range{"bEngineFlatMap::at() - key not found"};
+            return m_slots[index].m_value.second;
+        }
+
+        /// @brief gets the value associated with a key, which must be in the map
+        /// @param key the key to search for
+        /// @return a const reference to the value associated with the key
+        /// @throws std::out_of_range if the key is not in the map
+        const mapped_type &at(const key_type &key) const { return const_cast<bEngineFlatMap *>(this)->at(key); }
+
+        /// @brief gets the value associated with a key, default constructing it if the key is not in the map
+        /// @param key the key to search for
+        /// @return a reference to the value associated with the key
+        mapped_type &operator[](const key_type &key) { return try_emplace(key).first->second; }
+
+        /// @brief gets the value associated with a key, default constructing it if the key is not in the map
+        /// @param key the key to search for (moved from only if it is inserted)
+        /// @return a reference to the value associated with the key
+        mapped_type &operator[](key_type &&key) { return try_emplace(std::move(key)).first->second; }
+
+        /// @brief inserts a value if its key is not already in the map
+        /// @param value the value to insert
+        /// @return an iterator to the value with the same key and true if the value was inserted
+        std::pair<iterator, bool> insert(const value_type &value) { return try_emplace(value.first, value.second); }
+
+        /// @brief inserts a value if its key is not already in the map
+        /// @param value the value to insert
+        /// @return an iterator to the value with the same key and true if the value was inserted
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return try_emplace(value.first, std::move(value.second));
+        }
+
+        /// @brief constructs a value in place if its key is not already in the map
+        /// @tparam K the type of the key argument
+        /// @tparam Args the types of the mapped value ctor arguments
+        /// @param key the key of the value
+        /// @param args the arguments for the mapped value's ctor
+        /// @return an iterator to the value with the same key and true if the value was inserted
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> emplace(K &&key, Args &&...args)
+        {
+            return try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+        }
+
+        /// @brief constructs a value in place if its key is not already in the map; nothing is constructed (or moved
+        /// from) if the key is already present
+        /// @tparam K the type of the key argument (which must be the key type unless the map is transparent)
+        /// @tparam Args the types of the mapped value ctor arguments
+        /// @param key the key of the value
+        /// @param args the arguments for the mapped value's ctor
+        /// @return an iterator to the value with the same key and true if the value was inserted
+        template <typename K = key_type, typename... Args>
+            requires(s_isTransparent || std::is_same_v<std::remove_cvref_t<K>, key_type>)
+        std::pair<iterator, bool> try_emplace(K &&key, Args &&...args)
+        {
+            const auto hash{hash_of(key)};
+            const auto found{find_index(key, hash)};
+            if (found != m_capacity)
+                return {iterator_at(found), false};
+
+            const auto index{prepare_insert(hash)};
+            slot_traits::construct(
+                m_slotAlloc,
+                &m_slots[index].m_value,
+                std::piecewise_construct,
+                std::forward_as_tuple(std::forward<K>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+            return {iterator_at(index), true};
+        }
+
+        /// @brief inserts a value, or assigns to the existing value if its key is already in the map
+        /// @tparam K the type of the key argument
+        /// @tparam V the type of the mapped value argument
+        /// @param key the key of the value
+        /// @param value the mapped value
+        /// @return an iterator to the value and true if the value was inserted (false if it was assigned)
+        template <typename K, typename V>
+        std::pair<iterator, bool> insert_or_assign(K &&key, V &&value)
+        {
+            auto result{try_emplace(std::forward<K>(key), std::forward<V>(value))};
+            if (!result.second)
+                result.first->second = std::forward<V>(value);
+            return result;
+        }
+
+        /// @brief erases the value associated with a key
+        /// @param key the key of the value to erase
+        /// @return the number of values erased (0 or 1)
+        size_type erase(const key_type &key) { return erase_index(find_index(key)); }
+
+        /// @brief erases the value associated with a key using a type which is not the key type (heterogeneous
+        /// lookup)
+        /// @tparam K a type which the hasher/key comparison accept alongside the key type
+        /// @param key the key of the value to erase
+        /// @return the number of values erased (0 or 1)
+        template <typename K>
+            requires(s_isTransparent && !std::is_convertible_v<const K &, const_iterator>)
+        size_type erase(const K &key)
+        {
+            return erase_index(find_index(key));
+        }
+
+        /// @brief erases the value an iterator points to; other iterators remain valid
+        /// @param position an iterator to the value to erase
+        void erase(const const_iterator position) { erase_index(static_cast<size_type>(position.m_slot - m_slots)); }
+
+        // private methods/functions
+      private:
+        /// @brief hashes (and mixes) a key
+        /// @tparam K the type of the key
+        /// @param key the key to hash
+        /// @return the mixed hash of the key
+        template <typename K>
+        std::uint64_t hash_of(const K &key) const
+        {
+            return Internal::mix_hash(static_cast<std::uint64_t>(m_hash(key)));
+        }
+
+        /// @brief gets the 7 bit fragment of a hash which is stored in the control byte
+        /// @param hash the mixed hash
+        /// @return the control byte fragment
+        static Internal::ctrl_t h2_of(const std::uint64_t hash) { return static_cast<Internal::ctrl_t>(hash & 0x7F); }
+
+        /// @brief gets the part of a hash which is used to choose the first probe position
+        /// @param hash the mixed hash
+        /// @return the probe position fragment
+        static size_type h1_of(const std::uint64_t hash) { return static_cast<size_type>(hash >> 7); }
+
+        /// @brief creates an iterator to a slot
+        /// @param index the index of the slot (or the capacity for end())
+        /// @return an iterator to the slot
+        iterator iterator_at(const size_type index)
+        {
+            return iterator{m_ctrl + index, m_slots + index, m_ctrl + m_capacity};
+        }
+
+        /// @brief finds the slot holding a key
+        /// @tparam K the type of the key
+        /// @param key the key to find
+        /// @return the index of the slot holding the key, or the capacity if the key is not in the map
+        template <typename K>
+        size_type find_index(const K &key) const
+        {
+            return m_size ? find_index(key, hash_of(key)) : m_capacity;
+        }
+
+        /// @brief finds the slot holding a key whose hash is already known
+        /// @tparam K the type of the key
+        /// @param key the key to find
+        /// @param hash the mixed hash of the key
+        /// @return the index of the slot holding the key, or the capacity if the key is not in the map
+        template <typename K>
+        size_type find_index(const K &key, const std::uint64_t hash) const
+        {
+            if (!m_capacity)
+                return m_capacity;
+
+            const auto    h2{h2_of(hash)};
+            ProbeSequence probe{m_capacity - 1, h1_of(hash) & (m_capacity - 1)};
+            while (true)
+            {
+                const Internal::FlatMapGroup group{m_ctrl + probe.m_offset};
+                for (auto mask{group.match(h2)}; mask; mask &= mask - 1)
+                {
+                    const auto index{(probe.m_offset + Internal::lowest_match(mask)) & probe.m_mask};
+                    if (m_eq(m_slots[index].m_value.first, key))
+                        return index;
+                }
+
+                // an empty control byte means the key would have been placed here if it were in the map
+                if (group.match_empty())
+                    return m_capacity;
+
+                probe.next();
+            }
+        }
+
+        /// @brief finds the first empty/deleted slot along the probe sequence of a hash
+        /// @param hash the mixed hash
+        /// @return the index of the first slot which can hold a value with the given hash
+        size_type find_first_non_full(const std::uint64_t hash) const
+        {
+            ProbeSequence probe{m_capacity - 1, h1_of(hash) & (m_capacity - 1)};
+            while (true)
+            {
+                const auto mask{Internal::FlatMapGroup{m_ctrl + probe.m_offset}.match_empty_or_deleted()};
+                if (mask)
+                    return (probe.m_offset + Internal::lowest_match(mask)) & probe.m_mask;
+                probe.next();
+            }
+        }
+
+        /// @brief sets a control byte and its clone (if it has one)
+        /// @param index the index of the slot
+        /// @param ctrl the new control byte
+        void set_ctrl(const size_type index, const Internal::ctrl_t ctrl)
+        {
+            m_ctrl[index] = ctrl;
+            if (index < s_groupWidth)
+                m_ctrl[m_capacity + index] = ctrl;
+        }
+
+        /// @brief finds the slot a new value with the given hash will be placed in, growing the table if needed, and
+        /// marks it as full
+        /// @param hash the mixed hash of the new value's key
+        /// @return the index of the slot the new value must be constructed in
+        size_type prepare_insert(const std::uint64_t hash)
+        {
+            auto index{m_capacity ? find_first_non_full(hash) : 0};
+
+            // reusing a deleted slot is free, but filling an empty slot uses up the remaining growth
+            if (!m_capacity || (m_growthLeft == 0 && m_ctrl[index] == Internal::s_ctrlEmpty))
+            {
+                grow();
+                index = find_first_non_full(hash);
+            }
+
+            if (m_ctrl[index] == Internal::s_ctrlEmpty)
+                --m_growthLeft;
+            set_ctrl(index, h2_of(hash));
+            ++m_size;
+            return index;
+        }
+
+        /// @brief inserts a copy of a value which is known not to be in the map (and which is known to fit)
+        /// @param value the value to insert
+        void insert_unique_unchecked(const value_type &value)
+        {
+            const auto index{prepare_insert(hash_of(value.first))};
+            slot_traits::construct(m_slotAlloc, &m_slots[index].m_value, value);
+        }
+
+        /// @brief makes room for more values; if most of the used slots are actually deleted the table is rehashed in
+        /// place (which reclaims them) instead of doubling in size
+        void grow()
+        {
+            if (m_capacity && m_size <= max_load(m_capacity) / 2)
+                rehash_to(m_capacity);
+            else
+                rehash_to(m_capacity ? m_capacity * 2 : s_minCapacity);
+        }
+
+        /// @brief moves every value into a new table of the given capacity
+        /// @param capacity the capacity of the new table (a power of two, no smaller than s_minCapacity)
+        void rehash_to(const size_type capacity)
+        {
+            auto *const oldCtrl{m_ctrl};
+            auto *const oldSlots{m_slots};
+            const auto  oldCapacity{m_capacity};
+
+            m_ctrl     = ctrl_traits::allocate(m_ctrlAlloc, capacity + s_groupWidth);
+            m_slots    = slot_traits::allocate(m_slotAlloc, capacity);
+            m_capacity = capacity;
+            std::memset(m_ctrl, static_cast<std::uint8_t>(Internal::s_ctrlEmpty), capacity + s_groupWidth);
+
+            for (size_type i{0}; i < oldCapacity; ++i)
+            {
+                if (!Internal::is_full(oldCtrl[i]))
+                    continue;
+
+                auto     &oldValue{oldSlots[i].m_mutableValue};
+                const auto hash{hash_of(oldValue.first)};
+                const auto index{find_first_non_full(hash)};
+                set_ctrl(index, h2_of(hash));
+                slot_traits::construct(m_slotAlloc, &m_slots[index].m_mutableValue, std::move(oldValue));
+                slot_traits::destroy(m_slotAlloc, &oldValue);
+            }
+
+            m_growthLeft = max_load(capacity) - m_size;
+
+            if (oldCapacity)
+            {
+                ctrl_traits::deallocate(m_ctrlAlloc, oldCtrl, oldCapacity + s_groupWidth);
+                slot_traits::deallocate(m_slotAlloc, oldSlots, oldCapacity);
+            }
+        }
+
+        /// @brief erases the value in a slot
+        /// @param index the index of the slot, or the capacity (in which case nothing happens)
+        /// @return the number of values erased (0 or 1)
+        size_type erase_index(const size_type index)
+        {
+            if (index == m_capacity)
+                return 0;
+
+            slot_traits::destroy(m_slotAlloc, &m_slots[index].m_value);
+            set_ctrl(index, Internal::s_ctrlDeleted);
+            --m_size;
+            return 1;
+        }
+
+        /// @brief destroys every value in the table (without touching the control bytes)
+        void destroy_values()
+        {
+            if constexpr (!std::is_trivially_destructible_v<value_type>)
+            {
+                for (size_type i{0}; i < m_capacity; ++i)
+                {
+                    if (Internal::is_full(m_ctrl[i]))
+                        slot_traits::destroy(m_slotAlloc, &m_slots[i].m_value);
+                }
+            }
+        }
+
+        /// @brief frees the table's arrays
+        void deallocate_table()
+        {
+            if (!m_capacity)
+                return;
+
+            ctrl_traits::deallocate(m_ctrlAlloc, m_ctrl, m_capacity + s_groupWidth);
+            slot_traits::deallocate(m_slotAlloc, m_slots, m_capacity);
+            m_ctrl     = nullptr;
+            m_slots    = nullptr;
+            m_capacity = 0;
+        }
+    };
+} // namespace bEngine
\ No newline at end of file
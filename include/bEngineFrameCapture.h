@@ -0,0 +1,68 @@
+#pragma once
+
+/// @file bEngineFrameCapture.h
+/// @brief the settings and statistics of frame capture in the bEngine library (see bEngineWindow::start_capture())
+///
+/// captured frames are read back asynchronously: each capture copies the window's frame into one of a ring of pixel
+/// pack buffers and places a fence after the copy, and only once the fence has signaled (a frame or two later) is the
+/// buffer handed to a worker thread, which converts and encodes it straight out of the buffer's persistent mapping.
+/// The render thread never waits on the GPU or on encoding; if every buffer is still in flight when a capture is due
+/// the frame is dropped (and counted) instead.
+
+#include <filesystem> // for where captures are written
+
+namespace bEngine
+{
+    /// @brief how captured frames are written
+    enum class bEngineCaptureFormat : unsigned char
+    {
+        /// @brief numbered QOI images (fast to encode, losslessly compressed)
+        QOI,
+
+        /// @brief numbered PNG images (widely supported, but written uncompressed)
+        PNG,
+
+        /// @brief a single raw video stream of RGB24 frames (e.g. for ffmpeg's -f rawvideo -pix_fmt rgb24)
+        RawVideo
+    };
+
+    /// @brief the settings of a capture
+    struct bEngineCaptureSettings
+    {
+        /// @brief the directory numbered images are written to (created if need be), or the file a raw video stream is
+        /// written to
+        std::filesystem::path m_path{};
+
+        /// @brief how captured frames are written
+        bEngineCaptureFormat m_format{bEngineCaptureFormat::QOI};
+
+        /// @brief the minimum time between captures, in seconds, or 0 to capture every frame
+        double m_interval{0.0};
+
+        /// @brief the number of pixel pack buffers in the ring (i.e. the number of captures in flight), at least 2
+        unsigned int m_bufferCount{4};
+
+        /// @brief the number of worker threads converting and encoding captured frames, at least 1
+        unsigned int m_workerCount{2};
+    };
+
+    /// @brief the statistics of a capture
+    struct bEngineCaptureStats
+    {
+        /// @brief the number of frames read back
+        unsigned long long m_capturedFrames{0};
+
+        /// @brief the number of frames encoded and written
+        unsigned long long m_writtenFrames{0};
+
+        /// @brief the number of frames which were due but dropped because every buffer was still in flight (or because
+        /// the window's size no longer matched the capture's)
+        unsigned long long m_droppedFrames{0};
+
+        /// @brief the number of frames which failed to be written
+        unsigned long long m_failedFrames{0};
+
+        /// @brief the total time the worker threads spent converting, encoding and writing frames, in seconds
+        double m_encodeSeconds{0.0};
+    };
+} // namespace bEngine
\ No newline at end of file
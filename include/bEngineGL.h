@@ -0,0 +1,606 @@
+#pragma once
+
+/// @file bEngineGL.h
+/// @brief move-only RAII wrappers for the GL objects used by the bEngine library
+///
+/// the wrappers are implemented purely with GL 4.6 direct state access (glCreate*/glNamed*/glTexture*/etc.), so an
+/// object never has to be bound just to be edited; objects are only bound when they're actually used, and binding goes
+/// through the context's state cache (see bEngineGLState.h) so it's applied lazily at the next draw. Parameters which
+/// take GL enums (formats, targets, flags, etc.) take the values of the enums as defined in glad's gl.h.
+///
+/// objects must be created on a thread with a current GL context (i.e. while a window is rendering) and are owned by
+/// that context. Destroying a wrapper never deletes the object immediately: the object is queued and deleted by the
+/// owning context a couple of frames later, once the GPU can no longer be using it. As such a wrapper may be destroyed
+/// on any thread, and may outlive the window whose context created it: its object is released along with its owner
+/// (see bEngineGLObject), leaving the wrapper empty.
+
+#include <cstddef>          // for ptrdiff_t (the size of GLsizeiptr/GLintptr)
+#include <initializer_list> // for the shader stages of a program
+#include <memory>           // for sharing a program's build with whoever is building it
+#include <string>           // for program info logs
+#include <string_view>      // for object labels, shader sources and uniform names
+
+namespace bEngine
+{
+    namespace GL
+    {
+        // fwd declarations of the (private) per-context/group state, the kinds of objects it manages and program builds
+        struct Context;
+        struct ContextGroup;
+        enum class ObjectType : unsigned char;
+        struct ProgramBuild;
+    } // namespace GL
+
+    /// @brief the base of every GL object wrapper; owns the object's name and returns it to the owning context's
+    /// deletion queue when destroyed
+    ///
+    /// shared objects (buffers, textures, samplers and programs) are owned by the context group they were created in
+    /// and may be used on any of its contexts (i.e. in any window); they're released (leaving their wrappers empty) if
+    /// the group's last context is destroyed first (i.e. every window closes). Local objects (framebuffers and vertex
+    /// arrays) are owned by the context which created them and may only be used on it; they're released (leaving their
+    /// wrappers empty) if that context is destroyed first.
+    class bEngineGLObject
+    {
+        // private data
+      private:
+        /// @brief the context group the object was created in, or nullptr if the wrapper is empty
+        GL::ContextGroup *m_group{nullptr};
+
+        /// @brief the context which created (and so owns) a local object, or nullptr if the object is shared or the
+        /// wrapper is empty
+        GL::Context *m_context{nullptr};
+
+        /// @brief the GL name of the object, or 0 if the wrapper is empty
+        unsigned int m_name{0};
+
+        /// @brief the kind of object, so it can be deleted correctly
+        GL::ObjectType m_type{};
+
+        // protected ctors
+      protected:
+        /// @brief default ctor creates an empty wrapper
+        bEngineGLObject() = default;
+
+        /// @brief ctor which takes ownership of an object created on the current context
+        /// @param type the kind of object
+        /// @param name the GL name of the object
+        bEngineGLObject(const GL::ObjectType type, const unsigned int name);
+
+        // protected methods/functions
+      protected:
+        /// @brief gets the context to use the object through, for use by the derived wrappers' implementations: the
+        /// current context for a shared object (which must belong to the object's group), or the owning context for a
+        /// local object
+        /// @return a pointer to the context to use the object through, or nullptr if the wrapper is empty
+        GL::Context *const get_context() const;
+
+        /// @brief gets the context group the object was created in, for use by the derived wrappers' implementations
+        /// @return a pointer to the object's group, or nullptr if the wrapper is empty
+        GL::ContextGroup *const get_group() const;
+
+        // public ctors/dtor/assignment
+      public:
+        /// @brief GL objects are uniquely owned, so wrappers are not copyable
+        bEngineGLObject(const bEngineGLObject &) = delete;
+
+        /// @brief GL objects are uniquely owned, so wrappers are not copyable
+        bEngineGLObject &operator=(const bEngineGLObject &) = delete;
+
+        /// @brief move ctor takes ownership of another wrapper's object, leaving the other wrapper empty
+        /// @param other the wrapper to take the object from
+        bEngineGLObject(bEngineGLObject &&other) noexcept;
+
+        /// @brief move assignment releases this wrapper's object then takes ownership of another wrapper's object
+        /// @param other the wrapper to take the object from
+        /// @return a reference to this wrapper
+        bEngineGLObject &operator=(bEngineGLObject &&other) noexcept;
+
+        /// @brief dtor releases the object, queueing it for deletion at the next frame-safe point
+        ~bEngineGLObject();
+
+        // public methods/functions
+      public:
+        /// @brief gets the GL name of the object, for interop with raw GL calls
+        /// @return the GL name of the object, or 0 if the wrapper is empty
+        const unsigned int get_name() const;
+
+        /// @brief checks whether the wrapper owns an object
+        /// @return true if the wrapper owns an object, false if it is empty (default constructed or moved from)
+        const bool get_is_valid() const;
+
+        /// @brief labels the object so it's identifiable in debug output and graphics debuggers
+        /// @param label the label for the object
+        void set_label(const std::string_view label) const;
+
+        /// @brief releases the object (queueing it for deletion), leaving the wrapper empty
+        void reset();
+    };
+
+    /// @brief a buffer object with immutable storage (glNamedBufferStorage)
+    class bEngineGLBuffer : public bEngineGLObject
+    {
+        // private data
+      private:
+        /// @brief the size of the buffer's storage, in bytes
+        std::ptrdiff_t m_size{0};
+
+        // public ctors
+      public:
+        /// @brief default ctor creates an empty wrapper
+        bEngineGLBuffer() = default;
+
+        /// @brief ctor which creates a buffer and its (immutable) storage
+        /// @param size the size of the buffer, in bytes
+        /// @param data the initial contents of the buffer, or nullptr to leave it uninitialized
+        /// @param storageFlags the GL_*_BIT storage flags of the buffer (e.g. GL_DYNAMIC_STORAGE_BIT to allow
+        /// upload(), GL_MAP_WRITE_BIT to allow map_range(), etc.)
+        bEngineGLBuffer(
+            const std::ptrdiff_t size,
+            const void *const    data         = nullptr,
+            const unsigned int   storageFlags = 0);
+
+        // public methods/functions
+      public:
+        /// @brief gets the size of the buffer's storage
+        /// @return the size of the buffer's storage, in bytes
+        const std::ptrdiff_t get_size() const;
+
+        /// @brief updates part of the buffer (glNamedBufferSubData); requires GL_DYNAMIC_STORAGE_BIT
+        /// @param offset the offset into the buffer to write to, in bytes
+        /// @param size the number of bytes to write
+        /// @param data the data to write
+        void upload(const std::ptrdiff_t offset, const std::ptrdiff_t size, const void *const data) const;
+
+        /// @brief copies part of this buffer into another buffer on the GPU (glCopyNamedBufferSubData)
+        /// @param destination the buffer to copy into
+        /// @param readOffset the offset into this buffer to copy from, in bytes
+        /// @param writeOffset the offset into the destination buffer to copy to, in bytes
+        /// @param size the number of bytes to copy
+        void copy_to(
+            const bEngineGLBuffer &destination,
+            const std::ptrdiff_t   readOffset,
+            const std::ptrdiff_t   writeOffset,
+            const std::ptrdiff_t   size) const;
+
+        /// @brief maps part of the buffer into client memory (glMapNamedBufferRange)
+        /// @param offset the offset of the range to map, in bytes
+        /// @param length the length of the range to map, in bytes
+        /// @param access the GL_MAP_*_BIT access flags for the mapping
+        /// @return a pointer to the mapped range, or nullptr if mapping failed
+        void *const map_range(
+            const std::ptrdiff_t offset,
+            const std::ptrdiff_t length,
+            const unsigned int   access) const;
+
+        /// @brief unmaps the buffer (glUnmapNamedBuffer)
+        /// @return true if the buffer's contents are intact, false if they were corrupted while mapped
+        const bool unmap() const;
+
+        /// @brief binds the buffer (or part of it) to an indexed binding point, e.g. a uniform/shader storage block
+        /// @param target the indexed target (e.g. GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER)
+        /// @param index the binding point index
+        /// @param offset the offset of the bound range, in bytes
+        /// @param size the size of the bound range, in bytes, or 0 to bind the whole buffer
+        void bind_base(
+            const unsigned int   target,
+            const unsigned int   index,
+            const std::ptrdiff_t offset = 0,
+            const std::ptrdiff_t size   = 0) const;
+    };
+
+    /// @brief a texture with immutable storage (glTextureStorage*)
+    class bEngineGLTexture : public bEngineGLObject
+    {
+        // private data
+      private:
+        /// @brief the texture's target (e.g. GL_TEXTURE_2D)
+        unsigned int m_target{0};
+
+        /// @brief the texture's internal format (e.g. GL_RGBA8)
+        unsigned int m_internalFormat{0};
+
+        /// @brief the number of mip levels the texture has
+        int m_levels{0};
+
+        /// @brief the size of the texture's base level, in texels (or layers)
+        ///
+        /// [0] - width
+        /// [1] - height (or the number of layers of a 1D array)
+        /// [2] - depth (or the number of layers of a 2D array)
+        int m_size[3]{0, 0, 0};
+
+        // public ctors
+      public:
+        /// @brief default ctor creates an empty wrapper
+        bEngineGLTexture() = default;
+
+        /// @brief ctor which creates a texture and its (immutable) storage; the dimensionality of the storage is
+        /// determined by the target
+        /// @param target the texture's target (GL_TEXTURE_1D/2D/3D/1D_ARRAY/2D_ARRAY/CUBE_MAP/CUBE_MAP_ARRAY)
+        /// @param levels the number of mip levels
+        /// @param internalFormat the sized internal format (e.g. GL_RGBA8)
+        /// @param width the width of the base level, in texels
+        /// @param height the height of the base level, in texels (or the number of layers of a 1D array)
+        /// @param depth the depth of the base level, in texels (or the number of layers of a 2D/cube map array)
+        bEngineGLTexture(
+            const unsigned int target,
+            const int          levels,
+            const unsigned int internalFormat,
+            const int          width,
+            const int          height = 1,
+            const int          depth  = 1);
+
+        // public methods/functions
+      public:
+        /// @brief gets the texture's target
+        /// @return the texture's target (e.g. GL_TEXTURE_2D)
+        const unsigned int get_target() const;
+
+        /// @brief gets the texture's internal format
+        /// @return the texture's internal format (e.g. GL_RGBA8)
+        const unsigned int get_internal_format() const;
+
+        /// @brief gets the number of mip levels the texture has
+        /// @return the number of mip levels the texture has
+        const int get_levels() const;
+
+        /// @brief gets the width of the texture's base level
+        /// @return the width of the texture's base level, in texels
+        const int get_width() const;
+
+        /// @brief gets the height of the texture's base level
+        /// @return the height of the texture's base level, in texels (or layers)
+        const int get_height() const;
+
+        /// @brief gets the depth of the texture's base level
+        /// @return the depth of the texture's base level, in texels (or layers)
+        const int get_depth() const;
+
+        /// @brief uploads texels into a region of one of the texture's levels (glTextureSubImage*)
+        /// @param level the mip level to upload to
+        /// @param x the x offset of the region
+        /// @param y the y offset of the region (ignored for 1D textures)
+        /// @param z the z offset (or first layer/face) of the region (ignored for 1D/2D textures)
+        /// @param width the width of the region
+        /// @param height the height of the region (ignored for 1D textures)
+        /// @param depth the depth (or number of layers/faces) of the region (ignored for 1D/2D textures)
+        /// @param format the format of the texels (e.g. GL_RGBA)
+        /// @param type the type of the texels (e.g. GL_UNSIGNED_BYTE)
+        /// @param texels the texels to upload (or an offset into the bound GL_PIXEL_UNPACK_BUFFER)
+        void upload(
+            const int          level,
+            const int          x,
+            const int          y,
+            const int          z,
+            const int          width,
+            const int          height,
+            const int          depth,
+            const unsigned int format,
+            const unsigned int type,
+            const void *const  texels) const;
+
+        /// @brief generates the texture's mip levels from its base level (glGenerateTextureMipmap)
+        void generate_mipmaps() const;
+
+        /// @brief sets an integer parameter of the texture (glTextureParameteri)
+        /// @param parameter the parameter to set (e.g. GL_TEXTURE_MIN_FILTER)
+        /// @param value the value of the parameter
+        void set_parameter(const unsigned int parameter, const int value) const;
+
+        /// @brief sets a float parameter of the texture (glTextureParameterf)
+        /// @param parameter the parameter to set (e.g. GL_TEXTURE_MAX_ANISOTROPY)
+        /// @param value the value of the parameter
+        void set_parameter(const unsigned int parameter, const float value) const;
+
+        /// @brief binds the texture to a texture unit (applied at the next draw)
+        /// @param unit the texture unit to bind to
+        void bind_to_unit(const unsigned int unit) const;
+    };
+
+    /// @brief a sampler object, which holds sampling state independently of any texture
+    class bEngineGLSampler : public bEngineGLObject
+    {
+        // public ctors
+      public:
+        /// @brief default ctor creates an empty wrapper
+        bEngineGLSampler() = default;
+
+        /// @brief ctor which creates a sampler with the given filters and wrap mode
+        /// @param minFilter the minification filter (e.g. GL_LINEAR_MIPMAP_LINEAR)
+        /// @param magFilter the magnification filter (e.g. GL_LINEAR)
+        /// @param wrapMode the wrap mode for every coordinate (e.g. GL_REPEAT)
+        bEngineGLSampler(const unsigned int minFilter, const unsigned int magFilter, const unsigned int wrapMode);
+
+        // public methods/functions
+      public:
+        /// @brief sets an integer parameter of the sampler (glSamplerParameteri)
+        /// @param parameter the parameter to set (e.g. GL_TEXTURE_COMPARE_MODE)
+        /// @param value the value of the parameter
+        void set_parameter(const unsigned int parameter, const int value) const;
+
+        /// @brief sets a float parameter of the sampler (glSamplerParameterf)
+        /// @param parameter the parameter to set (e.g. GL_TEXTURE_MAX_ANISOTROPY)
+        /// @param value the value of the parameter
+        void set_parameter(const unsigned int parameter, const float value) const;
+
+        /// @brief binds the sampler to a texture unit (applied at the next draw)
+        /// @param unit the texture unit to bind to
+        void bind_to_unit(const unsigned int unit) const;
+    };
+
+    /// @brief a framebuffer object
+    ///
+    /// framebuffers are NOT shared between contexts, so a framebuffer may only be used on the context which created it
+    class bEngineGLFramebuffer : public bEngineGLObject
+    {
+        // private ctors
+      private:
+        /// @brief ctor which takes ownership of a framebuffer created by create_framebuffer()
+        /// @param name the GL name of the framebuffer
+        explicit bEngineGLFramebuffer(const unsigned int name);
+
+        // public static methods
+      public:
+        /// @brief framebuffer creation "factory" function, since creating a framebuffer takes no arguments
+        /// @return a new (incomplete) framebuffer with no attachments
+        static bEngineGLFramebuffer create_framebuffer();
+
+        // public ctors
+      public:
+        /// @brief default ctor creates an empty wrapper
+        bEngineGLFramebuffer() = default;
+
+        // public methods/functions
+      public:
+        /// @brief attaches a level of a texture to the framebuffer (glNamedFramebufferTexture)
+        /// @param attachment the attachment point (e.g. GL_COLOR_ATTACHMENT0 or GL_DEPTH_ATTACHMENT)
+        /// @param texture the texture to attach
+        /// @param level the mip level of the texture to attach
+        void attach_texture(const unsigned int attachment, const bEngineGLTexture &texture, const int level = 0) const;
+
+        /// @brief attaches a single layer of a layered texture to the framebuffer (glNamedFramebufferTextureLayer)
+        /// @param attachment the attachment point (e.g. GL_COLOR_ATTACHMENT0 or GL_DEPTH_ATTACHMENT)
+        /// @param texture the (layered) texture to attach
+        /// @param level the mip level of the texture to attach
+        /// @param layer the layer of the texture to attach
+        void attach_texture_layer(
+            const unsigned int      attachment,
+            const bEngineGLTexture &texture,
+            const int               level,
+            const int               layer) const;
+
+        /// @brief sets which color attachments fragment shader outputs are written to (glNamedFramebufferDrawBuffers)
+        /// @param drawBuffers the color attachments, in the order of the fragment shader outputs
+        void set_draw_buffers(std::initializer_list<unsigned int> drawBuffers) const;
+
+        /// @brief checks whether the framebuffer can be rendered to
+        /// @return true if the framebuffer is complete, false if not
+        const bool get_is_complete() const;
+
+        /// @brief clears a color attachment (glClearNamedFramebufferfv)
+        /// @param drawBuffer the index of the draw buffer to clear
+        /// @param color the color to clear to (RGBA)
+        void clear_color(const int drawBuffer, const float color[4]) const;
+
+        /// @brief clears the depth attachment (glClearNamedFramebufferfv)
+        /// @param depth the depth to clear to
+        void clear_depth(const float depth = 1.0f) const;
+
+        /// @brief binds the framebuffer for rendering/reading (applied at the next draw)
+        /// @param target the target to bind to (GL_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER)
+        void bind(const unsigned int target) const;
+    };
+
+    /// @brief a vertex array object, describing how vertex attributes are fetched from buffers
+    ///
+    /// vertex arrays are NOT shared between contexts, so a vertex array may only be used on the context which created
+    /// it
+    class bEngineGLVertexArray : public bEngineGLObject
+    {
+        // private ctors
+      private:
+        /// @brief ctor which takes ownership of a vertex array created by create_vertex_array()
+        /// @param name the GL name of the vertex array
+        explicit bEngineGLVertexArray(const unsigned int name);
+
+        // public static methods
+      public:
+        /// @brief vertex array creation "factory" function, since creating a vertex array takes no arguments
+        /// @return a new vertex array with no attributes
+        static bEngineGLVertexArray create_vertex_array();
+
+        // public ctors
+      public:
+        /// @brief default ctor creates an empty wrapper
+        bEngineGLVertexArray() = default;
+
+        // public methods/functions
+      public:
+        /// @brief attaches a buffer to a vertex buffer binding point (glVertexArrayVertexBuffer)
+        /// @param bindingIndex the binding point to attach to
+        /// @param buffer the buffer to attach
+        /// @param offset the offset of the first vertex in the buffer, in bytes
+        /// @param stride the distance between vertices, in bytes
+        void set_vertex_buffer(
+            const unsigned int     bindingIndex,
+            const bEngineGLBuffer &buffer,
+            const std::ptrdiff_t   offset,
+            const int              stride) const;
+
+        /// @brief sets the element (index) buffer (glVertexArrayElementBuffer)
+        /// @param buffer the buffer holding the indices
+        void set_element_buffer(const bEngineGLBuffer &buffer) const;
+
+        /// @brief enables a floating point attribute and sets its format and binding point
+        /// @param attributeIndex the index of the attribute (its shader location)
+        /// @param bindingIndex the vertex buffer binding point the attribute is read from
+        /// @param componentCount the number of components in the attribute (1-4)
+        /// @param type the type of each component in the buffer (e.g. GL_FLOAT)
+        /// @param isNormalized true if integer components should be normalized to [0, 1] (or [-1, 1])
+        /// @param relativeOffset the offset of the attribute within a vertex, in bytes
+        void set_attribute(
+            const unsigned int attributeIndex,
+            const unsigned int bindingIndex,
+            const int          componentCount,
+            const unsigned int type,
+            const bool         isNormalized,
+            const unsigned int relativeOffset) const;
+
+        /// @brief enables an integer attribute and sets its format and binding point
+        /// @param attributeIndex the index of the attribute (its shader location)
+        /// @param bindingIndex the vertex buffer binding point the attribute is read from
+        /// @param componentCount the number of components in the attribute (1-4)
+        /// @param type the type of each component in the buffer (e.g. GL_UNSIGNED_INT)
+        /// @param relativeOffset the offset of the attribute within a vertex, in bytes
+        void set_integer_attribute(
+            const unsigned int attributeIndex,
+            const unsigned int bindingIndex,
+            const int          componentCount,
+            const unsigned int type,
+            const unsigned int relativeOffset) const;
+
+        /// @brief sets how often a binding point advances (glVertexArrayBindingDivisor)
+        /// @param bindingIndex the binding point
+        /// @param divisor 0 to advance per vertex, or N to advance every N instances
+        void set_binding_divisor(const unsigned int bindingIndex, const unsigned int divisor) const;
+
+        /// @brief binds the vertex array for drawing (applied at the next draw)
+        void bind() const;
+    };
+
+    /// @brief the source of a single shader stage of a program
+    struct bEngineGLShaderSource
+    {
+        /// @brief the stage (e.g. GL_VERTEX_SHADER)
+        unsigned int m_stage{0};
+
+        /// @brief the GLSL source of the stage
+        std::string_view m_source{};
+    };
+
+    /// @brief a linked shader program
+    ///
+    /// programs are either built synchronously (by the ctor) or asynchronously (by create_program_async()). An
+    /// asynchronous build is compiled and linked in parallel by the driver if it supports KHR_parallel_shader_compile,
+    /// or on a compile thread with its own context otherwise, so many programs can be submitted up front and built
+    /// while the application does other work (e.g. loads assets). Until it's ready a program draws with its placeholder
+    /// (if it has one); draws recorded with a pending program which has no placeholder are skipped.
+    class bEngineGLProgram : public bEngineGLObject
+    {
+        // private data
+      private:
+        /// @brief the program's build, which is shared with whoever is building it
+        std::shared_ptr<GL::ProgramBuild> m_build{nullptr};
+
+        /// @brief the program drawn with while this one is still being built, or nullptr for none
+        const bEngineGLProgram *m_placeholder{nullptr};
+
+        // private ctors
+      private:
+        /// @brief ctor which creates a program and starts building it
+        /// @param stages the sources of each stage of the program
+        /// @param defines source injected into every stage right after its #version line
+        /// @param placeholder the program drawn with while this one is still being built, or nullptr for none
+        /// @param isAsync true to return without waiting for the build to finish
+        bEngineGLProgram(
+            std::initializer_list<bEngineGLShaderSource> stages,
+            const std::string_view                       defines,
+            const bEngineGLProgram *const                placeholder,
+            const bool                                   isAsync);
+
+        // public static methods
+      public:
+        /// @brief asynchronous program creation "factory" function; submits the program's build and returns
+        /// immediately
+        ///
+        /// the sources are copied, so they don't have to outlive the call. The build's progress can be polled with
+        /// get_is_ready(); get_is_linked()/get_info_log(), get_uniform_location() and the set_uniform*() functions
+        /// wait for it to finish, so look uniforms up and set them once get_is_ready() returns true to avoid stalling.
+        /// @param stages the sources of each stage of the program
+        /// @param defines source injected into every stage right after its #version line
+        /// @param placeholder the (already built) program drawn with until this one is ready, which must outlive it,
+        /// or nullptr to skip draws until then
+        /// @return the new program, which is usually still being built
+        static bEngineGLProgram create_program_async(
+            std::initializer_list<bEngineGLShaderSource> stages,
+            const std::string_view                       defines     = {},
+            const bEngineGLProgram *const                placeholder = nullptr);
+
+        // public ctors
+      public:
+        /// @brief default ctor creates an empty wrapper
+        bEngineGLProgram() = default;
+
+        /// @brief ctor which compiles the given stages and links them into a program; failure is reported through
+        /// get_is_linked()/get_info_log() rather than by throwing, so shaders can be hot-reloaded
+        ///
+        /// if the program cache is enabled (see bEngineGLProgramCache.h) the program is loaded from its cached binary
+        /// when possible, and its binary is cached once it links otherwise
+        /// @param stages the sources of each stage of the program
+        /// @param defines source injected into every stage right after its #version line (e.g. "#define SHADOWS 1\n"),
+        /// so variants of a program can share their sources
+        bEngineGLProgram(std::initializer_list<bEngineGLShaderSource> stages, const std::string_view defines = {});
+
+        // public methods/functions
+      public:
+        /// @brief checks whether the program has finished building (successfully or not) without blocking; may be
+        /// called from any thread, but a build is only finalized when polled on a thread where a context of the
+        /// program's group is current (which also happens at the start of every frame)
+        /// @return true if the program has finished building, false if it's still being built
+        const bool get_is_ready() const;
+
+        /// @brief checks whether the program compiled and linked successfully, waiting for it to finish building
+        /// @return true if the program can be used, false if not
+        const bool get_is_linked() const;
+
+        /// @brief gets the compile/link log, waiting for the program to finish building
+        /// @return the compile/link log if compiling or linking failed, or an empty string if not
+        const std::string &get_info_log() const;
+
+        /// @brief gets the GL name draws with the program should use: the program's own once it's linked, otherwise
+        /// its placeholder's; safe to call from any thread
+        /// @return the GL name to draw with, or 0 if there's nothing which can be drawn with yet
+        const unsigned int get_drawable_name() const;
+
+        /// @brief gets the location of a uniform (glGetUniformLocation), waiting for the program to finish building;
+        /// look locations up once, not every frame
+        /// @param name the name of the uniform
+        /// @return the location of the uniform, or -1 if the program has no active uniform with that name
+        const int get_uniform_location(const char *const name) const;
+
+        /// @brief sets an int (or sampler) uniform without binding the program (glProgramUniform1i), waiting for the
+        /// program to finish building
+        /// @param location the location of the uniform
+        /// @param value the value of the uniform
+        void set_uniform(const int location, const int value) const;
+
+        /// @brief sets a float uniform without binding the program (glProgramUniform1f), waiting for the program to
+        /// finish building
+        /// @param location the location of the uniform
+        /// @param value the value of the uniform
+        void set_uniform(const int location, const float value) const;
+
+        /// @brief sets a (vector of) float vector uniform without binding the program (glProgramUniform*fv), waiting
+        /// for the program to finish building
+        /// @param location the location of the uniform
+        /// @param componentCount the number of components in the vector (1-4)
+        /// @param count the number of vectors (for arrays)
+        /// @param values the values of the uniform
+        void set_uniform_vectors(
+            const int          location,
+            const int          componentCount,
+            const int          count,
+            const float *const values) const;
+
+        /// @brief sets a (vector of) 4x4 matrix uniform without binding the program (glProgramUniformMatrix4fv),
+        /// waiting for the program to finish building
+        /// @param location the location of the uniform
+        /// @param count the number of matrices (for arrays)
+        /// @param values the (column major) values of the uniform
+        void set_uniform_matrices(const int location, const int count, const float *const values) const;
+
+        /// @brief makes the program (or its placeholder, while it's still being built) the one used for drawing
+        /// (applied at the next draw)
+        void use() const;
+    };
+} // namespace bEngine
\ No newline at end of file
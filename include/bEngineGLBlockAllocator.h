@@ -0,0 +1,177 @@
+#pragma once
+
+/// @file bEngineGLBlockAllocator.h
+/// @brief the interface for sub-allocating uniform and shader storage blocks in the bEngine library: per-material
+/// constants live in persistent blocks of one large buffer, per-draw constants in per-frame blocks of a stream buffer,
+/// and draws bind their ranges (glBindBufferRange) instead of setting uniforms or owning buffers
+
+#include "bEngineCommandBuffer.h"  // for binding blocks to draws
+#include "bEngineGL.h"             // for the buffer persistent blocks are allocated from
+#include "bEngineGLStreamBuffer.h" // for the ring per-frame blocks are allocated from
+
+#include <cstddef> // for ptrdiff_t
+#include <vector>  // for the free ranges
+
+namespace bEngine
+{
+    /// @brief a block of a buffer, bindable as a uniform or shader storage block
+    struct bEngineGLBufferBlock
+    {
+        /// @brief the buffer the block is in, or nullptr if the block couldn't be allocated
+        const bEngineGLBuffer *m_buffer{nullptr};
+
+        /// @brief the offset of the block in the buffer, in bytes (a multiple of the allocator's alignment)
+        std::ptrdiff_t m_offset{0};
+
+        /// @brief the size of the block, in bytes (rounded up to the allocator's alignment)
+        std::ptrdiff_t m_size{0};
+
+        /// @brief the mapped memory of a per-frame block, which is written directly (nullptr for persistent blocks,
+        /// which are written with bEngineGLBlockAllocator::update())
+        void *m_data{nullptr};
+
+        /// @brief checks whether the block was allocated
+        /// @return true if the block is valid
+        const bool get_is_valid() const { return m_buffer != nullptr; };
+    };
+
+    /// @brief the statistics of a block allocator's persistent blocks
+    struct bEngineBlockAllocatorStats
+    {
+        /// @brief the number of persistent blocks allocated
+        unsigned long long m_blockCount{0};
+
+        /// @brief the number of bytes of persistent blocks allocated
+        std::ptrdiff_t m_usedBytes{0};
+
+        /// @brief the capacity of the persistent buffer, in bytes
+        std::ptrdiff_t m_capacity{0};
+
+        /// @brief the number of free ranges between the persistent blocks (1 when unfragmented)
+        unsigned long long m_freeRangeCount{0};
+
+        /// @brief the number of times the persistent buffer grew
+        unsigned long long m_growCount{0};
+    };
+
+    /// @brief sub-allocates uniform and shader storage blocks, aligned for both (GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT and
+    /// GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT)
+    ///
+    /// persistent blocks (e.g. a material's constants, which rarely change) are allocated first-fit from a free list
+    /// over one large buffer, coalescing freed neighbours, and are rewritten with update(); when the buffer is full it
+    /// grows by doubling, copying every block on the GPU so their offsets stay the same. Per-frame blocks (e.g. a
+    /// draw's transform) are allocated from the streaming ring, and are only valid until the end of the frame.
+    ///
+    /// each block is bound to a draw with set_uniform_block() (binding 0, per draw), set_material_block() (uniform
+    /// binding 1, per material) or set_storage_block() (shader storage binding 0); the command queue only rebinds a
+    /// range when it differs from the previous draw's, so draws sorted by material share its binding. The allocator
+    /// must be created and used on the thread which owns its context.
+    class bEngineGLBlockAllocator
+    {
+        // private types
+      private:
+        /// @brief a free range of the persistent buffer
+        struct FreeRange
+        {
+            /// @brief the offset of the range, in bytes
+            std::ptrdiff_t m_offset{0};
+
+            /// @brief the size of the range, in bytes
+            std::ptrdiff_t m_size{0};
+        };
+
+        // private data
+      private:
+        /// @brief the stream buffer per-frame blocks are allocated from
+        bEngineGLStreamBuffer *const m_streamBuffer{nullptr};
+
+        /// @brief the alignment of every block's offset (and size)
+        std::ptrdiff_t m_alignment{0};
+
+        /// @brief the buffer persistent blocks are allocated from
+        bEngineGLBuffer m_buffer;
+
+        /// @brief the free ranges of the persistent buffer, ordered by offset
+        std::vector<FreeRange> m_freeRanges;
+
+        /// @brief the statistics of the persistent blocks
+        bEngineBlockAllocatorStats m_stats{};
+
+        // public ctors
+      public:
+        /// @brief default ctor is insufficient
+        bEngineGLBlockAllocator() = delete;
+
+        /// @brief ctor which creates the persistent buffer on the current context
+        /// @param streamBuffer the stream buffer per-frame blocks are allocated from, which must outlive the allocator
+        /// @param capacity the initial capacity of the persistent buffer, in bytes
+        bEngineGLBlockAllocator(bEngineGLStreamBuffer &streamBuffer, const std::ptrdiff_t capacity = 1024 * 1024);
+
+        // public methods/functions
+      public:
+        /// @brief allocates a persistent block
+        /// @param size the size of the block, in bytes
+        /// @param data the block's initial contents (size bytes), or nullptr to leave them undefined
+        /// @return the block, which stays valid until it's freed
+        const bEngineGLBufferBlock allocate(const std::ptrdiff_t size, const void *const data = nullptr);
+
+        /// @brief rewrites (part of) a persistent block; the write happens immediately, so every draw executed after
+        /// it (including draws recorded earlier in the frame, which only execute as the window renders) sees the new
+        /// contents
+        /// @param block the block
+        /// @param data the new contents
+        /// @param size the number of bytes to write (0 for the whole block)
+        /// @param offset the offset within the block to write at, in bytes
+        void update(
+            const bEngineGLBufferBlock &block,
+            const void *const           data,
+            const std::ptrdiff_t        size   = 0,
+            const std::ptrdiff_t        offset = 0);
+
+        /// @brief frees a persistent block; draws recorded this frame must not use it, since its range may be
+        /// reallocated and rewritten before they execute
+        /// @param block the block, which is invalidated
+        void free(bEngineGLBufferBlock &block);
+
+        /// @brief allocates a per-frame block from the stream buffer
+        /// @param size the size of the block, in bytes
+        /// @param data the block's contents (size bytes), or nullptr to write them through the block's m_data
+        /// @return the block, which is only valid until the end of the frame (invalid if the stream buffer doesn't have
+        /// enough space left this frame)
+        const bEngineGLBufferBlock allocate_frame(const std::ptrdiff_t size, const void *const data = nullptr);
+
+        /// @brief gets the alignment of every block
+        /// @return the alignment of every block's offset, in bytes
+        const std::ptrdiff_t get_alignment() const;
+
+        /// @brief gets the statistics of the persistent blocks
+        /// @return the statistics of the persistent blocks
+        const bEngineBlockAllocatorStats get_stats() const;
+
+        /// @brief binds a block to a draw's uniform block binding 0 (per-draw data)
+        /// @param item the draw
+        /// @param block the block
+        static void set_uniform_block(bEngineDrawItem &item, const bEngineGLBufferBlock &block);
+
+        /// @brief binds a block to a draw's uniform block binding 1 (per-material data)
+        /// @param item the draw
+        /// @param block the block
+        static void set_material_block(bEngineDrawItem &item, const bEngineGLBufferBlock &block);
+
+        /// @brief binds a block to a draw's shader storage block binding 0
+        /// @param item the draw
+        /// @param block the block
+        static void set_storage_block(bEngineDrawItem &item, const bEngineGLBufferBlock &block);
+
+        // private methods/functions
+      private:
+        /// @brief rounds a size up to the alignment
+        /// @param size the size, in bytes
+        /// @return the aligned size, in bytes
+        const std::ptrdiff_t align(const std::ptrdiff_t size) const;
+
+        /// @brief grows the persistent buffer until it has a free range of a size, copying the blocks into it
+        /// @param size the size of the free range needed, in bytes
+        void grow(const std::ptrdiff_t size);
+    };
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,182 @@
+#pragma once
+
+/// @file bEngineGLInstancing.h
+/// @brief the interface for instanced mesh rendering in the bEngine library, which draws every copy of a mesh (e.g.
+/// foliage, crowds, debris) with a single instanced draw
+
+#include "bEngineCommandBuffer.h"  // for the state each bucket of instances is drawn with
+#include "bEngineGLMultiDraw.h"    // for the mesh pool instanced meshes are drawn from
+#include "bEngineGLStreamBuffer.h" // for the per-frame memory instances are written to
+
+#include <glm\glm.hpp> // for instance transforms
+
+#include <cstddef> // for ptrdiff_t and byte
+#include <cstdint> // for fixed width integers
+#include <vector>  // for the buckets and their instances
+
+namespace bEngine
+{
+    /// @brief the statistics of an instance batch's last recorded frame
+    struct bEngineInstanceStats
+    {
+        /// @brief the number of instances drawn
+        std::uint32_t m_instanceCount{0};
+
+        /// @brief the number of instanced draws the instances were drawn with
+        std::uint32_t m_drawCount{0};
+
+        /// @brief the number of instances which weren't drawn because the stream buffer ran out of space
+        std::uint32_t m_droppedInstances{0};
+
+        /// @brief the number of bytes of instance data written to the stream buffer
+        std::ptrdiff_t m_uploadedBytes{0};
+    };
+
+    /// @brief collects a frame's instances of the meshes in a mesh pool and draws each bucket (a mesh and the state
+    /// it's drawn with) with one instanced draw
+    ///
+    /// instances are appended each frame, and recording writes every bucket's instances contiguously into the
+    /// (persistently mapped) stream buffer; each bucket's draw then finds its instances through its base instance. An
+    /// instance's transform is quantized to an affine 3x4 matrix: a full precision translation and half float basis
+    /// vectors, 36 bytes instead of a mat4's 64. Its custom data (e.g. a color or animation frame) follows the
+    /// transform.
+    ///
+    /// the batch reads instances through binding point 1 of the pool's vertex array, and the transform through
+    /// attribute locations 12-15 (see s_shaderInterface); custom attributes are set up with set_custom_attribute() and
+    /// must use locations below 12. The vertex shader composes the transform with get_instance_transform(). A pool's
+    /// vertex array can only be shared by one instance batch, which must be created and used on the thread which owns
+    /// its context.
+    class bEngineGLInstanceBatch
+    {
+        // public static data
+      public:
+        /// @brief the vertex buffer binding point of the pool's vertex array instances are read from
+        static constexpr unsigned int s_instanceBinding{1};
+
+        /// @brief the first of the four attribute locations the transform is read from
+        static constexpr unsigned int s_transformLocation{12};
+
+        /// @brief the size of an instance's (quantized) transform, in bytes; custom data starts at this offset
+        static constexpr int s_transformSize{36};
+
+        /// @brief the declarations a vertex shader drawing instances needs, e.g. injected through a program's defines
+        static constexpr const char *s_shaderInterface{R"(
+layout(location = 12) in vec3 a_instanceTranslation;
+layout(location = 13) in vec3 a_instanceBasisX;
+layout(location = 14) in vec3 a_instanceBasisY;
+layout(location = 15) in vec3 a_instanceBasisZ;
+
+mat4 get_instance_transform()
+{
+    return mat4(
+        vec4(a_instanceBasisX, 0.0),
+        vec4(a_instanceBasisY, 0.0),
+        vec4(a_instanceBasisZ, 0.0),
+        vec4(a_instanceTranslation, 1.0));
+}
+)"};
+
+        // private types
+      private:
+        /// @brief a mesh, the state it's drawn with and the frame's instances of it
+        struct Bucket
+        {
+            /// @brief the mesh the instances are copies of
+            bEngineMeshRange m_mesh{};
+
+            /// @brief the state the instances are drawn with
+            bEngineDrawItem m_item{};
+
+            /// @brief the sort key of the bucket's draw
+            std::uint64_t m_sortKey{0};
+
+            /// @brief the frame's (packed) instances
+            std::vector<std::byte> m_instances;
+        };
+
+        // private data
+      private:
+        /// @brief the stream buffer instances are written to each frame
+        bEngineGLStreamBuffer *const m_streamBuffer{nullptr};
+
+        /// @brief the pool the instanced meshes are in
+        const bEngineGLMeshPool *const m_meshPool{nullptr};
+
+        /// @brief the size of an instance's custom data, in bytes
+        const int m_customDataSize{0};
+
+        /// @brief the size of a whole instance, in bytes
+        const int m_instanceStride{0};
+
+        /// @brief the batch's buckets
+        std::vector<Bucket> m_buckets;
+
+        /// @brief the statistics of the last recorded frame
+        bEngineInstanceStats m_stats{};
+
+        // public ctors
+      public:
+        /// @brief default ctor is insufficient
+        bEngineGLInstanceBatch() = delete;
+
+        /// @brief ctor which attaches the instance binding and transform attributes to the pool's vertex array
+        /// @param streamBuffer the stream buffer the instances are written to each frame, which must outlive the batch
+        /// @param meshPool the pool the instanced meshes are in, which must outlive the batch
+        /// @param customDataSize the size of each instance's custom data, in bytes (a multiple of 4; may be 0)
+        bEngineGLInstanceBatch(
+            bEngineGLStreamBuffer   &streamBuffer,
+            const bEngineGLMeshPool &meshPool,
+            const int                customDataSize = 0);
+
+        // public methods/functions
+      public:
+        /// @brief sets up an attribute reading from the instances' custom data (see
+        /// bEngineGLVertexArray::set_attribute())
+        /// @param attributeIndex the index of the attribute (its shader location, below s_transformLocation)
+        /// @param componentCount the number of components in the attribute (1-4)
+        /// @param type the type of each component in the custom data (e.g. GL_UNSIGNED_BYTE)
+        /// @param isNormalized true if integer components should be normalized to [0, 1] (or [-1, 1])
+        /// @param customDataOffset the offset of the attribute within the custom data, in bytes
+        void set_custom_attribute(
+            const unsigned int attributeIndex,
+            const int          componentCount,
+            const unsigned int type,
+            const bool         isNormalized,
+            const unsigned int customDataOffset) const;
+
+        /// @brief adds a bucket: a mesh of the pool and the state its instances are drawn with
+        /// @param mesh the mesh, from the batch's pool
+        /// @param item the state the instances are drawn with (program, textures, render state, uniforms, etc.); its
+        /// vertex array and draw parameters are overridden by the batch
+        /// @param sortKey the sort key of the bucket's draw
+        /// @return the ID instances refer to the bucket by
+        const std::uint32_t add_bucket(
+            const bEngineMeshRange &mesh,
+            const bEngineDrawItem  &item,
+            const std::uint64_t     sortKey);
+
+        /// @brief starts a new frame, forgetting the previous frame's instances (the buckets keep their memory)
+        void begin();
+
+        /// @brief adds an instance to the frame, quantizing its transform
+        /// @param bucket the ID of the bucket the instance belongs to
+        /// @param transform the instance's transform; only its affine (upper 3x4) part is kept
+        /// @param customData the instance's custom data (the custom data size bytes), or nullptr to zero it
+        void add_instance(
+            const std::uint32_t bucket,
+            const glm::mat4    &transform,
+            const void *const   customData = nullptr);
+
+        /// @brief writes the frame's instances into the stream buffer and records a draw for each non-empty bucket
+        /// @param commands the command buffer to record into
+        void record(bEngineCommandBuffer &commands);
+
+        /// @brief gets the size of a whole instance
+        /// @return the size of a whole instance (its transform and custom data), in bytes
+        const int get_instance_stride() const;
+
+        /// @brief gets the statistics of the last recorded frame
+        /// @return the statistics of the last recorded frame
+        const bEngineInstanceStats get_stats() const;
+    };
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,203 @@
+#pragma once
+
+/// @file bEngineGLMultiDraw.h
+/// @brief the interface for multi-draw indirect batching in the bEngine library, which submits whole passes of small
+/// meshes with a single glMultiDrawElementsIndirect instead of a draw call per mesh
+
+#include "bEngineGL.h"             // for the buffers/vertex array of a mesh pool
+#include "bEngineGLStreamBuffer.h" // for the per-frame memory a draw batch is built in
+
+#include <cstddef> // for ptrdiff_t
+#include <cstdint> // for fixed width integers (the layout of an indirect command is fixed by GL)
+
+namespace bEngine
+{
+    // fwd declarations for recording a batch
+    class bEngineCommandBuffer;
+    struct bEngineDrawItem;
+
+    /// @brief a single indirect command of glMultiDrawElementsIndirect, laid out exactly as GL expects
+    struct bEngineDrawIndirectCommand
+    {
+        /// @brief the number of indices to draw
+        std::uint32_t m_count{0};
+
+        /// @brief the number of instances to draw
+        std::uint32_t m_instanceCount{0};
+
+        /// @brief the index of the first index to draw
+        std::uint32_t m_firstIndex{0};
+
+        /// @brief the value added to every index before fetching vertices
+        std::int32_t m_baseVertex{0};
+
+        /// @brief the instance the draw starts at (i.e. gl_BaseInstance)
+        std::uint32_t m_baseInstance{0};
+    };
+    static_assert(sizeof(bEngineDrawIndirectCommand) == 20, "indirect commands must match GL's tightly packed layout");
+
+    /// @brief the location of a mesh in a mesh pool's shared buffers
+    struct bEngineMeshRange
+    {
+        /// @brief the index of the mesh's first index in the pool's index buffer
+        std::uint32_t m_firstIndex{0};
+
+        /// @brief the number of indices of the mesh
+        std::uint32_t m_indexCount{0};
+
+        /// @brief the index of the mesh's first vertex in the pool's vertex buffer (its indices are relative to it)
+        std::int32_t m_baseVertex{0};
+    };
+
+    /// @brief a pair of "megabuffers" which many meshes sharing a vertex format are packed into, so that any of them
+    /// can be drawn without changing the vertex array or buffer bindings
+    ///
+    /// the pool's vertex array reads vertices from binding point 0 and 32 bit (GL_UNSIGNED_INT) indices from the index
+    /// buffer; only the attributes have to be set up (through get_vertex_array()). Meshes are appended and live as
+    /// long as the pool.
+    class bEngineGLMeshPool
+    {
+        // private data
+      private:
+        /// @brief the size of a single vertex, in bytes
+        const int m_vertexStride{0};
+
+        /// @brief the number of vertices the pool can hold
+        const std::uint32_t m_vertexCapacity{0};
+
+        /// @brief the number of indices the pool can hold
+        const std::uint32_t m_indexCapacity{0};
+
+        /// @brief the number of vertices in use
+        std::uint32_t m_vertexCount{0};
+
+        /// @brief the number of indices in use
+        std::uint32_t m_indexCount{0};
+
+        /// @brief the shared vertex buffer
+        bEngineGLBuffer m_vertices;
+
+        /// @brief the shared index buffer
+        bEngineGLBuffer m_indices;
+
+        /// @brief the vertex array which draws from the shared buffers
+        bEngineGLVertexArray m_vertexArray;
+
+        // public ctors/dtor
+      public:
+        /// @brief default ctor is insufficient
+        bEngineGLMeshPool() = delete;
+
+        /// @brief ctor which creates the shared buffers and their vertex array on the current context
+        /// @param vertexStride the size of a single vertex, in bytes
+        /// @param vertexCapacity the number of vertices the pool can hold
+        /// @param indexCapacity the number of indices the pool can hold
+        bEngineGLMeshPool(
+            const int           vertexStride,
+            const std::uint32_t vertexCapacity,
+            const std::uint32_t indexCapacity);
+
+        // public methods/functions
+      public:
+        /// @brief uploads a mesh into the shared buffers; throws a bEngineException if the pool is full
+        /// @param vertices the mesh's vertices (vertexCount * the vertex stride bytes)
+        /// @param vertexCount the number of vertices of the mesh
+        /// @param indices the mesh's indices, relative to its first vertex
+        /// @param indexCount the number of indices of the mesh
+        /// @return the location of the mesh in the pool, for drawing it
+        const bEngineMeshRange add_mesh(
+            const void *const          vertices,
+            const std::uint32_t        vertexCount,
+            const std::uint32_t *const indices,
+            const std::uint32_t        indexCount);
+
+        /// @brief gets the vertex array which draws from the pool, e.g. for setting up its attributes (which must read
+        /// from binding point 0)
+        /// @return a reference to the pool's vertex array
+        const bEngineGLVertexArray &get_vertex_array() const;
+
+        /// @brief gets the size of a single vertex
+        /// @return the size of a single vertex, in bytes
+        const int get_vertex_stride() const;
+
+        /// @brief gets the number of vertices in use
+        /// @return the number of vertices in use
+        const std::uint32_t get_vertex_count() const;
+
+        /// @brief gets the number of indices in use
+        /// @return the number of indices in use
+        const std::uint32_t get_index_count() const;
+    };
+
+    /// @brief a batch of draws from a mesh pool which is submitted with a single glMultiDrawElementsIndirect
+    ///
+    /// each frame the batch allocates its indirect commands, and a block of user-defined per-draw data (e.g. a
+    /// transform and material index) bound to shader storage block binding 0, from a stream buffer. Every draw's
+    /// command and data are written straight into the mapped memory by set_draw(), which may be called from any
+    /// number of threads at once as long as they write different draws; so building a batch of tens of thousands of
+    /// draws can be split across workers. The data of draw N is element N of the storage block, and draw N starts at
+    /// instance N, so shaders find their data with gl_BaseInstance (or gl_DrawID).
+    class bEngineGLDrawBatch
+    {
+        // private data
+      private:
+        /// @brief the stream buffer the batch is built in
+        bEngineGLStreamBuffer *const m_streamBuffer{nullptr};
+
+        /// @brief the size of a single draw's data, in bytes
+        const std::ptrdiff_t m_drawDataSize{0};
+
+        /// @brief the alignment of shader storage block ranges on the current context
+        std::ptrdiff_t m_storageAlignment{0};
+
+        /// @brief the number of draws in the current frame's batch
+        std::uint32_t m_drawCount{0};
+
+        /// @brief the current frame's indirect commands
+        bEngineGLStreamBuffer::Allocation m_commands{};
+
+        /// @brief the current frame's per-draw data
+        bEngineGLStreamBuffer::Allocation m_drawData{};
+
+        // public ctors/dtor
+      public:
+        /// @brief default ctor is insufficient
+        bEngineGLDrawBatch() = delete;
+
+        /// @brief ctor which prepares a batch on the current context
+        /// @param streamBuffer the stream buffer the batch is built in each frame, which must outlive the batch
+        /// @param drawDataSize the size of a single draw's data, in bytes (its std430 array stride; may be 0)
+        bEngineGLDrawBatch(bEngineGLStreamBuffer &streamBuffer, const std::ptrdiff_t drawDataSize);
+
+        // public methods/functions
+      public:
+        /// @brief starts this frame's batch, allocating space for its draws; must be called on the context's thread
+        /// before any draws are set
+        /// @param drawCount the number of draws in the batch
+        /// @return true if the batch was allocated, false if the stream buffer doesn't have enough space left this
+        /// frame (the batch is then empty)
+        const bool begin(const std::uint32_t drawCount);
+
+        /// @brief sets one draw of the batch; safe to call from any thread for distinct draws
+        /// @param drawIndex the index of the draw in the batch
+        /// @param mesh the mesh to draw
+        /// @param drawData the draw's data (the draw data size bytes), or nullptr to leave it unwritten
+        /// @param instanceCount the number of instances of the mesh to draw
+        void set_draw(
+            const std::uint32_t     drawIndex,
+            const bEngineMeshRange &mesh,
+            const void *const       drawData,
+            const std::uint32_t     instanceCount = 1) const;
+
+        /// @brief records the whole batch as a single multi-draw, once every draw has been set
+        /// @param commands the command buffer to record into
+        /// @param sortKey the sort key of the multi-draw
+        /// @param item the state shared by the batch (program, the pool's vertex array, textures, etc.); its storage
+        /// block and index type are overridden by the batch
+        void record(bEngineCommandBuffer &commands, const std::uint64_t sortKey, const bEngineDrawItem &item) const;
+
+        /// @brief gets the number of draws in the current frame's batch
+        /// @return the number of draws in the current frame's batch
+        const std::uint32_t get_draw_count() const;
+    };
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+/// @file bEngineGLProgramCache.h
+/// @brief the interface for the on-disk program binary cache of the bEngine library
+///
+/// once a cache directory is set, every program which links successfully has its binary (glGetProgramBinary) saved
+/// to the directory, keyed by a hash of its sources, its defines and the driver (vendor/renderer/version strings).
+/// Later builds of the same program load the binary (glProgramBinary) instead of compiling and linking the GLSL; if the
+/// driver refuses the binary (e.g. after a driver update) the program is compiled as usual and the binary is replaced.
+
+#include <filesystem> // for the cache directory
+
+namespace bEngine
+{
+    /// @brief the statistics of the program cache since the application started
+    struct bEngineGLProgramCacheStats
+    {
+        /// @brief the number of programs loaded from the cache
+        unsigned long long m_hits{0};
+
+        /// @brief the number of programs which had to be compiled (including rejected binaries)
+        unsigned long long m_misses{0};
+
+        /// @brief the number of cached binaries which the driver refused to load
+        unsigned long long m_rejections{0};
+
+        /// @brief the time the hits would have spent compiling/linking (as measured when they were cached), minus the
+        /// time spent loading them, in seconds
+        double m_savedSeconds{0.0};
+    };
+
+    /// @brief functions for configuring the program binary cache; may be called from any thread
+    namespace GLProgramCache
+    {
+        /// @brief sets the directory program binaries are saved to/loaded from, creating it if need be
+        /// @param directory the cache directory, or an empty path to disable the cache (the default)
+        /// @return true if the cache is enabled, false if it was disabled or the directory couldn't be created
+        const bool set_directory(const std::filesystem::path &directory);
+
+        /// @brief gets the directory program binaries are saved to/loaded from
+        /// @return the cache directory, or an empty path if the cache is disabled
+        const std::filesystem::path get_directory();
+
+        /// @brief gets the cache's statistics
+        /// @return the cache's statistics since the application started
+        const bEngineGLProgramCacheStats get_stats();
+    } // namespace GLProgramCache
+} // namespace bEngine
\ No newline at end of file
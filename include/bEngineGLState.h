@@ -0,0 +1,90 @@
+#pragma once
+
+/// @file bEngineGLState.h
+/// @brief the interface for the GL state of the current context in the bEngine library
+///
+/// every binding (via the GL object wrappers' bind/use methods) and every piece of fixed-function state set here is
+/// shadowed by the current context: requests which wouldn't change anything are never sent to GL, and the state which
+/// actually changed is applied lazily, all at once, right before the next draw (or clear). As such raw GL calls which
+/// change bindings/state must be followed by a call to invalidate().
+
+namespace bEngine
+{
+    /// @brief the number of state changes requested vs actually issued to GL during a frame
+    struct bEngineGLStateStats
+    {
+        /// @brief the number of bindings/state changes which were requested
+        unsigned long long m_requestedChanges{0};
+
+        /// @brief the number of GL calls which were actually made to apply them
+        unsigned long long m_issuedCalls{0};
+
+        /// @brief the number of requested changes which didn't need a GL call (because they were redundant)
+        unsigned long long m_elidedChanges{0};
+    };
+
+    /// @brief functions for setting the state of (and drawing with) the context which is current on the calling
+    /// thread; these may only be called while a window is rendering
+    namespace GLState
+    {
+        /// @brief sets whether blending is enabled and how (glEnable/glDisable(GL_BLEND), glBlendFunc)
+        /// @param isEnabled true to enable blending, false to disable it
+        /// @param sourceFactor the source blend factor (e.g. GL_SRC_ALPHA)
+        /// @param destinationFactor the destination blend factor (e.g. GL_ONE_MINUS_SRC_ALPHA)
+        void set_blend(const bool isEnabled, const unsigned int sourceFactor, const unsigned int destinationFactor);
+
+        /// @brief sets the depth test/write state (glEnable/glDisable(GL_DEPTH_TEST), glDepthMask, glDepthFunc)
+        /// @param isTestEnabled true to enable depth testing, false to disable it
+        /// @param isWriteEnabled true to write to the depth buffer, false to leave it untouched
+        /// @param function the depth comparison function (e.g. GL_LESS)
+        void set_depth(const bool isTestEnabled, const bool isWriteEnabled, const unsigned int function);
+
+        /// @brief sets the face culling state (glEnable/glDisable(GL_CULL_FACE), glCullFace)
+        /// @param isEnabled true to enable face culling, false to disable it
+        /// @param face the face to cull (e.g. GL_BACK)
+        void set_cull_face(const bool isEnabled, const unsigned int face);
+
+        /// @brief sets the viewport (glViewport); the viewport is reset to the whole window before each render
+        /// @param x the x coordinate of the viewport's lower left corner, in pixels
+        /// @param y the y coordinate of the viewport's lower left corner, in pixels
+        /// @param width the width of the viewport, in pixels
+        /// @param height the height of the viewport, in pixels
+        void set_viewport(const int x, const int y, const int width, const int height);
+
+        /// @brief applies any pending state, then draws (glDrawArraysInstanced)
+        /// @param mode the primitive mode (e.g. GL_TRIANGLES)
+        /// @param first the first vertex to draw
+        /// @param count the number of vertices to draw
+        /// @param instanceCount the number of instances to draw
+        void draw_arrays(const unsigned int mode, const int first, const int count, const int instanceCount = 1);
+
+        /// @brief applies any pending state, then draws with the bound element buffer (glDrawElementsInstanced)
+        /// @param mode the primitive mode (e.g. GL_TRIANGLES)
+        /// @param count the number of indices to draw
+        /// @param indexType the type of the indices (e.g. GL_UNSIGNED_INT)
+        /// @param offset the offset of the first index into the element buffer, in bytes
+        /// @param instanceCount the number of instances to draw
+        void draw_elements(
+            const unsigned int mode,
+            const int          count,
+            const unsigned int indexType,
+            const unsigned int offset,
+            const int          instanceCount = 1);
+
+        /// @brief applies any pending state immediately, e.g. before making raw GL draw calls
+        void flush();
+
+        /// @brief forgets everything known about the real GL state, so the next flush applies every piece of state;
+        /// must be called after making raw GL calls which change bindings/state
+        void invalidate();
+
+        /// @brief gets the state change statistics of the previous (complete) frame on the current context
+        /// @return the state change statistics of the previous frame
+        const bEngineGLStateStats get_frame_stats();
+
+        /// @brief sets how often the shadowed state is checked against the real GL state (which is slow, since it
+        /// stalls on glGet* queries); any difference is reported as a warning and the shadowed state is corrected
+        /// @param frameInterval the number of frames between checks, or 0 to never check (the default in release)
+        void set_validation_interval(const unsigned int frameInterval);
+    } // namespace GLState
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,166 @@
+#pragma once
+
+/// @file bEngineGLStreamBuffer.h
+/// @brief the interface for streaming buffers in the bEngine library, which hold per-frame dynamic data (vertices,
+/// uniforms, etc.) without ever stalling on glBufferSubData
+
+#include "bEngineGL.h" // for the buffer the stream buffer is built on
+
+#include <atomic>  // for lock-free sub-allocation and statistics
+#include <cstddef> // for ptrdiff_t/byte
+#include <vector>  // for the fence of each region
+
+namespace bEngine
+{
+    /// @brief the statistics of a stream buffer since it was created
+    struct bEngineGLStreamStats
+    {
+        /// @brief the number of successful allocations
+        unsigned long long m_allocations{0};
+
+        /// @brief the number of bytes handed out by successful allocations (excluding alignment padding)
+        unsigned long long m_allocatedBytes{0};
+
+        /// @brief the number of allocations which failed because the frame's region was full
+        unsigned long long m_failedAllocations{0};
+
+        /// @brief the number of frames which had to wait for the GPU to finish reading a region before reusing it
+        unsigned long long m_stalls{0};
+
+        /// @brief the total time spent waiting on the GPU, in seconds
+        double m_stallSeconds{0.0};
+
+        /// @brief the number of times the ring wrapped around to its first region
+        unsigned long long m_wraparounds{0};
+    };
+
+    /// @brief a ring of N frame-sized regions of a single persistently (and coherently) mapped buffer
+    ///
+    /// each frame, data is written straight into the current region through the mapping; nothing is copied and no GL
+    /// calls are made to upload it. When a frame ends a fence is placed after the frame's commands, and when the ring
+    /// comes back around to a region its fence is waited on first, so the CPU never overwrites data the GPU hasn't
+    /// read yet. With 3 regions the CPU can run up to 2 frames ahead of the GPU before stalling.
+    ///
+    /// the stream buffer must be created and destroyed on the thread which owns its context (i.e. in a window's render
+    /// function) and registers itself with that context, which advances it every frame. allocate() is lock-free and
+    /// can be called from any thread while the frame's commands are being recorded. If the context is destroyed first
+    /// (i.e. its window closes), the stream buffer is released with it and every later allocation fails.
+    class bEngineGLStreamBuffer
+    {
+        // public types
+      public:
+        /// @brief a sub-allocation of the current frame's region
+        struct Allocation
+        {
+            /// @brief a pointer to the allocation's (write-only) memory, or nullptr if the allocation failed
+            void *m_data{nullptr};
+
+            /// @brief the offset of the allocation in the stream buffer, in bytes (e.g. for vertex buffer bindings
+            /// or uniform block ranges)
+            std::ptrdiff_t m_offset{0};
+
+            /// @brief the size of the allocation, in bytes
+            std::ptrdiff_t m_size{0};
+        };
+
+        // private data
+      private:
+        /// @brief the context the stream buffer is registered with, or nullptr once the stream buffer is released
+        GL::Context *m_context{nullptr};
+
+        /// @brief the underlying buffer
+        bEngineGLBuffer m_buffer;
+
+        /// @brief the persistent mapping of the whole buffer
+        std::byte *m_mapping{nullptr};
+
+        /// @brief the size of each region, in bytes
+        const std::ptrdiff_t m_regionSize{0};
+
+        /// @brief the number of regions in the ring
+        const unsigned int m_regionCount{0};
+
+        /// @brief the region being written this frame
+        unsigned int m_currentRegion{0};
+
+        /// @brief the offset of the first unallocated byte in the current region
+        std::atomic<std::ptrdiff_t> m_regionOffset{0};
+
+        /// @brief the fence (GLsync) guarding each region, or nullptr if the region isn't in use by the GPU
+        std::vector<void *> m_fences;
+
+        /// @brief the number of successful allocations
+        std::atomic<unsigned long long> m_allocations{0};
+
+        /// @brief the number of bytes handed out by successful allocations
+        std::atomic<unsigned long long> m_allocatedBytes{0};
+
+        /// @brief the number of failed allocations
+        std::atomic<unsigned long long> m_failedAllocations{0};
+
+        /// @brief the number of frames which stalled on a fence
+        unsigned long long m_stalls{0};
+
+        /// @brief the total time spent stalled on fences, in seconds
+        double m_stallSeconds{0.0};
+
+        /// @brief the number of times the ring wrapped around
+        unsigned long long m_wraparounds{0};
+
+        // public ctors/dtor
+      public:
+        /// @brief default ctor is insufficient
+        bEngineGLStreamBuffer() = delete;
+
+        /// @brief ctor which creates, maps and registers the stream buffer with the current context
+        /// @param regionSize the number of bytes which can be allocated each frame
+        /// @param regionCount the number of regions (frames) in the ring
+        bEngineGLStreamBuffer(const std::ptrdiff_t regionSize, const unsigned int regionCount = 3);
+
+        /// @brief the stream buffer is registered with its context by address, so it is not copyable
+        bEngineGLStreamBuffer(const bEngineGLStreamBuffer &) = delete;
+
+        /// @brief the stream buffer is registered with its context by address, so it is not copyable
+        bEngineGLStreamBuffer &operator=(const bEngineGLStreamBuffer &) = delete;
+
+        /// @brief dtor releases the stream buffer (see release())
+        ~bEngineGLStreamBuffer();
+
+        // public methods/functions
+      public:
+        /// @brief allocates memory from the current frame's region; lock-free and safe to call from any thread
+        ///
+        /// the memory is only valid until the end of the frame, and should only be written (reading mapped memory
+        /// is slow)
+        /// @param size the number of bytes to allocate
+        /// @param alignment the alignment of the allocation's offset (a power of two, e.g. the uniform buffer offset
+        /// alignment for uniform blocks)
+        /// @return the allocation, whose data is nullptr if the region doesn't have enough space left
+        Allocation allocate(const std::ptrdiff_t size, const std::ptrdiff_t alignment = 16);
+
+        /// @brief gets the underlying buffer, for binding allocations (e.g. as vertex buffers or uniform blocks)
+        /// @return a reference to the underlying buffer
+        const bEngineGLBuffer &get_buffer() const;
+
+        /// @brief gets the number of bytes which can be allocated each frame
+        /// @return the size of each region, in bytes
+        const std::ptrdiff_t get_region_size() const;
+
+        /// @brief gets the stream buffer's statistics
+        /// @return the stream buffer's statistics since it was created
+        const bEngineGLStreamStats get_stats() const;
+
+        /// @brief moves on to the next region, waiting for the GPU to finish with it first if need be; called
+        /// automatically by the owning context at the start of each frame
+        void begin_frame();
+
+        /// @brief fences the current region after the frame's commands; called automatically by the owning context at
+        /// the end of each frame
+        void end_frame();
+
+        /// @brief unregisters the stream buffer from its context, deletes its fences and releases its buffer, after
+        /// which every allocation fails; called automatically by the owning context if it's destroyed first, and
+        /// otherwise by the dtor (the context must be current either way)
+        void release();
+    };
+} // namespace bEngine
\ No newline at end of file
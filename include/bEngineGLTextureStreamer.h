@@ -0,0 +1,381 @@
+#pragma once
+
+/// @file bEngineGLTextureStreamer.h
+/// @brief the interface for streaming textures in the bEngine library: mip levels are decoded by worker threads
+/// straight into persistently mapped pixel unpack buffers, uploaded within a per-frame byte budget, and made resident
+/// smallest level first (clamped with GL_TEXTURE_BASE_LEVEL) as screen-space demand asks for more detail
+
+#include "bEngineGL.h" // for the streamed textures and the staging buffer
+
+#include <condition_variable> // for waking the worker threads
+#include <cstddef>            // for ptrdiff_t/byte
+#include <cstdint>            // for fixed width integers
+#include <deque>              // for the staging ring and the worker threads' queues
+#include <functional>         // for decoding levels
+#include <memory>             // for sharing loaders with the worker threads and the (non-movable) uploads
+#include <mutex>              // for guarding the worker threads' queues
+#include <thread>             // for the worker threads
+#include <vector>             // for the textures, their levels and the worker threads
+
+namespace bEngine
+{
+    /// @brief the staging memory a level of a streamed texture is decoded into, on a worker thread
+    struct bEngineStreamedLevel
+    {
+        /// @brief the mip level being decoded
+        int m_level{0};
+
+        /// @brief the width of the level, in texels
+        int m_width{0};
+
+        /// @brief the height of the level, in texels
+        int m_height{0};
+
+        /// @brief the distance between the starts of consecutive rows, in bytes (each row is padded to 4 bytes, GL's
+        /// default unpack alignment)
+        std::ptrdiff_t m_rowStride{0};
+
+        /// @brief the (write-only, mapped) memory the level's rows are written to, m_rowStride * m_height bytes
+        void *m_texels{nullptr};
+    };
+
+    /// @brief the description of a streamed texture (always a 2D texture with uncompressed texels)
+    struct bEngineStreamedTextureDesc
+    {
+        /// @brief the width of the base level, in texels
+        int m_width{0};
+
+        /// @brief the height of the base level, in texels
+        int m_height{0};
+
+        /// @brief the number of mip levels, or 0 for a full chain down to 1x1
+        int m_levels{0};
+
+        /// @brief the sized internal format of the texture (e.g. GL_RGBA8 or GL_SRGB8_ALPHA8)
+        unsigned int m_internalFormat{0};
+
+        /// @brief the format of the decoded texels (e.g. GL_RGBA)
+        unsigned int m_format{0};
+
+        /// @brief the type of the decoded texels (e.g. GL_UNSIGNED_BYTE)
+        unsigned int m_type{0};
+
+        /// @brief the size of a decoded texel, in bytes (e.g. 4 for GL_RGBA/GL_UNSIGNED_BYTE)
+        int m_texelSize{0};
+
+        /// @brief decodes a level into staging memory; called on a worker thread (possibly for several levels of the
+        /// texture at once), so it must be thread-safe, and returns false if the level couldn't be decoded
+        std::function<bool(const bEngineStreamedLevel &)> m_loader{};
+    };
+
+    /// @brief a handle to a texture of a texture streamer
+    struct bEngineStreamedTexture
+    {
+        /// @brief the index of the texture in its streamer
+        std::uint32_t m_index{0xFFFFFFFF};
+
+        /// @brief checks whether the handle refers to a texture
+        /// @return true if the handle is valid
+        const bool get_is_valid() const { return m_index != 0xFFFFFFFF; };
+    };
+
+    /// @brief the settings of a texture streamer
+    struct bEngineTextureStreamerSettings
+    {
+        /// @brief the number of bytes uploaded each frame; at least one level is uploaded each frame regardless, so
+        /// levels larger than the budget still make progress
+        std::ptrdiff_t m_uploadBudget{8 * 1024 * 1024};
+
+        /// @brief the size of the staging (pixel unpack) buffer levels are decoded into, in bytes; bounds the bytes
+        /// being decoded or waiting to be uploaded, and levels larger than it are never streamed
+        std::ptrdiff_t m_stagingSize{64 * 1024 * 1024};
+
+        /// @brief the number of worker threads decoding levels, at least 1
+        unsigned int m_workerCount{2};
+    };
+
+    /// @brief the statistics of a texture streamer
+    struct bEngineTextureStreamerStats
+    {
+        /// @brief the number of textures being streamed
+        unsigned long long m_textureCount{0};
+
+        /// @brief the number of bytes of the levels which have been uploaded
+        unsigned long long m_residentBytes{0};
+
+        /// @brief the number of bytes of storage allocated for the textures' full mip chains (immutable storage is
+        /// allocated up front, so this is the upper bound of their residency)
+        unsigned long long m_storageBytes{0};
+
+        /// @brief the number of levels being decoded by the worker threads
+        unsigned long long m_decodingLevels{0};
+
+        /// @brief the number of decoded levels waiting for upload budget (the upload queue's depth)
+        unsigned long long m_queuedLevels{0};
+
+        /// @brief the number of bytes of the staging buffer in use
+        std::ptrdiff_t m_stagingBytes{0};
+
+        /// @brief the number of levels uploaded
+        unsigned long long m_uploadedLevels{0};
+
+        /// @brief the number of bytes uploaded
+        unsigned long long m_uploadedBytes{0};
+
+        /// @brief the number of levels which failed to decode
+        unsigned long long m_failedLevels{0};
+    };
+
+    /// @brief streams textures' mip levels in the background, so loading a large texture set never stalls the frame
+    ///
+    /// every texture's immutable storage is allocated when it's added, but none of its levels are resident yet. Each
+    /// frame update() hands the next levels to the worker threads, smallest first across every texture, each decoding
+    /// into its own range of a ring of persistently mapped staging memory. Decoded levels are uploaded from the
+    /// staging buffer (bound as GL_PIXEL_UNPACK_BUFFER, so the copy happens on the GPU's timeline) until the frame's
+    /// upload budget is spent, and a fence after each upload frees its staging range once the GPU has read it.
+    ///
+    /// a texture's GL_TEXTURE_BASE_LEVEL is clamped to its finest contiguous resident level, so sampling never touches
+    /// a level which hasn't been uploaded. Levels are streamed down to the level its demand asks for (initially only
+    /// the smallest), set with set_screen_size() from the size it's drawn at; resident levels are never evicted.
+    ///
+    /// the streamer must be created, updated and destroyed on the thread which owns its context (i.e. in a window's
+    /// render function), and registers itself with that context. If the context is destroyed first (i.e. its window
+    /// closes), the streamer is released with it: nothing more is streamed, but the textures stay usable by the other
+    /// windows.
+    class bEngineGLTextureStreamer
+    {
+        // private types
+      private:
+        /// @brief the state of a level of a texture
+        enum class LevelState : unsigned char
+        {
+            /// @brief not resident, and not being streamed
+            Absent,
+
+            /// @brief being decoded, or decoded and waiting to be uploaded
+            Streaming,
+
+            /// @brief uploaded
+            Resident,
+
+            /// @brief failed to decode; the texture streams no finer levels
+            Failed
+        };
+
+        /// @brief a streamed texture
+        struct Texture
+        {
+            /// @brief the texture
+            bEngineGLTexture m_texture{};
+
+            /// @brief the format of the decoded texels
+            unsigned int m_format{0};
+
+            /// @brief the type of the decoded texels
+            unsigned int m_type{0};
+
+            /// @brief the size of a decoded texel, in bytes
+            int m_texelSize{0};
+
+            /// @brief decodes the texture's levels; shared with the worker threads, so it outlives in-flight decodes
+            std::shared_ptr<const std::function<bool(const bEngineStreamedLevel &)>> m_loader{};
+
+            /// @brief the state of each level
+            std::vector<LevelState> m_levels{};
+
+            /// @brief the finest contiguous resident level (the texture's GL_TEXTURE_BASE_LEVEL), or the number of
+            /// levels if none are resident
+            int m_residentLevel{0};
+
+            /// @brief the finest level demand asks for
+            int m_wantedLevel{0};
+
+            /// @brief the finest level which fits in the staging buffer
+            int m_finestLevel{0};
+
+            /// @brief identifies the texture across reuses of its index, so stale decodes are discarded
+            unsigned long long m_serial{0};
+        };
+
+        /// @brief a level's range of the staging buffer, from being decoded to the GPU having read it
+        struct Upload
+        {
+            /// @brief the offset of the range in the staging buffer, in bytes
+            std::ptrdiff_t m_offset{0};
+
+            /// @brief the size of the range, in bytes
+            std::ptrdiff_t m_size{0};
+
+            /// @brief the index of the level's texture
+            std::uint32_t m_texture{0};
+
+            /// @brief the serial of the level's texture
+            unsigned long long m_serial{0};
+
+            /// @brief the level being decoded (with the mapped memory it's written to)
+            bEngineStreamedLevel m_level{};
+
+            /// @brief decodes the level
+            std::shared_ptr<const std::function<bool(const bEngineStreamedLevel &)>> m_loader{};
+
+            /// @brief true if the level was decoded; written by a worker thread before it hands the upload back
+            bool m_isDecoded{false};
+
+            /// @brief the fence placed after the level's upload, or nullptr if it hasn't been uploaded
+            void *m_fence{nullptr};
+
+            /// @brief true once the range can be reused (after the fence signals, or if the level was discarded)
+            bool m_isDone{false};
+        };
+
+        // private data
+      private:
+        /// @brief the context the streamer is registered with, or nullptr once the streamer is released
+        GL::Context *m_context{nullptr};
+
+        /// @brief the settings the streamer was created with
+        const bEngineTextureStreamerSettings m_settings;
+
+        /// @brief the staging (pixel unpack) buffer levels are decoded into
+        bEngineGLBuffer m_staging;
+
+        /// @brief the staging buffer's persistent mapping
+        std::byte *m_mapping{nullptr};
+
+        /// @brief the staging ranges in use, in ring order
+        std::deque<std::unique_ptr<Upload>> m_uploads;
+
+        /// @brief the offset of the first unallocated byte of the staging ring
+        std::ptrdiff_t m_stagingTail{0};
+
+        /// @brief the streamed textures, indexed by their handles
+        std::vector<Texture> m_textures;
+
+        /// @brief the indices of removed textures, which are reused
+        std::vector<std::uint32_t> m_freeTextures;
+
+        /// @brief the serial of the next texture added
+        unsigned long long m_nextSerial{1};
+
+        /// @brief the decoded levels waiting for upload budget
+        std::vector<Upload *> m_ready;
+
+        /// @brief the statistics of the streamer
+        bEngineTextureStreamerStats m_stats{};
+
+        /// @brief guards the worker threads' queues
+        std::mutex m_queueMutex;
+
+        /// @brief signalled when a level is queued for decoding or the worker threads should stop
+        std::condition_variable m_queueCondition;
+
+        /// @brief the levels waiting for a worker thread
+        std::deque<Upload *> m_decodeQueue;
+
+        /// @brief the levels the worker threads have finished (successfully or not)
+        std::deque<Upload *> m_decodedQueue;
+
+        /// @brief true once the worker threads should stop
+        bool m_isStopping{false};
+
+        /// @brief the worker threads; declared last so they start after everything they use is constructed
+        std::vector<std::thread> m_workers;
+
+        // public ctors/dtor
+      public:
+        /// @brief ctor which creates and maps the staging buffer, registers the streamer with the current context and
+        /// starts the worker threads
+        /// @param settings the settings of the streamer
+        bEngineGLTextureStreamer(const bEngineTextureStreamerSettings &settings = {});
+
+        /// @brief the worker threads refer to the streamer by address, so it is not copyable
+        bEngineGLTextureStreamer(const bEngineGLTextureStreamer &) = delete;
+
+        /// @brief the worker threads refer to the streamer by address, so it is not copyable
+        bEngineGLTextureStreamer &operator=(const bEngineGLTextureStreamer &) = delete;
+
+        /// @brief dtor releases the streamer (see release())
+        ~bEngineGLTextureStreamer();
+
+        // public methods/functions
+      public:
+        /// @brief adds a texture, allocating its storage; its smallest level is streamed first
+        /// @param desc the description of the texture
+        /// @return a handle to the texture
+        const bEngineStreamedTexture add_texture(const bEngineStreamedTextureDesc &desc);
+
+        /// @brief removes a texture (deleting it once the GPU is done with it); levels still being decoded are
+        /// discarded
+        /// @param texture the texture, which is invalidated
+        void remove_texture(bEngineStreamedTexture &texture);
+
+        /// @brief sets the level demand asks for from the size a texture is drawn at; the level whose size best matches
+        /// is streamed (and every smaller level before it)
+        /// @param texture the texture
+        /// @param pixels the larger of the width and height the texture covers on screen, in pixels
+        void set_screen_size(const bEngineStreamedTexture texture, const float pixels);
+
+        /// @brief sets the finest level demand asks for
+        /// @param texture the texture
+        /// @param level the finest level to stream (clamped to the texture's levels)
+        void set_wanted_level(const bEngineStreamedTexture texture, const int level);
+
+        /// @brief uploads decoded levels within the budget, updates the textures' base levels, frees the staging
+        /// ranges the GPU has read and hands the next levels to the worker threads; call once a frame, before the
+        /// frame's textures are bound (does nothing once the streamer is released)
+        void update();
+
+        /// @brief gets a streamed texture, for binding
+        /// @param texture the texture
+        /// @return a reference to the texture
+        const bEngineGLTexture &get_texture(const bEngineStreamedTexture texture) const;
+
+        /// @brief gets a texture's finest resident level (its GL_TEXTURE_BASE_LEVEL)
+        /// @param texture the texture
+        /// @return the finest contiguous resident level, or the number of levels if none are resident
+        const int get_resident_level(const bEngineStreamedTexture texture) const;
+
+        /// @brief checks whether any of a texture's levels can be sampled
+        /// @param texture the texture
+        /// @return true if at least the texture's smallest level is resident
+        const bool get_is_resident(const bEngineStreamedTexture texture) const;
+
+        /// @brief gets the streamer's statistics
+        /// @return the streamer's statistics
+        const bEngineTextureStreamerStats get_stats() const;
+
+        /// @brief stops the worker threads (abandoning the levels they haven't decoded), unregisters the streamer from
+        /// its context, deletes the fences and releases the staging buffer, after which nothing more is streamed;
+        /// called automatically by the owning context if it's destroyed first, and otherwise by the dtor (the context
+        /// must be current either way)
+        void release();
+
+        // private methods/functions
+      private:
+        /// @brief gets the size of a level's staging range
+        /// @param texture the level's texture
+        /// @param level the level
+        /// @return the size of the level's rows (padded to 4 bytes) times its height, in bytes
+        const std::ptrdiff_t get_level_size(const Texture &texture, const int level) const;
+
+        /// @brief allocates a range of the staging ring
+        /// @param size the size of the range, in bytes
+        /// @return the offset of the range, or -1 if the ring doesn't have a large enough free range
+        const std::ptrdiff_t allocate_staging(const std::ptrdiff_t size) const;
+
+        /// @brief takes the levels the worker threads have finished, discarding failed and stale ones
+        void collect_decoded();
+
+        /// @brief uploads decoded levels (smallest first) until the frame's budget is spent
+        void upload_ready();
+
+        /// @brief frees the staging ranges at the front of the ring which the GPU has finished reading
+        void retire_staging();
+
+        /// @brief hands the next levels (smallest first) to the worker threads while the staging ring has room
+        void dispatch_decodes();
+
+        /// @brief a worker thread's loop
+        void run();
+    };
+} // namespace bEngine
\ No newline at end of file
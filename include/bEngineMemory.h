@@ -0,0 +1,51 @@
+#pragma once
+
+/// @file bEngineMemory.h
+/// @brief functions for provisioning large blocks of memory in the bEngine library, with control over which NUMA node
+/// the memory lives on and whether it is backed by large (huge) pages
+
+#include <cstddef> // for size_t
+
+namespace bEngine
+{
+    /// @brief functions for NUMA/page aware memory provisioning
+    ///
+    /// on a multi-socket system memory attached to another socket is noticeably slower to access, so large arrays
+    /// should be allocated on the same NUMA node as the threads which process them; pin the worker threads to a node
+    /// with pin_current_thread_to_numa_node() and allocate their data with allocate_pages() on that same node
+    namespace Memory
+    {
+        /// @brief gets the number of NUMA nodes the system has
+        /// @return the number of NUMA nodes, which is 1 on a non-NUMA system
+        const unsigned int get_numa_node_count();
+
+        /// @brief gets the NUMA node of the processor the calling thread is currently running on
+        /// @return the NUMA node of the calling thread's current processor
+        const unsigned int get_current_numa_node();
+
+        /// @brief pins the calling thread to the processors of a NUMA node (e.g. when starting a worker thread)
+        /// @param numaNode the NUMA node to pin the thread to
+        /// @return true if the thread was pinned, false if not (e.g. the node doesn't exist)
+        const bool pin_current_thread_to_numa_node(const unsigned int numaNode);
+
+        /// @brief gets the size of a large (huge) page
+        /// @return the size of a large page in bytes, or 0 if large pages aren't supported
+        const std::size_t get_large_page_size();
+
+        /// @brief allocates (zeroed, page aligned) memory directly from the OS, intended for large, long-lived arenas
+        /// and arrays rather than general purpose allocations
+        ///
+        /// large pages fall back to regular pages (with a warning) if they can't be used; on Windows they require the
+        /// user to be granted the "Lock pages in memory" privilege
+        /// @param size the number of bytes to allocate
+        /// @param numaNode the NUMA node the memory should be physically allocated on, or -1 for no preference
+        /// @param useLargePages true to back the memory with large pages, which reduces TLB misses for large arrays
+        /// @return a pointer to the memory, or nullptr if the allocation failed
+        void *const allocate_pages(const std::size_t size, const int numaNode = -1, const bool useLargePages = false);
+
+        /// @brief frees memory which was allocated with allocate_pages()
+        /// @param memory the memory to be freed (nullptr is ignored)
+        /// @param size the size which was passed to allocate_pages()
+        void free_pages(void *const memory, const std::size_t size);
+    } // namespace Memory
+} // namespace bEngine
\ No newline at end of file
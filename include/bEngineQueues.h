@@ -0,0 +1,439 @@
+#pragma once
+
+/// @file bEngineQueues.h
+/// @brief bounded lock-free queues for passing data between threads (input from the platform poll thread, audio
+/// commands, logging, job submission, etc.)
+
+#include <atomic>      // for the (lock-free) head/tail indices and per-cell sequence numbers
+#include <bit>         // for bit_ceil, capacities are always rounded up to a power of two
+#include <cstddef>     // for size_t
+#include <new>         // for aligned operator new/delete and placement new
+#include <utility>     // for move/forward
+
+namespace bEngine
+{
+    /// @brief implementation details shared by the engine's (header-only) containers; not intended for use by the user
+    namespace Internal
+    {
+        /// @brief the size of a cache line, used to keep data written by different threads from false sharing
+        ///
+        /// 64 bytes is correct for every platform the engine targets; std::hardware_destructive_interference_size is
+        /// not used since it is allowed to differ between translation units/compiler flags
+        inline constexpr std::size_t s_cacheLineSize{64};
+
+        /// @brief uninitialized, suitably aligned storage for a single queue element
+        /// @tparam T the type of the element
+        template <typename T>
+        struct alignas(T) QueueStorage
+        {
+            /// @brief the raw bytes of the element
+            std::byte m_bytes[sizeof(T)];
+
+            /// @brief gets the element living in the storage
+            /// @return a pointer to the element
+            T *get() { return std::launder(reinterpret_cast<T *>(m_bytes)); }
+        };
+    } // namespace Internal
+
+    /// @brief a bounded, lock-free, single-producer/single-consumer ring buffer
+    ///
+    /// exactly one thread may push and exactly one (other) thread may pop at any given time. The producer and consumer
+    /// indices live on separate cache lines, each alongside its side's cached copy of the other side's index, so the
+    /// other side's cache line is only read when the queue looks full (producer) or empty (consumer).
+    /// @tparam T the type of the elements, which must be move constructible
+    template <typename T>
+    class bEngineSPSCQueue
+    {
+        // private data
+      private:
+        /// @brief the number of elements the queue can hold (always a power of two)
+        const std::size_t m_capacity;
+
+        /// @brief capacity - 1, used to wrap the (ever increasing) indices into the buffer
+        const std::size_t m_mask;
+
+        /// @brief the element storage
+        Internal::QueueStorage<T> *const m_buffer;
+
+        /// @brief the index of the next element to be pushed; written by the producer only
+        alignas(Internal::s_cacheLineSize) std::atomic<std::size_t> m_tail{0};
+
+        /// @brief the producer's (possibly stale) copy of m_head
+        std::size_t m_cachedHead{0};
+
+        /// @brief the index of the next element to be popped; written by the consumer only
+        alignas(Internal::s_cacheLineSize) std::atomic<std::size_t> m_head{0};
+
+        /// @brief the consumer's (possibly stale) copy of m_tail
+        std::size_t m_cachedTail{0};
+
+        /// @brief keeps the consumer's data from sharing a cache line with whatever follows the queue
+        std::byte m_padding[Internal::s_cacheLineSize - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+
+        // public ctors/dtor
+      public:
+        /// @brief default ctor is insufficient
+        bEngineSPSCQueue() = delete;
+
+        /// @brief ctor which allocates room for (at least) the given number of elements
+        /// @param capacity the minimum number of elements the queue must hold; rounded up to a power of two
+        explicit bEngineSPSCQueue(const std::size_t capacity)
+            : m_capacity{std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)},
+              m_mask{m_capacity - 1},
+              m_buffer{static_cast<Internal::QueueStorage<T> *>(::operator new(
+                  m_capacity * sizeof(Internal::QueueStorage<T>),
+                  std::align_val_t{alignof(Internal::QueueStorage<T>)}))} { };
+
+        /// @brief queues are tied to the threads using them, so they cannot be copied
+        bEngineSPSCQueue(const bEngineSPSCQueue &) = delete;
+
+        /// @brief queues are tied to the threads using them, so they cannot be copied
+        bEngineSPSCQueue &operator=(const bEngineSPSCQueue &) = delete;
+
+        /// @brief dtor destroys any elements which were never popped and frees the buffer
+        ///
+        /// must not be called while either thread is still using the queue
+        ~bEngineSPSCQueue()
+        {
+            for (auto i{m_head.load()}; i != m_tail.load(); ++i)
+                m_buffer[i & m_mask].get()->~T();
+            ::operator delete(m_buffer, std::align_val_t{alignof(Internal::QueueStorage<T>)});
+        };
+
+        // public methods/functions
+      public:
+        /// @brief gets the number of elements the queue can hold
+        /// @return the number of elements the queue can hold
+        std::size_t capacity() const { return m_capacity; }
+
+        /// @brief gets the (approximate, if called while the queue is in use) number of elements in the queue
+        /// @return the number of elements in the queue
+        std::size_t size_approx() const
+        {
+            return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+        }
+
+        /// @brief constructs an element at the back of the queue (producer only)
+        /// @tparam Args the types of the element's ctor arguments
+        /// @param args the element's ctor arguments
+        /// @return true if the element was pushed, false if the queue was full
+        template <typename... Args>
+        bool try_emplace(Args &&...args)
+        {
+            const auto tail{m_tail.load(std::memory_order_relaxed)};
+            if (tail - m_cachedHead == m_capacity)
+            {
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+                if (tail - m_cachedHead == m_capacity)
+                    return false;
+            }
+
+            ::new (m_buffer[tail & m_mask].m_bytes) T(std::forward<Args>(args)...);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief pushes a copy of an element to the back of the queue (producer only)
+        /// @param value the element to push
+        /// @return true if the element was pushed, false if the queue was full
+        bool try_push(const T &value) { return try_emplace(value); }
+
+        /// @brief moves an element to the back of the queue (producer only)
+        /// @param value the element to push; only moved from if it was pushed
+        /// @return true if the element was pushed, false if the queue was full
+        bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+        /// @brief moves as many elements as will fit from a range to the back of the queue, publishing them all at once
+        /// (producer only)
+        /// @tparam InputIt the type of the iterator to the elements
+        /// @param first an iterator to the first element to push
+        /// @param count the number of elements available in the range
+        /// @return the number of elements pushed (the first N elements of the range were moved from)
+        template <typename InputIt>
+        std::size_t push_batch(InputIt first, const std::size_t count)
+        {
+            const auto tail{m_tail.load(std::memory_order_relaxed)};
+            if (m_capacity - (tail - m_cachedHead) < count)
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+
+            const auto free{m_capacity - (tail - m_cachedHead)};
+            const auto pushed{count < free ? count : free};
+            for (std::size_t i{0}; i < pushed; ++i, ++first)
+                ::new (m_buffer[(tail + i) & m_mask].m_bytes) T(std::move(*first));
+
+            m_tail.store(tail + pushed, std::memory_order_release);
+            return pushed;
+        }
+
+        /// @brief pops the element at the front of the queue (consumer only)
+        /// @param value the element which receives the popped element
+        /// @return true if an element was popped, false if the queue was empty
+        bool try_pop(T &value)
+        {
+            const auto head{m_head.load(std::memory_order_relaxed)};
+            if (head == m_cachedTail)
+            {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head == m_cachedTail)
+                    return false;
+            }
+
+            auto *const element{m_buffer[head & m_mask].get()};
+            value = std::move(*element);
+            element->~T();
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief pops up to the given number of elements from the front of the queue, releasing their slots all at
+        /// once (consumer only)
+        /// @tparam OutputIt the type of the iterator which receives the elements
+        /// @param out an iterator which the popped elements are assigned through
+        /// @param maxCount the maximum number of elements to pop
+        /// @return the number of elements popped
+        template <typename OutputIt>
+        std::size_t pop_batch(OutputIt out, const std::size_t maxCount)
+        {
+            const auto head{m_head.load(std::memory_order_relaxed)};
+            if (m_cachedTail - head < maxCount)
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+            const auto available{m_cachedTail - head};
+            const auto popped{maxCount < available ? maxCount : available};
+            for (std::size_t i{0}; i < popped; ++i, ++out)
+            {
+                auto *const element{m_buffer[(head + i) & m_mask].get()};
+                *out = std::move(*element);
+                element->~T();
+            }
+
+            m_head.store(head + popped, std::memory_order_release);
+            return popped;
+        }
+    };
+
+    /// @brief a bounded, lock-free, multi-producer/multi-consumer queue (after Dmitry Vyukov's bounded MPMC queue)
+    ///
+    /// every cell carries a sequence number which tells producers/consumers whether the cell is ready for them in the
+    /// current "lap" around the buffer, so a push or pop is a single CAS on the shared index followed by an
+    /// uncontended write to the claimed cell. Batch operations claim a run of ready cells with one CAS.
+    /// @tparam T the type of the elements, which must be move constructible
+    template <typename T>
+    class bEngineMPMCQueue
+    {
+        // private types
+      private:
+        /// @brief a single cell of the queue, padded to a cache line so neighbouring cells don't false share
+        struct alignas(Internal::s_cacheLineSize) Cell
+        {
+            /// @brief the cell's sequence number; equal to the position when the cell is free for a producer and to
+            /// position + 1 when it holds an element for a consumer
+            std::atomic<std::size_t> m_sequence;
+
+            /// @brief the element storage
+            Internal::QueueStorage<T> m_storage;
+        };
+
+        // private data
+      private:
+        /// @brief the number of elements the queue can hold (always a power of two)
+        const std::size_t m_capacity;
+
+        /// @brief capacity - 1, used to wrap the (ever increasing) positions into the buffer
+        const std::size_t m_mask;
+
+        /// @brief the cells of the queue
+        Cell *const m_cells;
+
+        /// @brief the position of the next cell to be claimed by a producer
+        alignas(Internal::s_cacheLineSize) std::atomic<std::size_t> m_enqueuePos{0};
+
+        /// @brief the position of the next cell to be claimed by a consumer
+        alignas(Internal::s_cacheLineSize) std::atomic<std::size_t> m_dequeuePos{0};
+
+        /// @brief keeps the dequeue position from sharing a cache line with whatever follows the queue
+        std::byte m_padding[Internal::s_cacheLineSize - sizeof(std::atomic<std::size_t>)];
+
+        // private methods/functions
+      private:
+        /// @brief claims up to the given number of consecutive cells which are ready for this side of the queue
+        /// @param pos the shared position to claim from (enqueue or dequeue position)
+        /// @param readyOffset 0 when claiming cells to push into, 1 when claiming cells to pop from
+        /// @param maxCount the maximum number of cells to claim
+        /// @param first receives the position of the first claimed cell
+        /// @return the number of cells claimed (0 if the queue is full/empty for this side)
+        std::size_t claim(
+            std::atomic<std::size_t> &pos,
+            const std::size_t         readyOffset,
+            const std::size_t         maxCount,
+            std::size_t              &first)
+        {
+            auto current{pos.load(std::memory_order_relaxed)};
+            while (true)
+            {
+                // count the run of cells which are ready for this lap
+                std::size_t ready{0};
+                while (ready < maxCount)
+                {
+                    const auto cellPos{current + ready};
+                    const auto sequence{m_cells[cellPos & m_mask].m_sequence.load(std::memory_order_acquire)};
+                    if (sequence != cellPos + readyOffset)
+                        break;
+                    ++ready;
+                }
+
+                if (ready == 0)
+                {
+                    // the first cell isn't ready: either another thread claimed it (and moved the position along, so
+                    // try again) or the queue really is full/empty
+                    const auto sequence{m_cells[current & m_mask].m_sequence.load(std::memory_order_acquire)};
+                    const auto diff{static_cast<std::ptrdiff_t>(sequence - (current + readyOffset))};
+                    if (diff < 0)
+                        return 0;
+                    current = pos.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (pos.compare_exchange_weak(current, current + ready, std::memory_order_relaxed))
+                {
+                    first = current;
+                    return ready;
+                }
+            }
+        }
+
+        // public ctors/dtor
+      public:
+        /// @brief default ctor is insufficient
+        bEngineMPMCQueue() = delete;
+
+        /// @brief ctor which allocates room for (at least) the given number of elements
+        /// @param capacity the minimum number of elements the queue must hold; rounded up to a power of two
+        explicit bEngineMPMCQueue(const std::size_t capacity)
+            : m_capacity{std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)},
+              m_mask{m_capacity - 1},
+              m_cells{static_cast<Cell *>(
+                  ::operator new(m_capacity * sizeof(Cell), std::align_val_t{alignof(Cell)}))}
+        {
+            for (std::size_t i{0}; i < m_capacity; ++i)
+                ::new (&m_cells[i].m_sequence) std::atomic<std::size_t>{i};
+        };
+
+        /// @brief queues are shared by the threads using them, so they cannot be copied
+        bEngineMPMCQueue(const bEngineMPMCQueue &) = delete;
+
+        /// @brief queues are shared by the threads using them, so they cannot be copied
+        bEngineMPMCQueue &operator=(const bEngineMPMCQueue &) = delete;
+
+        /// @brief dtor destroys any elements which were never popped and frees the cells
+        ///
+        /// must not be called while any thread is still using the queue
+        ~bEngineMPMCQueue()
+        {
+            for (auto i{m_dequeuePos.load()}; i != m_enqueuePos.load(); ++i)
+                m_cells[i & m_mask].m_storage.get()->~T();
+            ::operator delete(m_cells, std::align_val_t{alignof(Cell)});
+        };
+
+        // public methods/functions
+      public:
+        /// @brief gets the number of elements the queue can hold
+        /// @return the number of elements the queue can hold
+        std::size_t capacity() const { return m_capacity; }
+
+        /// @brief gets the (approximate, if called while the queue is in use) number of elements in the queue
+        /// @return the number of elements in the queue
+        std::size_t size_approx() const
+        {
+            const auto enqueued{m_enqueuePos.load(std::memory_order_acquire)};
+            const auto dequeued{m_dequeuePos.load(std::memory_order_acquire)};
+            return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+
+        /// @brief constructs an element at the back of the queue (any thread)
+        /// @tparam Args the types of the element's ctor arguments
+        /// @param args the element's ctor arguments
+        /// @return true if the element was pushed, false if the queue was full
+        template <typename... Args>
+        bool try_emplace(Args &&...args)
+        {
+            std::size_t pos{0};
+            if (!claim(m_enqueuePos, 0, 1, pos))
+                return false;
+
+            auto &cell{m_cells[pos & m_mask]};
+            ::new (cell.m_storage.m_bytes) T(std::forward<Args>(args)...);
+            cell.m_sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief pushes a copy of an element to the back of the queue (any thread)
+        /// @param value the element to push
+        /// @return true if the element was pushed, false if the queue was full
+        bool try_push(const T &value) { return try_emplace(value); }
+
+        /// @brief moves an element to the back of the queue (any thread)
+        /// @param value the element to push; only moved from if it was pushed
+        /// @return true if the element was pushed, false if the queue was full
+        bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+        /// @brief moves as many elements as will fit from a range to the back of the queue with a single claim of the
+        /// shared position (any thread); the pushed elements are contiguous in the queue
+        /// @tparam InputIt the type of the iterator to the elements
+        /// @param first an iterator to the first element to push
+        /// @param count the number of elements available in the range
+        /// @return the number of elements pushed (the first N elements of the range were moved from)
+        template <typename InputIt>
+        std::size_t push_batch(InputIt first, const std::size_t count)
+        {
+            std::size_t pos{0};
+            const auto  pushed{count ? claim(m_enqueuePos, 0, count, pos) : 0};
+            for (std::size_t i{0}; i < pushed; ++i, ++first)
+            {
+                auto &cell{m_cells[(pos + i) & m_mask]};
+                ::new (cell.m_storage.m_bytes) T(std::move(*first));
+                cell.m_sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            return pushed;
+        }
+
+        /// @brief pops the element at the front of the queue (any thread)
+        /// @param value the element which receives the popped element
+        /// @return true if an element was popped, false if the queue was empty
+        bool try_pop(T &value)
+        {
+            std::size_t pos{0};
+            if (!claim(m_dequeuePos, 1, 1, pos))
+                return false;
+
+            auto       &cell{m_cells[pos & m_mask]};
+            auto *const element{cell.m_storage.get()};
+            value = std::move(*element);
+            element->~T();
+            cell.m_sequence.store(pos + m_capacity, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief pops up to the given number of elements from the front of the queue with a single claim of the shared
+        /// position (any thread)
+        /// @tparam OutputIt the type of the iterator which receives the elements
+        /// @param out an iterator which the popped elements are assigned through
+        /// @param maxCount the maximum number of elements to pop
+        /// @return the number of elements popped
+        template <typename OutputIt>
+        std::size_t pop_batch(OutputIt out, const std::size_t maxCount)
+        {
+            std::size_t pos{0};
+            const auto  popped{maxCount ? claim(m_dequeuePos, 1, maxCount, pos) : 0};
+            for (std::size_t i{0}; i < popped; ++i, ++out)
+            {
+                auto       &cell{m_cells[(pos + i) & m_mask]};
+                auto *const element{cell.m_storage.get()};
+                *out = std::move(*element);
+                element->~T();
+                cell.m_sequence.store(pos + i + m_capacity, std::memory_order_release);
+            }
+            return popped;
+        }
+    };
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,401 @@
+#pragma once
+
+/// @file bEngineRenderGraph.h
+/// @brief the interface for frame render graphs in the bEngine library: passes declare the (virtual) textures they
+/// read and write, and the graph culls the passes nothing depends on, orders the rest and aliases their transient
+/// textures into a shared pool
+
+#include "bEngineCommandBuffer.h" // for recording the passes
+#include "bEngineGL.h"            // for the pooled textures and the passes' framebuffers
+
+#include <cstdint>    // for fixed width integers
+#include <filesystem> // for where GraphViz dumps are written
+#include <functional> // for the passes' setup and execute callbacks
+#include <string>     // for the names of passes/textures and GraphViz dumps
+#include <vector>     // for the passes, resources and pool
+
+namespace bEngine
+{
+    // fwd declaration of the graph, which builders and contexts refer to
+    class bEngineRenderGraph;
+
+    /// @brief the description of a transient texture (always a 2D texture); transient textures only share pooled
+    /// textures with identical descriptions
+    struct bEngineRenderGraphTextureDesc
+    {
+        /// @brief the width of the texture, in texels
+        int m_width{0};
+
+        /// @brief the height of the texture, in texels
+        int m_height{0};
+
+        /// @brief the sized internal format of the texture (e.g. GL_RGBA16F or GL_DEPTH24_STENCIL8)
+        unsigned int m_format{0};
+
+        /// @brief the number of mip levels of the texture
+        int m_levels{1};
+
+        /// @brief compares two descriptions
+        /// @param other the description to compare to
+        /// @return true if the descriptions are identical
+        bool operator==(const bEngineRenderGraphTextureDesc &other) const = default;
+    };
+
+    /// @brief a handle to a version of a virtual texture of a render graph; every write creates a new version, so a
+    /// pass reading a version depends on the pass which wrote it
+    struct bEngineRenderGraphResource
+    {
+        /// @brief the index of the version in its graph
+        std::uint32_t m_index{0xFFFFFFFF};
+
+        /// @brief checks whether the handle refers to a version
+        /// @return true if the handle is valid
+        const bool get_is_valid() const { return m_index != 0xFFFFFFFF; };
+    };
+
+    /// @brief declares a pass' resources, while the pass is being added
+    class bEngineRenderGraphBuilder
+    {
+        // private data
+      private:
+        /// @brief the graph the pass is being added to
+        bEngineRenderGraph &m_graph;
+
+        /// @brief the index of the pass
+        const std::uint32_t m_pass{0};
+
+        // public ctors
+      public:
+        /// @brief ctor which builds a pass of a graph
+        /// @param graph the graph the pass is being added to
+        /// @param pass the index of the pass
+        bEngineRenderGraphBuilder(bEngineRenderGraph &graph, const std::uint32_t pass);
+
+        // public methods/functions
+      public:
+        /// @brief creates a transient texture, which only exists while the graph executes; its contents are undefined
+        /// until a pass writes it
+        /// @param name the name of the texture (for GraphViz dumps)
+        /// @param desc the description of the texture
+        /// @return the texture's first version, which has to be written before it's read
+        const bEngineRenderGraphResource create_texture(
+            const std::string                   &name,
+            const bEngineRenderGraphTextureDesc &desc);
+
+        /// @brief declares that the pass reads a version of a texture, so the pass which wrote it runs first
+        /// @param resource the version read
+        /// @return the version read
+        const bEngineRenderGraphResource read(const bEngineRenderGraphResource resource);
+
+        /// @brief declares that the pass writes a texture (it's attached to the pass' framebuffer)
+        /// @param resource the version the pass writes over; passes which read it run first
+        /// @return the new version the pass writes, which later passes read
+        const bEngineRenderGraphResource write(const bEngineRenderGraphResource resource);
+
+        /// @brief declares that the pass has effects outside of the graph (e.g. drawing to the window), so it's never
+        /// culled
+        void set_has_side_effects();
+    };
+
+    /// @brief the resources of a pass, while it executes
+    class bEngineRenderGraphContext
+    {
+        // private data
+      private:
+        /// @brief the graph which is executing
+        const bEngineRenderGraph &m_graph;
+
+        /// @brief the index of the pass
+        const std::uint32_t m_pass{0};
+
+        /// @brief the position of the pass in the graph's execution order
+        const std::uint8_t m_order{0};
+
+        // public ctors
+      public:
+        /// @brief ctor which executes a pass of a graph
+        /// @param graph the graph which is executing
+        /// @param pass the index of the pass
+        /// @param order the position of the pass in the graph's execution order
+        bEngineRenderGraphContext(const bEngineRenderGraph &graph, const std::uint32_t pass, const std::uint8_t order);
+
+        // public methods/functions
+      public:
+        /// @brief gets the texture a version of a virtual texture is backed by
+        /// @param resource the version, which the pass must have read or written
+        /// @return a reference to the (pooled or imported) texture
+        const bEngineGLTexture &get_texture(const bEngineRenderGraphResource resource) const;
+
+        /// @brief gets the framebuffer of the pass: every texture it writes, depth/stencil formats attached as its
+        /// depth/stencil and the rest as its color attachments in the order they were written
+        /// @return the pass' framebuffer, or nullptr (the window) if the pass doesn't write any textures
+        const bEngineGLFramebuffer *get_framebuffer() const;
+
+        /// @brief gets the viewport covering the pass' framebuffer, which its draws should use since transient
+        /// textures needn't be the size of the window
+        /// @return the size of the (smallest) texture the pass writes, or a zero size (the render's default viewport)
+        /// if the pass doesn't write any textures
+        const bEngineViewport get_viewport() const;
+
+        /// @brief makes a sort key which orders a command within the pass; the graph's layer and the pass' position
+        /// take the layer and pass bits, so commands execute in the graph's order whatever else their keys hold
+        /// @param shader an ID of the shader
+        /// @param material an ID of the material
+        /// @param depth the quantized depth of the draw
+        /// @return the sort key
+        const std::uint64_t get_sort_key(
+            const std::uint16_t shader   = 0,
+            const std::uint16_t material = 0,
+            const std::uint16_t depth    = 0) const;
+    };
+
+    /// @brief the statistics of a render graph's last compilation
+    struct bEngineRenderGraphStats
+    {
+        /// @brief the number of passes added
+        std::uint32_t m_passCount{0};
+
+        /// @brief the number of passes culled because nothing depended on them
+        std::uint32_t m_culledPassCount{0};
+
+        /// @brief the number of transient textures used by the passes which weren't culled
+        std::uint32_t m_transientTextureCount{0};
+
+        /// @brief the number of pooled textures the transient textures were aliased into
+        std::uint32_t m_pooledTextureCount{0};
+
+        /// @brief the (estimated) size of the transient textures, were each given its own texture, in bytes
+        std::uint64_t m_transientBytes{0};
+
+        /// @brief the (estimated) size of the pooled textures used, in bytes
+        std::uint64_t m_pooledBytes{0};
+
+        /// @brief the number of pooled textures created
+        std::uint32_t m_createdTextureCount{0};
+    };
+
+    /// @brief a frame's passes and the textures they read and write
+    ///
+    /// each frame the graph is reset, passes are added (each declaring its resources in a setup callback), and the
+    /// graph is compiled and executed. Compiling culls every pass whose outputs are never read (unless it has side
+    /// effects or writes an imported texture), then computes the lifetime of each transient texture from the first
+    /// to the last surviving pass which uses it. Transient textures whose lifetimes don't overlap share a pooled
+    /// texture if their descriptions match; GL can't alias memory between different formats or sizes, so aliasing is
+    /// by description. Pooled textures persist between frames and are released once unused for a few frames.
+    ///
+    /// passes execute in the order they were added, and record their commands with the sort keys of their context
+    /// (see bEngineRenderGraphContext::get_sort_key()), so at most 256 passes can survive culling. Their draws target
+    /// the context's framebuffer and viewport (see bEngineRenderGraphContext::get_viewport()), so transient textures
+    /// can be any size. A graph must be created and used on the thread which owns its context.
+    class bEngineRenderGraph
+    {
+        // friends
+      private:
+        friend class bEngineRenderGraphBuilder;
+        friend class bEngineRenderGraphContext;
+
+        // public types
+      public:
+        /// @brief the callback a pass declares its resources in, as it's added
+        using setup_fn = std::function<void(bEngineRenderGraphBuilder &builder)>;
+
+        /// @brief the callback a pass records its commands in, as the graph executes
+        using execute_fn =
+            std::function<void(const bEngineRenderGraphContext &context, bEngineCommandBuffer &commands)>;
+
+        // private types
+      private:
+        /// @brief a pass of the graph
+        struct Pass
+        {
+            /// @brief the name of the pass
+            std::string m_name;
+
+            /// @brief the callback the pass records its commands in
+            execute_fn m_execute;
+
+            /// @brief the versions the pass reads
+            std::vector<std::uint32_t> m_reads{};
+
+            /// @brief the versions the pass writes
+            std::vector<std::uint32_t> m_writes{};
+
+            /// @brief true if the pass is never culled
+            bool m_hasSideEffects{false};
+
+            /// @brief the number of written versions which are read (plus one if the pass has side effects)
+            std::uint32_t m_refCount{0};
+
+            /// @brief true if the pass was culled
+            bool m_isCulled{false};
+        };
+
+        /// @brief a virtual texture of the graph
+        struct Texture
+        {
+            /// @brief the name of the texture
+            std::string m_name;
+
+            /// @brief the description of the texture
+            bEngineRenderGraphTextureDesc m_desc{};
+
+            /// @brief the imported texture, or nullptr if the texture is transient
+            const bEngineGLTexture *m_imported{nullptr};
+
+            /// @brief the pooled texture backing the transient texture, or -1 if it isn't used
+            int m_pooled{-1};
+
+            /// @brief the first position in the execution order which uses the texture, or -1 if none does
+            int m_firstUse{-1};
+
+            /// @brief the last position in the execution order which uses the texture, or -1 if none does
+            int m_lastUse{-1};
+        };
+
+        /// @brief a version of a virtual texture
+        struct Version
+        {
+            /// @brief the index of the texture
+            std::uint32_t m_texture{0};
+
+            /// @brief the version number (0 until the texture is first written)
+            std::uint32_t m_version{0};
+
+            /// @brief the index of the pass which wrote the version, or -1 for the first version
+            int m_producer{-1};
+
+            /// @brief the number of passes which read the version (plus one for versions of imported textures)
+            std::uint32_t m_refCount{0};
+        };
+
+        /// @brief a texture of the pool
+        struct PooledTexture
+        {
+            /// @brief the description of the texture
+            bEngineRenderGraphTextureDesc m_desc{};
+
+            /// @brief the texture
+            bEngineGLTexture m_texture;
+
+            /// @brief the last frame the texture was used in
+            unsigned long long m_lastUsedFrame{0};
+
+            /// @brief the last position in the current frame's execution order which uses the texture
+            int m_busyUntil{-1};
+        };
+
+        /// @brief the framebuffer of a position in the execution order, kept between frames
+        struct PassFramebuffer
+        {
+            /// @brief the framebuffer
+            bEngineGLFramebuffer m_framebuffer;
+
+            /// @brief the GL names of the textures attached to the framebuffer, in attachment order (the framebuffers
+            /// are dropped whenever pooled textures are released, so a recycled name can't match a stale framebuffer)
+            std::vector<unsigned int> m_attachments;
+        };
+
+        // public static data
+      public:
+        /// @brief the number of frames a pooled texture stays in the pool unused before it's released
+        static constexpr unsigned long long s_poolFrames{3};
+
+        // private data
+      private:
+        /// @brief the layer the graph's commands are recorded on
+        const std::uint8_t m_layer{0};
+
+        /// @brief the frame's passes, in the order they were added
+        std::vector<Pass> m_passes;
+
+        /// @brief the frame's virtual textures
+        std::vector<Texture> m_textures;
+
+        /// @brief the versions of the frame's virtual textures
+        std::vector<Version> m_versions;
+
+        /// @brief the passes which survived culling, in execution order
+        std::vector<std::uint32_t> m_executionOrder;
+
+        /// @brief the pool transient textures are aliased into
+        std::vector<PooledTexture> m_pool;
+
+        /// @brief the framebuffer of each position in the execution order
+        std::vector<PassFramebuffer> m_framebuffers;
+
+        /// @brief the current frame
+        unsigned long long m_frame{0};
+
+        /// @brief true once the frame's graph has been compiled
+        bool m_isCompiled{false};
+
+        /// @brief the file compiled graphs are dumped to, or empty to not dump them
+        std::filesystem::path m_dumpPath{};
+
+        /// @brief the last GraphViz dump written
+        std::string m_lastDump;
+
+        /// @brief the statistics of the last compilation
+        bEngineRenderGraphStats m_stats{};
+
+        // public ctors
+      public:
+        /// @brief ctor which creates an empty graph
+        /// @param layer the layer (of the sort key) the graph's commands are recorded on
+        explicit bEngineRenderGraph(const std::uint8_t layer = 0);
+
+        // public methods/functions
+      public:
+        /// @brief forgets the frame's passes and textures (the pool keeps its textures)
+        void reset();
+
+        /// @brief imports a texture from outside the graph; imported textures are never aliased, and passes writing
+        /// them are never culled
+        /// @param name the name of the texture (for GraphViz dumps)
+        /// @param texture the texture, which must outlive the graph's execution
+        /// @return the texture's first version (its current contents)
+        const bEngineRenderGraphResource import_texture(const std::string &name, const bEngineGLTexture &texture);
+
+        /// @brief adds a pass, calling its setup callback immediately
+        /// @param name the name of the pass (for GraphViz dumps)
+        /// @param setup the callback the pass declares its resources in
+        /// @param execute the callback the pass records its commands in
+        void add_pass(const std::string &name, const setup_fn &setup, execute_fn execute);
+
+        /// @brief culls the passes nothing depends on, computes the transient textures' lifetimes and aliases them into
+        /// the pool (creating pooled textures if need be), then dumps the graph if it differs from the last dump
+        void compile();
+
+        /// @brief executes the compiled graph's passes, which record their commands
+        /// @param commands the command buffer the passes record into
+        void execute(bEngineCommandBuffer &commands);
+
+        /// @brief sets the file compiled graphs are dumped to (in GraphViz's DOT format) whenever they change
+        /// @param path the file to dump to, or empty to not dump compiled graphs
+        void set_dump_path(const std::filesystem::path &path);
+
+        /// @brief describes the frame's graph in GraphViz's DOT format: passes (culled ones dashed) and the versions
+        /// of textures they read and write, labeled with the pooled texture each transient texture was aliased into
+        /// @return the DOT description of the graph
+        const std::string get_graphviz() const;
+
+        /// @brief gets the statistics of the last compilation
+        /// @return the statistics of the last compilation
+        const bEngineRenderGraphStats get_stats() const;
+
+        // private methods/functions
+      private:
+        /// @brief adds a version of a texture
+        /// @param texture the index of the texture
+        /// @param producer the index of the pass which writes the version, or -1 for the first version
+        /// @return the new version
+        const bEngineRenderGraphResource add_version(const std::uint32_t texture, const int producer);
+
+        /// @brief aliases the transient textures into the pool, in execution order
+        void alias_textures();
+
+        /// @brief attaches the textures a position in the execution order writes to its framebuffer, if they changed
+        /// @param order the position in the execution order
+        void update_framebuffer(const std::size_t order);
+    };
+} // namespace bEngine
\ No newline at end of file
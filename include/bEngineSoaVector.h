@@ -0,0 +1,668 @@
+#pragma once
+
+/// @file bEngineSoaVector.h
+/// @brief a structure-of-arrays container which stores each field of its elements in its own SIMD-friendly array
+
+#include <algorithm>   // for fill/copy when growing and bulk-erasing
+#include <cstddef>     // for size_t/ptrdiff_t
+#include <cstring>     // for memcpy/memmove of the (trivially copyable) field arrays
+#include <iterator>    // for the iterator tags
+#include <new>         // for aligned operator new/delete
+#include <numeric>     // for lcm when computing the padding granularity
+#include <tuple>       // for the per-field pointers and the proxy references
+#include <type_traits> // for ensuring every field is trivially copyable
+#include <utility>     // for index_sequence/move/swap
+
+namespace bEngine
+{
+    /// @brief a vector of elements made up of the fields Ts..., stored as one array per field (structure of arrays)
+    ///
+    /// every field array starts on a 64 byte boundary and the capacity is always a multiple of a granularity which
+    /// makes every array a whole number of 64 bytes long; additionally every element between size() and
+    /// padded_size() is kept value initialized. Together this means a kernel can walk padded_size() elements with
+    /// full-width (aligned) SIMD loads/stores on every field and never needs a scalar remainder loop.
+    ///
+    /// elements are accessed through proxy references (a std::tuple of references to each field) so structured
+    /// bindings work, e.g. `for (auto [position, velocity] : particles)`. zip() returns a view over any subset of the
+    /// fields for kernels which only touch some of them.
+    /// @tparam Ts the types of the fields, which must all be trivially copyable (e.g. glm vectors, floats, ints)
+    template <typename... Ts>
+    class bEngineSoaVector
+    {
+        static_assert(sizeof...(Ts) > 0, "a bEngineSoaVector needs at least one field");
+        static_assert(
+            (std::is_trivially_copyable_v<Ts> && ...),
+            "every bEngineSoaVector field must be trivially copyable");
+
+        // public types/static data
+      public:
+        /// @brief the type of a (copied) element
+        using value_type = std::tuple<Ts...>;
+
+        /// @brief the proxy reference to an element
+        using reference = std::tuple<Ts &...>;
+
+        /// @brief the proxy const reference to an element
+        using const_reference = std::tuple<const Ts &...>;
+
+        /// @brief the type of the field with the given index
+        /// @tparam I the index of the field
+        template <std::size_t I>
+        using field_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+        /// @brief the alignment of every field array (a cache line, and the widest SIMD register the engine targets)
+        static constexpr std::size_t s_alignment{64};
+
+        /// @brief the number of elements the capacity (and padded_size()) is always a multiple of; chosen so every
+        /// field array is a whole number of s_alignment bytes long
+        static constexpr std::size_t s_granularity{[] {
+            std::size_t granularity{1};
+            ((granularity = std::lcm(granularity, s_alignment / std::gcd(s_alignment, sizeof(Ts)))), ...);
+            return granularity;
+        }()};
+
+        // public iterators/views
+      public:
+        /// @brief a random access iterator over a subset of the fields, which dereferences to a proxy (tuple of
+        /// references)
+        /// @tparam Fields the (possibly const) types of the fields being iterated
+        template <typename... Fields>
+        class Iterator
+        {
+            // public types
+          public:
+            /// @brief the iterator category; the proxy reference means this can only claim to be an input iterator,
+            /// although every random access operation is supported
+            using iterator_category = std::input_iterator_tag;
+
+            /// @brief the value type
+            using value_type = std::tuple<std::remove_const_t<Fields>...>;
+
+            /// @brief the difference type
+            using difference_type = std::ptrdiff_t;
+
+            /// @brief the (proxy) reference type
+            using reference = std::tuple<Fields &...>;
+
+            // private data
+          private:
+            /// @brief the field arrays
+            std::tuple<Fields *...> m_arrays{};
+
+            /// @brief the index of the current element
+            std::size_t m_index{0};
+
+            // public ctors/operators
+          public:
+            /// @brief default ctor creates a singular iterator
+            Iterator() = default;
+
+            /// @brief ctor which positions the iterator
+            /// @param arrays the field arrays
+            /// @param index the index of the element to point to
+            Iterator(const std::tuple<Fields *...> &arrays, const std::size_t index)
+                : m_arrays{arrays},
+                  m_index{index} { };
+
+            /// @brief dereferences the iterator
+            /// @return a proxy reference to the current element
+            reference operator*() const
+            {
+                return std::apply([this](auto *...arrays) { return reference{arrays[m_index]...}; }, m_arrays);
+            }
+
+            /// @brief accesses an element relative to the iterator
+            /// @param offset the offset of the element
+            /// @return a proxy reference to the element
+            reference operator[](const difference_type offset) const { return *(*this + offset); }
+
+            /// @brief moves to the next element
+            /// @return this iterator
+            Iterator &operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+
+            /// @brief moves to the next element
+            /// @return a copy of the iterator before it moved
+            Iterator operator++(int)
+            {
+                auto copy{*this};
+                ++m_index;
+                return copy;
+            }
+
+            /// @brief moves to the previous element
+            /// @return this iterator
+            Iterator &operator--()
+            {
+                --m_index;
+                return *this;
+            }
+
+            /// @brief moves to the previous element
+            /// @return a copy of the iterator before it moved
+            Iterator operator--(int)
+            {
+                auto copy{*this};
+                --m_index;
+                return copy;
+            }
+
+            /// @brief moves the iterator by an offset
+            /// @param offset the number of elements to move by
+            /// @return this iterator
+            Iterator &operator+=(const difference_type offset)
+            {
+                m_index += offset;
+                return *this;
+            }
+
+            /// @brief moves the iterator back by an offset
+            /// @param offset the number of elements to move back by
+            /// @return this iterator
+            Iterator &operator-=(const difference_type offset)
+            {
+                m_index -= offset;
+                return *this;
+            }
+
+            /// @brief gets an iterator moved by an offset
+            /// @param offset the number of elements to move by
+            /// @return the moved iterator
+            Iterator operator+(const difference_type offset) const { return Iterator{m_arrays, m_index + offset}; }
+
+            /// @brief gets an iterator moved back by an offset
+            /// @param offset the number of elements to move back by
+            /// @return the moved iterator
+            Iterator operator-(const difference_type offset) const { return Iterator{m_arrays, m_index - offset}; }
+
+            /// @brief gets the distance between two iterators
+            /// @param other the other iterator
+            /// @return the number of elements between the iterators
+            difference_type operator-(const Iterator &other) const
+            {
+                return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+            }
+
+            /// @brief compares two iterators
+            /// @param other the iterator to compare against
+            /// @return true if both iterators point to the same element
+            bool operator==(const Iterator &other) const { return m_index == other.m_index; }
+
+            /// @brief orders two iterators
+            /// @param other the iterator to compare against
+            /// @return the ordering of the two iterators' positions
+            auto operator<=>(const Iterator &other) const { return m_index <=> other.m_index; }
+        };
+
+        /// @brief a view over a subset of the fields of the vector, intended for kernels which process the fields as
+        /// plain (aligned, padded) arrays
+        /// @tparam Fields the (possibly const) types of the fields in the view
+        template <typename... Fields>
+        class ZipView
+        {
+            // private data
+          private:
+            /// @brief the field arrays
+            std::tuple<Fields *...> m_arrays;
+
+            /// @brief the number of elements in the view
+            std::size_t m_size;
+
+            // public ctors/methods
+          public:
+            /// @brief ctor which creates the view
+            /// @param arrays the field arrays
+            /// @param size the number of elements in the view
+            ZipView(const std::tuple<Fields *...> &arrays, const std::size_t size)
+                : m_arrays{arrays},
+                  m_size{size} { };
+
+            /// @brief gets the number of elements in the view
+            /// @return the number of elements in the view
+            std::size_t size() const { return m_size; }
+
+            /// @brief gets the number of elements which can be processed (size() rounded up to the granularity)
+            /// @return the padded number of elements
+            std::size_t padded_size() const { return (m_size + s_granularity - 1) / s_granularity * s_granularity; }
+
+            /// @brief gets one of the view's (64 byte aligned) field arrays
+            /// @tparam J the index of the field within the view
+            /// @return a pointer to the first element of the field array
+            template <std::size_t J>
+            auto *data() const
+            {
+                return std::get<J>(m_arrays);
+            }
+
+            /// @brief gets an iterator to the first element of the view
+            /// @return an iterator to the first element
+            Iterator<Fields...> begin() const { return Iterator<Fields...>{m_arrays, 0}; }
+
+            /// @brief gets an iterator one past the last element of the view
+            /// @return an iterator one past the last element
+            Iterator<Fields...> end() const { return Iterator<Fields...>{m_arrays, m_size}; }
+
+            /// @brief calls a function for every element of the view with a reference to each of the element's fields
+            /// @tparam Fn the type of the function
+            /// @param fn the function, called as fn(field0, field1, ...)
+            template <typename Fn>
+            void for_each(Fn &&fn) const
+            {
+                std::apply(
+                    [&](auto *...arrays) {
+                        for (std::size_t i{0}; i < m_size; ++i)
+                            fn(arrays[i]...);
+                    },
+                    m_arrays);
+            }
+        };
+
+        /// @brief the (mutable) iterator type
+        using iterator = Iterator<Ts...>;
+
+        /// @brief the const iterator type
+        using const_iterator = Iterator<const Ts...>;
+
+        // private data
+      private:
+        /// @brief one (64 byte aligned) array per field
+        std::tuple<Ts *...> m_arrays{};
+
+        /// @brief the number of elements in the vector
+        std::size_t m_size{0};
+
+        /// @brief the number of elements every field array has room for (always a multiple of s_granularity)
+        std::size_t m_capacity{0};
+
+        // private methods/functions
+      private:
+        /// @brief rounds an element count up to the granularity
+        /// @param count the element count
+        /// @return the smallest multiple of the granularity which is no smaller than the count
+        static constexpr std::size_t round_up(const std::size_t count)
+        {
+            return (count + s_granularity - 1) / s_granularity * s_granularity;
+        }
+
+        /// @brief allocates an (uninitialized) field array
+        /// @tparam T the type of the field
+        /// @param capacity the number of elements in the array
+        /// @return the new array
+        template <typename T>
+        static T *allocate_array(const std::size_t capacity)
+        {
+            return static_cast<T *>(::operator new(capacity * sizeof(T), std::align_val_t{s_alignment}));
+        }
+
+        /// @brief frees a field array
+        /// @tparam T the type of the field
+        /// @param array the array to free
+        template <typename T>
+        static void free_array(T *const array)
+        {
+            if (array)
+                ::operator delete(array, std::align_val_t{s_alignment});
+        }
+
+        /// @brief frees every field array in a tuple of them
+        /// @param arrays the arrays to free
+        static void free_arrays(const std::tuple<Ts *...> &arrays)
+        {
+            std::apply([](auto *...array) { (free_array(array), ...); }, arrays);
+        }
+
+        /// @brief copies a field array into a new allocation of the given capacity
+        /// @tparam T the type of the field
+        /// @param array the array to reallocate; replaced by the new array
+        /// @param capacity the number of elements in the new array
+        /// @param size the number of elements to copy into the new array
+        /// @return the old array, which the caller must free
+        template <typename T>
+        static T *reallocate_array(T *&array, const std::size_t capacity, const std::size_t size)
+        {
+            auto *const oldArray{array};
+            array = allocate_array<T>(capacity);
+            if (size)
+                std::memcpy(array, oldArray, size * sizeof(T));
+            return oldArray;
+        }
+
+        /// @brief copies every field array into new allocations with room for at least the given number of elements
+        /// @param count the number of elements to make room for
+        /// @return the old field arrays, which the caller must free
+        std::tuple<Ts *...> reallocate(const std::size_t count)
+        {
+            const auto capacity{round_up(count)};
+            auto       oldArrays{std::apply(
+                [&](auto *&...arrays) { return std::tuple<Ts *...>{reallocate_array(arrays, capacity, m_size)...}; },
+                m_arrays)};
+
+            m_capacity = capacity;
+            value_initialize(m_size, m_capacity);
+            return oldArrays;
+        }
+
+        /// @brief resets the elements in [first, last) of every field array to value initialized elements
+        /// @param first the index of the first element to reset
+        /// @param last the index one past the last element to reset
+        void value_initialize(const std::size_t first, const std::size_t last)
+        {
+            std::apply([&](auto *...arrays) { (std::fill(arrays + first, arrays + last, Ts{}), ...); }, m_arrays);
+        }
+
+        /// @brief writes an element's fields at an index
+        /// @tparam Is the indices of the fields
+        /// @param index the index of the element
+        /// @param values the values of the element's fields
+        template <std::size_t... Is>
+        void write(std::index_sequence<Is...>, const std::size_t index, const Ts &...values)
+        {
+            ((std::get<Is>(m_arrays)[index] = values), ...);
+        }
+
+        /// @brief ensures there is room for at least the given number of elements, growing geometrically
+        ///
+        /// the old field arrays are handed back rather than freed, since the values being inserted may live in them
+        /// (e.g. `v.push_back(v.get<0>(0))`); the caller frees them once the values have been written
+        /// @param count the number of elements which must fit
+        /// @return the old field arrays if the vector grew (all nullptr if not), which the caller must free
+        std::tuple<Ts *...> grow_to_fit(const std::size_t count)
+        {
+            if (count <= m_capacity)
+                return {};
+            return reallocate(count > m_capacity * 2 ? count : m_capacity * 2);
+        }
+
+        // public ctors/dtor/assignment
+      public:
+        /// @brief default ctor creates an empty vector which does not allocate until the first insertion
+        bEngineSoaVector() = default;
+
+        /// @brief ctor which creates an empty vector with room for the given number of elements
+        /// @param capacity the number of elements to reserve room for
+        explicit bEngineSoaVector(const std::size_t capacity) { reserve(capacity); };
+
+        /// @brief copy ctor copies every field array
+        /// @param other the vector to copy
+        bEngineSoaVector(const bEngineSoaVector &other)
+        {
+            reserve(other.m_size);
+            std::apply([&](const auto *...arrays) { append_arrays(arrays..., other.m_size); }, other.m_arrays);
+        };
+
+        /// @brief move ctor steals the other vector's arrays, leaving it empty
+        /// @param other the vector to move from
+        bEngineSoaVector(bEngineSoaVector &&other) noexcept
+            : m_arrays{std::exchange(other.m_arrays, std::tuple<Ts *...>{})},
+              m_size{std::exchange(other.m_size, 0)},
+              m_capacity{std::exchange(other.m_capacity, 0)} { };
+
+        /// @brief copy assignment (copy and swap)
+        /// @param other the vector to copy
+        /// @return this vector
+        bEngineSoaVector &operator=(const bEngineSoaVector &other)
+        {
+            if (this != &other)
+            {
+                bEngineSoaVector copy{other};
+                swap(copy);
+            }
+            return *this;
+        }
+
+        /// @brief move assignment (move and swap)
+        /// @param other the vector to move from
+        /// @return this vector
+        bEngineSoaVector &operator=(bEngineSoaVector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                bEngineSoaVector moved{std::move(other)};
+                swap(moved);
+            }
+            return *this;
+        }
+
+        /// @brief dtor frees every field array
+        ~bEngineSoaVector() { free_arrays(m_arrays); };
+
+        // public methods/functions
+      public:
+        /// @brief gets the number of elements in the vector
+        /// @return the number of elements in the vector
+        std::size_t size() const { return m_size; }
+
+        /// @brief gets the number of elements a kernel may process: size() rounded up to the granularity; the elements
+        /// past size() are value initialized
+        /// @return the padded number of elements
+        std::size_t padded_size() const { return round_up(m_size); }
+
+        /// @brief gets the number of elements the vector has room for
+        /// @return the number of elements the vector has room for
+        std::size_t capacity() const { return m_capacity; }
+
+        /// @brief checks whether the vector is empty
+        /// @return true if the vector holds no elements
+        bool empty() const { return m_size == 0; }
+
+        /// @brief gets one of the (64 byte aligned, padded) field arrays
+        /// @tparam I the index of the field
+        /// @return a pointer to the first element of the field array
+        template <std::size_t I>
+        field_type<I> *data()
+        {
+            return std::get<I>(m_arrays);
+        }
+
+        /// @brief gets one of the (64 byte aligned, padded) field arrays
+        /// @tparam I the index of the field
+        /// @return a const pointer to the first element of the field array
+        template <std::size_t I>
+        const field_type<I> *data() const
+        {
+            return std::get<I>(m_arrays);
+        }
+
+        /// @brief accesses a single field of an element
+        /// @tparam I the index of the field
+        /// @param index the index of the element
+        /// @return a reference to the field
+        template <std::size_t I>
+        field_type<I> &get(const std::size_t index)
+        {
+            return std::get<I>(m_arrays)[index];
+        }
+
+        /// @brief accesses a single field of an element
+        /// @tparam I the index of the field
+        /// @param index the index of the element
+        /// @return a const reference to the field
+        template <std::size_t I>
+        const field_type<I> &get(const std::size_t index) const
+        {
+            return std::get<I>(m_arrays)[index];
+        }
+
+        /// @brief accesses an element
+        /// @param index the index of the element
+        /// @return a proxy reference to the element
+        reference operator[](const std::size_t index) { return begin()[index]; }
+
+        /// @brief accesses an element
+        /// @param index the index of the element
+        /// @return a proxy const reference to the element
+        const_reference operator[](const std::size_t index) const { return begin()[index]; }
+
+        /// @brief gets an iterator to the first element
+        /// @return an iterator to the first element
+        iterator begin() { return iterator{m_arrays, 0}; }
+
+        /// @brief gets an iterator one past the last element
+        /// @return an iterator one past the last element
+        iterator end() { return iterator{m_arrays, m_size}; }
+
+        /// @brief gets a const iterator to the first element
+        /// @return a const iterator to the first element
+        const_iterator begin() const
+        {
+            return const_iterator{std::apply([](auto *...a) { return std::tuple<const Ts *...>{a...}; }, m_arrays), 0};
+        }
+
+        /// @brief gets a const iterator one past the last element
+        /// @return a const iterator one past the last element
+        const_iterator end() const { return begin() + static_cast<std::ptrdiff_t>(m_size); }
+
+        /// @brief gets a view over a subset of the fields
+        /// @tparam Is the indices of the fields in the view (in the order they should appear)
+        /// @return a view over the selected fields
+        template <std::size_t... Is>
+        ZipView<field_type<Is>...> zip()
+        {
+            return ZipView<field_type<Is>...>{std::tuple<field_type<Is> *...>{std::get<Is>(m_arrays)...}, m_size};
+        }
+
+        /// @brief gets a view over a subset of the fields
+        /// @tparam Is the indices of the fields in the view (in the order they should appear)
+        /// @return a const view over the selected fields
+        template <std::size_t... Is>
+        ZipView<const field_type<Is>...> zip() const
+        {
+            return ZipView<const field_type<Is>...>{
+                std::tuple<const field_type<Is> *...>{std::get<Is>(m_arrays)...},
+                m_size};
+        }
+
+        /// @brief gets a view over every field
+        /// @return a view over every field
+        ZipView<Ts...> zip_all() { return ZipView<Ts...>{m_arrays, m_size}; }
+
+        /// @brief ensures the vector has room for at least the given number of elements
+        /// @param count the number of elements to make room for
+        void reserve(const std::size_t count)
+        {
+            if (count <= m_capacity)
+                return;
+
+            free_arrays(reallocate(count));
+        }
+
+        /// @brief resizes the vector; new elements are value initialized
+        /// @param count the new number of elements
+        void resize(const std::size_t count)
+        {
+            reserve(count);
+            if (count < m_size)
+                value_initialize(count, m_size);
+            m_size = count;
+        }
+
+        /// @brief removes every element (but keeps the capacity)
+        void clear() { resize(0); }
+
+        /// @brief appends an element
+        /// @param values the values of the element's fields
+        void push_back(const Ts &...values)
+        {
+            const auto oldArrays{grow_to_fit(m_size + 1)};
+            write(std::index_sequence_for<Ts...>{}, m_size, values...);
+            free_arrays(oldArrays);
+            ++m_size;
+        }
+
+        /// @brief appends a number of copies of an element (bulk append)
+        /// @param count the number of copies to append
+        /// @param values the values of the element's fields
+        void append(const std::size_t count, const Ts &...values)
+        {
+            const auto oldArrays{grow_to_fit(m_size + count)};
+            std::apply(
+                [&](auto *...arrays) { (std::fill(arrays + m_size, arrays + m_size + count, values), ...); },
+                m_arrays);
+            free_arrays(oldArrays);
+            m_size += count;
+        }
+
+        /// @brief appends elements from one (plain) array per field (bulk append)
+        /// @param arrays one pointer per field to the values to append
+        /// @param count the number of elements to append
+        void append_arrays(const Ts *const... arrays, const std::size_t count)
+        {
+            const auto oldArrays{grow_to_fit(m_size + count)};
+            std::apply(
+                [&](auto *...destinations) {
+                    ((count ? (void)std::memcpy(destinations + m_size, arrays, count * sizeof(Ts)) : (void)0), ...);
+                },
+                m_arrays);
+            free_arrays(oldArrays);
+            m_size += count;
+        }
+
+        /// @brief removes the last element
+        void pop_back() { resize(m_size - 1); }
+
+        /// @brief removes an element by moving the last element into its place (does not preserve order, O(1))
+        /// @param index the index of the element to remove
+        void erase_unordered(const std::size_t index)
+        {
+            const auto last{m_size - 1};
+            if (index != last)
+                std::apply([&](auto *...arrays) { ((arrays[index] = arrays[last]), ...); }, m_arrays);
+            pop_back();
+        }
+
+        /// @brief removes a range of elements, preserving the order of the remaining elements (bulk erase)
+        /// @param first the index of the first element to remove
+        /// @param last the index one past the last element to remove
+        void erase(const std::size_t first, const std::size_t last)
+        {
+            if (first >= last)
+                return;
+
+            std::apply(
+                [&](auto *...arrays) {
+                    (std::memmove(arrays + first, arrays + last, (m_size - last) * sizeof(Ts)), ...);
+                },
+                m_arrays);
+            resize(m_size - (last - first));
+        }
+
+        /// @brief removes every element for which a predicate returns true, preserving the order of the remaining
+        /// elements (bulk erase in a single pass)
+        /// @tparam Pred the type of the predicate
+        /// @param pred the predicate, called as pred(field0, field1, ...) with const references to each field
+        /// @return the number of elements removed
+        template <typename Pred>
+        std::size_t erase_if(Pred &&pred)
+        {
+            std::size_t kept{0};
+            std::apply(
+                [&](auto *...arrays) {
+                    for (std::size_t i{0}; i < m_size; ++i)
+                    {
+                        if (pred(std::as_const(arrays[i])...))
+                            continue;
+                        if (kept != i)
+                            ((arrays[kept] = arrays[i]), ...);
+                        ++kept;
+                    }
+                },
+                m_arrays);
+
+            const auto removed{m_size - kept};
+            resize(kept);
+            return removed;
+        }
+
+        /// @brief swaps the contents of two vectors
+        /// @param other the vector to swap with
+        void swap(bEngineSoaVector &other) noexcept
+        {
+            std::swap(m_arrays, other.m_arrays);
+            std::swap(m_size, other.m_size);
+            std::swap(m_capacity, other.m_capacity);
+        }
+    };
+} // namespace bEngine
\ No newline at end of file
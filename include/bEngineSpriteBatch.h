@@ -0,0 +1,228 @@
+#pragma once
+
+/// @file bEngineSpriteBatch.h
+/// @brief the interface for batched 2D sprite rendering in the bEngine library, which draws tens of thousands of
+/// sprites with a handful of instanced draws
+
+#include "bEngineCommandBuffer.h"  // for the blend mode of a sprite material
+#include "bEngineGL.h"             // for the atlas texture, the sprite program and vertex array
+#include "bEngineGLStreamBuffer.h" // for the per-frame memory sprite instances are written to
+
+#include <glm\glm.hpp> // for the vectors/matrices sprites are described with
+
+#include <cstdint> // for fixed width integers
+#include <span>    // for adding many sprites at once
+#include <vector>  // for the atlas' shelves and the frame's sprites
+
+namespace bEngine
+{
+    /// @brief the location of an image in a sprite atlas
+    struct bEngineSpriteImage
+    {
+        /// @brief the image's rectangle in its page (min u, min v, max u, max v)
+        glm::vec4 m_uvRect{0.0f, 0.0f, 1.0f, 1.0f};
+
+        /// @brief the page (layer of the atlas' texture array) the image is on
+        std::uint16_t m_page{0};
+    };
+
+    /// @brief a 2D texture array whose layers ("pages") many sprite images are packed into, so sprites using any of
+    /// them can be drawn together without switching textures
+    ///
+    /// images are packed onto shelves (rows as tall as the tallest image on them) with a transparent texel of padding
+    /// around each, so bilinear filtering never bleeds between neighbours. Images live as long as the atlas.
+    class bEngineSpriteAtlas
+    {
+        // private types
+      private:
+        /// @brief a row of images on a page
+        struct Shelf
+        {
+            /// @brief the y coordinate of the shelf's bottom, in texels
+            int m_y{0};
+
+            /// @brief the height of the shelf, in texels
+            int m_height{0};
+
+            /// @brief the x coordinate of the shelf's first free texel
+            int m_x{0};
+        };
+
+        // private data
+      private:
+        /// @brief the atlas' texture array (RGBA8)
+        bEngineGLTexture m_texture;
+
+        /// @brief the width and height of each page, in texels
+        const int m_pageSize{0};
+
+        /// @brief the shelves of each page
+        std::vector<std::vector<Shelf>> m_shelves;
+
+        // public ctors
+      public:
+        /// @brief default ctor is insufficient
+        bEngineSpriteAtlas() = delete;
+
+        /// @brief ctor which creates the atlas' (transparent) texture array on the current context
+        /// @param pageSize the width and height of each page, in texels
+        /// @param pageCount the number of pages
+        bEngineSpriteAtlas(const int pageSize = 2048, const int pageCount = 4);
+
+        // public methods/functions
+      public:
+        /// @brief packs an image into the atlas and uploads it
+        /// @param width the width of the image, in texels
+        /// @param height the height of the image, in texels
+        /// @param texels the image's texels as tightly packed RGBA8, first row first (at the image's min v)
+        /// @param image receives the location of the image
+        /// @return true if the image was added, false if no page has room left for it
+        const bool add_image(const int width, const int height, const void *const texels, bEngineSpriteImage &image);
+
+        /// @brief gets the atlas' texture array
+        /// @return a reference to the atlas' texture array
+        const bEngineGLTexture &get_texture() const;
+    };
+
+    /// @brief what a group of sprites is drawn with; sprites of the same material (and layer) are drawn together
+    struct bEngineSpriteMaterial
+    {
+        /// @brief the atlas the sprites' images are in
+        const bEngineSpriteAtlas *m_atlas{nullptr};
+
+        /// @brief how the sprites blend with what's already drawn
+        bEngineBlendMode m_blend{bEngineBlendMode::Alpha};
+    };
+
+    /// @brief a single sprite instance
+    struct bEngineSprite
+    {
+        /// @brief the position of the sprite's center
+        glm::vec2 m_position{0.0f};
+
+        /// @brief the width and height of the sprite (drawn at half precision)
+        glm::vec2 m_scale{1.0f};
+
+        /// @brief the rotation of the sprite around its center, in radians (counterclockwise for a y-up projection);
+        /// drawn at half precision, so it should be kept within a turn or so
+        float m_rotation{0.0f};
+
+        /// @brief the part of the image drawn (min u, min v, max u, max v), relative to the image (e.g. an animation
+        /// frame); the min corner maps to the sprite's min x/y corner
+        glm::vec4 m_uvRect{0.0f, 0.0f, 1.0f, 1.0f};
+
+        /// @brief the color the image is multiplied by
+        glm::vec4 m_color{1.0f};
+
+        /// @brief the image the sprite draws, in its material's atlas
+        bEngineSpriteImage m_image{};
+
+        /// @brief the material the sprite is drawn with (see bEngineSpriteBatch::add_material())
+        std::uint16_t m_material{0};
+
+        /// @brief the layer of the sprite; lower layers are drawn first, and sprites within a layer are drawn in the
+        /// order they were added (per material)
+        std::uint8_t m_layer{0};
+    };
+
+    /// @brief the statistics of a sprite batch's last recorded frame
+    struct bEngineSpriteStats
+    {
+        /// @brief the number of sprites drawn
+        std::uint32_t m_spriteCount{0};
+
+        /// @brief the number of instanced draws the sprites were drawn with
+        std::uint32_t m_drawCount{0};
+
+        /// @brief the number of sprites which weren't drawn because the stream buffer ran out of space
+        std::uint32_t m_droppedSprites{0};
+    };
+
+    /// @brief collects a frame's sprites and draws them with one instanced draw per run of sprites sharing a layer and
+    /// material
+    ///
+    /// recording sorts the sprites by layer and material with a counting sort which writes each sprite's (compact, 32
+    /// byte) instance straight into its sorted position in the stream buffer, so there's no separate sort or copy.
+    /// Each run is then an instanced draw of a quad (triangle strip), with the instance attributes advancing per
+    /// instance from the run's base instance. The batch must be created and used on the thread which owns its context.
+    class bEngineSpriteBatch
+    {
+        // public static data
+      public:
+        /// @brief the maximum number of materials a batch can have
+        static constexpr std::uint16_t s_maxMaterials{256};
+
+        // private data
+      private:
+        /// @brief the stream buffer sprite instances (and the view projection) are written to each frame
+        bEngineGLStreamBuffer *const m_streamBuffer{nullptr};
+
+        /// @brief the alignment of uniform block ranges on the current context
+        std::ptrdiff_t m_uniformAlignment{0};
+
+        /// @brief the program sprites are drawn with
+        bEngineGLProgram m_program;
+
+        /// @brief the vertex array reading sprite instances from the stream buffer
+        bEngineGLVertexArray m_vertexArray;
+
+        /// @brief the batch's materials
+        std::vector<bEngineSpriteMaterial> m_materials;
+
+        /// @brief the sprites added this frame
+        std::vector<bEngineSprite> m_sprites;
+
+        /// @brief the first sorted position of each (layer, material) bucket, reused every frame
+        std::vector<std::uint32_t> m_bucketOffsets;
+
+        /// @brief the statistics of the last recorded frame
+        bEngineSpriteStats m_stats{};
+
+        // public ctors
+      public:
+        /// @brief default ctor is insufficient
+        bEngineSpriteBatch() = delete;
+
+        /// @brief ctor which builds the sprite program and vertex array on the current context
+        /// @param streamBuffer the stream buffer the batch is built in each frame, which must outlive the batch; its
+        /// region size must be a multiple of 32 bytes (the size of a sprite instance)
+        bEngineSpriteBatch(bEngineGLStreamBuffer &streamBuffer);
+
+        // public methods/functions
+      public:
+        /// @brief adds a material to the batch
+        /// @param material the material
+        /// @return the ID sprites refer to the material by
+        const std::uint16_t add_material(const bEngineSpriteMaterial &material);
+
+        /// @brief starts a new frame, forgetting the previous frame's sprites
+        void begin();
+
+        /// @brief adds a sprite to the frame
+        /// @param sprite the sprite
+        void add_sprite(const bEngineSprite &sprite);
+
+        /// @brief adds several sprites to the frame
+        /// @param sprites the sprites
+        void add_sprites(std::span<const bEngineSprite> sprites);
+
+        /// @brief sorts the frame's sprites into the stream buffer and records their draws
+        /// @param commands the command buffer to record into
+        /// @param sortKey the sort key of every draw (which keep their relative order, since the queue's sort is
+        /// stable)
+        /// @param viewProjection the matrix transforming sprite positions into clip space (e.g. glm::ortho())
+        /// @param framebuffer the framebuffer to draw to, or nullptr for the window
+        /// @param viewport the viewport to draw with (e.g. a render graph pass' viewport), or a zero size for the
+        /// render's default viewport
+        void record(
+            bEngineCommandBuffer       &commands,
+            const std::uint64_t         sortKey,
+            const glm::mat4            &viewProjection,
+            const bEngineGLFramebuffer *framebuffer = nullptr,
+            const bEngineViewport      &viewport    = {});
+
+        /// @brief gets the statistics of the last recorded frame
+        /// @return the statistics of the last recorded frame
+        const bEngineSpriteStats get_stats() const;
+    };
+} // namespace bEngine
\ No newline at end of file
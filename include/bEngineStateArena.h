@@ -0,0 +1,176 @@
+#pragma once
+
+/// @file bEngineStateArena.h
+/// @brief the interface for a state arena in the bEngine library, a contiguous block of memory which holds all of the
+/// tick-mutable simulation data so the whole simulation can be snapshotted/restored with a single copy
+
+#include <cstddef>     // for size_t/max_align_t
+#include <memory>      // for unique_ptr which owns the arena/snapshot memory
+#include <new>         // for placement new when creating objects in the arena
+#include <type_traits> // for ensuring only trivially copyable types live in the arena
+#include <utility>     // for forward
+#include <vector>      // for the ring of snapshot records
+
+namespace bEngine
+{
+    /// @brief a linear arena which all tick-mutable simulation state is allocated from, plus a ring of snapshots of
+    /// that arena
+    ///
+    /// because the state lives in one contiguous block, taking a snapshot is a single memcpy of the used part of the
+    /// arena into the ring and restoring a snapshot is a single memcpy back; neither depends on what the state
+    /// actually is. The application snapshots the arena after every tick, which is what allows it to rewind to an
+    /// earlier tick and resimulate (see bEngineApp::request_rewind()).
+    ///
+    /// only trivially copyable types may be created in the arena (a memcpy must be a valid copy), and pointers held
+    /// by the state should point into the arena (so they stay valid across a restore). Allocations should be made
+    /// before the first snapshot is taken: restoring a snapshot also restores the amount of the arena in use.
+    class bEngineStateArena
+    {
+        // private types
+      private:
+        /// @brief the bookkeeping for a single snapshot in the ring
+        struct SnapshotRecord
+        {
+            /// @brief the tick the snapshot was taken at
+            unsigned long long m_tick{0};
+
+            /// @brief the number of bytes of the arena which were in use (and copied) when the snapshot was taken
+            std::size_t m_usedBytes{0};
+
+            /// @brief true if the record holds a snapshot, false if it has never been written
+            bool m_isValid{false};
+        };
+
+        /// @brief deleter for the arena/snapshot memory, which is allocated in whole pages
+        struct PageDeleter
+        {
+            /// @brief the number of bytes which were allocated
+            std::size_t m_size{0};
+
+            /// @brief frees memory allocated with Memory::allocate_pages()
+            /// @param memory the memory to be freed
+            void operator()(std::byte *const memory) const;
+        };
+
+        // private static data
+      private:
+        /// @brief the alignment of the arena's size (and so of every snapshot in the ring); the memory itself is page
+        /// aligned
+        static constexpr std::size_t s_alignment{64};
+
+        // private static methods
+      private:
+        /// @brief checks the arena can be created before any of its memory is allocated
+        /// @param capacity the number of bytes the arena should hold
+        /// @param snapshotCount the number of snapshots kept in the ring
+        /// @return the capacity rounded up to the arena's alignment; throws a bEngineException if there are no
+        /// snapshots, or if the arena is empty or too large to allocate
+        static const std::size_t get_checked_capacity(const std::size_t capacity, const unsigned int snapshotCount);
+
+        // private data
+      private:
+        /// @brief the number of bytes the arena can hold
+        const std::size_t m_capacity{0};
+
+        /// @brief the number of snapshots kept in the ring
+        const unsigned int m_snapshotCount{0};
+
+        /// @brief the number of bytes of the arena which have been handed out
+        std::size_t m_usedBytes{0};
+
+        /// @brief the arena itself
+        std::unique_ptr<std::byte[], PageDeleter> m_memory;
+
+        /// @brief the snapshot ring's memory; m_snapshotCount blocks of m_capacity bytes each
+        std::unique_ptr<std::byte[], PageDeleter> m_snapshotMemory;
+
+        /// @brief the records for each block of the snapshot ring
+        std::vector<SnapshotRecord> m_snapshots;
+
+        // public ctors/dtor
+      public:
+        /// @brief default ctor is insufficient
+        bEngineStateArena() = delete;
+
+        /// @brief ctor which allocates the arena and its snapshot ring; throws a bEngineException if the arena can't be
+        /// created
+        /// @param capacity the number of bytes the arena can hold
+        /// @param snapshotCount the number of snapshots kept in the ring (i.e. how many ticks can be rewound)
+        /// @param numaNode the NUMA node the arena and its snapshots should live on, or -1 for no preference
+        /// @param useLargePages true to back the arena and its snapshots with large pages
+        bEngineStateArena(
+            const std::size_t  capacity,
+            const unsigned int snapshotCount,
+            const int          numaNode      = -1,
+            const bool         useLargePages = false);
+
+        /// @brief the arena owns the simulation state, so it is not copyable
+        bEngineStateArena(const bEngineStateArena &) = delete;
+
+        /// @brief the arena owns the simulation state, so it is not copyable
+        bEngineStateArena &operator=(const bEngineStateArena &) = delete;
+
+        /// @brief default dtor is acceptable
+        ~bEngineStateArena() = default;
+
+        // public methods/functions
+      public:
+        /// @brief allocates (uninitialized) memory from the arena
+        /// @param size the number of bytes to allocate
+        /// @param alignment the alignment of the allocation (must be a power of two no larger than 64)
+        /// @return a pointer to the allocated memory; throws a bEngineException if the arena is out of memory
+        void *const allocate(const std::size_t size, const std::size_t alignment = alignof(std::max_align_t));
+
+        /// @brief creates an object in the arena
+        /// @tparam T the type of the object, which must be trivially copyable
+        /// @tparam Args the types of the object's ctor arguments
+        /// @param args the object's ctor arguments
+        /// @return a pointer to the new object, which lives as long as the arena
+        template <typename T, typename... Args>
+        T *const create(Args &&...args)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can live in a state arena");
+            return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /// @brief creates an array of (value initialized) objects in the arena
+        /// @tparam T the type of the objects, which must be trivially copyable
+        /// @param count the number of objects in the array
+        /// @return a pointer to the first object of the array, which lives as long as the arena
+        template <typename T>
+        T *const create_array(const std::size_t count)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can live in a state arena");
+            auto *const array{static_cast<T *>(allocate(sizeof(T) * count, alignof(T)))};
+            for (std::size_t i{0}; i < count; ++i)
+                ::new (array + i) T();
+            return array;
+        }
+
+        /// @brief copies the used part of the arena into the snapshot ring, replacing the oldest snapshot
+        /// @param tick the tick the snapshot represents
+        void save_snapshot(const unsigned long long tick);
+
+        /// @brief checks whether a snapshot of the given tick is still in the ring
+        /// @param tick the tick to check for
+        /// @return true if the tick can be restored, false if it was never saved or has been overwritten
+        const bool has_snapshot(const unsigned long long tick) const;
+
+        /// @brief copies a snapshot back into the arena, which takes time proportional to the size of the snapshot
+        /// @param tick the tick to restore
+        /// @return true if the snapshot was restored, false if it is not in the ring
+        const bool restore_snapshot(const unsigned long long tick);
+
+        /// @brief gets the number of bytes the arena can hold
+        /// @return the number of bytes the arena can hold
+        const std::size_t get_capacity() const;
+
+        /// @brief gets the number of bytes of the arena in use
+        /// @return the number of bytes of the arena in use (i.e. the size of a snapshot)
+        const std::size_t get_used_bytes() const;
+
+        /// @brief gets the number of snapshots kept in the ring
+        /// @return the number of snapshots kept in the ring
+        const unsigned int get_snapshot_count() const;
+    };
+} // namespace bEngine
\ No newline at end of file
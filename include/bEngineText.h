@@ -0,0 +1,284 @@
+#pragma once
+
+/// @file bEngineText.h
+/// @brief the interface for text rendering in the bEngine library: fonts are rasterized on demand into a glyph atlas
+/// which is shared by every string, and a frame's text is drawn in a single instanced draw
+
+#include "bEngineCommandBuffer.h"  // for recording the text's draw
+#include "bEngineGL.h"             // for the text program and vertex array
+#include "bEngineGLStreamBuffer.h" // for the per-frame memory glyph quads are written to
+
+#include <glm\glm.hpp> // for the positions/colors text is described with
+
+#include <cstdint>     // for fixed width integers
+#include <memory>      // for owning fonts and the glyph atlas
+#include <string_view> // for the strings drawn
+#include <vector>      // for the fonts and the shaped glyphs
+
+namespace bEngine
+{
+    namespace GL
+    {
+        // fwd declaration of the (private) glyph atlas
+        class GlyphAtlas;
+    } // namespace GL
+
+    /// @brief the vertical metrics of a font at a pixel size
+    struct bEngineFontMetrics
+    {
+        /// @brief the distance from the baseline to the top of the tallest glyphs, in pixels
+        float m_ascent{0.0f};
+
+        /// @brief the distance from the baseline to the bottom of the lowest glyphs, in pixels (positive)
+        float m_descent{0.0f};
+
+        /// @brief the extra space between lines, in pixels
+        float m_lineGap{0.0f};
+    };
+
+    /// @brief a glyph rasterized by a font
+    struct bEngineGlyphBitmap
+    {
+        /// @brief the width of the glyph's bitmap, in pixels (0 for glyphs which draw nothing, e.g. a space)
+        int m_width{0};
+
+        /// @brief the height of the glyph's bitmap, in pixels
+        int m_height{0};
+
+        /// @brief the horizontal distance from the pen position to the bitmap's left edge, in pixels
+        float m_bearingX{0.0f};
+
+        /// @brief the vertical distance from the baseline up to the bitmap's top edge, in pixels
+        float m_bearingY{0.0f};
+
+        /// @brief the bitmap's coverage (0-255), m_width * m_height bytes with the top row first
+        std::vector<std::uint8_t> m_coverage;
+    };
+
+    /// @brief the source of a font's glyphs, implemented on top of a font library (e.g. FreeType or stb_truetype)
+    /// which has loaded the font; the text renderer owns it once added and only calls it from its context's thread
+    class bEngineFontRasterizer
+    {
+        // public ctors/dtor
+      public:
+        /// @brief virtual dtor, since rasterizers are owned through this interface
+        virtual ~bEngineFontRasterizer() = default;
+
+        // public methods/functions
+      public:
+        /// @brief gets the vertical metrics of the font
+        /// @param pixelSize the size of the font (its em height), in pixels
+        /// @return the vertical metrics of the font at the size
+        virtual const bEngineFontMetrics get_metrics(const float pixelSize) const = 0;
+
+        /// @brief maps a codepoint to one of the font's glyphs
+        /// @param codepoint the (Unicode) codepoint
+        /// @return the index of the codepoint's glyph (the font's missing glyph, usually 0, if it doesn't have one)
+        virtual const std::uint32_t get_glyph_index(const char32_t codepoint) const = 0;
+
+        /// @brief gets the distance the pen moves after a glyph
+        /// @param glyph the index of the glyph
+        /// @param pixelSize the size of the font, in pixels
+        /// @return the glyph's advance, in pixels
+        virtual const float get_advance(const std::uint32_t glyph, const float pixelSize) const = 0;
+
+        /// @brief gets the kerning adjustment between two glyphs
+        /// @param left the index of the first glyph
+        /// @param right the index of the glyph which follows it
+        /// @param pixelSize the size of the font, in pixels
+        /// @return the adjustment added to the left glyph's advance, in pixels (0 by default)
+        virtual const float get_kerning(
+            const std::uint32_t /*left*/,
+            const std::uint32_t /*right*/,
+            const float /*pixelSize*/) const
+        {
+            return 0.0f;
+        }
+
+        /// @brief rasterizes a glyph
+        /// @param glyph the index of the glyph
+        /// @param pixelSize the size of the font, in pixels
+        /// @param bitmap receives the glyph's bitmap
+        /// @return true if the glyph was rasterized, false if it couldn't be (it's then drawn as nothing)
+        virtual const bool rasterize_glyph(
+            const std::uint32_t glyph,
+            const float         pixelSize,
+            bEngineGlyphBitmap &bitmap) const = 0;
+    };
+
+    /// @brief how a string's glyphs are rasterized
+    enum class bEngineGlyphMode : unsigned char
+    {
+        Coverage,      ///< rasterized at the (whole pixel) size drawn; sharpest, but each size is rasterized separately
+        DistanceField, ///< rasterized once as a signed distance field, then scaled to any size without rasterizing
+    };
+
+    /// @brief the statistics of a text renderer's last recorded frame
+    struct bEngineTextStats
+    {
+        /// @brief the number of glyphs drawn
+        std::uint32_t m_glyphCount{0};
+
+        /// @brief the number of draws the glyphs were drawn with
+        std::uint32_t m_drawCount{0};
+
+        /// @brief the number of glyphs which weren't drawn because the atlas or the stream buffer ran out of space
+        std::uint32_t m_droppedGlyphs{0};
+
+        /// @brief the number of glyphs rasterized (i.e. which weren't already in the atlas)
+        std::uint32_t m_rasterizedGlyphs{0};
+
+        /// @brief the number of atlas pages evicted to make room for new glyphs
+        std::uint32_t m_evictedPages{0};
+
+        /// @brief the number of strings whose shaping was found in the shaping cache
+        std::uint32_t m_shapingHits{0};
+
+        /// @brief the number of strings which had to be shaped
+        std::uint32_t m_shapingMisses{0};
+    };
+
+    /// @brief draws text from any number of fonts, sizes and glyph modes
+    ///
+    /// glyphs are rasterized the first time they're drawn and packed into the pages (layers) of an R8 texture array
+    /// with a skyline packer. When the atlas is full, the least recently used page which wasn't used by the current
+    /// frame is evicted and its glyphs are rasterized again the next time they're drawn. Strings are shaped (their
+    /// glyphs chosen and positioned, with kerning) once and cached by font, size and content, so static text costs a
+    /// lookup per frame. Every glyph quad of the frame is written to the stream buffer and drawn with a single
+    /// instanced draw, whichever pages and modes they use.
+    ///
+    /// text is laid out in a y-down space (e.g. pixels with glm::ortho(0, width, height, 0)), starting at the
+    /// baseline of the first line. The renderer must be created and used on the thread which owns its context.
+    class bEngineTextRenderer
+    {
+        // private types
+      private:
+        // fwd declarations of the (private) shaping cache and the shaped strings it holds
+        struct ShapedText;
+        struct ShapingCache;
+
+        // private data
+      private:
+        /// @brief the stream buffer glyph quads (and the view projection) are written to each frame
+        bEngineGLStreamBuffer *const m_streamBuffer{nullptr};
+
+        /// @brief the alignment of uniform block ranges on the current context
+        std::ptrdiff_t m_uniformAlignment{0};
+
+        /// @brief the program glyphs are drawn with
+        bEngineGLProgram m_program;
+
+        /// @brief the vertex array reading glyph quads from the stream buffer
+        bEngineGLVertexArray m_vertexArray;
+
+        /// @brief the glyph atlas
+        std::unique_ptr<GL::GlyphAtlas> m_atlas{nullptr};
+
+        /// @brief the shaping cache
+        std::unique_ptr<ShapingCache> m_shaping{nullptr};
+
+        /// @brief the fonts
+        std::vector<std::unique_ptr<bEngineFontRasterizer>> m_fonts;
+
+        /// @brief the frame's glyph quads, in the order they're drawn
+        std::vector<std::byte> m_quads;
+
+        /// @brief the statistics of the current frame
+        bEngineTextStats m_stats{};
+
+        /// @brief the statistics of the last recorded frame
+        bEngineTextStats m_lastStats{};
+
+        // public ctors/dtor
+      public:
+        /// @brief default ctor is insufficient
+        bEngineTextRenderer() = delete;
+
+        /// @brief ctor which creates the atlas, program and vertex array on the current context
+        /// @param streamBuffer the stream buffer the text is built in each frame, which must outlive the renderer; its
+        /// region size must be a multiple of 32 bytes (the size of a glyph quad)
+        /// @param pageSize the width and height of each atlas page, in texels
+        /// @param pageCount the number of atlas pages
+        /// @param shapingCapacity the number of shaped strings kept before strings which weren't drawn by the last
+        /// frame are evicted
+        bEngineTextRenderer(
+            bEngineGLStreamBuffer &streamBuffer,
+            const int              pageSize        = 1024,
+            const int              pageCount       = 4,
+            const std::size_t      shapingCapacity = 4096);
+
+        /// @brief the renderer's fonts and atlas are tied to it, so it can't be copied
+        bEngineTextRenderer(const bEngineTextRenderer &) = delete;
+
+        /// @brief the renderer's fonts and atlas are tied to it, so it can't be copied
+        bEngineTextRenderer &operator=(const bEngineTextRenderer &) = delete;
+
+        /// @brief dtor releases the atlas and fonts
+        ~bEngineTextRenderer();
+
+        // public methods/functions
+      public:
+        /// @brief adds a font
+        /// @param rasterizer the font's rasterizer
+        /// @return the ID text refers to the font by
+        const std::uint16_t add_font(std::unique_ptr<bEngineFontRasterizer> rasterizer);
+
+        /// @brief gets the vertical metrics of a font
+        /// @param font the ID of the font
+        /// @param pixelSize the size of the font, in pixels
+        /// @return the vertical metrics of the font at the size
+        const bEngineFontMetrics get_metrics(const std::uint16_t font, const float pixelSize) const;
+
+        /// @brief starts a new frame, forgetting the previous frame's text
+        void begin();
+
+        /// @brief measures a string without drawing it
+        /// @param font the ID of the font
+        /// @param text the string (UTF-8); lines are separated by '\n'
+        /// @param pixelSize the size of the font, in pixels
+        /// @return the width of the widest line and the distance from the first baseline to the last, in pixels
+        const glm::vec2 measure_text(const std::uint16_t font, const std::string_view text, const float pixelSize);
+
+        /// @brief adds a string to the frame
+        /// @param font the ID of the font
+        /// @param text the string (UTF-8); lines are separated by '\n'
+        /// @param position the pen position the string starts at (the baseline of its first line)
+        /// @param pixelSize the size of the font, in pixels
+        /// @param color the color of the string
+        /// @param mode how the string's glyphs are rasterized
+        void add_text(
+            const std::uint16_t    font,
+            const std::string_view text,
+            const glm::vec2       &position,
+            const float            pixelSize,
+            const glm::vec4       &color = glm::vec4{1.0f},
+            const bEngineGlyphMode mode  = bEngineGlyphMode::Coverage);
+
+        /// @brief writes the frame's glyph quads into the stream buffer and records their draw
+        /// @param commands the command buffer to record into
+        /// @param sortKey the sort key of the draw
+        /// @param viewProjection the matrix transforming text positions into clip space
+        /// @param framebuffer the framebuffer to draw to, or nullptr for the window
+        /// @param viewport the viewport to draw with (e.g. a render graph pass' viewport), or a zero size for the
+        /// render's default viewport
+        void record(
+            bEngineCommandBuffer       &commands,
+            const std::uint64_t         sortKey,
+            const glm::mat4            &viewProjection,
+            const bEngineGLFramebuffer *framebuffer = nullptr,
+            const bEngineViewport      &viewport    = {});
+
+        /// @brief gets the statistics of the last recorded frame
+        /// @return the statistics of the last recorded frame
+        const bEngineTextStats get_stats() const;
+
+        // private methods/functions
+      private:
+        /// @brief finds a string's shaping in the cache, shaping it if it isn't there
+        /// @param font the ID of the font
+        /// @param text the string (UTF-8)
+        /// @param pixelSize the size of the font, in pixels
+        /// @return the string's shaping, which is valid until the next string is shaped
+        const ShapedText &shape_text(const std::uint16_t font, const std::string_view text, const float pixelSize);
+    };
+} // namespace bEngine
\ No newline at end of file
@@ -3,17 +3,97 @@
 /// @file bEngineWindow.h
 /// @brief the interface for a window in the bEngine library
 
+#include "bEngineDynamicResolution.h" // for rendering the window at a dynamic resolution
+#include "bEngineFrameCapture.h"      // for capturing the window's frames
+
 #include <memory> // for access to unique _ptr for the PIMPL idiom
+#include <span>   // for rendering several windows at once
 #include <string> // for access to strings
+#include <vector> // for read back pixels
 
 namespace bEngine
 {
     // fwd declaration for the bEngineWindow class which is used as an argument in the render function typedef
     class bEngineWindow;
 
+    // fwd declaration for the command buffer the render function records into
+    class bEngineCommandBuffer;
+
     /// @brief the typedef associated with a window render function; returns (void) given a pointer to the (const)
-    /// window to render to
-    typedef void (*window_render_fn)(const bEngineWindow *const window);
+    /// window to render to and the command buffer to record the window's render commands into
+    ///
+    /// the commands are sorted (along with any other commands submitted to the window) and executed after the render
+    /// function returns; see bEngineCommandBuffer.h
+    typedef void (*window_render_fn)(const bEngineWindow *const window, bEngineCommandBuffer &commands);
+
+    /// @brief how a window's presents are synchronized with the display
+    enum class bEnginePresentMode : unsigned char
+    {
+        /// @brief present immediately (swap interval 0), which may tear
+        Immediate,
+
+        /// @brief wait for the display's next refresh (swap interval 1)
+        VSync,
+
+        /// @brief wait for the display's next refresh unless the frame is late, in which case present immediately
+        /// (swap interval -1); falls back to VSync if the driver doesn't support it
+        AdaptiveSync
+    };
+
+    /// @brief timing instrumentation for a window's presents
+    struct bEnginePresentStats
+    {
+        /// @brief the number of frames the window has presented
+        unsigned long long m_presentCount{0};
+
+        /// @brief the number of times the window's context had to be made current (i.e. another context was current)
+        unsigned long long m_contextSwitches{0};
+
+        /// @brief the CPU time the last frame spent recording and executing (i.e. submitting) its commands, in seconds
+        double m_lastRenderSeconds{0.0};
+
+        /// @brief the (exponential moving) average CPU time a frame spends recording and executing its commands, in
+        /// seconds
+        double m_averageRenderSeconds{0.0};
+
+        /// @brief the time the last present blocked the calling thread, in seconds
+        double m_lastPresentSeconds{0.0};
+
+        /// @brief the (exponential moving) average time a present blocks the calling thread, in seconds
+        double m_averagePresentSeconds{0.0};
+
+        /// @brief the longest time a present has blocked the calling thread, in seconds
+        double m_maxPresentSeconds{0.0};
+
+        /// @brief the time between the last two presents, in seconds
+        double m_lastFrameSeconds{0.0};
+
+        /// @brief the (exponential moving) average time between presents, in seconds
+        double m_averageFrameSeconds{0.0};
+    };
+
+    /// @brief the size a window's size-dependent render targets (e.g. offscreen color/depth targets) are allocated with
+    ///
+    /// the window's size is tracked every frame, but render targets only follow it lazily: while the window is being
+    /// resized interactively they're allocated oversized (with headroom, so a drag rarely reallocates them) and
+    /// rendered to through a window-sized viewport, and once the size has settled they're allocated at exactly the
+    /// window's size. The generation only changes as a frame begins, so recreating render targets whenever it differs
+    /// from the generation they were created for recreates them at most once per frame
+    struct bEngineRenderTargetSize
+    {
+        /// @brief the width render targets are allocated with, in pixels; at least the window's width
+        int m_width{0};
+
+        /// @brief the height render targets are allocated with, in pixels; at least the window's height
+        int m_height{0};
+
+        /// @brief true while the window is being resized, in which case render targets may be larger than the window
+        /// and only their bottom-left, window-sized region is rendered to
+        bool m_isResizing{false};
+
+        /// @brief incremented whenever the size render targets are allocated with changes
+        unsigned long long m_generation{0};
+    };
 
     /// @brief the bEngineWindow interface for interacting with the window/storing window data
     class bEngineWindow
@@ -42,6 +122,16 @@ namespace bEngine
             std::string    &&title    = std::string{s_defaultWindowName},
             window_render_fn renderFn = nullptr);
 
+        /// @brief renders several windows, in order, from the calling thread
+        ///
+        /// each window's context is made current once (and only if it isn't already), so keeping the order stable
+        /// keeps the context switches per frame at one per window. With paced presentation only the last window's
+        /// present waits for the display (according to its present mode) while the others present immediately, so a
+        /// frame costs one refresh rather than one per window; the last window paces every other window
+        /// @param windows the windows to render
+        /// @param isPaced true to pace every window's presents with the last window's
+        static void render_windows(std::span<const std::unique_ptr<bEngineWindow>> windows, const bool isPaced);
+
         // private members/data
       private:
         /// @brief the (unique) ID associated with the window
@@ -50,7 +140,7 @@ namespace bEngine
         /// run of an application
         const unsigned int m_windowID{s_windowCounter++};
 
-        /// @brief the size of the window, in pixels
+        /// @brief the size of the window('s framebuffer), in pixels; updated as each frame begins
         ///
         /// [0] - width
         /// [1] - height
@@ -62,6 +152,9 @@ namespace bEngine
         /// @brief the window's (user provided) render function
         window_render_fn m_renderFn{nullptr};
 
+        /// @brief how the window's presents are synchronized with the display
+        bEnginePresentMode m_presentMode{bEnginePresentMode::VSync};
+
         /// @the platform-specific window implementation; defined in the bEngineWindow.cpp file and must be implemented
         /// per-platform
         struct PlatformWindowImpl;
@@ -80,6 +173,13 @@ namespace bEngine
         {
         };
 
+        // private methods/functions
+      private:
+        /// @brief renders and presents the window (see render())
+        /// @param isPresentImmediate true to present immediately regardless of the present mode, when another window
+        /// paces the presents
+        void render_frame(const bool isPresentImmediate);
+
         // (public) ctors and dtor
       public:
         /// @brief deafult ctor is insufficient
@@ -115,14 +215,90 @@ namespace bEngine
         /// @return the ID associated with this window
         const unsigned int get_window_ID() const;
 
+        /// @brief gets the width of the window('s framebuffer) as of the current frame
+        /// @return the width of the window, in pixels (0 while the window is minimized)
+        const int get_width() const;
+
+        /// @brief gets the height of the window('s framebuffer) as of the current frame
+        /// @return the height of the window, in pixels (0 while the window is minimized)
+        const int get_height() const;
+
+        /// @brief gets the size the window's size-dependent render targets are allocated with as of the current frame
+        /// (see bEngineRenderTargetSize); render targets should be recreated when its generation changes, and
+        /// rendered to with a viewport of the window's size
+        /// @return the render target size
+        const bEngineRenderTargetSize get_render_target_size() const;
+
+        /// @brief sets how the window's presents are synchronized with the display (applied at the next present)
+        /// @param presentMode the desired present mode; VSync by default
+        void set_present_mode(const bEnginePresentMode presentMode);
+
+        /// @brief gets how the window's presents are synchronized with the display
+        /// @return the window's present mode
+        const bEnginePresentMode get_present_mode() const;
+
+        /// @brief gets the timing instrumentation of the window's presents
+        /// @return the window's present statistics
+        const bEnginePresentStats get_present_stats() const;
+
+        /// @brief reads back the window's last presented frame (e.g. for golden-image tests or screenshots); blocks
+        /// until the GPU has finished the frame, so it's not meant to be called every frame
+        ///
+        /// a headless window (see bEnginePlatform.h) renders into an offscreen framebuffer of exactly its requested
+        /// size, so its frames are deterministic; a native window's frame is read from its front buffer, which is
+        /// only reliable while the window is unobscured
+        /// @return the frame's pixels as tightly packed RGBA8 (width * height * 4 bytes), bottom row first
+        const std::vector<unsigned char> read_pixels() const;
+
+        /// @brief enables (replacing any previous settings) or disables rendering the window at a dynamic resolution
+        /// (see bEngineDynamicResolution.h)
+        ///
+        /// while enabled, everything recorded for the window renders into a scaled offscreen target, which is upscaled
+        /// into the window's framebuffer once the frame's commands are executed; each render starts with a viewport of
+        /// the scaled size (see get_dynamic_resolution_stats())
+        /// @param settings the settings of the dynamic resolution
+        void set_dynamic_resolution(const bEngineDynamicResolutionSettings &settings);
+
+        /// @brief gets the current render scale/size of the window and the decisions the dynamic resolution controller
+        /// has taken
+        /// @return the dynamic resolution statistics
+        const bEngineDynamicResolutionStats get_dynamic_resolution_stats() const;
+
+        /// @brief starts capturing the frames the window renders, replacing any capture in progress
+        ///
+        /// frames are read back and written asynchronously (see bEngineFrameCapture.h), so capturing doesn't stall
+        /// rendering; the capture's size is the window's size when it starts, and frames rendered at any other size
+        /// (i.e. after the window is resized) are dropped
+        /// @param settings where, how and how often frames are captured
+        /// @return true if the capture started, false if its output couldn't be opened
+        const bool start_capture(const bEngineCaptureSettings &settings);
+
+        /// @brief stops capturing the window's frames; blocks until every frame already read back has been written
+        void stop_capture();
+
+        /// @brief gets the statistics of the capture in progress, or of the last capture if none is in progress
+        /// @return the capture statistics
+        const bEngineCaptureStats get_capture_stats() const;
+
+        /// @brief queues a command buffer to be executed during the window's next render; this is how commands
+        /// recorded on other (e.g. job) threads reach the window
+        ///
+        /// this is thread-safe, so it can be called from any thread
+        /// @param commands the command buffer to queue
+        void submit_commands(bEngineCommandBuffer &&commands) const;
+
         /// @brief wraps the window's user-provided render function
         ///
         /// As a rough idea of the implementation (though not necessarily 100% accurate):
-        /// - clears the window
-        /// - ensures the window is targeted for rendering
-        /// - renders
-        /// - presents the result to the window
-        void render() const;
+        /// - ensures the window is targeted for rendering (making its context current if it isn't already)
+        /// - updates the window's size (and, lazily, its render target size)
+        /// - redirects the window's framebuffer to the scaled target, with dynamic resolution
+        /// - records the window's commands (via the render function)
+        /// - sorts and executes every command recorded/submitted for the window
+        /// - upscales the scaled target into the window's framebuffer and adjusts the render scale, with dynamic
+        /// resolution
+        /// - presents the result to the window (according to its present mode), timing the present
+        void render();
     };
 
 } // namespace bEngine
\ No newline at end of file
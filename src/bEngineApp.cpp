@@ -5,9 +5,10 @@
 /// @file bEngineApp.cpp
 /// @brief implementations for the bEngineApp.h file
 
-#include "bEnginePlatform.h"  // for access to platform-specific functions/methods
-#include "bEngineUtilities.h" // for access to versioning functions and info/warning/error macros
-#include "bEngineWindow.h"    // for access to the bEngineWindow class definition
+#include "bEnginePlatform.h"   // for access to platform-specific functions/methods
+#include "bEngineStateArena.h" // for access to the bEngineStateArena class definition
+#include "bEngineUtilities.h"  // for access to versioning functions and info/warning/error macros
+#include "bEngineWindow.h"     // for access to the bEngineWindow class definition
 
 #include <format> // for formatting the default app name
 
@@ -30,6 +31,8 @@ bEngine::bEngineApp::bEngineApp(
       m_tickFn{tickFn},
       m_shutdownFn{shutdownFn} { };
 
+bEngine::bEngineApp::~bEngineApp() = default;
+
 bEngine::bEngineApp bEngine::bEngineApp::create_app(
     std::string   &&name,
     app_init_fn     initFn,
@@ -65,6 +68,48 @@ const bool bEngine::bEngineApp::initialize()
     return true;
 }
 
+bEngine::bEngineStateArena *const bEngine::bEngineApp::create_state_arena(
+    const std::size_t  sizeInBytes,
+    const unsigned int snapshotCount,
+    const int          numaNode,
+    const bool         useLargePages)
+{
+    m_stateArena = std::make_unique<bEngine::bEngineStateArena>(sizeInBytes, snapshotCount, numaNode, useLargePages);
+    return m_stateArena.get();
+}
+
+bEngine::bEngineStateArena *const bEngine::bEngineApp::get_state_arena() const
+{
+    return m_stateArena.get();
+}
+
+const unsigned long long bEngine::bEngineApp::get_current_tick() const
+{
+    return m_currentTick;
+}
+
+const bool bEngine::bEngineApp::get_is_resimulating() const
+{
+    return m_isResimulating;
+}
+
+const bool bEngine::bEngineApp::request_rewind(const unsigned long long tick)
+{
+    if (m_isResimulating)
+        return false;
+
+    if (!m_stateArena || tick > m_currentTick || !m_stateArena->has_snapshot(tick))
+    {
+        WARNING_MSG(std::format("Cannot rewind to tick {}, it is not in the state arena's snapshot ring.", tick));
+        return false;
+    }
+
+    // if several rewinds are requested in the same frame, the earliest one wins (it covers all the others)
+    m_rewindTick        = (m_isRewindRequested && m_rewindTick < tick) ? m_rewindTick : tick;
+    m_isRewindRequested = true;
+    return true;
+}
+
 void bEngine::bEngineApp::quit()
 {
     INFO_MSG("Quitting...");
@@ -77,6 +122,11 @@ void bEngine::bEngineApp::run()
     double lastTime{bEngine::Platform::get_time()};
     double tickAccumulator{0.0};
 
+    // the state arena (if there is one) always holds a snapshot of the current tick, so the very first tick can be
+    // rewound to as well
+    if (m_stateArena)
+        m_stateArena->save_snapshot(m_currentTick);
+
     // the loop continues while the app is still running...
     while (m_isRunning)
     {
@@ -104,12 +154,33 @@ void bEngine::bEngineApp::run()
         if (m_updateFn)
             m_updateFn(deltaTime);
 
+        // if a rewind was requested, restore the requested tick's snapshot and resimulate back up to the current tick
+        // before any new ticks happen (so the rewind is invisible to everything but the simulation state)
+        if (m_isRewindRequested && m_stateArena->restore_snapshot(m_rewindTick))
+        {
+            const auto targetTick{m_currentTick};
+            m_isResimulating = true;
+            for (m_currentTick = m_rewindTick; m_currentTick < targetTick;)
+            {
+                if (m_tickFn)
+                    m_tickFn(m_tickLength);
+                m_stateArena->save_snapshot(++m_currentTick);
+            }
+            m_isResimulating = false;
+        }
+        m_isRewindRequested = false;
+
         // we tick as frequently as the tick rate (inverse of tick length) and we do multiple ticks if we somehow
         // lag/time-out
         while (m_tickFn && tickAccumulator >= m_tickLength)
         {
             m_tickFn(m_tickLength);
             tickAccumulator -= m_tickLength;
+
+            // snapshot every tick so any of the last N ticks can be rewound to
+            ++m_currentTick;
+            if (m_stateArena)
+                m_stateArena->save_snapshot(m_currentTick);
         }
 
         // now we'll check for windows which should close; if they should close we'll simply call the .reset() method
@@ -129,15 +200,22 @@ void bEngine::bEngineApp::run()
         m_windows = std::move(openWindows);
 
         // since we know all of the windows left in the vector are valid, we can just issue render commands to all of
-        // them without worrying about nullptrs!
-        for (auto &window : m_windows)
-        {
-            window->render();
-        }
+        // them without worrying about nullptrs! they're rendered in the order they were added, every frame
+        bEngineWindow::render_windows(m_windows, m_isPresentationPaced);
     }
 }
 
 void bEngine::bEngineApp::set_tick_length(const double tickLength)
 {
     m_tickLength = tickLength;
+}
+
+void bEngine::bEngineApp::set_is_presentation_paced(const bool isPresentationPaced)
+{
+    m_isPresentationPaced = isPresentationPaced;
+}
+
+const bool bEngine::bEngineApp::get_is_presentation_paced() const
+{
+    return m_isPresentationPaced;
 }
\ No newline at end of file
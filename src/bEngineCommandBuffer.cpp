@@ -0,0 +1,137 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineCommandBuffer.h"
+
+/// @file bEngineCommandBuffer.cpp
+/// @brief implementations for the bEngineCommandBuffer.h file
+
+#include "bEngineGL.h" // for the names of the GL objects commands reference
+
+namespace
+{
+    /// @brief gets the GL name of an (optional) GL object
+    /// @param object the object, or nullptr
+    /// @return the GL name of the object, or 0 if there isn't one
+    const unsigned int get_name_of(const bEngine::bEngineGLObject *const object)
+    {
+        return object ? object->get_name() : 0;
+    }
+} // namespace
+
+void bEngine::bEngineCommandBuffer::clear_color(
+    const std::uint64_t         sortKey,
+    const bEngineGLFramebuffer *framebuffer,
+    const float                 red,
+    const float                 green,
+    const float                 blue,
+    const float                 alpha)
+{
+    auto &command{m_commands.emplace_back()};
+    command.m_type        = bEngineRenderCommand::Type::ClearColor;
+    command.m_framebuffer = get_name_of(framebuffer);
+    command.m_clear       = {{red, green, blue, alpha}, 1.0f};
+    m_keys.push_back(sortKey);
+}
+
+void bEngine::bEngineCommandBuffer::clear_depth(
+    const std::uint64_t         sortKey,
+    const bEngineGLFramebuffer *framebuffer,
+    const float                 depth)
+{
+    auto &command{m_commands.emplace_back()};
+    command.m_type        = bEngineRenderCommand::Type::ClearDepth;
+    command.m_framebuffer = get_name_of(framebuffer);
+    command.m_clear       = {{0.0f, 0.0f, 0.0f, 0.0f}, depth};
+    m_keys.push_back(sortKey);
+}
+
+void bEngine::bEngineCommandBuffer::draw(const std::uint64_t sortKey, const bEngineDrawItem &item)
+{
+    record_draw(sortKey, item);
+}
+
+void bEngine::bEngineCommandBuffer::multi_draw_indirect(
+    const std::uint64_t    sortKey,
+    const bEngineDrawItem &item,
+    const bEngineGLBuffer &indirectBuffer,
+    const std::ptrdiff_t   indirectOffset,
+    const int              drawCount)
+{
+    auto &command{record_draw(sortKey, item)};
+    command.m_type                  = bEngineRenderCommand::Type::MultiDrawIndirect;
+    command.m_draw.m_indirectBuffer = indirectBuffer.get_name();
+    command.m_draw.m_indirectOffset = indirectOffset;
+    command.m_draw.m_count          = drawCount;
+}
+
+bEngine::bEngineRenderCommand &bEngine::bEngineCommandBuffer::record_draw(
+    const std::uint64_t    sortKey,
+    const bEngineDrawItem &item)
+{
+    auto &command{m_commands.emplace_back()};
+    command.m_type        = bEngineRenderCommand::Type::Draw;
+    command.m_state       = item.m_state;
+    command.m_framebuffer = get_name_of(item.m_framebuffer);
+    command.m_viewport    = item.m_viewport;
+
+    auto &draw{command.m_draw};
+    draw.m_program     = item.m_program ? item.m_program->get_drawable_name() : 0;
+    draw.m_vertexArray = get_name_of(item.m_vertexArray);
+    for (unsigned int unit{0}; unit < bEngineDrawItem::s_textureCount; ++unit)
+    {
+        draw.m_textures[unit] = get_name_of(item.m_textures[unit]);
+        draw.m_samplers[unit] = get_name_of(item.m_samplers[unit]);
+    }
+    draw.m_uniformBuffer = get_name_of(item.m_uniformBuffer);
+    draw.m_uniformOffset = item.m_uniformOffset;
+    draw.m_uniformSize   = (item.m_uniformBuffer && item.m_uniformSize == 0)
+                               ? item.m_uniformBuffer->get_size() - item.m_uniformOffset
+                               : item.m_uniformSize;
+    draw.m_materialBuffer = get_name_of(item.m_materialBuffer);
+    draw.m_materialOffset = item.m_materialOffset;
+    draw.m_materialSize   = (item.m_materialBuffer && item.m_materialSize == 0)
+                                ? item.m_materialBuffer->get_size() - item.m_materialOffset
+                                : item.m_materialSize;
+    draw.m_storageBuffer = get_name_of(item.m_storageBuffer);
+    draw.m_storageOffset = item.m_storageOffset;
+    draw.m_storageSize   = (item.m_storageBuffer && item.m_storageSize == 0)
+                               ? item.m_storageBuffer->get_size() - item.m_storageOffset
+                               : item.m_storageSize;
+    draw.m_mode          = item.m_mode;
+    draw.m_indexType     = item.m_indexType;
+    draw.m_first         = item.m_first;
+    draw.m_count         = item.m_count;
+    draw.m_instanceCount = item.m_instanceCount;
+    draw.m_baseVertex    = item.m_baseVertex;
+    draw.m_baseInstance  = item.m_baseInstance;
+
+    m_keys.push_back(sortKey);
+    return command;
+}
+
+void bEngine::bEngineCommandBuffer::reserve(const std::size_t commandCount)
+{
+    m_keys.reserve(commandCount);
+    m_commands.reserve(commandCount);
+}
+
+void bEngine::bEngineCommandBuffer::reset()
+{
+    m_keys.clear();
+    m_commands.clear();
+}
+
+const std::size_t bEngine::bEngineCommandBuffer::get_size() const
+{
+    return m_commands.size();
+}
+
+const std::vector<std::uint64_t> &bEngine::bEngineCommandBuffer::get_keys() const
+{
+    return m_keys;
+}
+
+const std::vector<bEngine::bEngineRenderCommand> &bEngine::bEngineCommandBuffer::get_commands() const
+{
+    return m_commands;
+}
\ No newline at end of file
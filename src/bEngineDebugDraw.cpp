@@ -0,0 +1,601 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineDebugDraw.h"
+
+/// @file bEngineDebugDraw.cpp
+/// @brief implementations for the bEngineDebugDraw.h and bEngineGLDebugDraw.h files
+
+#ifdef DEBUG
+
+#    include "bEngineFlatMap.h"     // for the windows' view projections
+#    include "bEngineGLContext.h"   // for the current context's limits
+#    include "bEngineGLDebugDraw.h" // for the windows' side of debug drawing
+#    include "bEngineUtilities.h"   // for access to warnings
+
+#    include <glm\gtc\matrix_transform.hpp> // for transforming unit cubes into boxes
+#    include <glm\gtc\packing.hpp>          // for packing debug vertex colors
+#    include <glm\gtc\type_ptr.hpp>         // for copying the view projection
+
+#    include <algorithm> // for compacting timed shapes
+#    include <array>     // for the stroke font
+#    include <chrono>    // for the durations of debug geometry
+#    include <cmath>     // for tessellating spheres
+#    include <cstdint>   // for fixed width integers
+#    include <cstring>   // for writing vertices and uniforms into mapped memory
+#    include <format>    // for formatting warnings
+#    include <memory>    // for sharing the threads' buffers with the registry
+#    include <mutex>     // for guarding the threads' buffers and the registry
+#    include <numbers>   // for the circle constant when tessellating spheres
+#    include <vector>    // for the debug vertices
+
+namespace
+{
+    /// @brief a vertex of a debug line as the debug program reads it
+    struct DebugVertex
+    {
+        /// @brief the world position of the vertex
+        float m_position[3];
+
+        /// @brief the screen space offset of the vertex from its projected position, in pixels (used by text labels)
+        float m_offset[2];
+
+        /// @brief the color of the vertex (RGBA8)
+        std::uint32_t m_color;
+    };
+
+    /// @brief a shape which is drawn until its duration has passed
+    struct TimedShape
+    {
+        /// @brief when the shape's duration passes
+        std::chrono::steady_clock::time_point m_expiry{};
+
+        /// @brief the number of vertices the shape was expanded into
+        std::size_t m_vertexCount{0};
+    };
+
+    /// @brief the debug geometry a thread has added since the last collection
+    struct ThreadBuffer
+    {
+        /// @brief guards the buffer against its collection (the only access from another thread)
+        std::mutex m_mutex;
+
+        /// @brief the vertices of the shapes which are drawn in the next frame only
+        std::vector<DebugVertex> m_frameVertices;
+
+        /// @brief the vertices of the shapes which are drawn until their duration has passed, in shape order
+        std::vector<DebugVertex> m_timedVertices;
+
+        /// @brief the shapes which are drawn until their duration has passed
+        std::vector<TimedShape> m_timedShapes;
+    };
+
+    /// @brief every thread's buffer, and the debug geometry collected from them
+    struct Registry
+    {
+        /// @brief guards the registry
+        std::mutex m_mutex;
+
+        /// @brief the buffer of every thread which has added debug geometry
+        std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+        /// @brief the vertices the current frame draws (its frame-only shapes, followed by every timed shape)
+        std::vector<DebugVertex> m_vertices;
+
+        /// @brief the vertices of the collected shapes which are drawn until their duration has passed
+        std::vector<DebugVertex> m_timedVertices;
+
+        /// @brief the collected shapes which are drawn until their duration has passed
+        std::vector<TimedShape> m_timedShapes;
+
+        /// @brief the view projection of each window which has set one
+        bEngine::bEngineFlatMap<const bEngine::bEngineWindow *, glm::mat4> m_viewProjections;
+    };
+
+    /// @brief the number of segments each of a debug sphere's circles is drawn with
+    constexpr int s_sphereSegments{24};
+
+    /// @brief the length of a debug arrow's head, relative to the arrow's length
+    constexpr float s_arrowHeadLength{0.2f};
+
+    /// @brief the half width of a debug arrow's head, relative to the arrow's length
+    constexpr float s_arrowHeadWidth{0.08f};
+
+    /// @brief the height of the stroke font's grid, in grid units (its width is 2, the advance 3)
+    constexpr float s_strokeFontHeight{4.0f};
+
+    /// @brief the stroke font, by ASCII code
+    ///
+    /// a glyph is a list of strokes between the points of a 3x5 grid, each point named by a letter in row order from
+    /// the bottom left: 'a'-'c' is the baseline (x 0 to 2), 'm'-'o' the top (y 4). Each stroke is a pair of letters;
+    /// spaces only separate strokes for readability. Codes without a glyph are drawn as a crossed box.
+    constexpr std::array<const char *, 128> s_strokeFont{[] {
+        std::array<const char *, 128> font{};
+        font['0'] = "ac co om ma ao";
+        font['1'] = "bn nj ac";
+        font['2'] = "mo oi ig ga ac";
+        font['3'] = "mo oc ca gi";
+        font['4'] = "mg gi oc";
+        font['5'] = "om mg gh hf fb ba";
+        font['6'] = "om ma ac ci ig";
+        font['7'] = "mo ob";
+        font['8'] = "ac co om ma gi";
+        font['9'] = "ac co om mg gi";
+        font['A'] = "aj jn nl lc gi";
+        font['B'] = "am mn nl lh hf fb ba gh";
+        font['C'] = "om ma ac";
+        font['D'] = "am mn nl lf fb ba";
+        font['E'] = "om ma ac gh";
+        font['F'] = "om ma gh";
+        font['G'] = "om ma ac ci ih";
+        font['H'] = "am oc gi";
+        font['I'] = "mo nb ac";
+        font['J'] = "no oc ca ad";
+        font['K'] = "am go gc";
+        font['L'] = "ma ac";
+        font['M'] = "am mh ho oc";
+        font['N'] = "am mc co";
+        font['O'] = "ac co om ma";
+        font['P'] = "am mo oi ig";
+        font['Q'] = "ac co om ma ec";
+        font['R'] = "am mo oi ig hc";
+        font['S'] = "om mg gi ic ca";
+        font['T'] = "mo nb";
+        font['U'] = "ma ac co";
+        font['V'] = "mb bo";
+        font['W'] = "ma ah hc co";
+        font['X'] = "ao mc";
+        font['Y'] = "mh ho hb";
+        font['Z'] = "mo oa ac";
+        font[' '] = "";
+        font['-'] = "gi";
+        font['+'] = "gi ek";
+        font['='] = "df jl";
+        font['_'] = "ac";
+        font['*'] = "dl jf ek";
+        font['/'] = "ao";
+        font['.'] = "be";
+        font[','] = "bd";
+        font[':'] = "be hk";
+        font['!'] = "nh be";
+        font['\''] = "nk";
+        font['"'] = "mj ol";
+        font['('] = "nj jd db";
+        font[')'] = "nl lf fb";
+        font['['] = "nm ma ab";
+        font[']'] = "no oc cb";
+        font['<'] = "lg gf";
+        font['>'] = "ji id";
+        return font;
+    }()};
+
+    /// @brief the strokes of codes without a glyph
+    constexpr const char *s_missingGlyph{"ac co om ma ao mc"};
+
+    /// @brief the debug program's vertex shader: projects each vertex, then moves it by its pixel offset
+    constexpr const char *s_vertexShader{R"(#version 460 core
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec2 a_offset;
+layout(location = 2) in vec4 a_color;
+
+layout(std140, binding = 0) uniform DebugDraw
+{
+    mat4 u_viewProjection;
+    vec2 u_viewportSize;
+};
+
+out vec4 v_color;
+
+void main()
+{
+    gl_Position = u_viewProjection * vec4(a_position, 1.0);
+    gl_Position.xy += a_offset * 2.0 / u_viewportSize * gl_Position.w;
+    v_color = a_color;
+}
+)"};
+
+    /// @brief the debug program's fragment shader
+    constexpr const char *s_fragmentShader{R"(#version 460 core
+in vec4 v_color;
+
+out vec4 o_color;
+
+void main()
+{
+    o_color = v_color;
+}
+)"};
+
+    /// @brief gets the registry
+    /// @return a reference to the registry
+    Registry &get_registry()
+    {
+        static Registry registry{};
+        return registry;
+    }
+
+    /// @brief gets the calling thread's buffer, registering it the first time
+    /// @return a reference to the calling thread's buffer
+    ThreadBuffer &get_thread_buffer()
+    {
+        thread_local const std::shared_ptr<ThreadBuffer> buffer{[] {
+            auto  created{std::make_shared<ThreadBuffer>()};
+            auto &registry{get_registry()};
+            std::scoped_lock lock{registry.m_mutex};
+            registry.m_buffers.push_back(created);
+            return created;
+        }()};
+        return *buffer;
+    }
+
+    /// @brief adds a shape to the calling thread's buffer, segment by segment; the buffer is locked for as long as
+    /// the writer exists
+    class ShapeWriter
+    {
+        // private data
+      private:
+        /// @brief the calling thread's buffer
+        ThreadBuffer &m_buffer;
+
+        /// @brief the lock on the buffer
+        std::scoped_lock<std::mutex> m_lock;
+
+        /// @brief the vertices the shape is added to
+        std::vector<DebugVertex> &m_vertices;
+
+        /// @brief the number of vertices in m_vertices before the shape was added
+        const std::size_t m_firstVertex{0};
+
+        /// @brief the color of the shape (RGBA8)
+        const std::uint32_t m_color{0};
+
+        /// @brief how long the shape is drawn for, in seconds
+        const double m_duration{0.0};
+
+        // public ctors/dtor
+      public:
+        /// @brief ctor which locks the calling thread's buffer
+        /// @param color the color of the shape
+        /// @param duration how long the shape is drawn for, in seconds (0 for the next frame only)
+        ShapeWriter(const glm::vec4 &color, const double duration)
+            : m_buffer{get_thread_buffer()},
+              m_lock{m_buffer.m_mutex},
+              m_vertices{duration > 0.0 ? m_buffer.m_timedVertices : m_buffer.m_frameVertices},
+              m_firstVertex{m_vertices.size()},
+              m_color{glm::packUnorm4x8(glm::clamp(color, 0.0f, 1.0f))},
+              m_duration{duration}
+        {
+        }
+
+        /// @brief dtor which records the shape's expiry (if it's timed) and unlocks the buffer
+        ~ShapeWriter()
+        {
+            if (m_duration > 0.0 && m_vertices.size() > m_firstVertex)
+            {
+                const auto expiry{
+                    std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(m_duration))};
+                m_buffer.m_timedShapes.push_back({expiry, m_vertices.size() - m_firstVertex});
+            }
+        }
+
+        // public methods/functions
+      public:
+        /// @brief adds a segment
+        /// @param from the world position of the start of the segment
+        /// @param to the world position of the end of the segment
+        /// @param fromOffset the pixel offset of the start of the segment
+        /// @param toOffset the pixel offset of the end of the segment
+        void add_segment(
+            const glm::vec3 &from,
+            const glm::vec3 &to,
+            const glm::vec2 &fromOffset = glm::vec2{0.0f},
+            const glm::vec2 &toOffset   = glm::vec2{0.0f})
+        {
+            m_vertices.push_back({{from.x, from.y, from.z}, {fromOffset.x, fromOffset.y}, m_color});
+            m_vertices.push_back({{to.x, to.y, to.z}, {toOffset.x, toOffset.y}, m_color});
+        }
+    };
+
+    /// @brief finds the point of the stroke font's grid a letter names
+    /// @param point the letter ('a'-'o')
+    /// @return the point, in grid units
+    const glm::vec2 get_stroke_point(const char point)
+    {
+        const auto index{point - 'a'};
+        return {static_cast<float>(index % 3), static_cast<float>(index / 3)};
+    }
+} // namespace
+
+void bEngine::bEngineDebugDraw::add_line(
+    const glm::vec3 &from,
+    const glm::vec3 &to,
+    const glm::vec4 &color,
+    const double     duration)
+{
+    ShapeWriter writer{color, duration};
+    writer.add_segment(from, to);
+}
+
+void bEngine::bEngineDebugDraw::add_box(
+    const glm::vec3 &min,
+    const glm::vec3 &max,
+    const glm::vec4 &color,
+    const double     duration)
+{
+    const auto transform{glm::translate(glm::mat4{1.0f}, (min + max) * 0.5f) * glm::scale(glm::mat4{1.0f}, max - min)};
+    add_box(transform, color, duration);
+}
+
+void bEngine::bEngineDebugDraw::add_box(const glm::mat4 &transform, const glm::vec4 &color, const double duration)
+{
+    // corner i has bit 0 set for +x, bit 1 for +y and bit 2 for +z; each edge joins corners differing in one bit
+    glm::vec3 corners[8];
+    for (int corner{0}; corner < 8; ++corner)
+    {
+        const glm::vec4 local{
+            (corner & 1) ? 0.5f : -0.5f,
+            (corner & 2) ? 0.5f : -0.5f,
+            (corner & 4) ? 0.5f : -0.5f,
+            1.0f};
+        corners[corner] = glm::vec3{transform * local};
+    }
+
+    ShapeWriter writer{color, duration};
+    for (int corner{0}; corner < 8; ++corner)
+    {
+        for (int axis{1}; axis < 8; axis <<= 1)
+        {
+            if (!(corner & axis))
+                writer.add_segment(corners[corner], corners[corner | axis]);
+        }
+    }
+}
+
+void bEngine::bEngineDebugDraw::add_sphere(
+    const glm::vec3 &center,
+    const float      radius,
+    const glm::vec4 &color,
+    const double     duration)
+{
+    ShapeWriter writer{color, duration};
+    const auto  step{2.0f * std::numbers::pi_v<float> / s_sphereSegments};
+    for (int segment{0}; segment < s_sphereSegments; ++segment)
+    {
+        const auto from{glm::vec2{std::cos(step * segment), std::sin(step * segment)} * radius};
+        const auto to{glm::vec2{std::cos(step * (segment + 1)), std::sin(step * (segment + 1))} * radius};
+        writer.add_segment(center + glm::vec3{from.x, from.y, 0.0f}, center + glm::vec3{to.x, to.y, 0.0f});
+        writer.add_segment(center + glm::vec3{from.x, 0.0f, from.y}, center + glm::vec3{to.x, 0.0f, to.y});
+        writer.add_segment(center + glm::vec3{0.0f, from.x, from.y}, center + glm::vec3{0.0f, to.x, to.y});
+    }
+}
+
+void bEngine::bEngineDebugDraw::add_arrow(
+    const glm::vec3 &from,
+    const glm::vec3 &to,
+    const glm::vec4 &color,
+    const double     duration)
+{
+    ShapeWriter writer{color, duration};
+    writer.add_segment(from, to);
+
+    const auto length{glm::length(to - from)};
+    if (length <= 0.0f)
+        return;
+
+    // the head is four lines back from the tip, spread along two axes perpendicular to the arrow
+    const auto direction{(to - from) / length};
+    const auto up{std::abs(direction.y) < 0.99f ? glm::vec3{0.0f, 1.0f, 0.0f} : glm::vec3{1.0f, 0.0f, 0.0f}};
+    const auto side{glm::normalize(glm::cross(direction, up)) * (length * s_arrowHeadWidth)};
+    const auto normal{glm::normalize(glm::cross(side, direction)) * (length * s_arrowHeadWidth)};
+    const auto base{to - direction * (length * s_arrowHeadLength)};
+    writer.add_segment(to, base + side);
+    writer.add_segment(to, base - side);
+    writer.add_segment(to, base + normal);
+    writer.add_segment(to, base - normal);
+}
+
+void bEngine::bEngineDebugDraw::add_text(
+    const glm::vec3       &position,
+    const std::string_view text,
+    const glm::vec4       &color,
+    const float            pixelHeight,
+    const double           duration)
+{
+    // every stroke is anchored at the label's position, and spelled out with pixel offsets from it
+    ShapeWriter writer{color, duration};
+    const auto  scale{pixelHeight / s_strokeFontHeight};
+    glm::vec2   pen{0.0f};
+    for (const auto character : text)
+    {
+        if (character == '\n')
+        {
+            pen = {0.0f, pen.y - (s_strokeFontHeight + 2.0f) * scale};
+            continue;
+        }
+
+        auto code{static_cast<unsigned char>(character)};
+        if (code >= 'a' && code <= 'z')
+            code = static_cast<unsigned char>(code - 'a' + 'A');
+        const char *strokes{code < s_strokeFont.size() ? s_strokeFont[code] : nullptr};
+        if (!strokes)
+            strokes = s_missingGlyph;
+
+        for (std::string_view remaining{strokes}; remaining.size() >= 2;)
+        {
+            if (remaining.front() == ' ')
+            {
+                remaining.remove_prefix(1);
+                continue;
+            }
+            writer.add_segment(
+                position,
+                position,
+                pen + get_stroke_point(remaining[0]) * scale,
+                pen + get_stroke_point(remaining[1]) * scale);
+            remaining.remove_prefix(2);
+        }
+        pen.x += 3.0f * scale;
+    }
+}
+
+void bEngine::bEngineDebugDraw::set_view_projection(const bEngineWindow &window, const glm::mat4 &viewProjection)
+{
+    auto            &registry{get_registry()};
+    std::scoped_lock lock{registry.m_mutex};
+    registry.m_viewProjections.insert_or_assign(&window, viewProjection);
+}
+
+void bEngine::bEngineDebugDraw::clear()
+{
+    auto            &registry{get_registry()};
+    std::scoped_lock lock{registry.m_mutex};
+    for (const auto &buffer : registry.m_buffers)
+    {
+        std::scoped_lock bufferLock{buffer->m_mutex};
+        buffer->m_frameVertices.clear();
+        buffer->m_timedVertices.clear();
+        buffer->m_timedShapes.clear();
+    }
+    registry.m_vertices.clear();
+    registry.m_timedVertices.clear();
+    registry.m_timedShapes.clear();
+}
+
+void bEngine::GL::collect_debug_draw()
+{
+    auto            &registry{get_registry()};
+    std::scoped_lock lock{registry.m_mutex};
+
+    // shapes collected by earlier frames are dropped once their duration has passed (new ones are drawn at least
+    // once, however short their duration)
+    const auto now{std::chrono::steady_clock::now()};
+    auto      &timedVertices{registry.m_timedVertices};
+    auto      &timedShapes{registry.m_timedShapes};
+    std::size_t keptVertices{0};
+    std::size_t keptShapes{0};
+    std::size_t vertex{0};
+    for (const auto &shape : timedShapes)
+    {
+        if (shape.m_expiry > now)
+        {
+            std::copy_n(timedVertices.begin() + vertex, shape.m_vertexCount, timedVertices.begin() + keptVertices);
+            keptVertices             += shape.m_vertexCount;
+            timedShapes[keptShapes++] = shape;
+        }
+        vertex += shape.m_vertexCount;
+    }
+    timedVertices.resize(keptVertices);
+    timedShapes.resize(keptShapes);
+
+    // the buffers of threads which have exited are only held by the registry, and are dropped once collected
+    registry.m_vertices.clear();
+    for (auto buffer{registry.m_buffers.begin()}; buffer != registry.m_buffers.end();)
+    {
+        {
+            std::scoped_lock bufferLock{(*buffer)->m_mutex};
+            auto            &source{**buffer};
+            registry.m_vertices.insert(
+                registry.m_vertices.end(),
+                source.m_frameVertices.begin(),
+                source.m_frameVertices.end());
+            timedVertices.insert(timedVertices.end(), source.m_timedVertices.begin(), source.m_timedVertices.end());
+            timedShapes.insert(timedShapes.end(), source.m_timedShapes.begin(), source.m_timedShapes.end());
+            source.m_frameVertices.clear();
+            source.m_timedVertices.clear();
+            source.m_timedShapes.clear();
+        }
+
+        if (buffer->use_count() == 1)
+            buffer = registry.m_buffers.erase(buffer);
+        else
+            ++buffer;
+    }
+    registry.m_vertices.insert(registry.m_vertices.end(), timedVertices.begin(), timedVertices.end());
+}
+
+void bEngine::GL::forget_debug_window(const bEngineWindow &window)
+{
+    auto            &registry{get_registry()};
+    std::scoped_lock lock{registry.m_mutex};
+    registry.m_viewProjections.erase(&window);
+}
+
+const bool bEngine::GL::has_debug_draw()
+{
+    auto            &registry{get_registry()};
+    std::scoped_lock lock{registry.m_mutex};
+    return !registry.m_vertices.empty();
+}
+
+bEngine::GL::DebugDrawRenderer::DebugDrawRenderer()
+    : m_streamBuffer{s_regionSize},
+      m_program{{GL_VERTEX_SHADER, s_vertexShader}, {GL_FRAGMENT_SHADER, s_fragmentShader}},
+      m_vertexArray{bEngineGLVertexArray::create_vertex_array()}
+{
+    GLint alignment{0};
+    GL::require_current_context().m_gl.GetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    m_uniformAlignment = alignment;
+
+    // vertices are read from the start of the stream buffer, and the draw offsets them with its first vertex
+    m_vertexArray.set_vertex_buffer(0, m_streamBuffer.get_buffer(), 0, sizeof(DebugVertex));
+    m_vertexArray.set_attribute(0, 0, 3, GL_FLOAT, false, offsetof(DebugVertex, m_position));
+    m_vertexArray.set_attribute(1, 0, 2, GL_FLOAT, false, offsetof(DebugVertex, m_offset));
+    m_vertexArray.set_attribute(2, 0, 4, GL_UNSIGNED_BYTE, true, offsetof(DebugVertex, m_color));
+}
+
+void bEngine::GL::DebugDrawRenderer::record(
+    bEngineCommandBuffer &commands,
+    const bEngineWindow  &window,
+    const int             viewportWidth,
+    const int             viewportHeight)
+{
+    auto            &registry{get_registry()};
+    std::scoped_lock lock{registry.m_mutex};
+    const auto      &vertices{registry.m_vertices};
+    if (vertices.empty() || viewportWidth <= 0 || viewportHeight <= 0)
+        return;
+
+    // the uniform block is a mat4 followed by a vec2, padded to a vec4 (std140)
+    constexpr std::ptrdiff_t stride{sizeof(DebugVertex)};
+    constexpr std::ptrdiff_t uniformSize{sizeof(glm::mat4) + sizeof(glm::vec4)};
+    const auto               size{static_cast<std::ptrdiff_t>(vertices.size()) * stride};
+
+    // vertices are found by their index, so the allocation has to start on a whole vertex; the stride isn't a power
+    // of two, so up to one vertex of extra space is allocated and the start is rounded up instead
+    auto allocation{m_streamBuffer.allocate(size + stride, 4)};
+    auto uniforms{m_streamBuffer.allocate(uniformSize, m_uniformAlignment)};
+    if (!allocation.m_data || !uniforms.m_data)
+    {
+        WARNING_MSG(std::format("Not enough debug draw space left this frame for {} vertices!", vertices.size()));
+        return;
+    }
+    const auto skip{(stride - allocation.m_offset % stride) % stride};
+    std::memcpy(static_cast<std::byte *>(allocation.m_data) + skip, vertices.data(), static_cast<std::size_t>(size));
+
+    const auto      found{registry.m_viewProjections.find(&window)};
+    const auto      viewProjection{found != registry.m_viewProjections.end() ? found->second : glm::mat4{1.0f}};
+    const glm::vec4 viewportSize{static_cast<float>(viewportWidth), static_cast<float>(viewportHeight), 0.0f, 0.0f};
+    std::memcpy(uniforms.m_data, glm::value_ptr(viewProjection), sizeof(glm::mat4));
+    std::memcpy(
+        static_cast<std::byte *>(uniforms.m_data) + sizeof(glm::mat4),
+        glm::value_ptr(viewportSize),
+        sizeof(glm::vec4));
+
+    // every shape is made of lines, so the whole frame's debug geometry is one draw, after everything else
+    bEngineDrawItem item{};
+    item.m_program       = &m_program;
+    item.m_vertexArray   = &m_vertexArray;
+    item.m_uniformBuffer = &m_streamBuffer.get_buffer();
+    item.m_uniformOffset = uniforms.m_offset;
+    item.m_uniformSize   = uniforms.m_size;
+    item.m_mode          = GL_LINES;
+    item.m_first         = static_cast<int>((allocation.m_offset + skip) / stride);
+    item.m_count         = static_cast<int>(vertices.size());
+    item.m_state.m_blend = bEngineBlendMode::Alpha;
+    item.m_state.m_depth = bEngineDepthMode::Disabled;
+    item.m_state.m_cull  = bEngineCullMode::None;
+    commands.draw(~std::uint64_t{0}, item);
+}
+
+#endif // DEBUG
\ No newline at end of file
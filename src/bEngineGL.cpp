@@ -0,0 +1,650 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGL.h"
+
+/// @file bEngineGL.cpp
+/// @brief implementations for the bEngineGL.h file
+
+#include "bEngineGLContext.h" // for the current context's function table, deletion queue and program builds
+#include "bEngineUtilities.h"  // for access to error messages
+
+#include <format>  // for formatting error messages
+#include <utility> // for exchange when moving wrappers
+
+namespace
+{
+    /// @brief gets the identifier glObjectLabel expects for a kind of object
+    /// @param type the kind of object
+    /// @return the GL identifier for the kind of object
+    const GLenum get_label_identifier(const bEngine::GL::ObjectType type)
+    {
+        using bEngine::GL::ObjectType;
+        switch (type)
+        {
+        case ObjectType::Buffer:
+            return GL_BUFFER;
+        case ObjectType::Texture:
+            return GL_TEXTURE;
+        case ObjectType::Sampler:
+            return GL_SAMPLER;
+        case ObjectType::Framebuffer:
+            return GL_FRAMEBUFFER;
+        case ObjectType::VertexArray:
+            return GL_VERTEX_ARRAY;
+        case ObjectType::Program:
+            return GL_PROGRAM;
+        }
+        return GL_NONE;
+    }
+
+    /// @brief gets the number of dimensions a texture target's storage has
+    /// @param target the texture target
+    /// @return 1 for 1D storage, 2 for 2D storage (2D textures, 1D arrays, cube maps) or 3 for 3D storage (3D
+    /// textures, 2D arrays, cube map arrays)
+    const int get_storage_dimensions(const GLenum target)
+    {
+        switch (target)
+        {
+        case GL_TEXTURE_1D:
+            return 1;
+        case GL_TEXTURE_3D:
+        case GL_TEXTURE_2D_ARRAY:
+        case GL_TEXTURE_CUBE_MAP:
+        case GL_TEXTURE_CUBE_MAP_ARRAY:
+            return 3;
+        default:
+            return 2;
+        }
+    }
+} // namespace
+
+#pragma region bEngineGLObject
+
+bEngine::bEngineGLObject::bEngineGLObject(const GL::ObjectType type, const unsigned int name)
+    : m_group{GL::require_current_context().m_group},
+      m_context{GL::get_is_shared(type) ? nullptr : GL::get_current_context()},
+      m_name{name},
+      m_type{type}
+{
+    if (m_context)
+        GL::track_local_object(*m_context, this);
+    else
+        GL::track_shared_object(*m_group, this);
+}
+
+bEngine::bEngineGLObject::bEngineGLObject(bEngineGLObject &&other) noexcept
+    : m_group{std::exchange(other.m_group, nullptr)},
+      m_context{std::exchange(other.m_context, nullptr)},
+      m_name{std::exchange(other.m_name, 0)},
+      m_type{other.m_type}
+{
+    if (m_context)
+        GL::untrack_local_object(*m_context, &other, this);
+    else if (m_group)
+        GL::untrack_shared_object(*m_group, &other, this);
+}
+
+bEngine::bEngineGLObject &bEngine::bEngineGLObject::operator=(bEngineGLObject &&other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        m_group   = std::exchange(other.m_group, nullptr);
+        m_context = std::exchange(other.m_context, nullptr);
+        m_name    = std::exchange(other.m_name, 0);
+        m_type    = other.m_type;
+        if (m_context)
+            GL::untrack_local_object(*m_context, &other, this);
+        else if (m_group)
+            GL::untrack_shared_object(*m_group, &other, this);
+    }
+    return *this;
+}
+
+bEngine::bEngineGLObject::~bEngineGLObject()
+{
+    reset();
+}
+
+bEngine::GL::Context *const bEngine::bEngineGLObject::get_context() const
+{
+    if (m_context || !m_group)
+        return m_context;
+
+    // a shared object is used through whichever member of its group is current
+    auto &context{GL::require_current_context()};
+    bENGINE_ASSERT(context.m_group == m_group, "GL objects can only be used on a context of the group they belong to!");
+    return &context;
+}
+
+bEngine::GL::ContextGroup *const bEngine::bEngineGLObject::get_group() const
+{
+    return m_group;
+}
+
+const unsigned int bEngine::bEngineGLObject::get_name() const
+{
+    return m_name;
+}
+
+const bool bEngine::bEngineGLObject::get_is_valid() const
+{
+    return m_name != 0;
+}
+
+void bEngine::bEngineGLObject::set_label(const std::string_view label) const
+{
+    if (m_group)
+        get_context()->m_gl.ObjectLabel(
+            get_label_identifier(m_type),
+            m_name,
+            static_cast<GLsizei>(label.size()),
+            label.data());
+}
+
+void bEngine::bEngineGLObject::reset()
+{
+    if (m_context)
+    {
+        GL::untrack_local_object(*m_context, this);
+        GL::queue_deletion(*m_context, m_type, m_name);
+    }
+    else if (m_group)
+    {
+        GL::untrack_shared_object(*m_group, this);
+        GL::queue_deletion(*m_group, m_type, m_name);
+    }
+
+    m_group   = nullptr;
+    m_context = nullptr;
+    m_name    = 0;
+}
+
+#pragma endregion
+
+#pragma region bEngineGLBuffer
+
+bEngine::bEngineGLBuffer::bEngineGLBuffer(
+    const std::ptrdiff_t size,
+    const void *const    data,
+    const unsigned int   storageFlags)
+    : bEngineGLObject{GL::ObjectType::Buffer, [] {
+                          GLuint name{0};
+                          GL::require_current_context().m_gl.CreateBuffers(1, &name);
+                          return name;
+                      }()},
+      m_size{size}
+{
+    get_context()->m_gl.NamedBufferStorage(get_name(), m_size, data, storageFlags);
+}
+
+const std::ptrdiff_t bEngine::bEngineGLBuffer::get_size() const
+{
+    return m_size;
+}
+
+void bEngine::bEngineGLBuffer::upload(
+    const std::ptrdiff_t offset,
+    const std::ptrdiff_t size,
+    const void *const    data) const
+{
+    get_context()->m_gl.NamedBufferSubData(get_name(), offset, size, data);
+}
+
+void bEngine::bEngineGLBuffer::copy_to(
+    const bEngineGLBuffer &destination,
+    const std::ptrdiff_t   readOffset,
+    const std::ptrdiff_t   writeOffset,
+    const std::ptrdiff_t   size) const
+{
+    get_context()->m_gl.CopyNamedBufferSubData(get_name(), destination.get_name(), readOffset, writeOffset, size);
+}
+
+void *const bEngine::bEngineGLBuffer::map_range(
+    const std::ptrdiff_t offset,
+    const std::ptrdiff_t length,
+    const unsigned int   access) const
+{
+    return get_context()->m_gl.MapNamedBufferRange(get_name(), offset, length, access);
+}
+
+const bool bEngine::bEngineGLBuffer::unmap() const
+{
+    return get_context()->m_gl.UnmapNamedBuffer(get_name()) == GL_TRUE;
+}
+
+void bEngine::bEngineGLBuffer::bind_base(
+    const unsigned int   target,
+    const unsigned int   index,
+    const std::ptrdiff_t offset,
+    const std::ptrdiff_t size) const
+{
+    // binding a range of the buffer is the only binding needed to use it; there is no bind-to-edit anywhere
+    get_context()->m_gl.BindBufferRange(target, index, get_name(), offset, size ? size : m_size - offset);
+}
+
+#pragma endregion
+
+#pragma region bEngineGLTexture
+
+bEngine::bEngineGLTexture::bEngineGLTexture(
+    const unsigned int target,
+    const int          levels,
+    const unsigned int internalFormat,
+    const int          width,
+    const int          height,
+    const int          depth)
+    : bEngineGLObject{GL::ObjectType::Texture, [target] {
+                          GLuint name{0};
+                          GL::require_current_context().m_gl.CreateTextures(target, 1, &name);
+                          return name;
+                      }()},
+      m_target{target},
+      m_internalFormat{internalFormat},
+      m_levels{levels},
+      m_size{width, height, depth}
+{
+    const auto &gl{get_context()->m_gl};
+    switch (get_storage_dimensions(m_target))
+    {
+    case 1:
+        gl.TextureStorage1D(get_name(), m_levels, m_internalFormat, width);
+        break;
+    case 2:
+        gl.TextureStorage2D(get_name(), m_levels, m_internalFormat, width, height);
+        break;
+    default:
+        // cube maps are allocated as 2D storage, their faces are only addressed as layers when uploading
+        if (m_target == GL_TEXTURE_CUBE_MAP)
+            gl.TextureStorage2D(get_name(), m_levels, m_internalFormat, width, height);
+        else
+            gl.TextureStorage3D(get_name(), m_levels, m_internalFormat, width, height, depth);
+        break;
+    }
+}
+
+const unsigned int bEngine::bEngineGLTexture::get_target() const
+{
+    return m_target;
+}
+
+const unsigned int bEngine::bEngineGLTexture::get_internal_format() const
+{
+    return m_internalFormat;
+}
+
+const int bEngine::bEngineGLTexture::get_levels() const
+{
+    return m_levels;
+}
+
+const int bEngine::bEngineGLTexture::get_width() const
+{
+    return m_size[0];
+}
+
+const int bEngine::bEngineGLTexture::get_height() const
+{
+    return m_size[1];
+}
+
+const int bEngine::bEngineGLTexture::get_depth() const
+{
+    return m_size[2];
+}
+
+void bEngine::bEngineGLTexture::upload(
+    const int          level,
+    const int          x,
+    const int          y,
+    const int          z,
+    const int          width,
+    const int          height,
+    const int          depth,
+    const unsigned int format,
+    const unsigned int type,
+    const void *const  texels) const
+{
+    const auto &gl{get_context()->m_gl};
+    switch (get_storage_dimensions(m_target))
+    {
+    case 1:
+        gl.TextureSubImage1D(get_name(), level, x, width, format, type, texels);
+        break;
+    case 2:
+        gl.TextureSubImage2D(get_name(), level, x, y, width, height, format, type, texels);
+        break;
+    default:
+        // with DSA, the faces of a cube map are uploaded as the layers of a 3D region
+        gl.TextureSubImage3D(get_name(), level, x, y, z, width, height, depth, format, type, texels);
+        break;
+    }
+}
+
+void bEngine::bEngineGLTexture::generate_mipmaps() const
+{
+    get_context()->m_gl.GenerateTextureMipmap(get_name());
+}
+
+void bEngine::bEngineGLTexture::set_parameter(const unsigned int parameter, const int value) const
+{
+    get_context()->m_gl.TextureParameteri(get_name(), parameter, value);
+}
+
+void bEngine::bEngineGLTexture::set_parameter(const unsigned int parameter, const float value) const
+{
+    get_context()->m_gl.TextureParameterf(get_name(), parameter, value);
+}
+
+void bEngine::bEngineGLTexture::bind_to_unit(const unsigned int unit) const
+{
+    get_context()->m_stateCache.set_texture(unit, get_name());
+}
+
+#pragma endregion
+
+#pragma region bEngineGLSampler
+
+bEngine::bEngineGLSampler::bEngineGLSampler(
+    const unsigned int minFilter,
+    const unsigned int magFilter,
+    const unsigned int wrapMode)
+    : bEngineGLObject{GL::ObjectType::Sampler, [] {
+                          GLuint name{0};
+                          GL::require_current_context().m_gl.CreateSamplers(1, &name);
+                          return name;
+                      }()}
+{
+    set_parameter(GL_TEXTURE_MIN_FILTER, static_cast<int>(minFilter));
+    set_parameter(GL_TEXTURE_MAG_FILTER, static_cast<int>(magFilter));
+    set_parameter(GL_TEXTURE_WRAP_S, static_cast<int>(wrapMode));
+    set_parameter(GL_TEXTURE_WRAP_T, static_cast<int>(wrapMode));
+    set_parameter(GL_TEXTURE_WRAP_R, static_cast<int>(wrapMode));
+}
+
+void bEngine::bEngineGLSampler::set_parameter(const unsigned int parameter, const int value) const
+{
+    get_context()->m_gl.SamplerParameteri(get_name(), parameter, value);
+}
+
+void bEngine::bEngineGLSampler::set_parameter(const unsigned int parameter, const float value) const
+{
+    get_context()->m_gl.SamplerParameterf(get_name(), parameter, value);
+}
+
+void bEngine::bEngineGLSampler::bind_to_unit(const unsigned int unit) const
+{
+    get_context()->m_stateCache.set_sampler(unit, get_name());
+}
+
+#pragma endregion
+
+#pragma region bEngineGLFramebuffer
+
+bEngine::bEngineGLFramebuffer::bEngineGLFramebuffer(const unsigned int name)
+    : bEngineGLObject{GL::ObjectType::Framebuffer, name} { };
+
+bEngine::bEngineGLFramebuffer bEngine::bEngineGLFramebuffer::create_framebuffer()
+{
+    GLuint name{0};
+    GL::require_current_context().m_gl.CreateFramebuffers(1, &name);
+    return bEngineGLFramebuffer{name};
+}
+
+void bEngine::bEngineGLFramebuffer::attach_texture(
+    const unsigned int      attachment,
+    const bEngineGLTexture &texture,
+    const int               level) const
+{
+    get_context()->m_gl.NamedFramebufferTexture(get_name(), attachment, texture.get_name(), level);
+}
+
+void bEngine::bEngineGLFramebuffer::attach_texture_layer(
+    const unsigned int      attachment,
+    const bEngineGLTexture &texture,
+    const int               level,
+    const int               layer) const
+{
+    get_context()->m_gl.NamedFramebufferTextureLayer(get_name(), attachment, texture.get_name(), level, layer);
+}
+
+void bEngine::bEngineGLFramebuffer::set_draw_buffers(std::initializer_list<unsigned int> drawBuffers) const
+{
+    get_context()->m_gl.NamedFramebufferDrawBuffers(
+        get_name(),
+        static_cast<GLsizei>(drawBuffers.size()),
+        drawBuffers.begin());
+}
+
+const bool bEngine::bEngineGLFramebuffer::get_is_complete() const
+{
+    const auto status{get_context()->m_gl.CheckNamedFramebufferStatus(get_name(), GL_FRAMEBUFFER)};
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        WARNING_MSG(std::format("Framebuffer #{} is incomplete (status 0x{:X}).", get_name(), status));
+        return false;
+    }
+    return true;
+}
+
+void bEngine::bEngineGLFramebuffer::clear_color(const int drawBuffer, const float color[4]) const
+{
+    // clears respect fixed-function state (e.g. the depth mask), so any pending state is applied first
+    get_context()->m_stateCache.flush(get_context()->m_gl);
+    get_context()->m_gl.ClearNamedFramebufferfv(get_name(), GL_COLOR, drawBuffer, color);
+}
+
+void bEngine::bEngineGLFramebuffer::clear_depth(const float depth) const
+{
+    get_context()->m_stateCache.flush(get_context()->m_gl);
+    get_context()->m_gl.ClearNamedFramebufferfv(get_name(), GL_DEPTH, 0, &depth);
+}
+
+void bEngine::bEngineGLFramebuffer::bind(const unsigned int target) const
+{
+    get_context()->m_stateCache.set_framebuffer(target, get_name());
+}
+
+#pragma endregion
+
+#pragma region bEngineGLVertexArray
+
+bEngine::bEngineGLVertexArray::bEngineGLVertexArray(const unsigned int name)
+    : bEngineGLObject{GL::ObjectType::VertexArray, name} { };
+
+bEngine::bEngineGLVertexArray bEngine::bEngineGLVertexArray::create_vertex_array()
+{
+    GLuint name{0};
+    GL::require_current_context().m_gl.CreateVertexArrays(1, &name);
+    return bEngineGLVertexArray{name};
+}
+
+void bEngine::bEngineGLVertexArray::set_vertex_buffer(
+    const unsigned int     bindingIndex,
+    const bEngineGLBuffer &buffer,
+    const std::ptrdiff_t   offset,
+    const int              stride) const
+{
+    get_context()->m_gl.VertexArrayVertexBuffer(get_name(), bindingIndex, buffer.get_name(), offset, stride);
+}
+
+void bEngine::bEngineGLVertexArray::set_element_buffer(const bEngineGLBuffer &buffer) const
+{
+    get_context()->m_gl.VertexArrayElementBuffer(get_name(), buffer.get_name());
+}
+
+void bEngine::bEngineGLVertexArray::set_attribute(
+    const unsigned int attributeIndex,
+    const unsigned int bindingIndex,
+    const int          componentCount,
+    const unsigned int type,
+    const bool         isNormalized,
+    const unsigned int relativeOffset) const
+{
+    const auto &gl{get_context()->m_gl};
+    gl.EnableVertexArrayAttrib(get_name(), attributeIndex);
+    gl.VertexArrayAttribFormat(
+        get_name(),
+        attributeIndex,
+        componentCount,
+        type,
+        isNormalized ? GL_TRUE : GL_FALSE,
+        relativeOffset);
+    gl.VertexArrayAttribBinding(get_name(), attributeIndex, bindingIndex);
+}
+
+void bEngine::bEngineGLVertexArray::set_integer_attribute(
+    const unsigned int attributeIndex,
+    const unsigned int bindingIndex,
+    const int          componentCount,
+    const unsigned int type,
+    const unsigned int relativeOffset) const
+{
+    const auto &gl{get_context()->m_gl};
+    gl.EnableVertexArrayAttrib(get_name(), attributeIndex);
+    gl.VertexArrayAttribIFormat(get_name(), attributeIndex, componentCount, type, relativeOffset);
+    gl.VertexArrayAttribBinding(get_name(), attributeIndex, bindingIndex);
+}
+
+void bEngine::bEngineGLVertexArray::set_binding_divisor(
+    const unsigned int bindingIndex,
+    const unsigned int divisor) const
+{
+    get_context()->m_gl.VertexArrayBindingDivisor(get_name(), bindingIndex, divisor);
+}
+
+void bEngine::bEngineGLVertexArray::bind() const
+{
+    get_context()->m_stateCache.set_vertex_array(get_name());
+}
+
+#pragma endregion
+
+#pragma region bEngineGLProgram
+
+bEngine::bEngineGLProgram::bEngineGLProgram(
+    std::initializer_list<bEngineGLShaderSource> stages,
+    const std::string_view                       defines,
+    const bEngineGLProgram *const                placeholder,
+    const bool                                   isAsync)
+    : bEngineGLObject{GL::ObjectType::Program, GL::require_current_context().m_gl.CreateProgram()},
+      m_build{std::make_shared<GL::ProgramBuild>(get_name(), stages, defines)},
+      m_placeholder{placeholder}
+{
+    GL::submit_program_build(*get_context(), m_build, isAsync);
+}
+
+bEngine::bEngineGLProgram bEngine::bEngineGLProgram::create_program_async(
+    std::initializer_list<bEngineGLShaderSource> stages,
+    const std::string_view                       defines,
+    const bEngineGLProgram *const                placeholder)
+{
+    return bEngineGLProgram{stages, defines, placeholder, true};
+}
+
+bEngine::bEngineGLProgram::bEngineGLProgram(
+    std::initializer_list<bEngineGLShaderSource> stages,
+    const std::string_view                       defines)
+    : bEngineGLProgram{stages, defines, nullptr, false}
+{
+}
+
+const bool bEngine::bEngineGLProgram::get_is_ready() const
+{
+    if (!get_is_valid())
+        return true;
+
+    // any member of the program's group may query (and so finish) the build, on the thread it's current on
+    if (auto *const context{GL::get_current_context()}; context && context->m_group == get_group())
+        return GL::poll_program_build(*context, *m_build);
+    return m_build->m_state.load(std::memory_order_acquire) != GL::BuildState::Pending;
+}
+
+const bool bEngine::bEngineGLProgram::get_is_linked() const
+{
+    if (!get_is_valid())
+        return false;
+
+    GL::wait_for_program_build(*get_context(), *m_build);
+    return m_build->m_state.load(std::memory_order_acquire) == GL::BuildState::Linked;
+}
+
+const std::string &bEngine::bEngineGLProgram::get_info_log() const
+{
+    static const std::string s_emptyInfoLog{""};
+    if (!get_is_valid())
+        return s_emptyInfoLog;
+
+    GL::wait_for_program_build(*get_context(), *m_build);
+    return m_build->m_infoLog;
+}
+
+const unsigned int bEngine::bEngineGLProgram::get_drawable_name() const
+{
+    if (get_is_valid() && m_build->m_state.load(std::memory_order_acquire) == GL::BuildState::Linked)
+        return get_name();
+    return m_placeholder ? m_placeholder->get_drawable_name() : 0;
+}
+
+const int bEngine::bEngineGLProgram::get_uniform_location(const char *const name) const
+{
+    // an asynchronously created program may still be compiling/linking, and GL needs a linked program here
+    GL::wait_for_program_build(*get_context(), *m_build);
+    return get_context()->m_gl.GetUniformLocation(get_name(), name);
+}
+
+void bEngine::bEngineGLProgram::set_uniform(const int location, const int value) const
+{
+    GL::wait_for_program_build(*get_context(), *m_build);
+    get_context()->m_gl.ProgramUniform1i(get_name(), location, value);
+}
+
+void bEngine::bEngineGLProgram::set_uniform(const int location, const float value) const
+{
+    GL::wait_for_program_build(*get_context(), *m_build);
+    get_context()->m_gl.ProgramUniform1f(get_name(), location, value);
+}
+
+void bEngine::bEngineGLProgram::set_uniform_vectors(
+    const int          location,
+    const int          componentCount,
+    const int          count,
+    const float *const values) const
+{
+    const auto &gl{get_context()->m_gl};
+    GL::wait_for_program_build(*get_context(), *m_build);
+    switch (componentCount)
+    {
+    case 1:
+        gl.ProgramUniform1fv(get_name(), location, count, values);
+        break;
+    case 2:
+        gl.ProgramUniform2fv(get_name(), location, count, values);
+        break;
+    case 3:
+        gl.ProgramUniform3fv(get_name(), location, count, values);
+        break;
+    case 4:
+        gl.ProgramUniform4fv(get_name(), location, count, values);
+        break;
+    default:
+        ERROR_MSG(std::format("Uniform vectors must have 1-4 components, not {}.", componentCount));
+        break;
+    }
+}
+
+void bEngine::bEngineGLProgram::set_uniform_matrices(
+    const int          location,
+    const int          count,
+    const float *const values) const
+{
+    GL::wait_for_program_build(*get_context(), *m_build);
+    get_context()->m_gl.ProgramUniformMatrix4fv(get_name(), location, count, GL_FALSE, values);
+}
+
+void bEngine::bEngineGLProgram::use() const
+{
+    get_context()->m_stateCache.set_program(get_drawable_name());
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLBlockAllocator.h"
+
+/// @file bEngineGLBlockAllocator.cpp
+/// @brief implementations for the bEngineGLBlockAllocator.h file
+
+#include "bEngineGLContext.h" // for the current context's limits
+#include "bEngineUtilities.h" // for access to assertions and warnings
+
+#include <algorithm> // for the larger of the two alignments
+#include <cstring>   // for writing per-frame blocks into mapped memory
+#include <format>    // for formatting info messages and warnings
+
+bEngine::bEngineGLBlockAllocator::bEngineGLBlockAllocator(
+    bEngineGLStreamBuffer &streamBuffer,
+    const std::ptrdiff_t   capacity)
+    : m_streamBuffer{&streamBuffer}
+{
+    bENGINE_ASSERT(capacity > 0, "A block allocator needs some capacity!");
+
+    // both alignments are powers of two, so blocks aligned to the larger one can be bound as either kind of block
+    const auto &gl{GL::require_current_context().m_gl};
+    GLint       uniformAlignment{0};
+    GLint       storageAlignment{0};
+    gl.GetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+    gl.GetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+    m_alignment = std::max({uniformAlignment, storageAlignment, 16});
+
+    m_buffer                 = bEngineGLBuffer{align(capacity), nullptr, GL_DYNAMIC_STORAGE_BIT};
+    m_stats.m_capacity       = m_buffer.get_size();
+    m_stats.m_freeRangeCount = 1;
+    m_freeRanges.push_back({0, m_stats.m_capacity});
+}
+
+const bEngine::bEngineGLBufferBlock bEngine::bEngineGLBlockAllocator::allocate(
+    const std::ptrdiff_t size,
+    const void *const    data)
+{
+    bENGINE_ASSERT(size > 0, "A block can't be empty!");
+    const auto alignedSize{align(size)};
+
+    // first fit: the lowest free range large enough, so blocks pack towards the start of the buffer
+    auto range{std::find_if(
+        m_freeRanges.begin(),
+        m_freeRanges.end(),
+        [alignedSize](const FreeRange &free) { return free.m_size >= alignedSize; })};
+    if (range == m_freeRanges.end())
+    {
+        grow(alignedSize);
+        range = std::prev(m_freeRanges.end());
+    }
+
+    const bEngineGLBufferBlock block{&m_buffer, range->m_offset, alignedSize};
+    range->m_offset += alignedSize;
+    range->m_size   -= alignedSize;
+    if (range->m_size == 0)
+        m_freeRanges.erase(range);
+
+    if (data)
+        m_buffer.upload(block.m_offset, size, data);
+
+    ++m_stats.m_blockCount;
+    m_stats.m_usedBytes      += alignedSize;
+    m_stats.m_freeRangeCount  = m_freeRanges.size();
+    return block;
+}
+
+void bEngine::bEngineGLBlockAllocator::update(
+    const bEngineGLBufferBlock &block,
+    const void *const           data,
+    const std::ptrdiff_t        size,
+    const std::ptrdiff_t        offset)
+{
+    bENGINE_ASSERT(block.m_buffer == &m_buffer, "Only the allocator's persistent blocks can be updated!");
+    const auto writeSize{size == 0 ? block.m_size - offset : size};
+    bENGINE_ASSERT(offset >= 0 && offset + writeSize <= block.m_size, "A block update can't write past the block!");
+
+    // the write is issued now, ahead of the frame's recorded (but not yet executed) draws
+    m_buffer.upload(block.m_offset + offset, writeSize, data);
+}
+
+void bEngine::bEngineGLBlockAllocator::free(bEngineGLBufferBlock &block)
+{
+    if (!block.get_is_valid())
+        return;
+    bENGINE_ASSERT(block.m_buffer == &m_buffer, "Only the allocator's persistent blocks can be freed!");
+
+    // the freed range is merged with the free ranges it touches, so the free list stays as short as possible
+    auto next{std::find_if(
+        m_freeRanges.begin(),
+        m_freeRanges.end(),
+        [&block](const FreeRange &free) { return free.m_offset > block.m_offset; })};
+    auto freed{m_freeRanges.insert(next, {block.m_offset, block.m_size})};
+    if (const auto following{std::next(freed)};
+        following != m_freeRanges.end() && freed->m_offset + freed->m_size == following->m_offset)
+    {
+        freed->m_size += following->m_size;
+        m_freeRanges.erase(following);
+    }
+    if (freed != m_freeRanges.begin())
+    {
+        if (const auto previous{std::prev(freed)}; previous->m_offset + previous->m_size == freed->m_offset)
+        {
+            previous->m_size += freed->m_size;
+            m_freeRanges.erase(freed);
+        }
+    }
+
+    --m_stats.m_blockCount;
+    m_stats.m_usedBytes      -= block.m_size;
+    m_stats.m_freeRangeCount  = m_freeRanges.size();
+    block                     = {};
+}
+
+const bEngine::bEngineGLBufferBlock bEngine::bEngineGLBlockAllocator::allocate_frame(
+    const std::ptrdiff_t size,
+    const void *const    data)
+{
+    const auto alignedSize{align(size)};
+    auto       allocation{m_streamBuffer->allocate(alignedSize, m_alignment)};
+    if (!allocation.m_data)
+    {
+        WARNING_MSG(std::format("Not enough stream buffer space left this frame for a {} byte block!", size));
+        return {};
+    }
+
+    if (data)
+        std::memcpy(allocation.m_data, data, static_cast<std::size_t>(size));
+    return {&m_streamBuffer->get_buffer(), allocation.m_offset, alignedSize, allocation.m_data};
+}
+
+const std::ptrdiff_t bEngine::bEngineGLBlockAllocator::get_alignment() const
+{
+    return m_alignment;
+}
+
+const bEngine::bEngineBlockAllocatorStats bEngine::bEngineGLBlockAllocator::get_stats() const
+{
+    return m_stats;
+}
+
+void bEngine::bEngineGLBlockAllocator::set_uniform_block(bEngineDrawItem &item, const bEngineGLBufferBlock &block)
+{
+    item.m_uniformBuffer = block.m_buffer;
+    item.m_uniformOffset = block.m_offset;
+    item.m_uniformSize   = block.m_size;
+}
+
+void bEngine::bEngineGLBlockAllocator::set_material_block(bEngineDrawItem &item, const bEngineGLBufferBlock &block)
+{
+    item.m_materialBuffer = block.m_buffer;
+    item.m_materialOffset = block.m_offset;
+    item.m_materialSize   = block.m_size;
+}
+
+void bEngine::bEngineGLBlockAllocator::set_storage_block(bEngineDrawItem &item, const bEngineGLBufferBlock &block)
+{
+    item.m_storageBuffer = block.m_buffer;
+    item.m_storageOffset = block.m_offset;
+    item.m_storageSize   = block.m_size;
+}
+
+const std::ptrdiff_t bEngine::bEngineGLBlockAllocator::align(const std::ptrdiff_t size) const
+{
+    return (size + m_alignment - 1) & ~(m_alignment - 1);
+}
+
+void bEngine::bEngineGLBlockAllocator::grow(const std::ptrdiff_t size)
+{
+    // the free range at the end of the buffer (if any) is extended, so it's the one which ends up large enough
+    const auto oldSize{m_buffer.get_size()};
+    const auto tailFree{
+        !m_freeRanges.empty() && m_freeRanges.back().m_offset + m_freeRanges.back().m_size == oldSize
+            ? m_freeRanges.back().m_size
+            : 0};
+    auto newSize{oldSize};
+    while (newSize - oldSize + tailFree < size)
+        newSize *= 2;
+
+    // the blocks are copied on the GPU and keep their offsets; draws recorded before the copy still refer to the old
+    // buffer, which is only deleted at the next frame-safe point, once they've executed
+    bEngineGLBuffer grown{newSize, nullptr, GL_DYNAMIC_STORAGE_BIT};
+    m_buffer.copy_to(grown, 0, 0, oldSize);
+    m_buffer = std::move(grown);
+
+    if (tailFree > 0)
+        m_freeRanges.back().m_size += newSize - oldSize;
+    else
+        m_freeRanges.push_back({oldSize, newSize - oldSize});
+
+    ++m_stats.m_growCount;
+    m_stats.m_capacity = newSize;
+    INFO_MSG(std::format("Grew a block allocator's persistent buffer to {} bytes.", newSize));
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLCommandQueue.h"
+
+/// @file bEngineGLCommandQueue.cpp
+/// @brief implementations for the bEngineGLCommandQueue.h file
+
+#include "bEngineGLContext.h" // for the context's function table and state cache
+
+#include <algorithm> // for copying the sorted entries
+#include <iterator>  // for moving the submitted buffers
+#include <utility>   // for swapping the radix sort's buffers
+
+namespace
+{
+    /// @brief applies the fixed-function state of a command to the state cache
+    /// @param cache the state cache of the context
+    /// @param state the state to apply
+    void apply_render_state(bEngine::GL::StateCache &cache, const bEngine::bEngineRenderState &state)
+    {
+        using namespace bEngine;
+
+        switch (state.m_blend)
+        {
+        case bEngineBlendMode::Opaque:
+            cache.set_blend(false, GL_ONE, GL_ZERO);
+            break;
+        case bEngineBlendMode::Alpha:
+            cache.set_blend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case bEngineBlendMode::Premultiplied:
+            cache.set_blend(true, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case bEngineBlendMode::Additive:
+            cache.set_blend(true, GL_SRC_ALPHA, GL_ONE);
+            break;
+        }
+
+        cache.set_depth(
+            state.m_depth != bEngineDepthMode::Disabled,
+            state.m_depth == bEngineDepthMode::TestAndWrite,
+            GL_LEQUAL);
+        cache.set_cull_face(
+            state.m_cull != bEngineCullMode::None,
+            state.m_cull == bEngineCullMode::Front ? GL_FRONT : GL_BACK);
+    }
+
+    /// @brief gets the size of an index type
+    /// @param indexType the type of the indices (GL_UNSIGNED_BYTE/SHORT/INT)
+    /// @return the size of a single index, in bytes
+    const std::uintptr_t get_index_size(const GLenum indexType)
+    {
+        switch (indexType)
+        {
+        case GL_UNSIGNED_BYTE:
+            return 1;
+        case GL_UNSIGNED_SHORT:
+            return 2;
+        default:
+            return 4;
+        }
+    }
+
+    /// @brief the range of a buffer bound to an indexed buffer binding, which the state cache doesn't shadow
+    struct BufferRangeBinding
+    {
+        /// @brief the target of the binding (e.g. GL_UNIFORM_BUFFER)
+        const GLenum m_target{GL_NONE};
+
+        /// @brief the index of the binding
+        const GLuint m_index{0};
+
+        /// @brief the name of the bound buffer
+        unsigned int m_buffer{0};
+
+        /// @brief the offset of the bound range, in bytes
+        std::ptrdiff_t m_offset{0};
+
+        /// @brief the size of the bound range, in bytes
+        std::ptrdiff_t m_size{0};
+
+        /// @brief binds a range of a buffer to the binding, unless it is already bound (a buffer of 0 leaves the
+        /// binding as it is)
+        /// @param gl the function table of the current context
+        /// @param buffer the name of the buffer
+        /// @param offset the offset of the range, in bytes
+        /// @param size the size of the range, in bytes
+        void bind(
+            const GladGLContext &gl,
+            const unsigned int   buffer,
+            const std::ptrdiff_t offset,
+            const std::ptrdiff_t size)
+        {
+            if (!buffer || (buffer == m_buffer && offset == m_offset && size == m_size))
+                return;
+
+            gl.BindBufferRange(m_target, m_index, buffer, offset, size);
+            m_buffer = buffer;
+            m_offset = offset;
+            m_size   = size;
+        }
+    };
+} // namespace
+
+void bEngine::GL::CommandQueue::sort_entries()
+{
+    const auto count{m_entries.size()};
+    if (count < 2)
+        return;
+
+    // a single pass over the keys counts every byte of every key at once
+    std::size_t histograms[8][256]{};
+    for (const auto &entry : m_entries)
+        for (int byte{0}; byte < 8; ++byte)
+            ++histograms[byte][(entry.m_key >> (byte * 8)) & 0xFF];
+
+    m_scratch.resize(count);
+    auto *source{m_entries.data()};
+    auto *destination{m_scratch.data()};
+    for (int byte{0}; byte < 8; ++byte)
+    {
+        auto &histogram{histograms[byte]};
+
+        // if every key has the same value for this byte, the pass wouldn't change the order so it's skipped (e.g. the
+        // layer/pass bytes, which rarely differ much)
+        if (histogram[(source[0].m_key >> (byte * 8)) & 0xFF] == count)
+            continue;
+
+        std::size_t offset{0};
+        for (auto &bucket : histogram)
+        {
+            const auto bucketCount{bucket};
+            bucket = offset;
+            offset += bucketCount;
+        }
+
+        for (std::size_t i{0}; i < count; ++i)
+            destination[histogram[(source[i].m_key >> (byte * 8)) & 0xFF]++] = source[i];
+
+        std::swap(source, destination);
+    }
+
+    if (source != m_entries.data())
+        std::copy_n(source, count, m_entries.data());
+}
+
+bEngine::bEngineCommandBuffer &bEngine::GL::CommandQueue::get_frame_buffer()
+{
+    return m_executingBuffers.front();
+}
+
+void bEngine::GL::CommandQueue::submit(bEngineCommandBuffer &&buffer)
+{
+    std::scoped_lock lock{m_submissionMutex};
+    m_submittedBuffers.emplace_back(std::move(buffer));
+}
+
+void bEngine::GL::CommandQueue::execute(Context &context)
+{
+    // take the submitted buffers, so submissions for the next frame can continue while this frame executes
+    {
+        std::scoped_lock lock{m_submissionMutex};
+        std::move(m_submittedBuffers.begin(), m_submittedBuffers.end(), std::back_inserter(m_executingBuffers));
+        m_submittedBuffers.clear();
+    }
+
+    // gather every command, in submission order (which the stable sort preserves for equal keys)
+    m_entries.clear();
+    for (std::uint32_t buffer{0}; buffer < m_executingBuffers.size(); ++buffer)
+    {
+        const auto &keys{m_executingBuffers[buffer].get_keys()};
+        for (std::uint32_t command{0}; command < keys.size(); ++command)
+            m_entries.push_back({keys[command], buffer, command});
+    }
+
+    sort_entries();
+
+    const auto &gl{context.m_gl};
+    auto       &cache{context.m_stateCache};
+
+    // the indexed buffer bindings and the indirect buffer aren't shadowed by the state cache, so track them here
+    BufferRangeBinding uniformBinding{GL_UNIFORM_BUFFER, 0};
+    BufferRangeBinding materialBinding{GL_UNIFORM_BUFFER, 1};
+    BufferRangeBinding storageBinding{GL_SHADER_STORAGE_BUFFER, 0};
+    unsigned int       boundIndirectBuffer{0};
+
+    // draws without a viewport of their own use the one the render started with, which is restored afterwards
+    int        defaultViewport[4]{0, 0, 0, 0};
+    const auto hasDefaultViewport{cache.get_viewport(defaultViewport)};
+
+    for (const auto &entry : m_entries)
+    {
+        const auto &command{m_executingBuffers[entry.m_buffer].get_commands()[entry.m_command]};
+
+        // commands recorded for the window draw to whatever backs it (an offscreen framebuffer when headless)
+        const auto framebuffer{command.m_framebuffer ? command.m_framebuffer : context.m_windowFramebuffer};
+        cache.set_framebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+
+        switch (command.m_type)
+        {
+        case bEngineRenderCommand::Type::ClearColor:
+            cache.flush(gl);
+            gl.ClearNamedFramebufferfv(framebuffer, GL_COLOR, 0, command.m_clear.m_color);
+            break;
+        case bEngineRenderCommand::Type::ClearDepth:
+            // depth clears are masked by the depth write state, so writes have to be enabled
+            cache.set_depth(false, true, GL_LEQUAL);
+            cache.flush(gl);
+            gl.ClearNamedFramebufferfv(framebuffer, GL_DEPTH, 0, &command.m_clear.m_depth);
+            break;
+        case bEngineRenderCommand::Type::Draw:
+        case bEngineRenderCommand::Type::MultiDrawIndirect:
+        {
+            // a draw whose program is still being built (and has no placeholder) is skipped
+            const auto &draw{command.m_draw};
+            if (draw.m_program == 0)
+                break;
+
+            cache.set_program(draw.m_program);
+            cache.set_vertex_array(draw.m_vertexArray);
+            for (unsigned int unit{0}; unit < bEngineDrawItem::s_textureCount; ++unit)
+            {
+                cache.set_texture(unit, draw.m_textures[unit]);
+                cache.set_sampler(unit, draw.m_samplers[unit]);
+            }
+            apply_render_state(cache, command.m_state);
+            if (const auto &viewport{command.m_viewport}; viewport.m_width > 0 && viewport.m_height > 0)
+                cache.set_viewport(viewport.m_x, viewport.m_y, viewport.m_width, viewport.m_height);
+            else if (hasDefaultViewport)
+                cache.set_viewport(defaultViewport[0], defaultViewport[1], defaultViewport[2], defaultViewport[3]);
+
+            uniformBinding.bind(gl, draw.m_uniformBuffer, draw.m_uniformOffset, draw.m_uniformSize);
+            materialBinding.bind(gl, draw.m_materialBuffer, draw.m_materialOffset, draw.m_materialSize);
+            storageBinding.bind(gl, draw.m_storageBuffer, draw.m_storageOffset, draw.m_storageSize);
+
+            cache.flush(gl);
+            if (command.m_type == bEngineRenderCommand::Type::MultiDrawIndirect)
+            {
+                if (draw.m_indirectBuffer != boundIndirectBuffer)
+                {
+                    gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, draw.m_indirectBuffer);
+                    boundIndirectBuffer = draw.m_indirectBuffer;
+                }
+                gl.MultiDrawElementsIndirect(
+                    draw.m_mode,
+                    draw.m_indexType,
+                    reinterpret_cast<const void *>(static_cast<std::uintptr_t>(draw.m_indirectOffset)),
+                    draw.m_count,
+                    0);
+            }
+            else if (draw.m_indexType)
+                gl.DrawElementsInstancedBaseVertexBaseInstance(
+                    draw.m_mode,
+                    draw.m_count,
+                    draw.m_indexType,
+                    reinterpret_cast<const void *>(
+                        static_cast<std::uintptr_t>(draw.m_first) * get_index_size(draw.m_indexType)),
+                    draw.m_instanceCount,
+                    draw.m_baseVertex,
+                    draw.m_baseInstance);
+            else
+                gl.DrawArraysInstancedBaseInstance(
+                    draw.m_mode,
+                    draw.m_first,
+                    draw.m_count,
+                    draw.m_instanceCount,
+                    draw.m_baseInstance);
+            break;
+        }
+        }
+    }
+
+    if (hasDefaultViewport)
+        cache.set_viewport(defaultViewport[0], defaultViewport[1], defaultViewport[2], defaultViewport[3]);
+
+    // the frame's buffer keeps its memory for the next frame, the submitted buffers are done with
+    m_executingBuffers.resize(1);
+    m_executingBuffers.front().reset();
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+/// @file bEngineGLCommandQueue.h
+/// @brief the (private) queue of command buffers waiting to be executed on a GL context
+
+#include "bEngineCommandBuffer.h" // for the command buffers which are queued
+
+#include <cstdint> // for fixed-width sort keys
+#include <mutex>   // for guarding submissions, which may come from any thread
+#include <vector>  // for the submitted buffers and the sorted command list
+
+namespace bEngine
+{
+    namespace GL
+    {
+        // fwd declaration of the per-context state the commands are executed with
+        struct Context;
+
+        /// @brief collects the command buffers recorded for a context during a frame, then sorts and executes all of
+        /// their commands at once on the thread which owns the context
+        class CommandQueue
+        {
+            // private types
+          private:
+            /// @brief a single command's position in the sorted order
+            struct SortEntry
+            {
+                /// @brief the command's sort key
+                std::uint64_t m_key{0};
+
+                /// @brief the index of the buffer holding the command
+                std::uint32_t m_buffer{0};
+
+                /// @brief the index of the command within its buffer
+                std::uint32_t m_command{0};
+            };
+
+            // private data
+          private:
+            /// @brief guards the submitted buffers
+            std::mutex m_submissionMutex;
+
+            /// @brief the buffers submitted since the last execution
+            std::vector<bEngineCommandBuffer> m_submittedBuffers;
+
+            /// @brief the buffers being executed; the first is the frame's buffer, followed by the submitted buffers
+            /// (which are swapped in under the lock, so submitting never waits on execution)
+            std::vector<bEngineCommandBuffer> m_executingBuffers{1};
+
+            /// @brief every queued command's sort entry (reused between frames)
+            std::vector<SortEntry> m_entries;
+
+            /// @brief scratch space for the radix sort (reused between frames)
+            std::vector<SortEntry> m_scratch;
+
+            // private methods/functions
+          private:
+            /// @brief (stably) sorts the sort entries by key, using an LSD radix sort over the bytes of the keys which
+            /// actually differ
+            void sort_entries();
+
+            // public methods/functions
+          public:
+            /// @brief gets the buffer the window's render function records into this frame; only the thread which
+            /// owns the context may record into it
+            /// @return a reference to the frame's buffer
+            bEngineCommandBuffer &get_frame_buffer();
+
+            /// @brief queues a command buffer to be executed with the next frame; safe to call from any thread
+            /// @param buffer the buffer to queue
+            void submit(bEngineCommandBuffer &&buffer);
+
+            /// @brief sorts every queued command by key and executes them on the context, then empties the queue; the
+            /// context must be current
+            /// @param context the context to execute the commands on
+            void execute(Context &context);
+        };
+    } // namespace GL
+} // namespace bEngine
\ No newline at end of file
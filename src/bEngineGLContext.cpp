@@ -0,0 +1,367 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLContext.h"
+
+/// @file bEngineGLContext.cpp
+/// @brief implementations for the bEngineGLContext.h file
+
+#include "bEngineGL.h"                // for releasing the local objects left when a context leaves its group
+#include "bEngineGLStreamBuffer.h"    // for advancing/fencing stream buffers each frame
+#include "bEngineGLTextureStreamer.h" // for releasing the texture streamers left when a context leaves its group
+#include "bEngineUtilities.h"         // for access to assertions and info/warning messages
+
+#include <algorithm>   // for finding the released objects which are old enough to delete and tracked objects
+#include <format>      // for formatting info/warning messages
+#include <string_view> // for comparing extension names
+
+namespace
+{
+    /// @brief the context which is current on this thread (GL contexts are current per-thread, as is this)
+    thread_local bEngine::GL::Context *currentContext{nullptr};
+
+    /// @brief deletes a single GL object; the caller must make every state cache which may have it bound forget it
+    /// @param gl the function table of the (current) context deleting the object
+    /// @param deletion the object to be deleted
+    void delete_object(const GladGLContext &gl, const bEngine::GL::PendingDeletion &deletion)
+    {
+        using bEngine::GL::ObjectType;
+        switch (deletion.m_type)
+        {
+        case ObjectType::Buffer:
+            gl.DeleteBuffers(1, &deletion.m_name);
+            break;
+        case ObjectType::Texture:
+            gl.DeleteTextures(1, &deletion.m_name);
+            break;
+        case ObjectType::Sampler:
+            gl.DeleteSamplers(1, &deletion.m_name);
+            break;
+        case ObjectType::Framebuffer:
+            gl.DeleteFramebuffers(1, &deletion.m_name);
+            break;
+        case ObjectType::VertexArray:
+            gl.DeleteVertexArrays(1, &deletion.m_name);
+            break;
+        case ObjectType::Program:
+            gl.DeleteProgram(deletion.m_name);
+            break;
+        }
+    }
+
+    /// @brief deletes a group's released objects; the group must be locked and one of its members current
+    /// @param context the (current) member deleting the objects
+    /// @param group the group which released the objects
+    /// @param isFlushing true to delete every released object, false to only delete those which are old enough
+    void delete_group_objects(bEngine::GL::Context &context, bEngine::GL::ContextGroup &group, const bool isFlushing)
+    {
+        using bEngine::GL::PendingDeletion;
+        auto &deletions{group.m_pendingDeletions};
+
+        // the queue is in release order, so everything old enough to delete is at the front
+        const auto firstKept{
+            isFlushing ? deletions.end()
+                       : std::find_if(
+                             deletions.begin(),
+                             deletions.end(),
+                             [&group](const PendingDeletion &deletion) {
+                                 return deletion.m_frame + bEngine::GL::Context::s_deletionDelay > group.m_frameIndex;
+                             })};
+
+        // a shared object may be bound on any member, and deleting it only unbinds it from the deleting context; the
+        // others keep the orphaned object bound, so their caches must not treat a new object reusing the name as bound
+        for (auto it{deletions.begin()}; it != firstKept; ++it)
+        {
+            for (auto *const member : group.m_contexts)
+                member->m_stateCache.forget(it->m_type, it->m_name);
+            delete_object(context.m_gl, *it);
+        }
+
+        deletions.erase(deletions.begin(), firstKept);
+    }
+
+    /// @brief records that a member of a group ended a frame; once every member has, the group's frame index advances
+    /// and the shared objects which are old enough are deleted
+    /// @param context the (current) member which ended a frame
+    void end_group_frame(bEngine::GL::Context &context)
+    {
+        auto           &group{*context.m_group};
+        std::scoped_lock lock{group.m_mutex};
+
+        context.m_hasEndedGroupFrame = true;
+        for (const auto *const member : group.m_contexts)
+        {
+            if (!member->m_hasEndedGroupFrame)
+                return;
+        }
+
+        for (auto *const member : group.m_contexts)
+            member->m_hasEndedGroupFrame = false;
+        ++group.m_frameIndex;
+        delete_group_objects(context, group, false);
+    }
+} // namespace
+
+const bool bEngine::GL::get_is_shared(const ObjectType type)
+{
+    return type != ObjectType::Framebuffer && type != ObjectType::VertexArray;
+}
+
+bEngine::GL::Context *const bEngine::GL::get_current_context()
+{
+    return currentContext;
+}
+
+void bEngine::GL::set_current_context(Context *const context)
+{
+    currentContext = context;
+}
+
+bEngine::GL::Context &bEngine::GL::require_current_context()
+{
+    bENGINE_ASSERT(currentContext, "GL objects can only be created/used on a thread with a current GL context!");
+    return *currentContext;
+}
+
+void bEngine::GL::join_group(Context &context, ContextGroup &group)
+{
+    std::scoped_lock lock{group.m_mutex};
+    context.m_group              = &group;
+    context.m_hasEndedGroupFrame = false;
+    group.m_contexts.push_back(&context);
+    INFO_MSG(std::format("A context joined the shared context group ({} contexts).", group.m_contexts.size()));
+}
+
+void bEngine::GL::leave_group(Context &context)
+{
+    // a build still in flight on the context can't be finished once it's gone
+    for (const auto &build : context.m_pendingBuilds)
+        wait_for_program_build(context, *build);
+    context.m_pendingBuilds.clear();
+
+    // stream buffers and texture streamers which outlive the context can't use it anymore (they unregister themselves)
+    if (const auto count{context.m_streamBuffers.size() + context.m_textureStreamers.size()}; count > 0)
+    {
+        WARNING_MSG(std::format("{} stream buffers/texture streamers outlived their context; releasing them.", count));
+    }
+    while (!context.m_streamBuffers.empty())
+        context.m_streamBuffers.back()->release();
+    while (!context.m_textureStreamers.empty())
+        context.m_textureStreamers.back()->release();
+
+    // the local objects are released (emptying their wrappers) outside of the lock, since releasing untracks them
+    std::vector<bEngineGLObject *> localObjects;
+    {
+        std::scoped_lock lock{context.m_deletionMutex};
+        localObjects.swap(context.m_localObjects);
+    }
+    if (!localObjects.empty())
+    {
+        WARNING_MSG(std::format("{} local objects outlived their context; releasing them.", localObjects.size()));
+    }
+    for (auto *const object : localObjects)
+        object->reset();
+    flush_deletions(context);
+
+    // the group (and every object in it) goes away with its last member, so the shared objects which outlived every
+    // window are released too, emptying their wrappers so they're safe to destroy later
+    auto                          &group{*context.m_group};
+    std::vector<bEngineGLObject *> sharedObjects;
+    {
+        std::scoped_lock lock{group.m_mutex};
+        if (group.m_contexts.size() == 1)
+            sharedObjects.swap(group.m_sharedObjects);
+    }
+    if (!sharedObjects.empty())
+    {
+        WARNING_MSG(std::format("{} shared objects outlived every context; releasing them.", sharedObjects.size()));
+    }
+    for (auto *const object : sharedObjects)
+        object->reset();
+
+    std::scoped_lock lock{group.m_mutex};
+
+    // the last member deletes everything the group released, since nobody is left to use it
+    if (group.m_contexts.size() == 1)
+        delete_group_objects(context, group, true);
+
+    std::erase(group.m_contexts, &context);
+    context.m_group = nullptr;
+}
+
+void bEngine::GL::track_local_object(Context &context, bEngineGLObject *const object)
+{
+    std::scoped_lock lock{context.m_deletionMutex};
+    context.m_localObjects.push_back(object);
+}
+
+void bEngine::GL::untrack_local_object(
+    Context               &context,
+    bEngineGLObject *const object,
+    bEngineGLObject *const replacement)
+{
+    std::scoped_lock lock{context.m_deletionMutex};
+    auto            &objects{context.m_localObjects};
+    if (const auto it{std::find(objects.begin(), objects.end(), object)}; it != objects.end())
+    {
+        if (replacement)
+            *it = replacement;
+        else
+            objects.erase(it);
+    }
+}
+
+void bEngine::GL::track_shared_object(ContextGroup &group, bEngineGLObject *const object)
+{
+    std::scoped_lock lock{group.m_mutex};
+    group.m_sharedObjects.push_back(object);
+}
+
+void bEngine::GL::untrack_shared_object(
+    ContextGroup          &group,
+    bEngineGLObject *const object,
+    bEngineGLObject *const replacement)
+{
+    std::scoped_lock lock{group.m_mutex};
+    auto            &objects{group.m_sharedObjects};
+    if (const auto it{std::find(objects.begin(), objects.end(), object)}; it != objects.end())
+    {
+        if (replacement)
+            *it = replacement;
+        else
+            objects.erase(it);
+    }
+}
+
+void bEngine::GL::load_extensions(Context &context, const GLADloadfunc loader)
+{
+    const auto &gl{context.m_gl};
+
+    GLint extensionCount{0};
+    gl.GetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint extension{0}; extension < extensionCount; ++extension)
+    {
+        const std::string_view name{reinterpret_cast<const char *>(gl.GetStringi(GL_EXTENSIONS, extension))};
+        if (name != "GL_KHR_parallel_shader_compile" && name != "GL_ARB_parallel_shader_compile")
+            continue;
+
+        // let the driver pick how many threads to compile with (0xFFFFFFFF is "implementation dependent")
+        using max_compiler_threads_fn = void(GLAD_API_PTR *)(GLuint);
+        const auto maxCompilerThreads{reinterpret_cast<max_compiler_threads_fn>(loader(
+            name == "GL_KHR_parallel_shader_compile" ? "glMaxShaderCompilerThreadsKHR"
+                                                     : "glMaxShaderCompilerThreadsARB"))};
+        if (maxCompilerThreads)
+            maxCompilerThreads(0xFFFFFFFF);
+
+        context.m_hasParallelShaderCompile = true;
+        INFO_MSG(std::format("Building programs in parallel with {}.", name));
+        return;
+    }
+}
+
+void bEngine::GL::submit_program_build(
+    Context                             &context,
+    const std::shared_ptr<ProgramBuild> &build,
+    const bool                           isAsync)
+{
+    if (auto &shaderCompiler{context.m_group->m_shaderCompiler}; isAsync && shaderCompiler)
+    {
+        // the compile thread's context only sees the (new) program once it has been flushed from this one
+        context.m_gl.Flush();
+        shaderCompiler->submit(std::shared_ptr{build});
+        return;
+    }
+
+    issue_program_build(context.m_gl, *build);
+    if (isAsync && context.m_hasParallelShaderCompile)
+        context.m_pendingBuilds.push_back(build);
+    else
+        finish_program_build(context.m_gl, *build);
+}
+
+const bool bEngine::GL::poll_program_build(Context &context, ProgramBuild &build)
+{
+    // builds on the compile thread publish their own state
+    if (build.m_state.load(std::memory_order_acquire) != BuildState::Pending)
+        return true;
+    if (!context.m_hasParallelShaderCompile || !get_is_program_build_complete(context.m_gl, build))
+        return false;
+
+    finish_program_build(context.m_gl, build);
+    return true;
+}
+
+void bEngine::GL::wait_for_program_build(Context &context, ProgramBuild &build)
+{
+    // a build on this context finishes by querying it, one on the compile thread has to be waited for
+    if (context.m_hasParallelShaderCompile)
+        finish_program_build(context.m_gl, build);
+    build.m_state.wait(BuildState::Pending, std::memory_order_acquire);
+}
+
+void bEngine::GL::queue_deletion(Context &context, const ObjectType type, const unsigned int name)
+{
+    std::scoped_lock lock{context.m_deletionMutex};
+    context.m_pendingDeletions.emplace_back(type, name, context.m_frameIndex);
+}
+
+void bEngine::GL::queue_deletion(ContextGroup &group, const ObjectType type, const unsigned int name)
+{
+    std::scoped_lock lock{group.m_mutex};
+    group.m_pendingDeletions.emplace_back(type, name, group.m_frameIndex);
+}
+
+void bEngine::GL::begin_frame(Context &context)
+{
+    for (auto *const streamBuffer : context.m_streamBuffers)
+        streamBuffer->begin_frame();
+
+    auto &builds{context.m_pendingBuilds};
+    builds.erase(
+        std::remove_if(
+            builds.begin(),
+            builds.end(),
+            [&context](const std::shared_ptr<ProgramBuild> &build) { return poll_program_build(context, *build); }),
+        builds.end());
+}
+
+void bEngine::GL::end_frame(Context &context)
+{
+    for (auto *const streamBuffer : context.m_streamBuffers)
+        streamBuffer->end_frame();
+
+    ++context.m_frameIndex;
+    context.m_stateCache.end_frame(context.m_gl);
+    end_group_frame(context);
+
+    std::scoped_lock lock{context.m_deletionMutex};
+
+    // the queue is in release order, so everything old enough to delete is at the front
+    const auto firstKept{std::find_if(
+        context.m_pendingDeletions.begin(),
+        context.m_pendingDeletions.end(),
+        [&context](const PendingDeletion &deletion) {
+            return deletion.m_frame + Context::s_deletionDelay > context.m_frameIndex;
+        })};
+
+    // deleting an object unbinds it, so the state cache must forget it
+    for (auto it{context.m_pendingDeletions.begin()}; it != firstKept; ++it)
+    {
+        context.m_stateCache.forget(it->m_type, it->m_name);
+        delete_object(context.m_gl, *it);
+    }
+
+    context.m_pendingDeletions.erase(context.m_pendingDeletions.begin(), firstKept);
+}
+
+void bEngine::GL::flush_deletions(Context &context)
+{
+    std::scoped_lock lock{context.m_deletionMutex};
+
+    for (const auto &deletion : context.m_pendingDeletions)
+    {
+        context.m_stateCache.forget(deletion.m_type, deletion.m_name);
+        delete_object(context.m_gl, deletion);
+    }
+
+    context.m_pendingDeletions.clear();
+}
\ No newline at end of file
@@ -0,0 +1,250 @@
+#pragma once
+
+/// @file bEngineGLContext.h
+/// @brief the (private) per-context GL state of the bEngine library; every GL call the library makes goes through the
+/// glad function table of the context which is current on the calling thread
+///
+/// every context belongs to a context group whose members share objects, so buffers, textures, samplers and programs
+/// are created (and uploaded) once and usable by every window. Container objects (framebuffers and vertex arrays)
+/// can't be shared by GL; they stay with the context which created them and are tracked by it.
+
+#include "bEngineGLCommandQueue.h"   // each context executes its own queued commands
+#include "bEngineGLShaderCompiler.h" // each context (group) builds its own programs
+#include "bEngineGLStateCache.h"     // each context shadows its own state
+
+#include <glad\gl.h> // for the (multi-context) glad function table
+
+#include <memory> // for the compile thread and the builds in flight
+#include <mutex>  // for guarding the deletion queues, since GL objects may be destroyed on any thread
+#include <vector> // for the deletion queues, registered stream/local objects, group members and builds in flight
+
+namespace bEngine
+{
+    // fwd declarations of the stream buffers a context advances every frame, the texture streamers registered with it
+    // and the wrappers of its local objects
+    class bEngineGLStreamBuffer;
+    class bEngineGLTextureStreamer;
+    class bEngineGLObject;
+
+    namespace GL
+    {
+        /// @brief the kinds of GL objects which the library wraps, which determines how they are deleted
+        enum class ObjectType : unsigned char
+        {
+            Buffer,
+            Texture,
+            Sampler,
+            Framebuffer,
+            VertexArray,
+            Program
+        };
+
+        /// @brief checks whether a kind of object is shared by the contexts of a group
+        /// @param type the kind of object
+        /// @return true for buffers, textures, samplers and programs, false for framebuffers and vertex arrays (which
+        /// only exist on the context which created them)
+        const bool get_is_shared(const ObjectType type);
+
+        /// @brief a GL object which has been released by its wrapper but not yet deleted
+        struct PendingDeletion
+        {
+            /// @brief the kind of object to delete
+            ObjectType m_type{ObjectType::Buffer};
+
+            /// @brief the GL name of the object
+            unsigned int m_name{0};
+
+            /// @brief the frame the object was released on
+            unsigned long long m_frame{0};
+        };
+
+        // fwd declaration of the group a context belongs to
+        struct ContextGroup;
+
+        /// @brief everything the library tracks for a single GL context
+        struct Context
+        {
+            /// @brief the number of frames a released object is kept alive for before it is deleted, so GPU work which
+            /// was queued before the release (but not yet executed) never sees a deleted object
+            static constexpr unsigned long long s_deletionDelay{2};
+
+            /// @brief glad's function table for the context
+            GladGLContext m_gl{};
+
+            /// @brief the group the context shares objects with, or nullptr until it joins one
+            ContextGroup *m_group{nullptr};
+
+            /// @brief true once the context has ended a frame since its group's frame index last advanced
+            bool m_hasEndedGroupFrame{false};
+
+            /// @brief the framebuffer commands recorded for the window draw to: 0 for the window's own, or the
+            /// offscreen framebuffer which backs a headless window
+            unsigned int m_windowFramebuffer{0};
+
+            /// @brief the shadow of the context's bindings and fixed-function state
+            StateCache m_stateCache;
+
+            /// @brief the command buffers waiting to be executed on the context
+            CommandQueue m_commandQueue;
+
+            /// @brief the stream buffers created on the context, which are advanced/fenced every frame
+            std::vector<bEngineGLStreamBuffer *> m_streamBuffers;
+
+            /// @brief the texture streamers created on the context, which are released if they outlive it
+            std::vector<bEngineGLTextureStreamer *> m_textureStreamers;
+
+            /// @brief true if the driver compiles/links in parallel (KHR/ARB_parallel_shader_compile), so builds are
+            /// issued on the context itself and polled for completion
+            bool m_hasParallelShaderCompile{false};
+
+            /// @brief the builds issued on the context which haven't finished yet (parallel shader compile only)
+            std::vector<std::shared_ptr<ProgramBuild>> m_pendingBuilds;
+
+            /// @brief the number of frames which have been completed on this context
+            unsigned long long m_frameIndex{0};
+
+            /// @brief guards the deletion queue
+            std::mutex m_deletionMutex;
+
+            /// @brief objects which have been released but not yet deleted (local objects only)
+            std::vector<PendingDeletion> m_pendingDeletions;
+
+            /// @brief the wrappers of the (unshared) local objects created on the context, which are released when the
+            /// context leaves its group; guarded by the deletion mutex
+            std::vector<bEngineGLObject *> m_localObjects;
+        };
+
+        /// @brief a group of contexts which share objects; every member is rendered on the same thread
+        struct ContextGroup
+        {
+            /// @brief guards the members and the deletion queue
+            std::mutex m_mutex;
+
+            /// @brief the contexts in the group
+            std::vector<Context *> m_contexts;
+
+            /// @brief the number of frames which every member has completed, advanced once all of them have ended one
+            unsigned long long m_frameIndex{0};
+
+            /// @brief shared objects which have been released but not yet deleted
+            std::vector<PendingDeletion> m_pendingDeletions;
+
+            /// @brief the wrappers of the shared objects created in the group, which are released when its last member
+            /// leaves
+            std::vector<bEngineGLObject *> m_sharedObjects;
+
+            /// @brief the compile thread programs are built on when the driver can't build them in parallel, or nullptr
+            /// if there isn't one (in which case programs are built synchronously)
+            std::unique_ptr<ShaderCompiler> m_shaderCompiler{nullptr};
+        };
+
+        /// @brief gets the context which is current on the calling thread
+        /// @return the context which is current on the calling thread, or nullptr if there isn't one
+        Context *const get_current_context();
+
+        /// @brief sets the context which is current on the calling thread; the platform must have already made the
+        /// underlying context current
+        /// @param context the context which is now current, or nullptr if there isn't one
+        void set_current_context(Context *const context);
+
+        /// @brief gets the context which is current on the calling thread, asserting there is one
+        /// @return a reference to the current context; throws a bEngineException if no context is current
+        Context &require_current_context();
+
+        /// @brief adds a context to a group; the context must be current and must not have created any objects yet
+        /// @param context the context joining the group
+        /// @param group the group to join
+        void join_group(Context &context, ContextGroup &group);
+
+        /// @brief removes a context from its group: finishes its program builds, releases the stream buffers and
+        /// texture streamers registered with it and its local objects (leaving their wrappers empty) and deletes
+        /// everything it released; the last member to leave also releases the group's shared objects (leaving their
+        /// wrappers empty) and deletes everything the group released. The context must be current and no GPU work may
+        /// be pending which uses the objects
+        /// @param context the context leaving its group
+        void leave_group(Context &context);
+
+        /// @brief starts tracking the wrapper of a local object, so it can be released when its context leaves its
+        /// group; safe to call from any thread
+        /// @param context the context which owns the object
+        /// @param object the wrapper of the object
+        void track_local_object(Context &context, bEngineGLObject *const object);
+
+        /// @brief stops tracking (or replaces) the wrapper of a local object; safe to call from any thread
+        /// @param context the context which owns the object
+        /// @param object the tracked wrapper of the object
+        /// @param replacement the wrapper which now owns the object (when moved), or nullptr to stop tracking it
+        void untrack_local_object(
+            Context               &context,
+            bEngineGLObject *const object,
+            bEngineGLObject *const replacement = nullptr);
+
+        /// @brief starts tracking the wrapper of a shared object, so it can be released when the group's last member
+        /// leaves; safe to call from any thread
+        /// @param group the group which owns the object
+        /// @param object the wrapper of the object
+        void track_shared_object(ContextGroup &group, bEngineGLObject *const object);
+
+        /// @brief stops tracking (or replaces) the wrapper of a shared object; safe to call from any thread
+        /// @param group the group which owns the object
+        /// @param object the tracked wrapper of the object
+        /// @param replacement the wrapper which now owns the object (when moved), or nullptr to stop tracking it
+        void untrack_shared_object(
+            ContextGroup          &group,
+            bEngineGLObject *const object,
+            bEngineGLObject *const replacement = nullptr);
+
+        /// @brief checks for (and enables) the extensions the library uses which glad's core-only loader doesn't load;
+        /// the context must be current
+        /// @param context the context to check
+        /// @param loader the loader of the context's functions
+        void load_extensions(Context &context, const GLADloadfunc loader);
+
+        /// @brief starts building a program: on the compile thread, in parallel on the context, or synchronously
+        /// (depending on what the context supports); the context must be current
+        /// @param context the context which owns the program
+        /// @param build the build to start
+        /// @param isAsync false to finish the build before returning
+        void submit_program_build(Context &context, const std::shared_ptr<ProgramBuild> &build, const bool isAsync);
+
+        /// @brief finishes a build if it has completed, without blocking; the context must be current
+        /// @param context the context which owns the program
+        /// @param build the build to poll
+        /// @return true if the build has finished, false if it's still pending
+        const bool poll_program_build(Context &context, ProgramBuild &build);
+
+        /// @brief blocks until a build has finished; the context must be current
+        /// @param context the context which owns the program
+        /// @param build the build to wait for
+        void wait_for_program_build(Context &context, ProgramBuild &build);
+
+        /// @brief queues a local GL object for deletion at the next frame-safe point; safe to call from any thread
+        /// @param context the context which owns the object
+        /// @param type the kind of object
+        /// @param name the GL name of the object
+        void queue_deletion(Context &context, const ObjectType type, const unsigned int name);
+
+        /// @brief queues a shared GL object for deletion once every member of its group has reached a frame-safe
+        /// point; safe to call from any thread
+        /// @param group the group which owns the object
+        /// @param type the kind of object
+        /// @param name the GL name of the object
+        void queue_deletion(ContextGroup &group, const ObjectType type, const unsigned int name);
+
+        /// @brief marks the start of a frame on a context, moving its stream buffers on to their next region and
+        /// finishing any program builds which have completed; the context must be current
+        /// @param context the context whose frame started
+        void begin_frame(Context &context);
+
+        /// @brief marks the end of a frame on a context, fencing its stream buffers and deleting any released objects
+        /// which are old enough (including its group's, once every member has ended a frame); the context must be
+        /// current
+        /// @param context the context whose frame ended
+        void end_frame(Context &context);
+
+        /// @brief deletes every local object the context released regardless of age; the context must be current and no
+        /// GPU work may be pending which uses the objects (e.g. when the context is being destroyed)
+        /// @param context the context to flush
+        void flush_deletions(Context &context);
+    } // namespace GL
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+/// @file bEngineGLDebugDraw.h
+/// @brief the (private) side of debug drawing the windows use: collecting the threads' debug geometry once per frame,
+/// and each window's renderer which draws it (see bEngineDebugDraw.h); only exists in debug builds
+
+#ifdef DEBUG
+
+#    include "bEngineCommandBuffer.h"  // for recording the debug draw
+#    include "bEngineDebugDraw.h"      // for the debug geometry drawn
+#    include "bEngineGL.h"             // for the debug program and vertex array
+#    include "bEngineGLStreamBuffer.h" // for the per-frame memory debug vertices are written to
+
+#    include <cstddef> // for ptrdiff_t
+
+namespace bEngine
+{
+    namespace GL
+    {
+        /// @brief merges every thread's debug geometry into the frame's, dropping geometry whose duration has passed;
+        /// called once per frame, before the windows render
+        void collect_debug_draw();
+
+        /// @brief forgets a window's debug view projection; called as the window is destroyed
+        /// @param window the window
+        void forget_debug_window(const bEngineWindow &window);
+
+        /// @brief checks whether the frame has any debug geometry
+        /// @return true if the frame has debug geometry to draw
+        const bool has_debug_draw();
+
+        /// @brief draws the frame's debug geometry in a window, with a single line draw
+        class DebugDrawRenderer
+        {
+            // public static data
+          public:
+            /// @brief the number of bytes of debug vertices (and uniforms) which can be drawn each frame
+            static constexpr std::ptrdiff_t s_regionSize{2 * 1024 * 1024};
+
+            // private data
+          private:
+            /// @brief the stream buffer the frame's debug vertices are written to
+            bEngineGLStreamBuffer m_streamBuffer;
+
+            /// @brief the alignment of uniform block ranges on the current context
+            std::ptrdiff_t m_uniformAlignment{0};
+
+            /// @brief the program debug lines are drawn with
+            bEngineGLProgram m_program;
+
+            /// @brief the vertex array reading debug vertices from the stream buffer
+            bEngineGLVertexArray m_vertexArray;
+
+            // public ctors/dtor
+          public:
+            /// @brief ctor which creates the stream buffer, program and vertex array on the current context
+            DebugDrawRenderer();
+
+            // public methods/functions
+          public:
+            /// @brief writes the frame's debug vertices into the stream buffer and records their draw into the window
+            /// @param commands the command buffer to record into
+            /// @param window the window the geometry is drawn in (for its view projection)
+            /// @param viewportWidth the width of the window's viewport, in pixels
+            /// @param viewportHeight the height of the window's viewport, in pixels
+            void record(
+                bEngineCommandBuffer &commands,
+                const bEngineWindow  &window,
+                const int             viewportWidth,
+                const int             viewportHeight);
+        };
+    } // namespace GL
+} // namespace bEngine
+
+#endif // DEBUG
\ No newline at end of file
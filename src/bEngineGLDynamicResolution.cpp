@@ -0,0 +1,187 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLDynamicResolution.h"
+
+/// @file bEngineGLDynamicResolution.cpp
+/// @brief implementations for the bEngineGLDynamicResolution.h file
+
+#include "bEngineGLContext.h" // for the context's function table, state cache and window framebuffer
+#include "bEngineUtilities.h" // for access to assertions, info messaging, etc.
+
+#include <algorithm> // for clamping the render scale
+#include <cmath>     // for sizing the scaled target
+#include <format>    // for formatting info messages
+
+namespace
+{
+    /// @brief the limit of the controller's accumulated (integral) error, so a long stretch at a scale bound can't
+    /// wind it up
+    constexpr double s_integralLimit{4.0};
+
+    /// @brief the smallest change the controller makes to the render scale; smaller adjustments are held back so the
+    /// scale doesn't jitter around the target
+    constexpr double s_minScaleStep{0.01};
+
+    /// @brief scales a length by a render scale
+    /// @param length the length, in pixels
+    /// @param scale the render scale
+    /// @return the scaled length, in pixels (at least 1)
+    const int scale_length(const int length, const double scale)
+    {
+        return std::max(1, static_cast<int>(std::lround(length * scale)));
+    }
+} // namespace
+
+bEngine::GL::DynamicResolution::DynamicResolution(Context &context, const bEngineDynamicResolutionSettings &settings)
+    : m_context{context},
+      m_settings{settings}
+{
+    bENGINE_ASSERT(
+        m_settings.m_minScale > 0.0 && m_settings.m_minScale <= m_settings.m_maxScale,
+        "Dynamic resolution needs a render scale range of (0, max]!");
+    bENGINE_ASSERT(m_settings.m_targetFrameSeconds > 0.0, "Dynamic resolution needs a positive target frame time!");
+
+    // timer queries are core, but a driver may report no bits for them when it can't actually time anything
+    const auto &gl{m_context.m_gl};
+    GLint       counterBits{0};
+    gl.GetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &counterBits);
+    m_hasTimerQueries = counterBits > 0;
+    if (m_hasTimerQueries)
+        gl.CreateQueries(GL_TIME_ELAPSED, s_queryCount, m_queries.data());
+
+    m_stats.m_scale      = m_settings.m_maxScale;
+    m_stats.m_isGpuTimed = m_hasTimerQueries;
+    INFO_MSG(std::format(
+        "Dynamic resolution enabled ({} timing, scale {}-{}).",
+        m_hasTimerQueries ? "GPU" : "CPU",
+        m_settings.m_minScale,
+        m_settings.m_maxScale));
+}
+
+bEngine::GL::DynamicResolution::~DynamicResolution()
+{
+    // the scaled target's textures/framebuffer are deleted by the context (group) once released
+    if (m_hasTimerQueries)
+        m_context.m_gl.DeleteQueries(s_queryCount, m_queries.data());
+}
+
+void bEngine::GL::DynamicResolution::begin_frame(const bEngineRenderTargetSize &targetSize, const int (&size)[2])
+{
+    // the scaled target only follows the window's render targets, so it's reallocated at most once per frame
+    if (m_framebuffer.get_name() == 0 || targetSize.m_generation != m_targetGeneration)
+    {
+        const auto width{scale_length(targetSize.m_width, m_settings.m_maxScale)};
+        const auto height{scale_length(targetSize.m_height, m_settings.m_maxScale)};
+        m_color       = bEngineGLTexture{GL_TEXTURE_2D, 1, GL_RGBA8, width, height};
+        m_depth       = bEngineGLTexture{GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, width, height};
+        m_framebuffer = bEngineGLFramebuffer::create_framebuffer();
+        m_framebuffer.attach_texture(GL_COLOR_ATTACHMENT0, m_color);
+        m_framebuffer.attach_texture(GL_DEPTH_STENCIL_ATTACHMENT, m_depth);
+        bENGINE_ASSERT(m_framebuffer.get_is_complete(), "Failed to create the scaled target of dynamic resolution!");
+        m_targetGeneration = targetSize.m_generation;
+    }
+
+    // everything recorded for the window renders into the scaled target instead
+    m_windowFramebuffer           = m_context.m_windowFramebuffer;
+    m_context.m_windowFramebuffer = m_framebuffer.get_name();
+    m_stats.m_renderWidth         = std::min(scale_length(size[0], m_stats.m_scale), m_color.get_width());
+    m_stats.m_renderHeight        = std::min(scale_length(size[1], m_stats.m_scale), m_color.get_height());
+
+    // a query still waiting for its result can't be reused, so the frame just isn't timed
+    m_isFrameTimed = m_hasTimerQueries && !m_isQueryPending[m_nextQuery];
+    if (m_isFrameTimed)
+        m_context.m_gl.BeginQuery(GL_TIME_ELAPSED, m_queries[m_nextQuery]);
+}
+
+void bEngine::GL::DynamicResolution::end_frame(const int (&size)[2], const double renderSeconds)
+{
+    const auto &gl{m_context.m_gl};
+    if (m_isFrameTimed)
+    {
+        gl.EndQuery(GL_TIME_ELAPSED);
+        m_isQueryPending[m_nextQuery] = true;
+        m_nextQuery                   = (m_nextQuery + 1) % s_queryCount;
+    }
+
+    // blits only depend on the framebuffers they're given (and the scissor test, which the library never enables)
+    m_context.m_windowFramebuffer = m_windowFramebuffer;
+    if (size[0] > 0 && size[1] > 0)
+    {
+        gl.BlitNamedFramebuffer(
+            m_framebuffer.get_name(),
+            m_windowFramebuffer,
+            0,
+            0,
+            m_stats.m_renderWidth,
+            m_stats.m_renderHeight,
+            0,
+            0,
+            size[0],
+            size[1],
+            GL_COLOR_BUFFER_BIT,
+            GL_LINEAR);
+    }
+
+    if (!m_hasTimerQueries)
+    {
+        update_scale(renderSeconds);
+        return;
+    }
+
+    // results become available in the order the queries were issued, so reading stops at the first one which isn't
+    while (m_isQueryPending[m_pendingQuery])
+    {
+        const auto query{m_queries[m_pendingQuery]};
+        GLint      isAvailable{GL_FALSE};
+        gl.GetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (isAvailable == GL_FALSE)
+            break;
+
+        GLuint64 elapsedNanoseconds{0};
+        gl.GetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNanoseconds);
+        m_isQueryPending[m_pendingQuery] = false;
+        m_pendingQuery                   = (m_pendingQuery + 1) % s_queryCount;
+        update_scale(static_cast<double>(elapsedNanoseconds) / 1e9);
+    }
+}
+
+const bEngine::bEngineDynamicResolutionStats &bEngine::GL::DynamicResolution::get_stats() const
+{
+    return m_stats;
+}
+
+void bEngine::GL::DynamicResolution::update_scale(const double frameSeconds)
+{
+    // the error is relative to the target, so the gains don't depend on the frame budget; positive means too slow
+    const auto error{(frameSeconds - m_settings.m_targetFrameSeconds) / m_settings.m_targetFrameSeconds};
+    const auto derivative{m_stats.m_sampleCount > 0 ? error - m_previousError : 0.0};
+    const auto integral{std::clamp(m_integral + error, -s_integralLimit, s_integralLimit)};
+    const auto output{
+        m_settings.m_proportionalGain * error + m_settings.m_integralGain * integral +
+        m_settings.m_derivativeGain * derivative};
+
+    const auto scale{m_stats.m_scale};
+    const auto targetScale{std::clamp(scale - output, m_settings.m_minScale, m_settings.m_maxScale)};
+
+    // the error only accumulates while the scale can still move in the direction it pushes (anti-windup)
+    const auto isSaturated{
+        (error > 0.0 && scale <= m_settings.m_minScale) || (error < 0.0 && scale >= m_settings.m_maxScale)};
+    if (!isSaturated)
+        m_integral = integral;
+    m_previousError = error;
+
+    ++m_stats.m_sampleCount;
+    m_stats.m_lastFrameSeconds = frameSeconds;
+    m_stats.m_lastError        = error;
+    m_stats.m_lastAdjustment   = 0.0;
+
+    // the bounds are always reachable, even by a step smaller than the minimum
+    const auto adjustment{targetScale - scale};
+    const auto isAtBound{targetScale == m_settings.m_minScale || targetScale == m_settings.m_maxScale};
+    if (std::abs(adjustment) < s_minScaleStep && !(isAtBound && adjustment != 0.0))
+        return;
+
+    m_stats.m_scale          = targetScale;
+    m_stats.m_lastAdjustment = adjustment;
+    ++(adjustment > 0.0 ? m_stats.m_increaseCount : m_stats.m_decreaseCount);
+}
\ No newline at end of file
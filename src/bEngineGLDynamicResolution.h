@@ -0,0 +1,126 @@
+#pragma once
+
+/// @file bEngineGLDynamicResolution.h
+/// @brief the (private) dynamic resolution of a window: its frames are rendered into a scaled offscreen target and
+/// upscaled into the window's framebuffer, at a render scale steered by measured frame times (see
+/// bEngineDynamicResolution.h)
+
+#include "bEngineDynamicResolution.h" // for the dynamic resolution settings and statistics
+#include "bEngineGL.h"                // for the scaled render target
+#include "bEngineWindow.h"            // for the window's render target size
+
+#include <array> // for the ring of timer queries
+
+namespace bEngine
+{
+    namespace GL
+    {
+        // fwd declaration of the per-context state frames are rendered with
+        struct Context;
+
+        /// @brief renders a window's frames at a dynamic resolution
+        ///
+        /// the scaled target is allocated at the largest render scale of the window's render target size, so changing
+        /// the render scale only changes the viewport and never reallocates anything
+        class DynamicResolution
+        {
+            // private static data
+          private:
+            /// @brief the number of timer queries in flight; results are read back this many frames late at most
+            static constexpr unsigned int s_queryCount{4};
+
+            // private data
+          private:
+            /// @brief the context frames are rendered on
+            Context &m_context;
+
+            /// @brief the settings of the dynamic resolution
+            const bEngineDynamicResolutionSettings m_settings;
+
+            /// @brief the color attachment of the scaled target
+            bEngineGLTexture m_color{};
+
+            /// @brief the depth/stencil attachment of the scaled target
+            bEngineGLTexture m_depth{};
+
+            /// @brief the scaled target frames are rendered into
+            bEngineGLFramebuffer m_framebuffer{};
+
+            /// @brief the render target size generation the scaled target was allocated for
+            unsigned long long m_targetGeneration{0};
+
+            /// @brief the framebuffer backing the window, which the scaled target is upscaled into
+            unsigned int m_windowFramebuffer{0};
+
+            /// @brief true if the driver supports GL_TIME_ELAPSED queries
+            bool m_hasTimerQueries{false};
+
+            /// @brief the ring of GL_TIME_ELAPSED queries
+            std::array<unsigned int, s_queryCount> m_queries{};
+
+            /// @brief whether each query of the ring is waiting for its result
+            std::array<bool, s_queryCount> m_isQueryPending{};
+
+            /// @brief the query the next frame is timed with
+            unsigned int m_nextQuery{0};
+
+            /// @brief the query whose result is read back next
+            unsigned int m_pendingQuery{0};
+
+            /// @brief true if the current frame is being timed with a query
+            bool m_isFrameTimed{false};
+
+            /// @brief the accumulated (integral) error of the controller
+            double m_integral{0.0};
+
+            /// @brief the controller's previous error
+            double m_previousError{0.0};
+
+            /// @brief the statistics of the dynamic resolution
+            bEngineDynamicResolutionStats m_stats{};
+
+            // public ctors/dtor
+          public:
+            /// @brief default ctor is insufficient
+            DynamicResolution() = delete;
+
+            /// @brief ctor which creates the timer queries; the context must be current
+            /// @param context the context frames are rendered on
+            /// @param settings the settings of the dynamic resolution
+            DynamicResolution(Context &context, const bEngineDynamicResolutionSettings &settings);
+
+            /// @brief the dynamic resolution can't be copied
+            DynamicResolution(const DynamicResolution &) = delete;
+
+            /// @brief the dynamic resolution can't be copied
+            DynamicResolution &operator=(const DynamicResolution &) = delete;
+
+            /// @brief dtor deletes the timer queries; the context must be current
+            ~DynamicResolution();
+
+            // public methods/functions
+          public:
+            /// @brief redirects the frame into the scaled target ((re)allocating it if the window's render target size
+            /// changed) and starts timing it; call as the frame begins, once the window's size is up to date
+            /// @param targetSize the window's render target size
+            /// @param size the window's size, in pixels
+            void begin_frame(const bEngineRenderTargetSize &targetSize, const int (&size)[2]);
+
+            /// @brief stops timing the frame, upscales the scaled target into the window's framebuffer and feeds every
+            /// frame time which has been measured to the controller; call once the frame's commands are executed
+            /// @param size the window's size, in pixels
+            /// @param renderSeconds the CPU time spent recording and executing the frame's commands, in seconds
+            void end_frame(const int (&size)[2], const double renderSeconds);
+
+            /// @brief gets the statistics of the dynamic resolution
+            /// @return the statistics
+            const bEngineDynamicResolutionStats &get_stats() const;
+
+            // private methods/functions
+          private:
+            /// @brief feeds a measured frame time to the controller, which adjusts the render scale
+            /// @param frameSeconds the frame time, in seconds
+            void update_scale(const double frameSeconds);
+        };
+    } // namespace GL
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,583 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLFrameCapture.h"
+
+/// @file bEngineGLFrameCapture.cpp
+/// @brief implementations for the bEngineGLFrameCapture.h file
+
+#include "bEngineGLContext.h" // for the context's function table and state cache
+#include "bEngineUtilities.h" // for access to assertions, error messaging, etc.
+
+#include <algorithm>    // for sizing deflate blocks and scheduling captures
+#include <array>        // for the CRC table and the QOI color index
+#include <cstdint>      // for fixed-width checksums
+#include <format>       // for naming image files
+#include <system_error> // for creating the capture directory without throwing
+
+namespace
+{
+    /// @brief the storage/mapping flags of a capture's pixel pack buffers: read by the CPU, mapped for the buffer's
+    /// lifetime, and coherent so a readback is visible to the CPU as soon as its fence signals
+    constexpr GLbitfield s_readbackFlags{GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT};
+
+    /// @brief how long the dtor waits on a pending readback at a time, in nanoseconds
+    constexpr GLuint64 s_readbackWaitTimeout{1'000'000'000};
+
+    /// @brief the largest block of a stored (i.e. uncompressed) deflate stream, in bytes
+    constexpr std::size_t s_maxStoredBlock{65'535};
+
+    /// @brief the CRC-32 (as used by PNG chunks) of every byte value
+    constexpr auto s_crcTable{[]() {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t value{0}; value < 256; ++value)
+        {
+            auto crc{value};
+            for (int bit{0}; bit < 8; ++bit)
+                crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+            table[value] = crc;
+        }
+        return table;
+    }()};
+
+    /// @brief appends a 32 bit value, most significant byte first (as both PNG and QOI store them)
+    /// @param encoded the encoded image to append to
+    /// @param value the value to append
+    void append_big_endian(std::vector<unsigned char> &encoded, const std::uint32_t value)
+    {
+        encoded.push_back(static_cast<unsigned char>(value >> 24));
+        encoded.push_back(static_cast<unsigned char>(value >> 16));
+        encoded.push_back(static_cast<unsigned char>(value >> 8));
+        encoded.push_back(static_cast<unsigned char>(value));
+    }
+
+    /// @brief converts a read back frame (RGBA8, bottom row first) to RGB8, top row first; the alpha channel of a
+    /// window's framebuffer is meaningless once presented, so it's dropped
+    /// @param pixels the read back frame
+    /// @param width the width of the frame, in pixels
+    /// @param height the height of the frame, in pixels
+    /// @param rgb receives the converted frame
+    void convert_frame(
+        const std::byte *const      pixels,
+        const int                   width,
+        const int                   height,
+        std::vector<unsigned char> &rgb)
+    {
+        const auto rowPixels{static_cast<std::size_t>(width)};
+        rgb.resize(rowPixels * height * 3);
+
+        auto *destination{rgb.data()};
+        for (int row{height - 1}; row >= 0; --row)
+        {
+            const auto *source{reinterpret_cast<const unsigned char *>(pixels) + rowPixels * row * 4};
+            for (std::size_t pixel{0}; pixel < rowPixels; ++pixel, source += 4, destination += 3)
+            {
+                destination[0] = source[0];
+                destination[1] = source[1];
+                destination[2] = source[2];
+            }
+        }
+    }
+
+    /// @brief encodes an RGB8 frame as a QOI image (see qoiformat.org)
+    /// @param rgb the frame, top row first
+    /// @param width the width of the frame, in pixels
+    /// @param height the height of the frame, in pixels
+    /// @param encoded receives the encoded image
+    void encode_qoi(
+        const std::vector<unsigned char> &rgb,
+        const int                         width,
+        const int                         height,
+        std::vector<unsigned char>       &encoded)
+    {
+        encoded.clear();
+        encoded.insert(encoded.end(), {'q', 'o', 'i', 'f'});
+        append_big_endian(encoded, static_cast<std::uint32_t>(width));
+        append_big_endian(encoded, static_cast<std::uint32_t>(height));
+        encoded.push_back(3); // channels
+        encoded.push_back(0); // sRGB with linear alpha
+
+        // the index starts out as (0, 0, 0, 0) like a decoder's, so every (opaque) pixel compared against it carries
+        // an alpha of 255; otherwise an opaque black pixel would match an untouched entry the decoder sees as clear
+        std::array<std::array<unsigned char, 4>, 64> index{};
+        std::array<unsigned char, 4>                 previous{0, 0, 0, 255};
+        unsigned char                                run{0};
+        const auto                                   end{rgb.data() + rgb.size()};
+        for (const auto *pixel{rgb.data()}; pixel != end; pixel += 3)
+        {
+            const std::array<unsigned char, 4> current{pixel[0], pixel[1], pixel[2], 255};
+            if (current == previous)
+            {
+                if (++run == 62 || pixel + 3 == end)
+                {
+                    encoded.push_back(static_cast<unsigned char>(0xC0 | (run - 1))); // QOI_OP_RUN
+                    run = 0;
+                }
+                continue;
+            }
+
+            if (run > 0)
+            {
+                encoded.push_back(static_cast<unsigned char>(0xC0 | (run - 1))); // QOI_OP_RUN
+                run = 0;
+            }
+
+            const auto hash{(current[0] * 3 + current[1] * 5 + current[2] * 7 + 255 * 11) % 64};
+            if (index[hash] == current)
+            {
+                encoded.push_back(static_cast<unsigned char>(hash)); // QOI_OP_INDEX
+            }
+            else
+            {
+                index[hash] = current;
+
+                const auto red{static_cast<signed char>(current[0] - previous[0])};
+                const auto green{static_cast<signed char>(current[1] - previous[1])};
+                const auto blue{static_cast<signed char>(current[2] - previous[2])};
+                const auto redGreen{red - green};
+                const auto blueGreen{blue - green};
+                if (red >= -2 && red <= 1 && green >= -2 && green <= 1 && blue >= -2 && blue <= 1)
+                {
+                    // QOI_OP_DIFF
+                    encoded.push_back(
+                        static_cast<unsigned char>(0x40 | (red + 2) << 4 | (green + 2) << 2 | (blue + 2)));
+                }
+                else if (green >= -32 && green <= 31 && redGreen >= -8 && redGreen <= 7 && blueGreen >= -8 &&
+                         blueGreen <= 7)
+                {
+                    // QOI_OP_LUMA
+                    encoded.push_back(static_cast<unsigned char>(0x80 | (green + 32)));
+                    encoded.push_back(static_cast<unsigned char>((redGreen + 8) << 4 | (blueGreen + 8)));
+                }
+                else
+                {
+                    encoded.insert(encoded.end(), {0xFE, current[0], current[1], current[2]}); // QOI_OP_RGB
+                }
+            }
+            previous = current;
+        }
+
+        encoded.insert(encoded.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+    }
+
+#ifdef DEBUG
+    /// @brief decodes a QOI image as the reference decoder does, to check that an encoded frame round-trips
+    /// @param encoded the encoded image
+    /// @param rgb receives the decoded image's RGB channels, top row first
+    /// @return true if the image was well-formed, false otherwise
+    const bool decode_qoi(const std::vector<unsigned char> &encoded, std::vector<unsigned char> &rgb)
+    {
+        constexpr std::size_t headerSize{14};
+        constexpr std::size_t endSize{8};
+        if (encoded.size() < headerSize + endSize)
+            return false;
+
+        const auto read_big_endian = [&encoded](const std::size_t offset)
+        {
+            return static_cast<std::uint32_t>(encoded[offset]) << 24 |
+                   static_cast<std::uint32_t>(encoded[offset + 1]) << 16 |
+                   static_cast<std::uint32_t>(encoded[offset + 2]) << 8 | encoded[offset + 3];
+        };
+        const auto pixelCount{static_cast<std::size_t>(read_big_endian(4)) * read_big_endian(8)};
+        rgb.clear();
+        rgb.reserve(pixelCount * 3);
+
+        std::array<std::array<unsigned char, 4>, 64> index{};
+        std::array<unsigned char, 4>                 pixel{0, 0, 0, 255};
+        int                                          run{0};
+        auto                                         position{headerSize};
+        const auto                                   chunksEnd{encoded.size() - endSize};
+        for (std::size_t decoded{0}; decoded < pixelCount; ++decoded)
+        {
+            if (run > 0)
+            {
+                --run;
+            }
+            else if (position < chunksEnd)
+            {
+                const auto tag{encoded[position++]};
+                if (tag == 0xFE && position + 3 <= chunksEnd)
+                {
+                    pixel = {encoded[position], encoded[position + 1], encoded[position + 2], pixel[3]};
+                    position += 3;
+                }
+                else if (tag == 0xFF && position + 4 <= chunksEnd)
+                {
+                    pixel = {encoded[position], encoded[position + 1], encoded[position + 2], encoded[position + 3]};
+                    position += 4;
+                }
+                else if ((tag & 0xC0) == 0x00)
+                {
+                    pixel = index[tag];
+                }
+                else if ((tag & 0xC0) == 0x40)
+                {
+                    pixel[0] = static_cast<unsigned char>(pixel[0] + ((tag >> 4) & 0x03) - 2);
+                    pixel[1] = static_cast<unsigned char>(pixel[1] + ((tag >> 2) & 0x03) - 2);
+                    pixel[2] = static_cast<unsigned char>(pixel[2] + (tag & 0x03) - 2);
+                }
+                else if ((tag & 0xC0) == 0x80 && position < chunksEnd)
+                {
+                    const auto green{(tag & 0x3F) - 32};
+                    const auto redBlue{encoded[position++]};
+                    pixel[0] = static_cast<unsigned char>(pixel[0] + green - 8 + ((redBlue >> 4) & 0x0F));
+                    pixel[1] = static_cast<unsigned char>(pixel[1] + green);
+                    pixel[2] = static_cast<unsigned char>(pixel[2] + green - 8 + (redBlue & 0x0F));
+                }
+                else if ((tag & 0xC0) == 0xC0 && tag < 0xFE)
+                {
+                    run = tag & 0x3F;
+                }
+                else
+                {
+                    return false;
+                }
+                index[(pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64] = pixel;
+            }
+            else
+            {
+                return false;
+            }
+
+            // every captured frame is opaque, so a pixel decoding with any other alpha is as wrong as a bad color
+            if (pixel[3] != 255)
+                return false;
+            rgb.insert(rgb.end(), {pixel[0], pixel[1], pixel[2]});
+        }
+        return position == chunksEnd;
+    }
+#endif
+
+    /// @brief appends a PNG chunk whose data has already been appended after an 8 byte gap (for its length and type)
+    /// @param encoded the encoded image to append to
+    /// @param start the offset of the chunk (i.e. of the gap)
+    /// @param type the chunk's type
+    void finish_png_chunk(std::vector<unsigned char> &encoded, const std::size_t start, const char (&type)[5])
+    {
+        const auto length{static_cast<std::uint32_t>(encoded.size() - start - 8)};
+        for (int byte{0}; byte < 4; ++byte)
+        {
+            encoded[start + byte]     = static_cast<unsigned char>(length >> (24 - byte * 8));
+            encoded[start + 4 + byte] = static_cast<unsigned char>(type[byte]);
+        }
+
+        // the CRC covers the type and data
+        std::uint32_t crc{0xFFFFFFFFu};
+        for (auto byte{start + 4}; byte < encoded.size(); ++byte)
+            crc = s_crcTable[(crc ^ encoded[byte]) & 0xFF] ^ (crc >> 8);
+        append_big_endian(encoded, crc ^ 0xFFFFFFFFu);
+    }
+
+    /// @brief encodes an RGB8 frame as a PNG image
+    ///
+    /// there's no deflate implementation in the library, so the image data is written as stored (uncompressed)
+    /// deflate blocks, which every PNG decoder reads; encoding stays cheap at the cost of larger files
+    /// @param rgb the frame, top row first
+    /// @param width the width of the frame, in pixels
+    /// @param height the height of the frame, in pixels
+    /// @param encoded receives the encoded image
+    void encode_png(
+        const std::vector<unsigned char> &rgb,
+        const int                         width,
+        const int                         height,
+        std::vector<unsigned char>       &encoded)
+    {
+        encoded.clear();
+        encoded.insert(encoded.end(), {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'});
+
+        auto start{encoded.size()};
+        encoded.resize(start + 8);
+        append_big_endian(encoded, static_cast<std::uint32_t>(width));
+        append_big_endian(encoded, static_cast<std::uint32_t>(height));
+        encoded.insert(encoded.end(), {8, 2, 0, 0, 0}); // 8 bit RGB, deflate, no interlacing
+        finish_png_chunk(encoded, start, "IHDR");
+
+        // the image data is every row preceded by its filter type (0, i.e. none), as a zlib stream
+        start = encoded.size();
+        encoded.resize(start + 8);
+        encoded.insert(encoded.end(), {0x78, 0x01});
+
+        const auto    rowSize{static_cast<std::size_t>(width) * 3};
+        const auto    dataSize{(rowSize + 1) * height};
+        std::uint32_t adlerLow{1};
+        std::uint32_t adlerHigh{0};
+        std::size_t   written{0};
+        std::size_t   blockLeft{0};
+        for (int row{0}; row < height; ++row)
+        {
+            const auto *const rowData{rgb.data() + rowSize * row};
+            for (std::size_t byte{0}; byte <= rowSize; ++byte, ++written, --blockLeft)
+            {
+                if (blockLeft == 0)
+                {
+                    blockLeft = std::min(dataSize - written, s_maxStoredBlock);
+                    const auto blockSize{static_cast<std::uint16_t>(blockLeft)};
+                    encoded.push_back(written + blockLeft == dataSize ? 1 : 0); // final block?
+                    encoded.push_back(static_cast<unsigned char>(blockSize));
+                    encoded.push_back(static_cast<unsigned char>(blockSize >> 8));
+                    encoded.push_back(static_cast<unsigned char>(~blockSize));
+                    encoded.push_back(static_cast<unsigned char>(~blockSize >> 8));
+                }
+
+                const unsigned char value{byte == 0 ? static_cast<unsigned char>(0) : rowData[byte - 1]};
+                encoded.push_back(value);
+                adlerLow  = (adlerLow + value) % 65'521;
+                adlerHigh = (adlerHigh + adlerLow) % 65'521;
+            }
+        }
+        append_big_endian(encoded, adlerHigh << 16 | adlerLow);
+        finish_png_chunk(encoded, start, "IDAT");
+
+        start = encoded.size();
+        encoded.resize(start + 8);
+        finish_png_chunk(encoded, start, "IEND");
+    }
+
+    /// @brief writes a whole file
+    /// @param path the path of the file
+    /// @param contents the file's contents
+    /// @return true if the file was written, false otherwise
+    const bool write_file(const std::filesystem::path &path, const std::vector<unsigned char> &contents)
+    {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<const char *>(contents.data()), static_cast<std::streamsize>(contents.size()));
+        return file.good();
+    }
+} // namespace
+
+bEngine::GL::FrameCapture::FrameCapture(
+    Context                      &context,
+    const bEngineCaptureSettings &settings,
+    const int                     width,
+    const int                     height)
+    : m_context{context},
+      m_settings{settings},
+      m_width{width},
+      m_height{height}
+{
+    bENGINE_ASSERT(m_settings.m_bufferCount > 1, "A capture needs at least 2 buffers to read back asynchronously!");
+    bENGINE_ASSERT(m_settings.m_workerCount > 0, "A capture needs at least 1 worker thread!");
+
+    if (m_settings.m_format == bEngineCaptureFormat::RawVideo)
+    {
+        m_video.open(m_settings.m_path, std::ios::binary | std::ios::trunc);
+        m_isOpen = m_video.is_open();
+    }
+    else
+    {
+        std::error_code error{};
+        std::filesystem::create_directories(m_settings.m_path, error);
+        m_isOpen = !error;
+    }
+    if (!m_isOpen)
+    {
+        ERROR_MSG(std::format("Failed to open the capture output \"{}\"!", m_settings.m_path.string()));
+        return;
+    }
+
+    const std::ptrdiff_t frameSize{static_cast<std::ptrdiff_t>(m_width) * m_height * 4};
+    m_slots.reserve(m_settings.m_bufferCount);
+    for (unsigned int slot{0}; slot < m_settings.m_bufferCount; ++slot)
+    {
+        auto &newSlot{*m_slots.emplace_back(std::make_unique<Slot>())};
+        newSlot.m_buffer = bEngineGLBuffer{frameSize, nullptr, s_readbackFlags};
+        newSlot.m_pixels = static_cast<const std::byte *>(newSlot.m_buffer.map_range(0, frameSize, s_readbackFlags));
+        bENGINE_ASSERT(newSlot.m_pixels, "Failed to persistently map a capture buffer!");
+    }
+
+    m_workers.reserve(m_settings.m_workerCount);
+    for (unsigned int worker{0}; worker < m_settings.m_workerCount; ++worker)
+        m_workers.emplace_back(&FrameCapture::run, this);
+}
+
+bEngine::GL::FrameCapture::~FrameCapture()
+{
+    // the buffers themselves are deleted (and implicitly unmapped) by the context group once released
+    finish();
+}
+
+const bool bEngine::GL::FrameCapture::get_is_open() const
+{
+    return m_isOpen;
+}
+
+void bEngine::GL::FrameCapture::finish()
+{
+    if (!m_isOpen)
+        return;
+
+    while (collect_readback(true))
+        ;
+
+    {
+        std::scoped_lock lock{m_queueMutex};
+        m_isStopping = true;
+    }
+    m_queueCondition.notify_all();
+    for (auto &worker : m_workers)
+        worker.join();
+    m_workers.clear();
+    m_isOpen = false;
+}
+
+void bEngine::GL::FrameCapture::capture_frame(const int width, const int height)
+{
+    if (!m_isOpen)
+        return;
+
+    while (collect_readback(false))
+        ;
+
+    const auto now{std::chrono::steady_clock::now()};
+    if (now < m_nextCapture)
+        return;
+
+    // every captured frame has the capture's size, so frames rendered after a resize can't be captured
+    auto &slot{*m_slots[m_nextSlot]};
+    if (width != m_width || height != m_height || slot.m_isBusy.load(std::memory_order_acquire))
+    {
+        ++m_droppedFrames;
+        return;
+    }
+
+    // schedule the next capture from this one's due time, so the capture rate doesn't drift by a frame each time
+    const auto interval{std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(m_settings.m_interval))};
+    m_nextCapture = std::max(m_nextCapture + interval, now);
+
+    // a native window's frame is still in its back buffer (this is called before presenting), a headless window's is
+    // in its offscreen framebuffer
+    const auto &gl{m_context.m_gl};
+    if (m_context.m_windowFramebuffer == 0)
+        gl.NamedFramebufferReadBuffer(0, GL_BACK);
+    m_context.m_stateCache.set_framebuffer(GL_READ_FRAMEBUFFER, m_context.m_windowFramebuffer);
+    m_context.m_stateCache.flush(gl);
+
+    // the pixel pack binding isn't tracked by the state cache, so it's restored immediately
+    slot.m_isBusy.store(true, std::memory_order_relaxed);
+    slot.m_frame = m_nextFrame++;
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, slot.m_buffer.get_name());
+    gl.ReadnPixels(
+        0,
+        0,
+        m_width,
+        m_height,
+        GL_RGBA,
+        GL_UNSIGNED_BYTE,
+        static_cast<GLsizei>(slot.m_buffer.get_size()),
+        nullptr);
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.m_fence = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_nextSlot = (m_nextSlot + 1) % m_slots.size();
+    ++m_capturedFrames;
+}
+
+const bEngine::bEngineCaptureStats bEngine::GL::FrameCapture::get_stats() const
+{
+    bEngineCaptureStats stats{};
+    stats.m_capturedFrames = m_capturedFrames;
+    stats.m_writtenFrames  = m_writtenFrames.load(std::memory_order_relaxed);
+    stats.m_droppedFrames  = m_droppedFrames;
+    stats.m_failedFrames   = m_failedFrames.load(std::memory_order_relaxed);
+    stats.m_encodeSeconds  = static_cast<double>(m_encodeNanoseconds.load(std::memory_order_relaxed)) / 1e9;
+    return stats;
+}
+
+const bool bEngine::GL::FrameCapture::collect_readback(const bool isWaiting)
+{
+    if (m_slots.empty())
+        return false;
+
+    auto &slot{*m_slots[m_pendingSlot]};
+    if (!slot.m_fence)
+        return false;
+
+    // flushing makes sure the fence eventually signals; anything but a timeout (i.e. a failed wait too) means the
+    // readback is done with, and the slot has to reach a worker thread either way so the raw video stays in order
+    const auto &gl{m_context.m_gl};
+    const auto  fence{static_cast<GLsync>(slot.m_fence)};
+    auto        status{gl.ClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, isWaiting ? s_readbackWaitTimeout : 0)};
+    while (isWaiting && status == GL_TIMEOUT_EXPIRED)
+        status = gl.ClientWaitSync(fence, 0, s_readbackWaitTimeout);
+    if (status == GL_TIMEOUT_EXPIRED)
+        return false;
+
+    gl.DeleteSync(fence);
+    slot.m_fence  = nullptr;
+    m_pendingSlot = (m_pendingSlot + 1) % m_slots.size();
+    {
+        std::scoped_lock lock{m_queueMutex};
+        m_queue.push_back(&slot);
+    }
+    m_queueCondition.notify_one();
+    return true;
+}
+
+void bEngine::GL::FrameCapture::run()
+{
+    // each worker thread reuses its scratch space for every frame it writes
+    std::vector<unsigned char> rgb;
+    std::vector<unsigned char> encoded;
+    while (true)
+    {
+        Slot *slot{nullptr};
+        {
+            std::unique_lock lock{m_queueMutex};
+            m_queueCondition.wait(lock, [this]() { return m_isStopping || !m_queue.empty(); });
+            if (m_queue.empty())
+                break;
+
+            slot = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        const auto encodeStart{std::chrono::steady_clock::now()};
+        const auto isWritten{write_frame(*slot, rgb, encoded)};
+        m_encodeNanoseconds.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - encodeStart)
+                .count(),
+            std::memory_order_relaxed);
+        (isWritten ? m_writtenFrames : m_failedFrames).fetch_add(1, std::memory_order_relaxed);
+
+        // the render thread may reuse the slot as soon as it's released
+        slot->m_isBusy.store(false, std::memory_order_release);
+    }
+}
+
+const bool bEngine::GL::FrameCapture::write_frame(
+    const Slot                 &slot,
+    std::vector<unsigned char> &rgb,
+    std::vector<unsigned char> &encoded)
+{
+    convert_frame(slot.m_pixels, m_width, m_height, rgb);
+
+    switch (m_settings.m_format)
+    {
+    case bEngineCaptureFormat::QOI:
+        encode_qoi(rgb, m_width, m_height, encoded);
+#ifdef DEBUG
+        // debug builds decode every frame the way the reference decoder would, so an encoder bug can't go unnoticed
+        if (std::vector<unsigned char> decoded; !decode_qoi(encoded, decoded) || decoded != rgb)
+        {
+            ERROR_MSG(std::format("Frame {} didn't survive a QOI round trip, so it wasn't written!", slot.m_frame));
+            return false;
+        }
+#endif
+        return write_file(m_settings.m_path / std::format("frame_{:06}.qoi", slot.m_frame), encoded);
+    case bEngineCaptureFormat::PNG:
+        encode_png(rgb, m_width, m_height, encoded);
+        return write_file(m_settings.m_path / std::format("frame_{:06}.png", slot.m_frame), encoded);
+    case bEngineCaptureFormat::RawVideo:
+        break;
+    }
+
+    // frames are converted in parallel but have to be appended to the raw video in order
+    std::unique_lock lock{m_videoMutex};
+    m_videoCondition.wait(lock, [this, &slot]() { return m_nextVideoFrame == slot.m_frame; });
+    m_video.write(reinterpret_cast<const char *>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+    const auto isWritten{m_video.good()};
+    ++m_nextVideoFrame;
+    lock.unlock();
+    m_videoCondition.notify_all();
+    return isWritten;
+}
\ No newline at end of file
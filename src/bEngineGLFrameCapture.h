@@ -0,0 +1,192 @@
+#pragma once
+
+/// @file bEngineGLFrameCapture.h
+/// @brief the (private) frame capture of a window: frames are read back into a ring of persistently mapped pixel pack
+/// buffers, and converted, encoded and written by worker threads once their fences signal (see bEngineFrameCapture.h)
+
+#include "bEngineFrameCapture.h" // for the capture settings and statistics
+#include "bEngineGL.h"           // for the pixel pack buffers
+
+#include <atomic>             // for the statistics and slot states shared with the worker threads
+#include <chrono>             // for the capture interval and timing encodes
+#include <condition_variable> // for waking the worker threads and ordering raw video writes
+#include <cstddef>            // for the mapped pixels
+#include <deque>              // for the worker threads' queue of finished readbacks
+#include <fstream>            // for the raw video stream
+#include <memory>             // for the (non-movable) slots
+#include <mutex>              // for guarding the queue and the raw video stream
+#include <thread>             // for the worker threads
+#include <vector>             // for the slots and worker threads
+
+namespace bEngine
+{
+    namespace GL
+    {
+        // fwd declaration of the per-context state frames are captured with
+        struct Context;
+
+        /// @brief captures the frames a window renders without stalling the window's thread
+        ///
+        /// a slot of the ring is free, then pending (its readback is in flight behind a fence), then encoding (a worker
+        /// thread owns it), then free again; frames due while no slot is free are dropped
+        class FrameCapture
+        {
+            // private types
+          private:
+            /// @brief one pixel pack buffer of the ring
+            struct Slot
+            {
+                /// @brief the pixel pack buffer frames are read back into
+                bEngineGLBuffer m_buffer{};
+
+                /// @brief the buffer's persistent mapping
+                const std::byte *m_pixels{nullptr};
+
+                /// @brief the fence placed after the slot's readback, or nullptr if no readback is pending
+                void *m_fence{nullptr};
+
+                /// @brief the index of the frame the slot holds
+                unsigned long long m_frame{0};
+
+                /// @brief true from the slot's readback until a worker thread has written its frame
+                std::atomic<bool> m_isBusy{false};
+            };
+
+            // private data
+          private:
+            /// @brief the context frames are read back on
+            Context &m_context;
+
+            /// @brief the settings the capture was started with
+            const bEngineCaptureSettings m_settings;
+
+            /// @brief the width of captured frames, in pixels
+            const int m_width{0};
+
+            /// @brief the height of captured frames, in pixels
+            const int m_height{0};
+
+            /// @brief true if the capture's output could be opened
+            bool m_isOpen{false};
+
+            /// @brief the ring of pixel pack buffers
+            std::vector<std::unique_ptr<Slot>> m_slots;
+
+            /// @brief the slot the next readback goes into; slots are used (and so finish) in ring order
+            std::size_t m_nextSlot{0};
+
+            /// @brief the slot whose readback finishes next
+            std::size_t m_pendingSlot{0};
+
+            /// @brief the index of the next frame read back (which numbers image files and orders the raw video)
+            unsigned long long m_nextFrame{0};
+
+            /// @brief the earliest time the next frame may be read back
+            std::chrono::steady_clock::time_point m_nextCapture{};
+
+            /// @brief the raw video stream, if writing one
+            std::ofstream m_video;
+
+            /// @brief guards the raw video stream and the index of the next frame written to it
+            std::mutex m_videoMutex;
+
+            /// @brief signalled when a frame has been written to the raw video stream
+            std::condition_variable m_videoCondition;
+
+            /// @brief the index of the next frame written to the raw video stream (frames may finish out of order)
+            unsigned long long m_nextVideoFrame{0};
+
+            /// @brief the number of frames read back
+            unsigned long long m_capturedFrames{0};
+
+            /// @brief the number of frames dropped because every slot was busy
+            unsigned long long m_droppedFrames{0};
+
+            /// @brief the number of frames encoded and written
+            std::atomic<unsigned long long> m_writtenFrames{0};
+
+            /// @brief the number of frames which failed to be written
+            std::atomic<unsigned long long> m_failedFrames{0};
+
+            /// @brief the total time spent encoding, in nanoseconds
+            std::atomic<long long> m_encodeNanoseconds{0};
+
+            /// @brief guards the queue of finished readbacks
+            std::mutex m_queueMutex;
+
+            /// @brief signalled when a finished readback is queued or the worker threads should stop
+            std::condition_variable m_queueCondition;
+
+            /// @brief the slots whose readback has finished, waiting for a worker thread
+            std::deque<Slot *> m_queue;
+
+            /// @brief true once the worker threads should stop (after draining the queue)
+            bool m_isStopping{false};
+
+            /// @brief the worker threads; declared last so they start after everything they use is constructed
+            std::vector<std::thread> m_workers;
+
+            // public ctors/dtor
+          public:
+            /// @brief default ctor is insufficient
+            FrameCapture() = delete;
+
+            /// @brief ctor which creates the ring and starts the worker threads; the context must be current
+            /// @param context the context frames are read back on
+            /// @param settings the settings of the capture
+            /// @param width the width of captured frames, in pixels
+            /// @param height the height of captured frames, in pixels
+            FrameCapture(Context &context, const bEngineCaptureSettings &settings, const int width, const int height);
+
+            /// @brief the capture can't be copied
+            FrameCapture(const FrameCapture &) = delete;
+
+            /// @brief the capture can't be copied
+            FrameCapture &operator=(const FrameCapture &) = delete;
+
+            /// @brief dtor finishes the capture (see finish()); the context must be current
+            ~FrameCapture();
+
+            // public methods/functions
+          public:
+            /// @brief checks whether the capture's output could be opened (i.e. its directory or raw video file)
+            /// @return true if frames can be written, false otherwise
+            const bool get_is_open() const;
+
+            /// @brief hands every finished readback to the worker threads without waiting on the GPU, then reads back
+            /// the window's frame if a capture is due; call once the frame is rendered and before it's presented
+            /// @param width the width of the rendered frame, in pixels
+            /// @param height the height of the rendered frame, in pixels
+            void capture_frame(const int width, const int height);
+
+            /// @brief finishes the capture: waits for every pending readback and lets the worker threads write them
+            /// before stopping the worker threads, so no read back frame is lost; the context must be current, and no
+            /// frame is captured afterwards
+            void finish();
+
+            /// @brief gets the capture's statistics
+            /// @return the capture's statistics
+            const bEngineCaptureStats get_stats() const;
+
+            // private methods/functions
+          private:
+            /// @brief hands the oldest pending readback to the worker threads if it has finished
+            /// @param isWaiting true to wait for the readback to finish
+            /// @return true if a readback was handed over, false if none is pending (or it hasn't finished)
+            const bool collect_readback(const bool isWaiting);
+
+            /// @brief a worker thread's loop
+            void run();
+
+            /// @brief converts, encodes and writes the frame held by a slot
+            /// @param slot the slot holding the frame
+            /// @param rgb scratch space for the frame's converted pixels
+            /// @param encoded scratch space for the encoded frame
+            /// @return true if the frame was written, false otherwise
+            const bool write_frame(
+                const Slot                 &slot,
+                std::vector<unsigned char> &rgb,
+                std::vector<unsigned char> &encoded);
+        };
+    } // namespace GL
+} // namespace bEngine
\ No newline at end of file
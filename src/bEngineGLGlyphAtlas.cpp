@@ -0,0 +1,310 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLGlyphAtlas.h"
+
+/// @file bEngineGLGlyphAtlas.cpp
+/// @brief implementations for the bEngineGLGlyphAtlas.h file
+
+#include "bEngineGLContext.h" // for clearing the atlas' pages
+#include "bEngineUtilities.h" // for access to assertions and warnings
+
+#include <algorithm> // for finding the lowest skyline position and clamping distances
+#include <cmath>     // for rounding sizes and measuring distances
+#include <format>    // for formatting warnings
+#include <limits>    // for the initial best skyline position
+
+namespace
+{
+    /// @brief packs the key glyphs are found in the atlas by
+    /// @param font the ID of the glyph's font
+    /// @param glyph the index of the glyph in its font
+    /// @param sizeKey the (whole pixel) size the glyph was rasterized at, or 0 for distance field glyphs
+    /// @param mode how the glyph was rasterized
+    /// @return the glyph's key
+    const std::uint64_t make_glyph_key(
+        const std::uint16_t             font,
+        const std::uint32_t             glyph,
+        const std::uint32_t             sizeKey,
+        const bEngine::bEngineGlyphMode mode)
+    {
+        return static_cast<std::uint64_t>(font) << 48 | static_cast<std::uint64_t>(sizeKey & 0x7FFF) << 33 |
+               static_cast<std::uint64_t>(mode) << 32 | glyph;
+    }
+
+    /// @brief converts a coverage bitmap into a signed distance field by searching each texel's neighbourhood for the
+    /// nearest texel on the other side of the edge; quadratic in the spread, but glyphs are only converted once
+    /// @param coverage the coverage bitmap, top row first
+    /// @param width the width of the bitmap, in texels
+    /// @param height the height of the bitmap, in texels
+    /// @param spread the distance over which the field ramps from inside to outside, which is also the padding added
+    /// around the bitmap
+    /// @param rowStride the distance between rows of the field, in bytes
+    /// @param field receives the field (128 on the edge, increasing inwards), top row first
+    void generate_distance_field(
+        const std::vector<std::uint8_t> &coverage,
+        const int                        width,
+        const int                        height,
+        const int                        spread,
+        const int                        rowStride,
+        std::vector<std::uint8_t>       &field)
+    {
+        const auto is_inside{[&](const int x, const int y) {
+            return x >= 0 && y >= 0 && x < width && y < height && coverage[y * width + x] >= 128;
+        }};
+
+        const auto fieldWidth{width + 2 * spread};
+        const auto fieldHeight{height + 2 * spread};
+        field.assign(static_cast<std::size_t>(rowStride) * fieldHeight, 0);
+        for (int y{0}; y < fieldHeight; ++y)
+        {
+            for (int x{0}; x < fieldWidth; ++x)
+            {
+                const auto isInside{is_inside(x - spread, y - spread)};
+                auto       nearest{static_cast<float>(spread)};
+                for (int dy{-spread}; dy <= spread; ++dy)
+                {
+                    for (int dx{-spread}; dx <= spread; ++dx)
+                    {
+                        if (is_inside(x - spread + dx, y - spread + dy) == isInside)
+                            continue;
+                        nearest = std::min(nearest, std::sqrt(static_cast<float>(dx * dx + dy * dy)));
+                    }
+                }
+
+                // the edge lies about halfway between a texel and its nearest neighbour across it
+                const auto distance{std::clamp(nearest - 0.5f, 0.0f, static_cast<float>(spread))};
+                const auto value{128.0f + (isInside ? distance : -distance) * 127.0f / spread};
+                field[y * rowStride + x] = static_cast<std::uint8_t>(std::clamp(value, 0.0f, 255.0f));
+            }
+        }
+    }
+} // namespace
+
+bEngine::GL::GlyphAtlas::GlyphAtlas(const int pageSize, const int pageCount)
+    : m_texture{GL_TEXTURE_2D_ARRAY, 1, GL_R8, pageSize, pageSize, pageCount},
+      m_pageSize{pageSize},
+      m_skylines(pageCount, {SkylineNode{0, 0, pageSize}}),
+      m_pageLastUsedFrames(pageCount, 0)
+{
+    // immutable storage starts out undefined, and the gutters between glyphs have to be empty
+    require_current_context().m_gl.ClearTexImage(m_texture.get_name(), 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    m_texture.set_parameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    m_texture.set_parameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    m_texture.set_parameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    m_texture.set_parameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+void bEngine::GL::GlyphAtlas::begin_frame()
+{
+    ++m_frame;
+}
+
+const bEngine::GL::AtlasGlyph *bEngine::GL::GlyphAtlas::get_glyph(
+    const std::uint16_t          font,
+    const bEngineFontRasterizer &rasterizer,
+    const std::uint32_t          glyph,
+    const float                  pixelSize,
+    const bEngineGlyphMode       mode,
+    bEngineTextStats            &stats)
+{
+    // coverage glyphs are rasterized at whole pixel sizes, distance field glyphs at a single size
+    const auto isDistanceField{mode == bEngineGlyphMode::DistanceField};
+    const auto rasterSize{isDistanceField ? s_distanceFieldSize : std::max(1.0f, std::round(pixelSize))};
+    const auto key{make_glyph_key(font, glyph, isDistanceField ? 0 : static_cast<std::uint32_t>(rasterSize), mode)};
+    if (auto found{m_glyphs.find(key)}; found != m_glyphs.end())
+    {
+        auto &entry{found->second};
+        entry.m_lastUsedFrame = m_frame;
+        if (!entry.m_glyph.m_isEmpty)
+            m_pageLastUsedFrames[entry.m_glyph.m_page] = m_frame;
+        return &entry.m_glyph;
+    }
+
+    Entry      entry{};
+    const auto size{rasterize(rasterizer, glyph, rasterSize, mode, entry)};
+    entry.m_lastUsedFrame = m_frame;
+    ++stats.m_rasterizedGlyphs;
+    if (entry.m_glyph.m_isEmpty)
+        return &m_glyphs.insert_or_assign(key, entry).first->second.m_glyph;
+
+    // every glyph keeps a texel of empty gutter to its right and below it, so filtering never reaches a neighbour
+    const auto paddedWidth{size.x + 1};
+    const auto paddedHeight{size.y + 1};
+    if (paddedWidth > m_pageSize || paddedHeight > m_pageSize)
+    {
+        WARNING_MSG(std::format("A {}x{} glyph doesn't fit in the glyph atlas' pages!", size.x, size.y));
+        return nullptr;
+    }
+
+    glm::ivec2 position{0};
+    auto       page{0};
+    while (page < static_cast<int>(m_skylines.size()) && !pack(page, paddedWidth, paddedHeight, position))
+        ++page;
+    if (page == static_cast<int>(m_skylines.size()))
+    {
+        page = evict_page();
+        if (page < 0)
+            return nullptr;
+        ++stats.m_evictedPages;
+        pack(page, paddedWidth, paddedHeight, position);
+    }
+
+    m_texture.upload(0, position.x, position.y, page, size.x, size.y, 1, GL_RED, GL_UNSIGNED_BYTE, m_texels.data());
+
+    const auto pageSize{static_cast<float>(m_pageSize)};
+    entry.m_glyph.m_uvRect = {
+        position.x / pageSize,
+        position.y / pageSize,
+        (position.x + size.x) / pageSize,
+        (position.y + size.y) / pageSize};
+    entry.m_glyph.m_page        = static_cast<std::uint16_t>(page);
+    m_pageLastUsedFrames[page] = m_frame;
+    return &m_glyphs.insert_or_assign(key, entry).first->second.m_glyph;
+}
+
+const bEngine::bEngineGLTexture &bEngine::GL::GlyphAtlas::get_texture() const
+{
+    return m_texture;
+}
+
+const glm::ivec2 bEngine::GL::GlyphAtlas::rasterize(
+    const bEngineFontRasterizer &rasterizer,
+    const std::uint32_t          glyph,
+    const float                  pixelSize,
+    const bEngineGlyphMode       mode,
+    Entry                       &entry)
+{
+    m_bitmap = {};
+    if (!rasterizer.rasterize_glyph(glyph, pixelSize, m_bitmap) || m_bitmap.m_width <= 0 || m_bitmap.m_height <= 0)
+        return glm::ivec2{0};
+    bENGINE_ASSERT(
+        m_bitmap.m_coverage.size() >= static_cast<std::size_t>(m_bitmap.m_width) * m_bitmap.m_height,
+        "A rasterized glyph's bitmap is smaller than its size!");
+
+    // rows are padded to the default (4 byte) unpack alignment
+    const auto padding{mode == bEngineGlyphMode::DistanceField ? s_distanceFieldSpread : 0};
+    const glm::ivec2 size{m_bitmap.m_width + 2 * padding, m_bitmap.m_height + 2 * padding};
+    const auto rowStride{(size.x + 3) & ~3};
+    if (mode == bEngineGlyphMode::DistanceField)
+        generate_distance_field(m_bitmap.m_coverage, m_bitmap.m_width, m_bitmap.m_height, padding, rowStride, m_texels);
+    else
+    {
+        m_texels.assign(static_cast<std::size_t>(rowStride) * size.y, 0);
+        for (int row{0}; row < size.y; ++row)
+        {
+            std::copy_n(
+                m_bitmap.m_coverage.begin() + static_cast<std::ptrdiff_t>(row) * size.x,
+                size.x,
+                m_texels.begin() + static_cast<std::ptrdiff_t>(row) * rowStride);
+        }
+    }
+
+    entry.m_glyph.m_offset  = {m_bitmap.m_bearingX - padding, -m_bitmap.m_bearingY - padding};
+    entry.m_glyph.m_size    = size;
+    entry.m_glyph.m_isEmpty = false;
+    return size;
+}
+
+const bool bEngine::GL::GlyphAtlas::pack(const int page, const int width, const int height, glm::ivec2 &position)
+{
+    auto &skyline{m_skylines[page]};
+
+    // find the lowest position (then the narrowest segment) the rectangle fits at, starting at a segment's left end
+    auto        bestY{std::numeric_limits<int>::max()};
+    auto        bestWidth{std::numeric_limits<int>::max()};
+    std::size_t bestNode{skyline.size()};
+    for (std::size_t node{0}; node < skyline.size(); ++node)
+    {
+        if (skyline[node].m_x + width > m_pageSize)
+            break;
+
+        // the rectangle rests on the highest segment it spans
+        auto y{0};
+        auto remaining{width};
+        for (auto spanned{node}; remaining > 0; ++spanned)
+        {
+            y          = std::max(y, skyline[spanned].m_y);
+            remaining -= skyline[spanned].m_width;
+        }
+        if (y + height > m_pageSize)
+            continue;
+
+        if (y < bestY || (y == bestY && skyline[node].m_width < bestWidth))
+        {
+            bestY     = y;
+            bestWidth = skyline[node].m_width;
+            bestNode  = node;
+        }
+    }
+    if (bestNode == skyline.size())
+        return false;
+
+    // the rectangle's top edge becomes a new segment, which shortens (or covers) the segments under it
+    position = {skyline[bestNode].m_x, bestY};
+    skyline.insert(skyline.begin() + bestNode, SkylineNode{position.x, bestY + height, width});
+    for (auto node{bestNode + 1}; node < skyline.size();)
+    {
+        const auto previousEnd{skyline[node - 1].m_x + skyline[node - 1].m_width};
+        if (skyline[node].m_x >= previousEnd)
+            break;
+
+        const auto overlap{previousEnd - skyline[node].m_x};
+        skyline[node].m_x     += overlap;
+        skyline[node].m_width -= overlap;
+        if (skyline[node].m_width > 0)
+            break;
+        skyline.erase(skyline.begin() + node);
+    }
+
+    // neighbouring segments at the same height are merged, so the skyline stays short
+    for (std::size_t node{1}; node < skyline.size();)
+    {
+        if (skyline[node - 1].m_y == skyline[node].m_y)
+        {
+            skyline[node - 1].m_width += skyline[node].m_width;
+            skyline.erase(skyline.begin() + node);
+        }
+        else
+            ++node;
+    }
+    return true;
+}
+
+const int bEngine::GL::GlyphAtlas::evict_page()
+{
+    auto page{-1};
+    for (int candidate{0}; candidate < static_cast<int>(m_pageLastUsedFrames.size()); ++candidate)
+    {
+        if (m_pageLastUsedFrames[candidate] < m_frame &&
+            (page < 0 || m_pageLastUsedFrames[candidate] < m_pageLastUsedFrames[page]))
+            page = candidate;
+    }
+    if (page < 0)
+    {
+        WARNING_MSG("The glyph atlas is full of glyphs drawn this frame!");
+        return -1;
+    }
+
+    // erasing keeps every other iterator valid
+    for (auto entry{m_glyphs.begin()}; entry != m_glyphs.end();)
+    {
+        const auto current{entry++};
+        if (!current->second.m_glyph.m_isEmpty && current->second.m_glyph.m_page == page)
+            m_glyphs.erase(current);
+    }
+
+    m_skylines[page] = {SkylineNode{0, 0, m_pageSize}};
+    require_current_context().m_gl.ClearTexSubImage(
+        m_texture.get_name(),
+        0,
+        0,
+        0,
+        page,
+        m_pageSize,
+        m_pageSize,
+        1,
+        GL_RED,
+        GL_UNSIGNED_BYTE,
+        nullptr);
+    return page;
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#pragma once
+
+/// @file bEngineGLGlyphAtlas.h
+/// @brief the (private) glyph atlas of a text renderer: glyphs are rasterized on demand and packed into the pages of
+/// an R8 texture array, evicting whole pages in least recently used order once it's full (see bEngineText.h)
+
+#include "bEngineFlatMap.h" // for finding glyphs in the atlas
+#include "bEngineGL.h"      // for the atlas' texture array
+#include "bEngineText.h"    // for the rasterizers glyphs are rasterized with
+
+#include <glm\glm.hpp> // for the glyphs' rectangles in their pages
+
+#include <cstdint> // for fixed width integers
+#include <vector>  // for the pages' skylines
+
+namespace bEngine
+{
+    namespace GL
+    {
+        /// @brief the location and placement of a glyph in the atlas
+        struct AtlasGlyph
+        {
+            /// @brief the glyph's rectangle in its page (min u, min v, max u, max v), min v being the top row
+            glm::vec4 m_uvRect{0.0f};
+
+            /// @brief the offset from the pen position (on the baseline, y down) to the quad's top left corner, in
+            /// pixels at the size the glyph was rasterized at
+            glm::vec2 m_offset{0.0f};
+
+            /// @brief the size of the quad, in pixels at the size the glyph was rasterized at
+            glm::vec2 m_size{0.0f};
+
+            /// @brief the page the glyph is on
+            std::uint16_t m_page{0};
+
+            /// @brief true if the glyph draws nothing (e.g. a space), in which case it takes no space in the atlas
+            bool m_isEmpty{true};
+        };
+
+        /// @brief rasterizes and packs glyphs into a texture array
+        ///
+        /// each page is packed with a skyline (bottom-left) packer, which keeps the top edge of the packed glyphs
+        /// as a list of horizontal segments and places each glyph as low as it fits. Glyphs can't be freed one by
+        /// one from a skyline, so space is reclaimed a page at a time: the least recently used page which the current
+        /// frame hasn't drawn from is cleared, and its glyphs are rasterized again when next drawn.
+        class GlyphAtlas
+        {
+            // public static data
+          public:
+            /// @brief the size distance field glyphs are rasterized at, in pixels; they're scaled to any other size
+            static constexpr float s_distanceFieldSize{48.0f};
+
+            /// @brief the distance (in pixels at s_distanceFieldSize) over which a distance field ramps from inside to
+            /// outside; it's also the padding around each distance field glyph
+            static constexpr int s_distanceFieldSpread{6};
+
+            // private types
+          private:
+            /// @brief a horizontal segment of a page's skyline
+            struct SkylineNode
+            {
+                /// @brief the x coordinate of the segment's left end, in texels
+                int m_x{0};
+
+                /// @brief the height of the skyline along the segment, in texels
+                int m_y{0};
+
+                /// @brief the width of the segment, in texels
+                int m_width{0};
+            };
+
+            /// @brief a glyph of the atlas
+            struct Entry
+            {
+                /// @brief the glyph's location and placement
+                AtlasGlyph m_glyph{};
+
+                /// @brief the frame the glyph was last drawn in
+                unsigned long long m_lastUsedFrame{0};
+            };
+
+            // private data
+          private:
+            /// @brief the atlas' texture array (R8)
+            bEngineGLTexture m_texture;
+
+            /// @brief the width and height of each page, in texels
+            const int m_pageSize{0};
+
+            /// @brief the skyline of each page, ordered by x
+            std::vector<std::vector<SkylineNode>> m_skylines;
+
+            /// @brief the frame each page was last drawn from in
+            std::vector<unsigned long long> m_pageLastUsedFrames;
+
+            /// @brief the glyphs in the atlas, by key (see get_glyph())
+            bEngineFlatMap<std::uint64_t, Entry> m_glyphs;
+
+            /// @brief the current frame
+            unsigned long long m_frame{1};
+
+            /// @brief the bitmap glyphs are rasterized into, reused for every glyph
+            bEngineGlyphBitmap m_bitmap{};
+
+            /// @brief the texels of a glyph as they're uploaded, reused for every glyph
+            std::vector<std::uint8_t> m_texels;
+
+            // public ctors/dtor
+          public:
+            /// @brief default ctor is insufficient
+            GlyphAtlas() = delete;
+
+            /// @brief ctor which creates the atlas' (empty) texture array on the current context
+            /// @param pageSize the width and height of each page, in texels
+            /// @param pageCount the number of pages
+            GlyphAtlas(const int pageSize, const int pageCount);
+
+            // public methods/functions
+          public:
+            /// @brief starts a new frame; pages drawn from by the previous frame become evictable
+            void begin_frame();
+
+            /// @brief finds a glyph in the atlas, rasterizing and packing it if it isn't there, and marks its page as
+            /// used by the current frame
+            /// @param font the ID of the glyph's font
+            /// @param rasterizer the glyph's font
+            /// @param glyph the index of the glyph in its font
+            /// @param pixelSize the size the glyph is drawn at, in pixels
+            /// @param mode how the glyph is rasterized
+            /// @param stats the statistics rasterizing and evicting are counted in
+            /// @return the glyph, or nullptr if the atlas has no room for it this frame (the pointer is valid until
+            /// the next glyph is found)
+            const AtlasGlyph *get_glyph(
+                const std::uint16_t          font,
+                const bEngineFontRasterizer &rasterizer,
+                const std::uint32_t          glyph,
+                const float                  pixelSize,
+                const bEngineGlyphMode       mode,
+                bEngineTextStats            &stats);
+
+            /// @brief gets the atlas' texture array
+            /// @return a reference to the atlas' texture array
+            const bEngineGLTexture &get_texture() const;
+
+            // private methods/functions
+          private:
+            /// @brief rasterizes a glyph into m_texels, as a distance field if requested
+            /// @param rasterizer the glyph's font
+            /// @param glyph the index of the glyph in its font
+            /// @param pixelSize the size to rasterize the glyph at, in pixels
+            /// @param mode how the glyph is rasterized
+            /// @param entry receives the glyph's placement (but not its location)
+            /// @return the width and height of the rasterized texels (zero if the glyph draws nothing)
+            const glm::ivec2 rasterize(
+                const bEngineFontRasterizer &rasterizer,
+                const std::uint32_t          glyph,
+                const float                  pixelSize,
+                const bEngineGlyphMode       mode,
+                Entry                       &entry);
+
+            /// @brief packs a rectangle into a page's skyline
+            /// @param page the page
+            /// @param width the width of the rectangle, in texels
+            /// @param height the height of the rectangle, in texels
+            /// @param position receives the rectangle's top left corner, in texels
+            /// @return true if the rectangle was packed, false if the page has no room for it
+            const bool pack(const int page, const int width, const int height, glm::ivec2 &position);
+
+            /// @brief evicts the least recently used page the current frame hasn't drawn from
+            /// @return the evicted page, or -1 if every page has been drawn from by the current frame
+            const int evict_page();
+        };
+    } // namespace GL
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLInstancing.h"
+
+/// @file bEngineGLInstancing.cpp
+/// @brief implementations for the bEngineGLInstancing.h file
+
+#include "bEngineUtilities.h" // for access to assertions and warnings
+
+#include <glad\gl.h>           // for the types of the instance attributes and of the mesh indices
+#include <glm\gtc\packing.hpp> // for quantizing instance transforms
+
+#include <cstring> // for packing instances and writing them into mapped memory
+#include <format>  // for formatting warnings
+
+namespace
+{
+    /// @brief an instance's transform as the vertex array reads it
+    struct InstanceTransform
+    {
+        /// @brief the translation (full precision, so instances far from the origin don't snap)
+        float m_translation[3];
+
+        /// @brief the basis vectors (the first three columns of the transform) as half floats; the fourth half of each
+        /// is unused, but keeps every attribute 4 byte aligned
+        std::uint16_t m_basis[3][4];
+    };
+    static_assert(
+        sizeof(InstanceTransform) == bEngine::bEngineGLInstanceBatch::s_transformSize,
+        "instance transforms must match the vertex array's layout");
+} // namespace
+
+bEngine::bEngineGLInstanceBatch::bEngineGLInstanceBatch(
+    bEngineGLStreamBuffer   &streamBuffer,
+    const bEngineGLMeshPool &meshPool,
+    const int                customDataSize)
+    : m_streamBuffer{&streamBuffer},
+      m_meshPool{&meshPool},
+      m_customDataSize{customDataSize},
+      m_instanceStride{s_transformSize + customDataSize}
+{
+    bENGINE_ASSERT(
+        m_customDataSize >= 0 && m_customDataSize % 4 == 0,
+        "An instance's custom data size must be a multiple of 4 bytes!");
+
+    // instances are read from the start of the stream buffer, and each bucket's draw offsets them with its base
+    // instance
+    const auto &vertexArray{m_meshPool->get_vertex_array()};
+    vertexArray.set_vertex_buffer(s_instanceBinding, m_streamBuffer->get_buffer(), 0, m_instanceStride);
+    vertexArray.set_binding_divisor(s_instanceBinding, 1);
+    vertexArray.set_attribute(
+        s_transformLocation,
+        s_instanceBinding,
+        3,
+        GL_FLOAT,
+        false,
+        offsetof(InstanceTransform, m_translation));
+    for (unsigned int column{0}; column < 3; ++column)
+    {
+        vertexArray.set_attribute(
+            s_transformLocation + 1 + column,
+            s_instanceBinding,
+            4,
+            GL_HALF_FLOAT,
+            false,
+            static_cast<unsigned int>(offsetof(InstanceTransform, m_basis) + column * sizeof(std::uint16_t[4])));
+    }
+}
+
+void bEngine::bEngineGLInstanceBatch::set_custom_attribute(
+    const unsigned int attributeIndex,
+    const int          componentCount,
+    const unsigned int type,
+    const bool         isNormalized,
+    const unsigned int customDataOffset) const
+{
+    bENGINE_ASSERT(attributeIndex < s_transformLocation, "Custom instance attributes must use locations below 12!");
+    bENGINE_ASSERT(customDataOffset < static_cast<unsigned int>(m_customDataSize), "Custom attribute out of range!");
+
+    m_meshPool->get_vertex_array().set_attribute(
+        attributeIndex,
+        s_instanceBinding,
+        componentCount,
+        type,
+        isNormalized,
+        s_transformSize + customDataOffset);
+}
+
+const std::uint32_t bEngine::bEngineGLInstanceBatch::add_bucket(
+    const bEngineMeshRange &mesh,
+    const bEngineDrawItem  &item,
+    const std::uint64_t     sortKey)
+{
+    m_buckets.push_back({mesh, item, sortKey, {}});
+    return static_cast<std::uint32_t>(m_buckets.size() - 1);
+}
+
+void bEngine::bEngineGLInstanceBatch::begin()
+{
+    for (auto &bucket : m_buckets)
+        bucket.m_instances.clear();
+}
+
+void bEngine::bEngineGLInstanceBatch::add_instance(
+    const std::uint32_t bucket,
+    const glm::mat4    &transform,
+    const void *const   customData)
+{
+    bENGINE_ASSERT(bucket < m_buckets.size(), "An instance refers to a bucket the batch doesn't have!");
+
+    InstanceTransform packed{};
+    packed.m_translation[0] = transform[3].x;
+    packed.m_translation[1] = transform[3].y;
+    packed.m_translation[2] = transform[3].z;
+    for (int column{0}; column < 3; ++column)
+    {
+        const auto basis{glm::packHalf4x16(glm::vec4{glm::vec3{transform[column]}, 0.0f})};
+        std::memcpy(packed.m_basis[column], &basis, sizeof(basis));
+    }
+
+    auto      &instances{m_buckets[bucket].m_instances};
+    const auto offset{instances.size()};
+    instances.resize(offset + m_instanceStride);
+    std::memcpy(instances.data() + offset, &packed, sizeof(packed));
+    if (m_customDataSize > 0)
+    {
+        auto *const destination{instances.data() + offset + s_transformSize};
+        if (customData)
+            std::memcpy(destination, customData, m_customDataSize);
+        else
+            std::memset(destination, 0, m_customDataSize);
+    }
+}
+
+void bEngine::bEngineGLInstanceBatch::record(bEngineCommandBuffer &commands)
+{
+    m_stats = {};
+
+    std::ptrdiff_t size{0};
+    for (const auto &bucket : m_buckets)
+        size += static_cast<std::ptrdiff_t>(bucket.m_instances.size());
+    const auto instanceCount{static_cast<std::uint32_t>(size / m_instanceStride)};
+    if (instanceCount == 0)
+        return;
+
+    // instances are found by their index, so the allocation has to start on a whole instance; strides are rarely
+    // powers of two, so up to one instance of extra space is allocated and the start is rounded up instead
+    auto allocation{m_streamBuffer->allocate(size + m_instanceStride, 4)};
+    if (!allocation.m_data)
+    {
+        WARNING_MSG(std::format("Not enough stream buffer space left this frame for {} instances!", instanceCount));
+        m_stats.m_droppedInstances = instanceCount;
+        return;
+    }
+    const auto skip{(m_instanceStride - allocation.m_offset % m_instanceStride) % m_instanceStride};
+
+    // each bucket is written with a single copy, since the mapping is write-only
+    auto      *destination{static_cast<std::byte *>(allocation.m_data) + skip};
+    auto       baseInstance{static_cast<std::uint32_t>((allocation.m_offset + skip) / m_instanceStride)};
+    const auto indexCount{m_meshPool->get_index_count()};
+    for (const auto &bucket : m_buckets)
+    {
+        if (bucket.m_instances.empty())
+            continue;
+
+        bENGINE_ASSERT(
+            bucket.m_mesh.m_firstIndex + bucket.m_mesh.m_indexCount <= indexCount,
+            "An instance bucket's mesh isn't in the batch's mesh pool!");
+        std::memcpy(destination, bucket.m_instances.data(), bucket.m_instances.size());
+        const auto bucketInstances{static_cast<std::uint32_t>(bucket.m_instances.size() / m_instanceStride)};
+
+        auto item{bucket.m_item};
+        item.m_vertexArray   = &m_meshPool->get_vertex_array();
+        item.m_indexType     = GL_UNSIGNED_INT;
+        item.m_first         = static_cast<int>(bucket.m_mesh.m_firstIndex);
+        item.m_count         = static_cast<int>(bucket.m_mesh.m_indexCount);
+        item.m_baseVertex    = bucket.m_mesh.m_baseVertex;
+        item.m_instanceCount = static_cast<int>(bucketInstances);
+        item.m_baseInstance  = baseInstance;
+        commands.draw(bucket.m_sortKey, item);
+
+        destination  += bucket.m_instances.size();
+        baseInstance += bucketInstances;
+        ++m_stats.m_drawCount;
+    }
+
+    m_stats.m_instanceCount = instanceCount;
+    m_stats.m_uploadedBytes = size;
+}
+
+const int bEngine::bEngineGLInstanceBatch::get_instance_stride() const
+{
+    return m_instanceStride;
+}
+
+const bEngine::bEngineInstanceStats bEngine::bEngineGLInstanceBatch::get_stats() const
+{
+    return m_stats;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLMultiDraw.h"
+
+/// @file bEngineGLMultiDraw.cpp
+/// @brief implementations for the bEngineGLMultiDraw.h file
+
+#include "bEngineCommandBuffer.h" // for recording a batch
+#include "bEngineGLContext.h"     // for the current context's limits
+#include "bEngineUtilities.h"     // for access to assertions and warnings
+
+#include <cstring> // for writing draws into mapped memory
+#include <format>  // for formatting warnings
+
+bEngine::bEngineGLMeshPool::bEngineGLMeshPool(
+    const int           vertexStride,
+    const std::uint32_t vertexCapacity,
+    const std::uint32_t indexCapacity)
+    : m_vertexStride{vertexStride},
+      m_vertexCapacity{vertexCapacity},
+      m_indexCapacity{indexCapacity},
+      m_vertices{static_cast<std::ptrdiff_t>(vertexCapacity) * vertexStride, nullptr, GL_DYNAMIC_STORAGE_BIT},
+      m_indices{
+          static_cast<std::ptrdiff_t>(indexCapacity * sizeof(std::uint32_t)),
+          nullptr,
+          GL_DYNAMIC_STORAGE_BIT},
+      m_vertexArray{bEngineGLVertexArray::create_vertex_array()}
+{
+    m_vertexArray.set_vertex_buffer(0, m_vertices, 0, m_vertexStride);
+    m_vertexArray.set_element_buffer(m_indices);
+}
+
+const bEngine::bEngineMeshRange bEngine::bEngineGLMeshPool::add_mesh(
+    const void *const          vertices,
+    const std::uint32_t        vertexCount,
+    const std::uint32_t *const indices,
+    const std::uint32_t        indexCount)
+{
+    bENGINE_ASSERT(
+        vertexCount <= m_vertexCapacity - m_vertexCount && indexCount <= m_indexCapacity - m_indexCount,
+        "The mesh pool is out of space!");
+
+    m_vertices.upload(
+        static_cast<std::ptrdiff_t>(m_vertexCount) * m_vertexStride,
+        static_cast<std::ptrdiff_t>(vertexCount) * m_vertexStride,
+        vertices);
+    m_indices.upload(
+        static_cast<std::ptrdiff_t>(m_indexCount) * sizeof(std::uint32_t),
+        static_cast<std::ptrdiff_t>(indexCount) * sizeof(std::uint32_t),
+        indices);
+
+    const bEngineMeshRange mesh{m_indexCount, indexCount, static_cast<std::int32_t>(m_vertexCount)};
+    m_vertexCount += vertexCount;
+    m_indexCount  += indexCount;
+    return mesh;
+}
+
+const bEngine::bEngineGLVertexArray &bEngine::bEngineGLMeshPool::get_vertex_array() const
+{
+    return m_vertexArray;
+}
+
+const int bEngine::bEngineGLMeshPool::get_vertex_stride() const
+{
+    return m_vertexStride;
+}
+
+const std::uint32_t bEngine::bEngineGLMeshPool::get_vertex_count() const
+{
+    return m_vertexCount;
+}
+
+const std::uint32_t bEngine::bEngineGLMeshPool::get_index_count() const
+{
+    return m_indexCount;
+}
+
+bEngine::bEngineGLDrawBatch::bEngineGLDrawBatch(bEngineGLStreamBuffer &streamBuffer, const std::ptrdiff_t drawDataSize)
+    : m_streamBuffer{&streamBuffer},
+      m_drawDataSize{drawDataSize}
+{
+    GLint alignment{0};
+    GL::require_current_context().m_gl.GetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    m_storageAlignment = alignment;
+}
+
+const bool bEngine::bEngineGLDrawBatch::begin(const std::uint32_t drawCount)
+{
+    m_drawCount = 0;
+    m_commands  = {};
+    m_drawData  = {};
+    if (drawCount == 0)
+        return true;
+
+    m_commands = m_streamBuffer->allocate(
+        static_cast<std::ptrdiff_t>(drawCount) * sizeof(bEngineDrawIndirectCommand),
+        alignof(bEngineDrawIndirectCommand));
+    if (m_drawDataSize > 0 && m_commands.m_data)
+        m_drawData = m_streamBuffer->allocate(
+            static_cast<std::ptrdiff_t>(drawCount) * m_drawDataSize,
+            m_storageAlignment);
+
+    if (!m_commands.m_data || (m_drawDataSize > 0 && !m_drawData.m_data))
+    {
+        WARNING_MSG(std::format("Not enough stream buffer space left this frame for a batch of {} draws!", drawCount));
+        m_commands = {};
+        m_drawData = {};
+        return false;
+    }
+
+    m_drawCount = drawCount;
+    return true;
+}
+
+void bEngine::bEngineGLDrawBatch::set_draw(
+    const std::uint32_t     drawIndex,
+    const bEngineMeshRange &mesh,
+    const void *const       drawData,
+    const std::uint32_t     instanceCount) const
+{
+    bENGINE_ASSERT(drawIndex < m_drawCount, "Draw index out of range of the batch!");
+
+    // the mapping is write-only (and possibly uncached), so each draw is written with a single copy
+    const bEngineDrawIndirectCommand command{
+        mesh.m_indexCount,
+        instanceCount,
+        mesh.m_firstIndex,
+        mesh.m_baseVertex,
+        drawIndex};
+    std::memcpy(static_cast<bEngineDrawIndirectCommand *>(m_commands.m_data) + drawIndex, &command, sizeof(command));
+
+    if (drawData && m_drawDataSize > 0)
+        std::memcpy(static_cast<std::byte *>(m_drawData.m_data) + drawIndex * m_drawDataSize, drawData, m_drawDataSize);
+}
+
+void bEngine::bEngineGLDrawBatch::record(
+    bEngineCommandBuffer  &commands,
+    const std::uint64_t    sortKey,
+    const bEngineDrawItem &item) const
+{
+    if (m_drawCount == 0)
+        return;
+
+    auto batchItem{item};
+    batchItem.m_indexType     = GL_UNSIGNED_INT;
+    batchItem.m_storageBuffer = m_drawDataSize > 0 ? &m_streamBuffer->get_buffer() : nullptr;
+    batchItem.m_storageOffset = m_drawData.m_offset;
+    batchItem.m_storageSize   = m_drawData.m_size;
+    commands.multi_draw_indirect(
+        sortKey,
+        batchItem,
+        m_streamBuffer->get_buffer(),
+        m_commands.m_offset,
+        static_cast<int>(m_drawCount));
+}
+
+const std::uint32_t bEngine::bEngineGLDrawBatch::get_draw_count() const
+{
+    return m_drawCount;
+}
\ No newline at end of file
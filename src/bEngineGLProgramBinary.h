@@ -0,0 +1,53 @@
+#pragma once
+
+/// @file bEngineGLProgramBinary.h
+/// @brief the (private) program binary functions behind the program cache (see bEngineGLProgramCache.h)
+
+#include "bEngineGL.h" // for the sources of a program
+
+#include <glad\gl.h> // for the (multi-context) glad function table
+
+#include <cstdint>     // for the 64 bit cache keys
+#include <filesystem>  // for the cache directory
+#include <span>        // for the stages of a program
+#include <string_view> // for the defines of a program
+
+namespace bEngine
+{
+    namespace GL
+    {
+        /// @brief gets the directory program binaries are cached in
+        /// @return the cache directory, or an empty path if the cache is disabled
+        const std::filesystem::path get_program_cache_directory();
+
+        /// @brief computes the cache key of a program: a (stable) FNV-1a hash of the driver's vendor/renderer/version
+        /// strings, the defines and every stage's type and source
+        /// @param gl the function table of the context the program is built on
+        /// @param stages the sources of each stage of the program
+        /// @param defines the defines injected into every stage
+        /// @return the cache key of the program
+        const std::uint64_t get_program_key(
+            const GladGLContext                         &gl,
+            const std::span<const bEngineGLShaderSource> stages,
+            const std::string_view                       defines);
+
+        /// @brief tries to load a program from its cached binary
+        /// @param gl the function table of the context the program is built on
+        /// @param program the GL name of the (empty) program
+        /// @param key the cache key of the program
+        /// @return true if the program was loaded and linked, false if it has to be compiled
+        const bool load_program_binary(const GladGLContext &gl, const unsigned int program, const std::uint64_t key);
+
+        /// @brief saves a (successfully linked) program's binary to the cache
+        /// @param gl the function table of the context the program was built on
+        /// @param program the GL name of the program, which should have been linked with
+        /// GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+        /// @param key the cache key of the program
+        /// @param buildSeconds the time it took to compile and link the program, in seconds
+        void save_program_binary(
+            const GladGLContext &gl,
+            const unsigned int   program,
+            const std::uint64_t  key,
+            const double         buildSeconds);
+    } // namespace GL
+} // namespace bEngine
\ No newline at end of file
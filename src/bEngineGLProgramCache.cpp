@@ -0,0 +1,296 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLProgramCache.h"
+
+/// @file bEngineGLProgramCache.cpp
+/// @brief implementations for the bEngineGLProgramCache.h and bEngineGLProgramBinary.h files
+
+#include "bEngineGLProgramBinary.h" // for the private half of the cache
+#include "bEngineUtilities.h"       // for access to info/warning messages
+
+#include <chrono>       // for timing binary loads
+#include <format>       // for formatting info/warning messages and file names
+#include <fstream>      // for reading/writing cached binaries
+#include <mutex>        // for guarding the cache directory and statistics
+#include <system_error> // for non-throwing filesystem operations
+#include <vector>       // for holding binaries while they're read/written
+
+namespace
+{
+    /// @brief identifies a program cache file ("bEPC")
+    constexpr std::uint32_t s_cacheMagic{0x43504562};
+
+    /// @brief the version of the cache file layout; bumped whenever BinaryHeader changes
+    constexpr std::uint32_t s_cacheVersion{1};
+
+    /// @brief the header written before every cached binary
+    struct BinaryHeader
+    {
+        /// @brief always s_cacheMagic
+        std::uint32_t m_magic{s_cacheMagic};
+
+        /// @brief always s_cacheVersion
+        std::uint32_t m_version{s_cacheVersion};
+
+        /// @brief the cache key of the program, guarding against (unlikely) file name collisions
+        std::uint64_t m_key{0};
+
+        /// @brief the driver-specific format of the binary
+        std::uint32_t m_format{0};
+
+        /// @brief the size of the binary which follows the header, in bytes
+        std::uint32_t m_size{0};
+
+        /// @brief the time it took to compile and link the program, in seconds
+        double m_buildSeconds{0.0};
+    };
+
+    /// @brief guards the cache directory and statistics
+    std::mutex s_cacheMutex;
+
+    /// @brief the cache directory, or an empty path if the cache is disabled
+    std::filesystem::path s_cacheDirectory{};
+
+    /// @brief the cache's statistics
+    bEngine::bEngineGLProgramCacheStats s_cacheStats{};
+
+    /// @brief the FNV-1a offset basis
+    constexpr std::uint64_t s_fnvOffsetBasis{0xcbf29ce484222325ull};
+
+    /// @brief the FNV-1a prime
+    constexpr std::uint64_t s_fnvPrime{0x100000001b3ull};
+
+    /// @brief continues an FNV-1a hash with some bytes
+    /// @param hash the hash so far
+    /// @param bytes the bytes to hash
+    /// @param size the number of bytes to hash
+    /// @return the updated hash
+    const std::uint64_t hash_bytes(std::uint64_t hash, const void *const bytes, const std::size_t size)
+    {
+        const auto *const data{static_cast<const unsigned char *>(bytes)};
+        for (std::size_t i{0}; i < size; ++i)
+            hash = (hash ^ data[i]) * s_fnvPrime;
+        return hash;
+    }
+
+    /// @brief continues an FNV-1a hash with a string, including its length so consecutive strings can't run together
+    /// @param hash the hash so far
+    /// @param string the string to hash
+    /// @return the updated hash
+    const std::uint64_t hash_string(const std::uint64_t hash, const std::string_view string)
+    {
+        const std::uint64_t size{string.size()};
+        return hash_bytes(hash_bytes(hash, &size, sizeof(size)), string.data(), string.size());
+    }
+
+    /// @brief gets the path of a program's cached binary
+    /// @param directory the cache directory
+    /// @param key the cache key of the program
+    /// @return the path of the program's cached binary
+    const std::filesystem::path get_binary_path(const std::filesystem::path &directory, const std::uint64_t key)
+    {
+        return directory / std::format("{:016x}.glbin", key);
+    }
+
+    /// @brief records a cache miss
+    /// @param key the cache key of the program which missed
+    /// @param isRejection true if the binary existed but the driver refused it
+    void record_miss([[maybe_unused]] const std::uint64_t key, const bool isRejection)
+    {
+        {
+            std::scoped_lock lock{s_cacheMutex};
+            ++s_cacheStats.m_misses;
+            if (isRejection)
+                ++s_cacheStats.m_rejections;
+        }
+
+        if (isRejection)
+        {
+            WARNING_MSG(std::format("The driver rejected the cached binary of program {:016x}; recompiling.", key));
+        }
+        else
+        {
+            INFO_MSG(std::format("Program {:016x} isn't cached; compiling.", key));
+        }
+    }
+} // namespace
+
+const bool bEngine::GLProgramCache::set_directory(const std::filesystem::path &directory)
+{
+    std::error_code error{};
+    if (!directory.empty())
+        std::filesystem::create_directories(directory, error);
+
+    std::scoped_lock lock{s_cacheMutex};
+    if (error)
+    {
+        WARNING_MSG(std::format(
+            "Failed to create the program cache directory '{}' ({}); the cache is disabled.",
+            directory.string(),
+            error.message()));
+        s_cacheDirectory.clear();
+        return false;
+    }
+
+    s_cacheDirectory = directory;
+    if (directory.empty())
+    {
+        INFO_MSG("The program cache is disabled.");
+    }
+    else
+    {
+        INFO_MSG(std::format("Caching program binaries in '{}'.", directory.string()));
+    }
+    return !directory.empty();
+}
+
+const std::filesystem::path bEngine::GLProgramCache::get_directory()
+{
+    return GL::get_program_cache_directory();
+}
+
+const bEngine::bEngineGLProgramCacheStats bEngine::GLProgramCache::get_stats()
+{
+    std::scoped_lock lock{s_cacheMutex};
+    return s_cacheStats;
+}
+
+const std::filesystem::path bEngine::GL::get_program_cache_directory()
+{
+    std::scoped_lock lock{s_cacheMutex};
+    return s_cacheDirectory;
+}
+
+const std::uint64_t bEngine::GL::get_program_key(
+    const GladGLContext                         &gl,
+    const std::span<const bEngineGLShaderSource> stages,
+    const std::string_view                       defines)
+{
+    // a binary is only valid for the driver which produced it, so the driver is part of the key
+    auto hash{s_fnvOffsetBasis};
+    for (const auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        const auto *const string{reinterpret_cast<const char *>(gl.GetString(name))};
+        hash = hash_string(hash, string ? string : "");
+    }
+
+    hash = hash_string(hash, defines);
+    for (const auto &stage : stages)
+    {
+        hash = hash_bytes(hash, &stage.m_stage, sizeof(stage.m_stage));
+        hash = hash_string(hash, stage.m_source);
+    }
+    return hash;
+}
+
+const bool bEngine::GL::load_program_binary(
+    const GladGLContext &gl,
+    const unsigned int   program,
+    const std::uint64_t  key)
+{
+    const auto directory{get_program_cache_directory()};
+    if (directory.empty())
+        return false;
+
+    // a missing, truncated or stale file is just a miss
+    std::ifstream file{get_binary_path(directory, key), std::ios::binary};
+    BinaryHeader  header{};
+    if (!file || !file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.m_magic != s_cacheMagic ||
+        header.m_version != s_cacheVersion || header.m_key != key)
+    {
+        record_miss(key, false);
+        return false;
+    }
+
+    std::vector<char> binary(header.m_size);
+    if (!file.read(binary.data(), binary.size()))
+    {
+        record_miss(key, false);
+        return false;
+    }
+
+    const auto loadStart{std::chrono::steady_clock::now()};
+    gl.ProgramBinary(program, header.m_format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    GLint status{GL_FALSE};
+    gl.GetProgramiv(program, GL_LINK_STATUS, &status);
+    const std::chrono::duration<double> loadTime{std::chrono::steady_clock::now() - loadStart};
+    if (status != GL_TRUE)
+    {
+        record_miss(key, true);
+        return false;
+    }
+
+    const auto savedSeconds{header.m_buildSeconds - loadTime.count()};
+    {
+        std::scoped_lock lock{s_cacheMutex};
+        ++s_cacheStats.m_hits;
+        s_cacheStats.m_savedSeconds += savedSeconds;
+    }
+    INFO_MSG(std::format(
+        "Loaded program {:016x} from the cache in {:.3f} ms (saving {:.3f} ms).",
+        key,
+        loadTime.count() * 1000.0,
+        savedSeconds * 1000.0));
+    return true;
+}
+
+void bEngine::GL::save_program_binary(
+    const GladGLContext &gl,
+    const unsigned int   program,
+    const std::uint64_t  key,
+    const double         buildSeconds)
+{
+    const auto directory{get_program_cache_directory()};
+    if (directory.empty())
+        return;
+
+    GLint length{0};
+    gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        WARNING_MSG(std::format("The driver has no binary for program {:016x}; it can't be cached.", key));
+        return;
+    }
+
+    std::vector<char> binary(length);
+    GLsizei           writtenLength{0};
+    GLenum            format{GL_NONE};
+    gl.GetProgramBinary(program, length, &writtenLength, &format, binary.data());
+
+    BinaryHeader header{};
+    header.m_key          = key;
+    header.m_format       = format;
+    header.m_size         = static_cast<std::uint32_t>(writtenLength);
+    header.m_buildSeconds = buildSeconds;
+
+    // write to a temporary file first so another instance of the application never reads a partial binary
+    const auto      path{get_binary_path(directory, key)};
+    auto            temporaryPath{path};
+    std::error_code error{};
+    temporaryPath += ".tmp";
+    {
+        std::ofstream file{temporaryPath, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(binary.data(), writtenLength);
+        if (!file)
+        {
+            WARNING_MSG(std::format("Failed to write the binary of program {:016x} to the cache.", key));
+            return;
+        }
+    }
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error)
+    {
+        WARNING_MSG(
+            std::format("Failed to write the binary of program {:016x} to the cache ({}).", key, error.message()));
+        std::filesystem::remove(temporaryPath, error);
+        return;
+    }
+
+    INFO_MSG(std::format(
+        "Cached the binary of program {:016x} ({} bytes, built in {:.3f} ms).",
+        key,
+        writtenLength,
+        buildSeconds * 1000.0));
+}
\ No newline at end of file
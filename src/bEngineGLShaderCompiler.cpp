@@ -0,0 +1,255 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLShaderCompiler.h"
+
+/// @file bEngineGLShaderCompiler.cpp
+/// @brief implementations for the bEngineGLShaderCompiler.h file
+
+#include "bEngineGLProgramBinary.h" // for loading/saving cached program binaries
+#include "bEngineUtilities.h"       // for access to error messages
+
+#include <algorithm> // for clamping the end of a shader's #version line
+#include <format>    // for formatting error messages
+
+namespace
+{
+    /// @brief gets the info log of a shader
+    /// @param gl the function table of the context the shader was compiled on
+    /// @param shader the GL name of the shader
+    /// @return the shader's info log
+    std::string get_shader_info_log(const GladGLContext &gl, const GLuint shader)
+    {
+        GLint logLength{0};
+        gl.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+
+        std::string infoLog(logLength > 0 ? logLength : 0, '\0');
+        GLsizei     writtenLength{0};
+        gl.GetShaderInfoLog(shader, logLength, &writtenLength, infoLog.data());
+        infoLog.resize(writtenLength);
+        return infoLog;
+    }
+
+    /// @brief gets the info log of a program
+    /// @param gl the function table of the context the program was linked on
+    /// @param program the GL name of the program
+    /// @return the program's info log
+    std::string get_program_info_log(const GladGLContext &gl, const GLuint program)
+    {
+        GLint logLength{0};
+        gl.GetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
+
+        std::string infoLog(logLength > 0 ? logLength : 0, '\0');
+        GLsizei     writtenLength{0};
+        gl.GetProgramInfoLog(program, logLength, &writtenLength, infoLog.data());
+        infoLog.resize(writtenLength);
+        return infoLog;
+    }
+
+    /// @brief publishes the result of a build, waking anyone waiting on it
+    /// @param build the build to publish
+    /// @param state the final state of the build
+    void publish_program_build(bEngine::GL::ProgramBuild &build, const bEngine::GL::BuildState state)
+    {
+        build.m_state.store(state, std::memory_order_release);
+        build.m_state.notify_all();
+    }
+} // namespace
+
+bEngine::GL::ProgramBuild::ProgramBuild(
+    const unsigned int                           program,
+    std::initializer_list<bEngineGLShaderSource> stages,
+    const std::string_view                       defines)
+    : m_program{program},
+      m_defines{defines}
+{
+    // the stages view the owned sources, so every source is copied before any views are taken
+    m_sources.reserve(stages.size());
+    for (const auto &stage : stages)
+        m_sources.emplace_back(stage.m_source);
+
+    m_stages.reserve(stages.size());
+    for (std::size_t stage{0}; stage < stages.size(); ++stage)
+        m_stages.push_back({stages.begin()[stage].m_stage, m_sources[stage]});
+}
+
+void bEngine::GL::issue_program_build(const GladGLContext &gl, ProgramBuild &build)
+{
+    build.m_buildStart = std::chrono::steady_clock::now();
+
+    // load the program's binary if it's cached, otherwise the binary has to be made retrievable before linking
+    build.m_isCached = !get_program_cache_directory().empty();
+    if (build.m_isCached)
+    {
+        build.m_cacheKey = get_program_key(gl, build.m_stages, build.m_defines);
+        if (load_program_binary(gl, build.m_program, build.m_cacheKey))
+        {
+            publish_program_build(build, BuildState::Linked);
+            return;
+        }
+        gl.ProgramParameteri(build.m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    // issue every compile and the link without querying anything in between, since any query would wait for the
+    // driver to finish; a stage which fails to compile just makes the link fail
+    for (const auto &stage : build.m_stages)
+    {
+        // the defines go right after the #version line (which must come first), or first if there isn't one
+        const auto &source{stage.m_source};
+        std::size_t versionEnd{0};
+        if (const auto versionStart{source.find("#version")}; versionStart != std::string_view::npos)
+            versionEnd = std::min(source.find('\n', versionStart), source.size() - 1) + 1;
+
+        const GLchar *sources[3]{source.data(), build.m_defines.c_str(), source.data() + versionEnd};
+        const GLint   lengths[3]{
+            static_cast<GLint>(versionEnd),
+            static_cast<GLint>(build.m_defines.size()),
+            static_cast<GLint>(source.size() - versionEnd)};
+
+        const auto shader{gl.CreateShader(stage.m_stage)};
+        gl.ShaderSource(shader, 3, sources, lengths);
+        gl.CompileShader(shader);
+        gl.AttachShader(build.m_program, shader);
+        build.m_shaders.push_back(shader);
+    }
+
+    gl.LinkProgram(build.m_program);
+}
+
+const bool bEngine::GL::get_is_program_build_complete(const GladGLContext &gl, const ProgramBuild &build)
+{
+    if (build.m_state.load(std::memory_order_acquire) != BuildState::Pending)
+        return true;
+
+    GLint isComplete{GL_FALSE};
+    gl.GetProgramiv(build.m_program, s_completionStatus, &isComplete);
+    return isComplete == GL_TRUE;
+}
+
+void bEngine::GL::finish_program_build(const GladGLContext &gl, ProgramBuild &build, const bool isOnSharedContext)
+{
+    if (build.m_state.load(std::memory_order_acquire) != BuildState::Pending)
+        return;
+
+    GLint status{GL_FALSE};
+    gl.GetProgramiv(build.m_program, GL_LINK_STATUS, &status);
+    const auto isLinked{status == GL_TRUE};
+
+    // report the first stage which failed to compile, or the link log if they all compiled
+    if (!isLinked)
+    {
+        for (const auto shader : build.m_shaders)
+        {
+            gl.GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+            if (status != GL_TRUE)
+            {
+                build.m_infoLog = get_shader_info_log(gl, shader);
+                break;
+            }
+        }
+        if (build.m_infoLog.empty())
+            build.m_infoLog = get_program_info_log(gl, build.m_program);
+    }
+
+    // the shaders aren't needed once the program is linked (or failed to link)
+    for (const auto shader : build.m_shaders)
+    {
+        if (isLinked)
+            gl.DetachShader(build.m_program, shader);
+        gl.DeleteShader(shader);
+    }
+    build.m_shaders.clear();
+
+    if (!isLinked)
+    {
+        ERROR_MSG(std::format("Failed to build program #{}:\n{}", build.m_program, build.m_infoLog));
+    }
+    else if (build.m_isCached)
+    {
+        save_program_binary(
+            gl,
+            build.m_program,
+            build.m_cacheKey,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - build.m_buildStart).count());
+    }
+
+    // another context is only guaranteed to see the linked program once this context's commands have completed
+    if (isOnSharedContext)
+        gl.Finish();
+
+    publish_program_build(build, isLinked ? BuildState::Linked : BuildState::Failed);
+}
+
+bEngine::GL::ShaderCompiler::ShaderCompiler(std::function<void(const bool)> &&setCurrent, const GLADloadfunc loader)
+    : m_setCurrent{std::move(setCurrent)},
+      m_loader{loader},
+      m_thread{&ShaderCompiler::run, this}
+{
+}
+
+bEngine::GL::ShaderCompiler::~ShaderCompiler()
+{
+    {
+        std::scoped_lock lock{m_queueMutex};
+        m_isStopping = true;
+    }
+    m_queueCondition.notify_one();
+    m_thread.join();
+}
+
+void bEngine::GL::ShaderCompiler::submit(std::shared_ptr<ProgramBuild> &&build)
+{
+    {
+        std::scoped_lock lock{m_queueMutex};
+        m_queue.push_back(std::move(build));
+    }
+    m_queueCondition.notify_one();
+}
+
+void bEngine::GL::ShaderCompiler::run()
+{
+    m_setCurrent(true);
+    const auto isLoaded{gladLoadGLContext(&m_gl, m_loader) != 0};
+    if (!isLoaded)
+    {
+        ERROR_MSG("Failed to load the GL functions for the compile thread's context!");
+    }
+
+    while (true)
+    {
+        std::shared_ptr<ProgramBuild> build{nullptr};
+        {
+            std::unique_lock lock{m_queueMutex};
+            m_queueCondition.wait(lock, [this]() { return m_isStopping || !m_queue.empty(); });
+            if (m_isStopping)
+                break;
+
+            build = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        // nobody is waiting for a build whose program was destroyed before it started
+        if (build.use_count() == 1)
+            continue;
+
+        if (!isLoaded)
+        {
+            build->m_infoLog = "The compile thread has no GL functions.";
+            publish_program_build(*build, BuildState::Failed);
+            continue;
+        }
+
+        issue_program_build(m_gl, *build);
+        finish_program_build(m_gl, *build, true);
+    }
+
+    // anything still queued will never be built
+    std::scoped_lock lock{m_queueMutex};
+    for (const auto &build : m_queue)
+    {
+        build->m_infoLog = "The compile thread stopped before the program was built.";
+        publish_program_build(*build, BuildState::Failed);
+    }
+    m_queue.clear();
+
+    m_setCurrent(false);
+}
\ No newline at end of file
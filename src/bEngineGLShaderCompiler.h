@@ -0,0 +1,167 @@
+#pragma once
+
+/// @file bEngineGLShaderCompiler.h
+/// @brief the (private) program building of the bEngine library; programs are compiled and linked either on the
+/// context which owns them (in parallel by the driver when KHR_parallel_shader_compile is supported) or on a compile
+/// thread with its own context sharing objects with the owning context
+
+#include "bEngineGL.h" // for the sources of a program
+
+#include <glad\gl.h> // for the (multi-context) glad function table
+
+#include <atomic>             // for publishing the state of a build across threads
+#include <chrono>             // for timing builds, which the program cache reports
+#include <condition_variable> // for waking the compile thread
+#include <cstdint>            // for the program cache key of a build
+#include <deque>              // for the compile thread's queue of builds
+#include <functional>         // for making the compile thread's context current
+#include <memory>             // for sharing builds between programs, contexts and the compile thread
+#include <mutex>              // for guarding the compile thread's queue
+#include <string>             // for the sources and info log of a build
+#include <thread>             // for the compile thread
+#include <vector>             // for the stages/shaders of a build
+
+namespace bEngine
+{
+    namespace GL
+    {
+        /// @brief GL_COMPLETION_STATUS_KHR, which glad's (core only) header doesn't define
+        constexpr GLenum s_completionStatus{0x91B1};
+
+        /// @brief the state of a program build
+        enum class BuildState : unsigned char
+        {
+            Pending,
+            Linked,
+            Failed
+        };
+
+        /// @brief everything needed to build a program, shared by the program and whoever is building it
+        struct ProgramBuild
+        {
+            /// @brief the GL name of the program being built
+            const unsigned int m_program{0};
+
+            /// @brief the (owned) source of each stage; builds may outlive the sources they were created from
+            std::vector<std::string> m_sources;
+
+            /// @brief each stage of the program, whose sources view m_sources
+            std::vector<bEngineGLShaderSource> m_stages;
+
+            /// @brief the defines injected into every stage
+            const std::string m_defines{""};
+
+            /// @brief true if the program's binary is cached (i.e. the program cache was enabled when it was issued)
+            bool m_isCached{false};
+
+            /// @brief the program cache key of the program
+            std::uint64_t m_cacheKey{0};
+
+            /// @brief the shaders being compiled for the program
+            std::vector<unsigned int> m_shaders;
+
+            /// @brief when the build was issued
+            std::chrono::steady_clock::time_point m_buildStart{};
+
+            /// @brief the compile/link log, if compiling or linking failed; only valid once the build isn't pending
+            std::string m_infoLog{""};
+
+            /// @brief the state of the build; set last (with release semantics) once everything else is written
+            std::atomic<BuildState> m_state{BuildState::Pending};
+
+            /// @brief default ctor is insufficient
+            ProgramBuild() = delete;
+
+            /// @brief ctor which copies the sources of a program
+            /// @param program the GL name of the program to build
+            /// @param stages the sources of each stage of the program
+            /// @param defines the defines injected into every stage
+            ProgramBuild(
+                const unsigned int                           program,
+                std::initializer_list<bEngineGLShaderSource> stages,
+                const std::string_view                       defines);
+        };
+
+        /// @brief issues a build: loads the program from its cached binary if possible, otherwise compiles every stage
+        /// and links them without waiting for any of it (so the driver may do it in parallel)
+        /// @param gl the function table of the context to build on
+        /// @param build the build to issue
+        void issue_program_build(const GladGLContext &gl, ProgramBuild &build);
+
+        /// @brief checks whether an issued build has finished without blocking; requires KHR_parallel_shader_compile
+        /// @param gl the function table of the context the build was issued on
+        /// @param build the issued build
+        /// @return true if the driver has finished the build, false if it's still compiling/linking
+        const bool get_is_program_build_complete(const GladGLContext &gl, const ProgramBuild &build);
+
+        /// @brief finishes an issued build (blocking until the driver is done with it): gathers the link status and
+        /// info log, deletes the shaders, caches the binary and publishes the state of the build
+        /// @param gl the function table of the context the build was issued on
+        /// @param build the issued build
+        /// @param isOnSharedContext true if the build was issued on a context other than the one which will use the
+        /// program, in which case the result is only published once that context's commands have completed
+        void finish_program_build(const GladGLContext &gl, ProgramBuild &build, const bool isOnSharedContext = false);
+
+        /// @brief a thread with its own GL context (sharing objects with a window's context) which builds programs,
+        /// for drivers without KHR_parallel_shader_compile
+        class ShaderCompiler
+        {
+            // private data
+          private:
+            /// @brief makes the compile thread's context current (true) or not current (false) on the calling thread
+            const std::function<void(const bool)> m_setCurrent;
+
+            /// @brief the loader of the compile thread's function table
+            const GLADloadfunc m_loader{nullptr};
+
+            /// @brief glad's function table for the compile thread's context
+            GladGLContext m_gl{};
+
+            /// @brief guards the queue of builds
+            std::mutex m_queueMutex;
+
+            /// @brief signalled when a build is queued or the thread should stop
+            std::condition_variable m_queueCondition;
+
+            /// @brief the builds waiting for the compile thread
+            std::deque<std::shared_ptr<ProgramBuild>> m_queue;
+
+            /// @brief true once the compile thread should stop
+            bool m_isStopping{false};
+
+            /// @brief the compile thread; declared last so it starts after everything it uses is constructed
+            std::thread m_thread;
+
+            // public ctors/dtor
+          public:
+            /// @brief default ctor is insufficient
+            ShaderCompiler() = delete;
+
+            /// @brief ctor which starts the compile thread
+            /// @param setCurrent makes the compile thread's context current (true) or not current (false) on the
+            /// calling thread
+            /// @param loader the loader of the compile thread's function table
+            ShaderCompiler(std::function<void(const bool)> &&setCurrent, const GLADloadfunc loader);
+
+            /// @brief the compile thread can't be copied
+            ShaderCompiler(const ShaderCompiler &) = delete;
+
+            /// @brief the compile thread can't be copied
+            ShaderCompiler &operator=(const ShaderCompiler &) = delete;
+
+            /// @brief dtor stops the compile thread; builds which haven't started fail
+            ~ShaderCompiler();
+
+            // public methods/functions
+          public:
+            /// @brief queues a build for the compile thread; the build's program must already exist (and be flushed)
+            /// @param build the build to queue
+            void submit(std::shared_ptr<ProgramBuild> &&build);
+
+            // private methods/functions
+          private:
+            /// @brief the compile thread's loop
+            void run();
+        };
+    } // namespace GL
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLState.h"
+
+/// @file bEngineGLState.cpp
+/// @brief implementations for the bEngineGLState.h file
+
+#include "bEngineGLContext.h" // for the current context's state cache
+
+#include <cstdint> // for uintptr_t, to pass element buffer offsets as pointers
+
+void bEngine::GLState::set_blend(
+    const bool         isEnabled,
+    const unsigned int sourceFactor,
+    const unsigned int destinationFactor)
+{
+    GL::require_current_context().m_stateCache.set_blend(isEnabled, sourceFactor, destinationFactor);
+}
+
+void bEngine::GLState::set_depth(const bool isTestEnabled, const bool isWriteEnabled, const unsigned int function)
+{
+    GL::require_current_context().m_stateCache.set_depth(isTestEnabled, isWriteEnabled, function);
+}
+
+void bEngine::GLState::set_cull_face(const bool isEnabled, const unsigned int face)
+{
+    GL::require_current_context().m_stateCache.set_cull_face(isEnabled, face);
+}
+
+void bEngine::GLState::set_viewport(const int x, const int y, const int width, const int height)
+{
+    GL::require_current_context().m_stateCache.set_viewport(x, y, width, height);
+}
+
+void bEngine::GLState::draw_arrays(
+    const unsigned int mode,
+    const int          first,
+    const int          count,
+    const int          instanceCount)
+{
+    auto &context{GL::require_current_context()};
+    context.m_stateCache.flush(context.m_gl);
+    context.m_gl.DrawArraysInstanced(mode, first, count, instanceCount);
+}
+
+void bEngine::GLState::draw_elements(
+    const unsigned int mode,
+    const int          count,
+    const unsigned int indexType,
+    const unsigned int offset,
+    const int          instanceCount)
+{
+    auto &context{GL::require_current_context()};
+    context.m_stateCache.flush(context.m_gl);
+    context.m_gl.DrawElementsInstanced(
+        mode,
+        count,
+        indexType,
+        reinterpret_cast<const void *>(static_cast<std::uintptr_t>(offset)),
+        instanceCount);
+}
+
+void bEngine::GLState::flush()
+{
+    auto &context{GL::require_current_context()};
+    context.m_stateCache.flush(context.m_gl);
+}
+
+void bEngine::GLState::invalidate()
+{
+    GL::require_current_context().m_stateCache.invalidate();
+}
+
+const bEngine::bEngineGLStateStats bEngine::GLState::get_frame_stats()
+{
+    return GL::require_current_context().m_stateCache.get_frame_stats();
+}
+
+void bEngine::GLState::set_validation_interval(const unsigned int frameInterval)
+{
+    GL::require_current_context().m_stateCache.set_validation_interval(frameInterval);
+}
\ No newline at end of file
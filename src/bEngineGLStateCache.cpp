@@ -0,0 +1,374 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLStateCache.h"
+
+/// @file bEngineGLStateCache.cpp
+/// @brief implementations for the bEngineGLStateCache.h file
+
+#include "bEngineGLContext.h" // for the kinds of GL objects
+#include "bEngineUtilities.h" // for access to assertions and warning messages
+
+#include <algorithm> // for copying/comparing ranges of state
+#include <format>    // for formatting validation warnings
+
+namespace
+{
+    /// @brief enables or disables a capability
+    /// @param gl the context's function table
+    /// @param capability the capability (e.g. GL_BLEND)
+    /// @param isEnabled 1 to enable the capability, 0 to disable it
+    void set_capability(const GladGLContext &gl, const GLenum capability, const unsigned int isEnabled)
+    {
+        if (isEnabled)
+            gl.Enable(capability);
+        else
+            gl.Disable(capability);
+    }
+
+    /// @brief finds the range of texture units whose pending binding differs from their current binding
+    /// @param current the current bindings
+    /// @param pending the pending bindings
+    /// @param first set to the first unit which differs
+    /// @param count set to the number of units from the first to the last unit which differs, or 0 if none do
+    void find_changed_units(
+        const unsigned int *const current,
+        const unsigned int *const pending,
+        GLuint                   &first,
+        GLsizei                  &count)
+    {
+        first = 0;
+        count = 0;
+        for (GLuint unit{0}; unit < bEngine::GL::StateCache::s_textureUnitCount; ++unit)
+        {
+            if (current[unit] == pending[unit])
+                continue;
+            if (count == 0)
+                first = unit;
+            count = static_cast<GLsizei>(unit - first + 1);
+        }
+    }
+} // namespace
+
+bEngine::GL::StateCache::StateCache()
+{
+    invalidate();
+
+#ifdef DEBUG
+    // desyncs are bugs, so they're looked for by default in debug mode
+    m_validationInterval = 120;
+#endif // DEBUG
+}
+
+void bEngine::GL::StateCache::request(unsigned int &pendingValue, const unsigned int value)
+{
+    ++m_frameStats.m_requestedChanges;
+    pendingValue = value;
+}
+
+void bEngine::GL::StateCache::set_program(const unsigned int program)
+{
+    request(m_pending.m_program, program);
+}
+
+void bEngine::GL::StateCache::set_vertex_array(const unsigned int vertexArray)
+{
+    request(m_pending.m_vertexArray, vertexArray);
+}
+
+void bEngine::GL::StateCache::set_framebuffer(const unsigned int target, const unsigned int framebuffer)
+{
+    if (target != GL_READ_FRAMEBUFFER)
+        request(m_pending.m_drawFramebuffer, framebuffer);
+    if (target != GL_DRAW_FRAMEBUFFER)
+        request(m_pending.m_readFramebuffer, framebuffer);
+}
+
+void bEngine::GL::StateCache::set_texture(const unsigned int unit, const unsigned int texture)
+{
+    bENGINE_ASSERT(unit < s_textureUnitCount, "Texture unit is out of range of the state cache!");
+    request(m_pending.m_textures[unit], texture);
+}
+
+void bEngine::GL::StateCache::set_sampler(const unsigned int unit, const unsigned int sampler)
+{
+    bENGINE_ASSERT(unit < s_textureUnitCount, "Texture unit is out of range of the state cache!");
+    request(m_pending.m_samplers[unit], sampler);
+}
+
+void bEngine::GL::StateCache::set_blend(
+    const bool         isEnabled,
+    const unsigned int sourceFactor,
+    const unsigned int destinationFactor)
+{
+    request(m_pending.m_isBlendEnabled, isEnabled);
+
+    // the factors don't matter while blending is disabled, so leave them be
+    if (isEnabled)
+    {
+        request(m_pending.m_blendSourceFactor, sourceFactor);
+        request(m_pending.m_blendDestinationFactor, destinationFactor);
+    }
+}
+
+void bEngine::GL::StateCache::set_depth(
+    const bool         isTestEnabled,
+    const bool         isWriteEnabled,
+    const unsigned int function)
+{
+    request(m_pending.m_isDepthTestEnabled, isTestEnabled);
+    request(m_pending.m_isDepthWriteEnabled, isWriteEnabled);
+    if (isTestEnabled)
+        request(m_pending.m_depthFunction, function);
+}
+
+void bEngine::GL::StateCache::set_cull_face(const bool isEnabled, const unsigned int face)
+{
+    request(m_pending.m_isCullingEnabled, isEnabled);
+    if (isEnabled)
+        request(m_pending.m_cullFace, face);
+}
+
+void bEngine::GL::StateCache::set_viewport(const int x, const int y, const int width, const int height)
+{
+    request(m_pending.m_viewport[0], static_cast<unsigned int>(x));
+    request(m_pending.m_viewport[1], static_cast<unsigned int>(y));
+    request(m_pending.m_viewport[2], static_cast<unsigned int>(width));
+    request(m_pending.m_viewport[3], static_cast<unsigned int>(height));
+}
+
+const bool bEngine::GL::StateCache::get_viewport(int (&viewport)[4]) const
+{
+    if (m_pending.m_viewport[2] == s_unknown)
+        return false;
+
+    for (int i{0}; i < 4; ++i)
+        viewport[i] = static_cast<int>(m_pending.m_viewport[i]);
+    return true;
+}
+
+void bEngine::GL::StateCache::flush(const GladGLContext &gl)
+{
+    auto &issued{m_frameStats.m_issuedCalls};
+
+    if (m_current.m_program != m_pending.m_program)
+    {
+        gl.UseProgram(m_pending.m_program);
+        m_current.m_program = m_pending.m_program;
+        ++issued;
+    }
+
+    if (m_current.m_vertexArray != m_pending.m_vertexArray)
+    {
+        gl.BindVertexArray(m_pending.m_vertexArray);
+        m_current.m_vertexArray = m_pending.m_vertexArray;
+        ++issued;
+    }
+
+    if (m_current.m_drawFramebuffer != m_pending.m_drawFramebuffer)
+    {
+        gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, m_pending.m_drawFramebuffer);
+        m_current.m_drawFramebuffer = m_pending.m_drawFramebuffer;
+        ++issued;
+    }
+
+    if (m_current.m_readFramebuffer != m_pending.m_readFramebuffer)
+    {
+        gl.BindFramebuffer(GL_READ_FRAMEBUFFER, m_pending.m_readFramebuffer);
+        m_current.m_readFramebuffer = m_pending.m_readFramebuffer;
+        ++issued;
+    }
+
+    // texture/sampler units are bound in one call covering every unit which changed
+    GLuint  firstUnit{0};
+    GLsizei unitCount{0};
+    find_changed_units(m_current.m_textures, m_pending.m_textures, firstUnit, unitCount);
+    if (unitCount)
+    {
+        gl.BindTextures(firstUnit, unitCount, m_pending.m_textures + firstUnit);
+        std::copy_n(m_pending.m_textures + firstUnit, unitCount, m_current.m_textures + firstUnit);
+        ++issued;
+    }
+
+    find_changed_units(m_current.m_samplers, m_pending.m_samplers, firstUnit, unitCount);
+    if (unitCount)
+    {
+        gl.BindSamplers(firstUnit, unitCount, m_pending.m_samplers + firstUnit);
+        std::copy_n(m_pending.m_samplers + firstUnit, unitCount, m_current.m_samplers + firstUnit);
+        ++issued;
+    }
+
+    if (m_current.m_isBlendEnabled != m_pending.m_isBlendEnabled)
+    {
+        set_capability(gl, GL_BLEND, m_pending.m_isBlendEnabled);
+        m_current.m_isBlendEnabled = m_pending.m_isBlendEnabled;
+        ++issued;
+    }
+
+    if (m_current.m_blendSourceFactor != m_pending.m_blendSourceFactor ||
+        m_current.m_blendDestinationFactor != m_pending.m_blendDestinationFactor)
+    {
+        gl.BlendFunc(m_pending.m_blendSourceFactor, m_pending.m_blendDestinationFactor);
+        m_current.m_blendSourceFactor      = m_pending.m_blendSourceFactor;
+        m_current.m_blendDestinationFactor = m_pending.m_blendDestinationFactor;
+        ++issued;
+    }
+
+    if (m_current.m_isDepthTestEnabled != m_pending.m_isDepthTestEnabled)
+    {
+        set_capability(gl, GL_DEPTH_TEST, m_pending.m_isDepthTestEnabled);
+        m_current.m_isDepthTestEnabled = m_pending.m_isDepthTestEnabled;
+        ++issued;
+    }
+
+    if (m_current.m_isDepthWriteEnabled != m_pending.m_isDepthWriteEnabled)
+    {
+        gl.DepthMask(m_pending.m_isDepthWriteEnabled ? GL_TRUE : GL_FALSE);
+        m_current.m_isDepthWriteEnabled = m_pending.m_isDepthWriteEnabled;
+        ++issued;
+    }
+
+    if (m_current.m_depthFunction != m_pending.m_depthFunction)
+    {
+        gl.DepthFunc(m_pending.m_depthFunction);
+        m_current.m_depthFunction = m_pending.m_depthFunction;
+        ++issued;
+    }
+
+    if (m_current.m_isCullingEnabled != m_pending.m_isCullingEnabled)
+    {
+        set_capability(gl, GL_CULL_FACE, m_pending.m_isCullingEnabled);
+        m_current.m_isCullingEnabled = m_pending.m_isCullingEnabled;
+        ++issued;
+    }
+
+    if (m_current.m_cullFace != m_pending.m_cullFace)
+    {
+        gl.CullFace(m_pending.m_cullFace);
+        m_current.m_cullFace = m_pending.m_cullFace;
+        ++issued;
+    }
+
+    // the viewport is only applied once it has actually been requested
+    if (m_pending.m_viewport[2] != s_unknown &&
+        !std::equal(m_pending.m_viewport, m_pending.m_viewport + 4, m_current.m_viewport))
+    {
+        gl.Viewport(
+            static_cast<GLint>(m_pending.m_viewport[0]),
+            static_cast<GLint>(m_pending.m_viewport[1]),
+            static_cast<GLsizei>(m_pending.m_viewport[2]),
+            static_cast<GLsizei>(m_pending.m_viewport[3]));
+        std::copy_n(m_pending.m_viewport, 4, m_current.m_viewport);
+        ++issued;
+    }
+}
+
+void bEngine::GL::StateCache::invalidate()
+{
+    std::fill_n(reinterpret_cast<unsigned int *>(&m_current), sizeof(State) / sizeof(unsigned int), s_unknown);
+}
+
+void bEngine::GL::StateCache::forget(const ObjectType type, const unsigned int name)
+{
+    // deleting a bound object reverts the binding to 0 (on this context), which is exactly what the pending state
+    // should become too; otherwise a new object reusing the name could be wrongly treated as already bound
+    const auto forget_binding{[name](unsigned int &current, unsigned int &pending) {
+        if (current == name)
+            current = 0;
+        if (pending == name)
+            pending = 0;
+    }};
+
+    switch (type)
+    {
+    case ObjectType::Texture:
+        for (unsigned int unit{0}; unit < s_textureUnitCount; ++unit)
+            forget_binding(m_current.m_textures[unit], m_pending.m_textures[unit]);
+        break;
+    case ObjectType::Sampler:
+        for (unsigned int unit{0}; unit < s_textureUnitCount; ++unit)
+            forget_binding(m_current.m_samplers[unit], m_pending.m_samplers[unit]);
+        break;
+    case ObjectType::Framebuffer:
+        forget_binding(m_current.m_drawFramebuffer, m_pending.m_drawFramebuffer);
+        forget_binding(m_current.m_readFramebuffer, m_pending.m_readFramebuffer);
+        break;
+    case ObjectType::VertexArray:
+        forget_binding(m_current.m_vertexArray, m_pending.m_vertexArray);
+        break;
+    case ObjectType::Program:
+        // a program in use is only flagged for deletion (it stays bound), so its name can't be reused while bound;
+        // still, it shouldn't be requested again
+        if (m_pending.m_program == name)
+            m_pending.m_program = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+void bEngine::GL::StateCache::end_frame(const GladGLContext &gl)
+{
+    m_frameStats.m_elidedChanges = (m_frameStats.m_requestedChanges > m_frameStats.m_issuedCalls)
+                                     ? m_frameStats.m_requestedChanges - m_frameStats.m_issuedCalls
+                                     : 0;
+    m_previousFrameStats = m_frameStats;
+    m_frameStats         = {};
+
+    if (m_validationInterval && ++m_framesSinceValidation >= m_validationInterval)
+    {
+        validate(gl);
+        m_framesSinceValidation = 0;
+    }
+}
+
+const bEngine::bEngineGLStateStats bEngine::GL::StateCache::get_frame_stats() const
+{
+    return m_previousFrameStats;
+}
+
+void bEngine::GL::StateCache::set_validation_interval(const unsigned int frameInterval)
+{
+    m_validationInterval    = frameInterval;
+    m_framesSinceValidation = 0;
+}
+
+const bool bEngine::GL::StateCache::validate(const GladGLContext &gl)
+{
+    bool isValid{true};
+
+    // compares a single piece of shadowed state to the real state, correcting the shadow if they differ
+    const auto check{
+        [&isValid]([[maybe_unused]] const char *const name, unsigned int &shadowed, const unsigned int actual) {
+            if (shadowed == s_unknown || shadowed == actual)
+                return;
+
+            WARNING_MSG(std::format("GL state desync: {} is {} but the state cache has {}.", name, actual, shadowed));
+            shadowed = actual;
+            isValid  = false;
+        }};
+    const auto get_integer{[&gl](const GLenum parameter) {
+        GLint value{0};
+        gl.GetIntegerv(parameter, &value);
+        return static_cast<unsigned int>(value);
+    }};
+
+    check("GL_CURRENT_PROGRAM", m_current.m_program, get_integer(GL_CURRENT_PROGRAM));
+    check("GL_VERTEX_ARRAY_BINDING", m_current.m_vertexArray, get_integer(GL_VERTEX_ARRAY_BINDING));
+    check("GL_DRAW_FRAMEBUFFER_BINDING", m_current.m_drawFramebuffer, get_integer(GL_DRAW_FRAMEBUFFER_BINDING));
+    check("GL_READ_FRAMEBUFFER_BINDING", m_current.m_readFramebuffer, get_integer(GL_READ_FRAMEBUFFER_BINDING));
+    check("GL_BLEND", m_current.m_isBlendEnabled, gl.IsEnabled(GL_BLEND));
+    check("GL_BLEND_SRC_RGB", m_current.m_blendSourceFactor, get_integer(GL_BLEND_SRC_RGB));
+    check("GL_BLEND_DST_RGB", m_current.m_blendDestinationFactor, get_integer(GL_BLEND_DST_RGB));
+    check("GL_DEPTH_TEST", m_current.m_isDepthTestEnabled, gl.IsEnabled(GL_DEPTH_TEST));
+    check("GL_DEPTH_WRITEMASK", m_current.m_isDepthWriteEnabled, get_integer(GL_DEPTH_WRITEMASK));
+    check("GL_DEPTH_FUNC", m_current.m_depthFunction, get_integer(GL_DEPTH_FUNC));
+    check("GL_CULL_FACE", m_current.m_isCullingEnabled, gl.IsEnabled(GL_CULL_FACE));
+    check("GL_CULL_FACE_MODE", m_current.m_cullFace, get_integer(GL_CULL_FACE_MODE));
+
+    GLint viewport[4]{0, 0, 0, 0};
+    gl.GetIntegerv(GL_VIEWPORT, viewport);
+    for (int i{0}; i < 4; ++i)
+        check("GL_VIEWPORT", m_current.m_viewport[i], static_cast<unsigned int>(viewport[i]));
+
+    return isValid;
+}
\ No newline at end of file
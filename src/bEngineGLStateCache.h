@@ -0,0 +1,206 @@
+#pragma once
+
+/// @file bEngineGLStateCache.h
+/// @brief the (private) shadow of a GL context's bindings and fixed-function state, which filters out redundant state
+/// changes and applies the rest lazily at draw time
+
+#include "bEngineGLState.h" // for the state change statistics
+
+#include <glad\gl.h> // for the (multi-context) glad function table
+
+namespace bEngine
+{
+    namespace GL
+    {
+        // fwd declaration of the kinds of GL objects the library manages
+        enum class ObjectType : unsigned char;
+
+        /// @brief shadows the state of a single GL context
+        ///
+        /// setters only record the requested ("pending") state; flush() compares the pending state to the state GL is
+        /// known to have ("current") and only issues calls for what differs. Texture/sampler units are applied with a
+        /// single glBindTextures/glBindSamplers call covering the range of units which changed.
+        class StateCache
+        {
+            // public static data
+          public:
+            /// @brief the number of texture units which are shadowed (the minimum GL 4.6 guarantees is 80, but no
+            /// renderer in the library uses more than this)
+            static constexpr unsigned int s_textureUnitCount{32};
+
+            /// @brief the value of a piece of state which isn't known (current) or hasn't been requested (pending)
+            static constexpr unsigned int s_unknown{~0u};
+
+            // private types
+          private:
+            /// @brief every piece of state which is shadowed; bools are stored as 0/1 so they can also be unknown
+            struct State
+            {
+                /// @brief the program in use
+                unsigned int m_program{0};
+
+                /// @brief the bound vertex array
+                unsigned int m_vertexArray{0};
+
+                /// @brief the framebuffer bound for drawing
+                unsigned int m_drawFramebuffer{0};
+
+                /// @brief the framebuffer bound for reading
+                unsigned int m_readFramebuffer{0};
+
+                /// @brief the texture bound to each texture unit
+                unsigned int m_textures[s_textureUnitCount]{};
+
+                /// @brief the sampler bound to each texture unit
+                unsigned int m_samplers[s_textureUnitCount]{};
+
+                /// @brief whether blending is enabled
+                unsigned int m_isBlendEnabled{0};
+
+                /// @brief the source blend factor
+                unsigned int m_blendSourceFactor{GL_ONE};
+
+                /// @brief the destination blend factor
+                unsigned int m_blendDestinationFactor{GL_ZERO};
+
+                /// @brief whether depth testing is enabled
+                unsigned int m_isDepthTestEnabled{0};
+
+                /// @brief whether depth writes are enabled
+                unsigned int m_isDepthWriteEnabled{1};
+
+                /// @brief the depth comparison function
+                unsigned int m_depthFunction{GL_LESS};
+
+                /// @brief whether face culling is enabled
+                unsigned int m_isCullingEnabled{0};
+
+                /// @brief the face which is culled
+                unsigned int m_cullFace{GL_BACK};
+
+                /// @brief the viewport (x, y, width, height); unknown until it is first set
+                unsigned int m_viewport[4]{s_unknown, s_unknown, s_unknown, s_unknown};
+            };
+
+            // private data
+          private:
+            /// @brief the state GL is known to have
+            State m_current{};
+
+            /// @brief the state which has been requested, and will be applied on the next flush
+            State m_pending{};
+
+            /// @brief the statistics of the frame in progress
+            bEngineGLStateStats m_frameStats{};
+
+            /// @brief the statistics of the previous (complete) frame
+            bEngineGLStateStats m_previousFrameStats{};
+
+            /// @brief the number of frames between validations, or 0 to never validate
+            unsigned int m_validationInterval{0};
+
+            /// @brief the number of frames since the last validation
+            unsigned int m_framesSinceValidation{0};
+
+            // private methods/functions
+          private:
+            /// @brief records a request to change a piece of state
+            /// @param pendingValue the pending value of the state
+            /// @param value the requested value of the state
+            void request(unsigned int &pendingValue, const unsigned int value);
+
+            // public ctors
+          public:
+            /// @brief default ctor; the real state of the context is treated as unknown, since the context may have
+            /// been used before the cache was created
+            StateCache();
+
+            // public methods/functions
+          public:
+            /// @brief requests a program be used
+            /// @param program the GL name of the program
+            void set_program(const unsigned int program);
+
+            /// @brief requests a vertex array be bound
+            /// @param vertexArray the GL name of the vertex array
+            void set_vertex_array(const unsigned int vertexArray);
+
+            /// @brief requests a framebuffer be bound
+            /// @param target GL_FRAMEBUFFER (both), GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER
+            /// @param framebuffer the GL name of the framebuffer, or 0 for the window's framebuffer
+            void set_framebuffer(const unsigned int target, const unsigned int framebuffer);
+
+            /// @brief requests a texture be bound to a texture unit
+            /// @param unit the texture unit
+            /// @param texture the GL name of the texture
+            void set_texture(const unsigned int unit, const unsigned int texture);
+
+            /// @brief requests a sampler be bound to a texture unit
+            /// @param unit the texture unit
+            /// @param sampler the GL name of the sampler
+            void set_sampler(const unsigned int unit, const unsigned int sampler);
+
+            /// @brief requests a blend state
+            /// @param isEnabled true to enable blending, false to disable it
+            /// @param sourceFactor the source blend factor
+            /// @param destinationFactor the destination blend factor
+            void set_blend(const bool isEnabled, const unsigned int sourceFactor, const unsigned int destinationFactor);
+
+            /// @brief requests a depth state
+            /// @param isTestEnabled true to enable depth testing, false to disable it
+            /// @param isWriteEnabled true to enable depth writes, false to disable them
+            /// @param function the depth comparison function
+            void set_depth(const bool isTestEnabled, const bool isWriteEnabled, const unsigned int function);
+
+            /// @brief requests a face culling state
+            /// @param isEnabled true to enable face culling, false to disable it
+            /// @param face the face to cull
+            void set_cull_face(const bool isEnabled, const unsigned int face);
+
+            /// @brief requests a viewport
+            /// @param x the x coordinate of the viewport's lower left corner
+            /// @param y the y coordinate of the viewport's lower left corner
+            /// @param width the width of the viewport
+            /// @param height the height of the viewport
+            void set_viewport(const int x, const int y, const int width, const int height);
+
+            /// @brief gets the requested viewport
+            /// @param viewport receives the x, y, width and height of the viewport
+            /// @return true if a viewport has been requested, false if it's unknown (viewport is left unchanged)
+            const bool get_viewport(int (&viewport)[4]) const;
+
+            /// @brief issues the GL calls needed to bring the context's state up to the requested state
+            /// @param gl the context's function table
+            void flush(const GladGLContext &gl);
+
+            /// @brief marks all of the context's real state as unknown, so the next flush applies everything
+            void invalidate();
+
+            /// @brief forgets an object which is being deleted, since deleting an object implicitly unbinds it (and its
+            /// name may be reused by a new object)
+            /// @param type the kind of object
+            /// @param name the GL name of the object
+            void forget(const ObjectType type, const unsigned int name);
+
+            /// @brief marks the end of a frame, rolling over the statistics and validating the shadowed state against
+            /// the real state if it's time to
+            /// @param gl the context's function table
+            void end_frame(const GladGLContext &gl);
+
+            /// @brief gets the statistics of the previous (complete) frame
+            /// @return the statistics of the previous frame
+            const bEngineGLStateStats get_frame_stats() const;
+
+            /// @brief sets how often the shadowed state is validated
+            /// @param frameInterval the number of frames between validations, or 0 to never validate
+            void set_validation_interval(const unsigned int frameInterval);
+
+            /// @brief compares the shadowed state against the real state (via glGet* queries), warning about and
+            /// correcting any difference; texture/sampler units aren't checked since querying them requires changing
+            /// the active texture unit
+            /// @param gl the context's function table
+            /// @return true if the shadowed state matched the real state, false if not
+            const bool validate(const GladGLContext &gl);
+        };
+    } // namespace GL
+} // namespace bEngine
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLStreamBuffer.h"
+
+/// @file bEngineGLStreamBuffer.cpp
+/// @brief implementations for the bEngineGLStreamBuffer.h file
+
+#include "bEngineGLContext.h" // for the context's function table and stream buffer registry
+#include "bEngineUtilities.h" // for access to assertions
+
+#include <algorithm> // for unregistering from the context
+#include <chrono>    // for timing stalls
+
+namespace
+{
+    /// @brief the storage/mapping flags of a stream buffer: written by the CPU, mapped for the buffer's lifetime, and
+    /// coherent so writes are visible to the GPU without explicit flushes
+    constexpr GLbitfield s_streamFlags{GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT};
+} // namespace
+
+bEngine::bEngineGLStreamBuffer::bEngineGLStreamBuffer(const std::ptrdiff_t regionSize, const unsigned int regionCount)
+    : m_context{&GL::require_current_context()},
+      m_buffer{regionSize * regionCount, nullptr, s_streamFlags},
+      m_regionSize{regionSize},
+      m_regionCount{regionCount},
+      m_fences(regionCount, nullptr)
+{
+    bENGINE_ASSERT(m_regionCount > 1, "A stream buffer needs at least 2 regions to avoid stalling every frame!");
+
+    m_mapping = static_cast<std::byte *>(m_buffer.map_range(0, m_regionSize * m_regionCount, s_streamFlags));
+    bENGINE_ASSERT(m_mapping, "Failed to persistently map a stream buffer!");
+
+    m_context->m_streamBuffers.push_back(this);
+}
+
+bEngine::bEngineGLStreamBuffer::~bEngineGLStreamBuffer()
+{
+    release();
+}
+
+bEngine::bEngineGLStreamBuffer::Allocation bEngine::bEngineGLStreamBuffer::allocate(
+    const std::ptrdiff_t size,
+    const std::ptrdiff_t alignment)
+{
+    // a released stream buffer has nothing left to allocate from
+    if (!m_mapping)
+    {
+        m_failedAllocations.fetch_add(1, std::memory_order_relaxed);
+        return {};
+    }
+
+    // claim [alignedOffset, alignedOffset + size) with a CAS loop; no locks, and a failed claim never moves the offset
+    auto offset{m_regionOffset.load(std::memory_order_relaxed)};
+    std::ptrdiff_t alignedOffset{0};
+    do
+    {
+        alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+        if (alignedOffset + size > m_regionSize)
+        {
+            m_failedAllocations.fetch_add(1, std::memory_order_relaxed);
+            return {};
+        }
+    } while (!m_regionOffset.compare_exchange_weak(
+        offset,
+        alignedOffset + size,
+        std::memory_order_relaxed,
+        std::memory_order_relaxed));
+
+    m_allocations.fetch_add(1, std::memory_order_relaxed);
+    m_allocatedBytes.fetch_add(static_cast<unsigned long long>(size), std::memory_order_relaxed);
+
+    const auto bufferOffset{static_cast<std::ptrdiff_t>(m_currentRegion) * m_regionSize + alignedOffset};
+    return {m_mapping + bufferOffset, bufferOffset, size};
+}
+
+const bEngine::bEngineGLBuffer &bEngine::bEngineGLStreamBuffer::get_buffer() const
+{
+    return m_buffer;
+}
+
+const std::ptrdiff_t bEngine::bEngineGLStreamBuffer::get_region_size() const
+{
+    return m_regionSize;
+}
+
+const bEngine::bEngineGLStreamStats bEngine::bEngineGLStreamBuffer::get_stats() const
+{
+    return {
+        m_allocations.load(std::memory_order_relaxed),
+        m_allocatedBytes.load(std::memory_order_relaxed),
+        m_failedAllocations.load(std::memory_order_relaxed),
+        m_stalls,
+        m_stallSeconds,
+        m_wraparounds};
+}
+
+void bEngine::bEngineGLStreamBuffer::begin_frame()
+{
+    m_currentRegion = (m_currentRegion + 1) % m_regionCount;
+    if (m_currentRegion == 0)
+        ++m_wraparounds;
+
+    // the region can't be written until the GPU has finished the frame which last used it
+    if (auto *const fence{static_cast<GLsync>(m_fences[m_currentRegion])})
+    {
+        const auto &gl{m_context->m_gl};
+
+        // the first check doesn't wait at all; if it isn't signaled yet the CPU is too far ahead, which is a stall
+        auto status{gl.ClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0)};
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+            const auto stallStart{std::chrono::steady_clock::now()};
+            while (status == GL_TIMEOUT_EXPIRED)
+                status = gl.ClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+
+            ++m_stalls;
+            m_stallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - stallStart).count();
+        }
+
+        gl.DeleteSync(fence);
+        m_fences[m_currentRegion] = nullptr;
+    }
+
+    m_regionOffset.store(0, std::memory_order_relaxed);
+}
+
+void bEngine::bEngineGLStreamBuffer::end_frame()
+{
+    m_fences[m_currentRegion] = m_context->m_gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void bEngine::bEngineGLStreamBuffer::release()
+{
+    if (!m_context)
+        return;
+
+    auto &streamBuffers{m_context->m_streamBuffers};
+    streamBuffers.erase(std::remove(streamBuffers.begin(), streamBuffers.end(), this), streamBuffers.end());
+
+    // the buffer itself is deleted (and implicitly unmapped) by the context group once the GPU is done with it
+    for (auto *&fence : m_fences)
+    {
+        if (fence)
+            m_context->m_gl.DeleteSync(static_cast<GLsync>(fence));
+        fence = nullptr;
+    }
+    m_buffer.reset();
+    m_mapping = nullptr;
+    m_context = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,480 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineGLTextureStreamer.h"
+
+/// @file bEngineGLTextureStreamer.cpp
+/// @brief implementations for the bEngineGLTextureStreamer.h file
+
+#include "bEngineGLContext.h" // for the context's function table
+#include "bEngineUtilities.h" // for access to assertions and warnings
+
+#include <algorithm> // for clamping levels and ordering uploads
+#include <bit>       // for the length of a full mip chain
+#include <cmath>     // for the level matching a screen size
+#include <format>    // for formatting warnings
+
+namespace
+{
+    /// @brief the storage/mapping flags of the staging buffer: written by the worker threads, mapped for the
+    /// streamer's lifetime, and coherent so decoded texels are visible to the GPU without explicit flushes
+    constexpr GLbitfield s_stagingFlags{GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT};
+
+    /// @brief the alignment of every staging range's offset, which covers the size of any texel type
+    constexpr std::ptrdiff_t s_stagingAlignment{16};
+} // namespace
+
+bEngine::bEngineGLTextureStreamer::bEngineGLTextureStreamer(const bEngineTextureStreamerSettings &settings)
+    : m_context{&GL::require_current_context()},
+      m_settings{settings},
+      m_staging{settings.m_stagingSize, nullptr, s_stagingFlags}
+{
+    bENGINE_ASSERT(m_settings.m_uploadBudget > 0, "A texture streamer needs an upload budget!");
+    bENGINE_ASSERT(m_settings.m_workerCount > 0, "A texture streamer needs at least 1 worker thread!");
+
+    m_mapping = static_cast<std::byte *>(m_staging.map_range(0, m_settings.m_stagingSize, s_stagingFlags));
+    bENGINE_ASSERT(m_mapping, "Failed to persistently map a texture streamer's staging buffer!");
+
+    m_context->m_textureStreamers.push_back(this);
+
+    m_workers.reserve(m_settings.m_workerCount);
+    for (unsigned int worker{0}; worker < m_settings.m_workerCount; ++worker)
+        m_workers.emplace_back(&bEngineGLTextureStreamer::run, this);
+}
+
+bEngine::bEngineGLTextureStreamer::~bEngineGLTextureStreamer()
+{
+    release();
+}
+
+const bEngine::bEngineStreamedTexture bEngine::bEngineGLTextureStreamer::add_texture(
+    const bEngineStreamedTextureDesc &desc)
+{
+    bENGINE_ASSERT(desc.m_width > 0 && desc.m_height > 0, "A streamed texture can't be empty!");
+    bENGINE_ASSERT(desc.m_texelSize > 0, "A streamed texture needs the size of its texels!");
+    bENGINE_ASSERT(desc.m_loader, "A streamed texture needs a loader to decode its levels!");
+
+    const auto largest{static_cast<unsigned int>(std::max(desc.m_width, desc.m_height))};
+    const auto fullChain{static_cast<int>(std::bit_width(largest))};
+    const auto levels{desc.m_levels > 0 ? std::min(desc.m_levels, fullChain) : fullChain};
+
+    std::uint32_t index{0};
+    if (m_freeTextures.empty())
+    {
+        index = static_cast<std::uint32_t>(m_textures.size());
+        m_textures.emplace_back();
+    }
+    else
+    {
+        index = m_freeTextures.back();
+        m_freeTextures.pop_back();
+    }
+
+    auto &texture{m_textures[index]};
+    texture.m_texture = bEngineGLTexture{GL_TEXTURE_2D, levels, desc.m_internalFormat, desc.m_width, desc.m_height};
+    texture.m_format        = desc.m_format;
+    texture.m_type          = desc.m_type;
+    texture.m_texelSize     = desc.m_texelSize;
+    texture.m_loader        = std::make_shared<const std::function<bool(const bEngineStreamedLevel &)>>(desc.m_loader);
+    texture.m_levels        = std::vector<LevelState>(static_cast<std::size_t>(levels), LevelState::Absent);
+    texture.m_residentLevel = levels;
+    texture.m_wantedLevel   = levels - 1;
+    texture.m_serial        = m_nextSerial++;
+
+    // a level has to be decoded into the staging buffer in one piece, so finer levels which don't fit are never wanted
+    texture.m_finestLevel = 0;
+    while (texture.m_finestLevel < levels - 1 &&
+           get_level_size(texture, texture.m_finestLevel) > m_settings.m_stagingSize)
+        ++texture.m_finestLevel;
+    if (texture.m_finestLevel > 0)
+    {
+        WARNING_MSG(std::format(
+            "A {}x{} streamed texture's levels finer than {} don't fit in the staging buffer, so won't be streamed!",
+            desc.m_width,
+            desc.m_height,
+            texture.m_finestLevel));
+    }
+
+    // nothing is sampled until the smallest level is resident, and then never a level which isn't
+    texture.m_texture.set_parameter(GL_TEXTURE_BASE_LEVEL, levels - 1);
+    texture.m_texture.set_parameter(GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+    ++m_stats.m_textureCount;
+    for (auto level{0}; level < levels; ++level)
+        m_stats.m_storageBytes += static_cast<unsigned long long>(get_level_size(texture, level));
+    return {index};
+}
+
+void bEngine::bEngineGLTextureStreamer::remove_texture(bEngineStreamedTexture &texture)
+{
+    if (!texture.get_is_valid())
+        return;
+    auto &removed{m_textures[texture.m_index]};
+    bENGINE_ASSERT(removed.m_serial != 0, "A streamed texture can't be removed twice!");
+
+    for (auto level{0}; level < static_cast<int>(removed.m_levels.size()); ++level)
+    {
+        const auto size{static_cast<unsigned long long>(get_level_size(removed, level))};
+        m_stats.m_storageBytes -= size;
+        if (removed.m_levels[level] == LevelState::Resident)
+            m_stats.m_residentBytes -= size;
+    }
+
+    // levels no worker thread has started and levels waiting for upload free their staging ranges straight away,
+    // while levels being decoded see their serial cleared and are discarded when they're collected
+    const auto isRemoved = [&texture, &removed](const Upload *const upload)
+    { return upload->m_texture == texture.m_index && upload->m_serial == removed.m_serial; };
+    {
+        std::scoped_lock lock{m_queueMutex};
+        std::erase_if(
+            m_decodeQueue,
+            [this, &isRemoved](Upload *const upload)
+            {
+                if (!isRemoved(upload))
+                    return false;
+                upload->m_isDone = true;
+                --m_stats.m_decodingLevels;
+                return true;
+            });
+    }
+    std::erase_if(
+        m_ready,
+        [&isRemoved](Upload *const upload)
+        {
+            if (!isRemoved(upload))
+                return false;
+            upload->m_isDone = true;
+            return true;
+        });
+    for (auto &upload : m_uploads)
+        if (isRemoved(upload.get()) && !upload->m_fence && !upload->m_isDone)
+            upload->m_serial = 0;
+
+    --m_stats.m_textureCount;
+    removed = {};
+    m_freeTextures.push_back(texture.m_index);
+    texture = {};
+}
+
+void bEngine::bEngineGLTextureStreamer::set_screen_size(const bEngineStreamedTexture texture, const float pixels)
+{
+    const auto &streamed{m_textures[texture.m_index]};
+    const auto  size{static_cast<float>(std::max(streamed.m_texture.get_width(), streamed.m_texture.get_height()))};
+
+    // the level whose size is closest to (without falling below) the size on screen, as the sampler would pick
+    const auto level{pixels > 0.0f ? static_cast<int>(std::floor(std::log2(size / pixels))) : 0x7FFFFFFF};
+    set_wanted_level(texture, level);
+}
+
+void bEngine::bEngineGLTextureStreamer::set_wanted_level(const bEngineStreamedTexture texture, const int level)
+{
+    auto &streamed{m_textures[texture.m_index]};
+    streamed.m_wantedLevel = std::clamp(level, 0, static_cast<int>(streamed.m_levels.size()) - 1);
+}
+
+void bEngine::bEngineGLTextureStreamer::update()
+{
+    if (!m_context)
+        return;
+
+    collect_decoded();
+    upload_ready();
+    retire_staging();
+    dispatch_decodes();
+}
+
+const bEngine::bEngineGLTexture &bEngine::bEngineGLTextureStreamer::get_texture(
+    const bEngineStreamedTexture texture) const
+{
+    return m_textures[texture.m_index].m_texture;
+}
+
+const int bEngine::bEngineGLTextureStreamer::get_resident_level(const bEngineStreamedTexture texture) const
+{
+    return m_textures[texture.m_index].m_residentLevel;
+}
+
+const bool bEngine::bEngineGLTextureStreamer::get_is_resident(const bEngineStreamedTexture texture) const
+{
+    const auto &streamed{m_textures[texture.m_index]};
+    return streamed.m_residentLevel < static_cast<int>(streamed.m_levels.size());
+}
+
+const bEngine::bEngineTextureStreamerStats bEngine::bEngineGLTextureStreamer::get_stats() const
+{
+    auto stats{m_stats};
+    stats.m_queuedLevels = m_ready.size();
+    if (!m_uploads.empty())
+    {
+        // the used part of the ring runs from the oldest range to the tail, possibly wrapping around
+        const auto head{m_uploads.front()->m_offset};
+        stats.m_stagingBytes =
+            m_stagingTail > head ? m_stagingTail - head : m_settings.m_stagingSize - head + m_stagingTail;
+    }
+    return stats;
+}
+
+void bEngine::bEngineGLTextureStreamer::release()
+{
+    if (!m_context)
+        return;
+
+    {
+        std::scoped_lock lock{m_queueMutex};
+        m_isStopping = true;
+    }
+    m_queueCondition.notify_all();
+    for (auto &worker : m_workers)
+        worker.join();
+    m_workers.clear();
+
+    auto &textureStreamers{m_context->m_textureStreamers};
+    std::erase(textureStreamers, this);
+
+    // the staging buffer itself is deleted (and implicitly unmapped) by the context group once the GPU is done with it
+    for (const auto &upload : m_uploads)
+        if (upload->m_fence)
+            m_context->m_gl.DeleteSync(static_cast<GLsync>(upload->m_fence));
+    m_uploads.clear();
+    m_ready.clear();
+    m_decodeQueue.clear();
+    m_decodedQueue.clear();
+    m_stats.m_decodingLevels = 0;
+    m_staging.reset();
+    m_mapping = nullptr;
+    m_context = nullptr;
+}
+
+const std::ptrdiff_t bEngine::bEngineGLTextureStreamer::get_level_size(const Texture &texture, const int level) const
+{
+    const auto width{std::max(texture.m_texture.get_width() >> level, 1)};
+    const auto height{std::max(texture.m_texture.get_height() >> level, 1)};
+    const auto rowStride{(static_cast<std::ptrdiff_t>(width) * texture.m_texelSize + 3) & ~std::ptrdiff_t{3}};
+    return rowStride * height;
+}
+
+const std::ptrdiff_t bEngine::bEngineGLTextureStreamer::allocate_staging(const std::ptrdiff_t size) const
+{
+    if (m_uploads.empty())
+        return size <= m_settings.m_stagingSize ? 0 : -1;
+
+    // ranges are freed in the order they were allocated, so the free space is after the tail and before the head
+    const auto head{m_uploads.front()->m_offset};
+    if (m_stagingTail > head)
+    {
+        if (m_settings.m_stagingSize - m_stagingTail >= size)
+            return m_stagingTail;
+        return head >= size ? 0 : -1;
+    }
+    return head - m_stagingTail >= size ? m_stagingTail : -1;
+}
+
+void bEngine::bEngineGLTextureStreamer::collect_decoded()
+{
+    std::deque<Upload *> decoded;
+    {
+        std::scoped_lock lock{m_queueMutex};
+        decoded.swap(m_decodedQueue);
+    }
+
+    for (auto *const upload : decoded)
+    {
+        --m_stats.m_decodingLevels;
+        auto *const texture{upload->m_serial != 0 ? &m_textures[upload->m_texture] : nullptr};
+        if (!texture || texture->m_serial != upload->m_serial)
+        {
+            upload->m_isDone = true;
+            continue;
+        }
+
+        if (!upload->m_isDecoded)
+        {
+            WARNING_MSG(std::format("Failed to decode level {} of a streamed texture!", upload->m_level.m_level));
+            texture->m_levels[upload->m_level.m_level] = LevelState::Failed;
+            ++m_stats.m_failedLevels;
+            upload->m_isDone = true;
+            continue;
+        }
+        m_ready.push_back(upload);
+    }
+}
+
+void bEngine::bEngineGLTextureStreamer::upload_ready()
+{
+    if (m_ready.empty())
+        return;
+
+    // the smallest levels go first, since they make (or keep) the most textures sampleable per byte
+    std::stable_sort(
+        m_ready.begin(),
+        m_ready.end(),
+        [](const Upload *const left, const Upload *const right) { return left->m_size < right->m_size; });
+
+    const auto    &gl{GL::require_current_context().m_gl};
+    std::ptrdiff_t uploadedBytes{0};
+    std::size_t    uploaded{0};
+    gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_staging.get_name());
+    for (; uploaded < m_ready.size(); ++uploaded)
+    {
+        auto &upload{*m_ready[uploaded]};
+        if (uploadedBytes > 0 && uploadedBytes + upload.m_size > m_settings.m_uploadBudget)
+            break;
+
+        // with an unpack buffer bound, the texels are an offset into it and the copy runs on the GPU's timeline
+        auto       &texture{m_textures[upload.m_texture]};
+        const auto &level{upload.m_level};
+        texture.m_texture.upload(
+            level.m_level,
+            0,
+            0,
+            0,
+            level.m_width,
+            level.m_height,
+            1,
+            texture.m_format,
+            texture.m_type,
+            reinterpret_cast<const void *>(upload.m_offset));
+        upload.m_fence = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        uploadedBytes += upload.m_size;
+
+        texture.m_levels[level.m_level] = LevelState::Resident;
+        m_stats.m_residentBytes += static_cast<unsigned long long>(upload.m_size);
+        ++m_stats.m_uploadedLevels;
+        m_stats.m_uploadedBytes += static_cast<unsigned long long>(upload.m_size);
+
+        // levels may finish out of order, so the base level only moves past contiguous resident levels
+        const auto previousLevel{texture.m_residentLevel};
+        while (texture.m_residentLevel > 0 &&
+               texture.m_levels[texture.m_residentLevel - 1] == LevelState::Resident)
+            --texture.m_residentLevel;
+        if (texture.m_residentLevel != previousLevel)
+            texture.m_texture.set_parameter(GL_TEXTURE_BASE_LEVEL, texture.m_residentLevel);
+    }
+    gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    m_ready.erase(m_ready.begin(), m_ready.begin() + static_cast<std::ptrdiff_t>(uploaded));
+}
+
+void bEngine::bEngineGLTextureStreamer::retire_staging()
+{
+    const auto &gl{GL::require_current_context().m_gl};
+    while (!m_uploads.empty())
+    {
+        auto &upload{*m_uploads.front()};
+        if (upload.m_fence)
+        {
+            // flushing makes sure the fence eventually signals, without waiting on it now
+            const auto fence{static_cast<GLsync>(upload.m_fence)};
+            if (gl.ClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+                break;
+            gl.DeleteSync(fence);
+            upload.m_fence  = nullptr;
+            upload.m_isDone = true;
+        }
+        if (!upload.m_isDone)
+            break;
+        m_uploads.pop_front();
+    }
+    if (m_uploads.empty())
+        m_stagingTail = 0;
+}
+
+void bEngine::bEngineGLTextureStreamer::dispatch_decodes()
+{
+    // each texture's candidate is its coarsest level which isn't streaming yet; a failed level stops the texture
+    const auto nextLevel = [](const Texture &texture)
+    {
+        const auto finest{std::max(texture.m_wantedLevel, texture.m_finestLevel)};
+        for (auto level{static_cast<int>(texture.m_levels.size()) - 1}; level >= finest; --level)
+        {
+            if (texture.m_levels[level] == LevelState::Failed)
+                return -1;
+            if (texture.m_levels[level] == LevelState::Absent)
+                return level;
+        }
+        return -1;
+    };
+
+    struct Candidate
+    {
+        std::ptrdiff_t m_size{0};
+        std::uint32_t  m_texture{0};
+        int            m_level{0};
+    };
+    std::vector<Candidate> candidates;
+    for (std::uint32_t index{0}; index < m_textures.size(); ++index)
+        if (m_textures[index].m_serial != 0)
+            if (const auto level{nextLevel(m_textures[index])}; level >= 0)
+                candidates.push_back({get_level_size(m_textures[index], level), index, level});
+
+    // smallest first across every texture, so the coarse levels of the whole set arrive before any fine level
+    const auto isLarger = [](const Candidate &left, const Candidate &right) { return left.m_size > right.m_size; };
+    std::make_heap(candidates.begin(), candidates.end(), isLarger);
+
+    std::size_t queued{0};
+    while (!candidates.empty())
+    {
+        std::pop_heap(candidates.begin(), candidates.end(), isLarger);
+        const auto candidate{candidates.back()};
+        candidates.pop_back();
+
+        // every remaining candidate is at least as large, so none of them would fit either
+        const auto offset{allocate_staging(candidate.m_size)};
+        if (offset < 0)
+            break;
+
+        auto       &texture{m_textures[candidate.m_texture]};
+        auto       &upload{*m_uploads.emplace_back(std::make_unique<Upload>())};
+        const auto  width{std::max(texture.m_texture.get_width() >> candidate.m_level, 1)};
+        const auto  height{std::max(texture.m_texture.get_height() >> candidate.m_level, 1)};
+        upload.m_offset  = offset;
+        upload.m_size    = candidate.m_size;
+        upload.m_texture = candidate.m_texture;
+        upload.m_serial  = texture.m_serial;
+        upload.m_level   = {candidate.m_level, width, height, candidate.m_size / height, m_mapping + offset};
+        upload.m_loader  = texture.m_loader;
+        m_stagingTail    = (offset + candidate.m_size + s_stagingAlignment - 1) & ~(s_stagingAlignment - 1);
+
+        texture.m_levels[candidate.m_level] = LevelState::Streaming;
+        ++m_stats.m_decodingLevels;
+        {
+            std::scoped_lock lock{m_queueMutex};
+            m_decodeQueue.push_back(&upload);
+        }
+        ++queued;
+
+        if (const auto level{nextLevel(texture)}; level >= 0)
+        {
+            candidates.push_back({get_level_size(texture, level), candidate.m_texture, level});
+            std::push_heap(candidates.begin(), candidates.end(), isLarger);
+        }
+    }
+
+    if (queued == 1)
+        m_queueCondition.notify_one();
+    else if (queued > 1)
+        m_queueCondition.notify_all();
+}
+
+void bEngine::bEngineGLTextureStreamer::run()
+{
+    while (true)
+    {
+        Upload *upload{nullptr};
+        {
+            std::unique_lock lock{m_queueMutex};
+            m_queueCondition.wait(lock, [this]() { return m_isStopping || !m_decodeQueue.empty(); });
+            if (m_isStopping)
+                break;
+
+            upload = m_decodeQueue.front();
+            m_decodeQueue.pop_front();
+        }
+
+        // only the worker thread touches the upload until it's handed back, which publishes the decoded texels too
+        upload->m_isDecoded = (*upload->m_loader)(upload->m_level);
+        {
+            std::scoped_lock lock{m_queueMutex};
+            m_decodedQueue.push_back(upload);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineMemory.h"
+
+/// @file bEngineMemory.cpp
+/// @brief implementations for the bEngineMemory.h file
+
+#include "bEnginePlatform.h" // the actual work is platform specific
+
+const unsigned int bEngine::Memory::get_numa_node_count()
+{
+    return Platform::get_numa_node_count();
+}
+
+const unsigned int bEngine::Memory::get_current_numa_node()
+{
+    return Platform::get_current_numa_node();
+}
+
+const bool bEngine::Memory::pin_current_thread_to_numa_node(const unsigned int numaNode)
+{
+    return Platform::pin_current_thread_to_numa_node(numaNode);
+}
+
+const std::size_t bEngine::Memory::get_large_page_size()
+{
+    return Platform::get_large_page_size();
+}
+
+void *const bEngine::Memory::allocate_pages(const std::size_t size, const int numaNode, const bool useLargePages)
+{
+    return Platform::allocate_pages(size, numaNode, useLargePages);
+}
+
+void bEngine::Memory::free_pages(void *const memory, const std::size_t size)
+{
+    Platform::free_pages(memory, size);
+}
\ No newline at end of file
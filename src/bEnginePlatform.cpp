@@ -7,6 +7,9 @@
 
 #include "bEngineUtilities.h" // for access to error/info message macros
 
+#include <format>      // for formatting warning/error messages
+#include <string_view> // for comparing the headless environment variable
+
 // WINDOWS implementations
 #ifdef WIN32
 
@@ -16,10 +19,66 @@
 namespace
 {
     ma_engine audioEngine;
-}
+
+    /// @brief what windows are backed by
+    bEngine::Platform::WindowBackend windowBackend{bEngine::Platform::WindowBackend::Native};
+
+    /// @brief reads the window backend from the BENGINE_HEADLESS environment variable
+    /// @return the requested window backend
+    const bEngine::Platform::WindowBackend read_window_backend()
+    {
+        using bEngine::Platform::WindowBackend;
+
+        // the length excludes the terminator when the value fits, and is the required size (so >= the buffer's) when it
+        // doesn't; a value which doesn't fit is just some other non-"0" value
+        char       headless[8]{};
+        const auto length{GetEnvironmentVariableA("BENGINE_HEADLESS", headless, sizeof(headless))};
+        const std::string_view value{headless, length < sizeof(headless) ? length : 0};
+        if (length == 0 || value == "0")
+            return WindowBackend::Native;
+        return value == "egl" ? WindowBackend::HeadlessEGL : WindowBackend::HeadlessOSMesa;
+    }
+
+    /// @brief attempts to enable the "lock pages in memory" privilege for the process, which Windows requires before
+    /// any large pages can be allocated; only attempted once, the first time large pages are requested
+    /// @return true if the privilege is enabled, false if not (in which case the user must grant it to their account)
+    const bool enable_large_page_privilege()
+    {
+        static const bool isEnabled{[]() {
+            HANDLE token{nullptr};
+            if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+                return false;
+
+            TOKEN_PRIVILEGES privileges{};
+            privileges.PrivilegeCount           = 1;
+            privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+            // AdjustTokenPrivileges "succeeds" even if the privilege wasn't granted, so the last error must be checked
+            const bool isAdjusted{
+                LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid) &&
+                AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                GetLastError() == ERROR_SUCCESS};
+
+            CloseHandle(token);
+            return isAdjusted;
+        }()};
+
+        return isEnabled;
+    }
+} // namespace
 
 const bool bEngine::Platform::initialize_platform_backends()
 {
+    // headless windows don't need a display, so glfw uses its null platform for them
+    windowBackend = read_window_backend();
+    if (windowBackend != WindowBackend::Native)
+    {
+        INFO_MSG(std::format(
+            "Running headless (BENGINE_HEADLESS is set), with {} contexts.",
+            windowBackend == WindowBackend::HeadlessEGL ? "EGL" : "OSMesa"));
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
+
     // attempt to load glfw
     const auto glfwResult = glfwInit();
     if (glfwResult)
@@ -32,8 +91,16 @@ const bool bEngine::Platform::initialize_platform_backends()
         return false;
     }
 
-    // attempt to load miniaudio
-    const auto miniaudioResult = (ma_engine_init(nullptr, &audioEngine) == MA_SUCCESS);
+    // attempt to load miniaudio; headless machines usually have no audio device either, so headless runs mix without
+    // one (keeping the audio code paths, and their costs, the same)
+    auto engineConfig{ma_engine_config_init()};
+    if (windowBackend != WindowBackend::Native)
+    {
+        engineConfig.noDevice   = MA_TRUE;
+        engineConfig.channels   = 2;
+        engineConfig.sampleRate = 48000;
+    }
+    const auto miniaudioResult = (ma_engine_init(&engineConfig, &audioEngine) == MA_SUCCESS);
     if (miniaudioResult)
     {
         INFO_MSG("Initialized miniaudio.");
@@ -62,6 +129,11 @@ void bEngine::Platform::free_platform_backends()
     ma_engine_uninit(&audioEngine);
 }
 
+const bEngine::Platform::WindowBackend bEngine::Platform::get_window_backend()
+{
+    return windowBackend;
+}
+
 void bEngine::Platform::poll_platform_events()
 {
     glfwPollEvents();
@@ -72,4 +144,98 @@ const double bEngine::Platform::get_time()
     return glfwGetTime();
 }
 
+const unsigned int bEngine::Platform::get_numa_node_count()
+{
+    ULONG highestNode{0};
+    if (!GetNumaHighestNodeNumber(&highestNode))
+        return 1;
+
+    return static_cast<unsigned int>(highestNode) + 1;
+}
+
+const unsigned int bEngine::Platform::get_current_numa_node()
+{
+    PROCESSOR_NUMBER processor{};
+    GetCurrentProcessorNumberEx(&processor);
+
+    USHORT node{0};
+    if (!GetNumaProcessorNodeEx(&processor, &node))
+        return 0;
+
+    return node;
+}
+
+const bool bEngine::Platform::pin_current_thread_to_numa_node(const unsigned int numaNode)
+{
+    // the node's processor mask includes its processor group, so this works on systems with more than 64 processors
+    GROUP_AFFINITY affinity{};
+    if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(numaNode), &affinity) || affinity.Mask == 0)
+    {
+        WARNING_MSG(std::format("Could not get the processors of NUMA node {}.", numaNode));
+        return false;
+    }
+
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr);
+}
+
+const std::size_t bEngine::Platform::get_large_page_size()
+{
+    return GetLargePageMinimum();
+}
+
+void *const bEngine::Platform::allocate_pages(const std::size_t size, const int numaNode, const bool useLargePages)
+{
+    DWORD       allocationType{MEM_RESERVE | MEM_COMMIT};
+    std::size_t allocationSize{size};
+
+    // Windows has no "transparent" huge pages; large pages must be requested explicitly, are never paged out, and
+    // must be allocated in multiples of the large page size
+    if (useLargePages)
+    {
+        const auto largePageSize{get_large_page_size()};
+        if (largePageSize && enable_large_page_privilege())
+        {
+            allocationType |= MEM_LARGE_PAGES;
+            allocationSize = (size + largePageSize - 1) / largePageSize * largePageSize;
+        }
+        else
+        {
+            WARNING_MSG("Large pages are unavailable (is 'Lock pages in memory' granted?); using regular pages.");
+        }
+    }
+
+    // VirtualAllocExNuma only sets the preferred node, the pages are physically allocated there when first touched
+    void *const memory{
+        (numaNode >= 0)
+            ? VirtualAllocExNuma(
+                  GetCurrentProcess(),
+                  nullptr,
+                  allocationSize,
+                  allocationType,
+                  PAGE_READWRITE,
+                  static_cast<DWORD>(numaNode))
+            : VirtualAlloc(nullptr, allocationSize, allocationType, PAGE_READWRITE)};
+
+    // large page allocations can fail even with the privilege if physical memory is fragmented, so fall back to
+    // regular pages rather than failing outright
+    if (!memory && (allocationType & MEM_LARGE_PAGES))
+    {
+        WARNING_MSG(std::format("Failed to allocate {} bytes of large pages; using regular pages.", allocationSize));
+        return allocate_pages(size, numaNode, false);
+    }
+
+    if (!memory)
+    {
+        ERROR_MSG(std::format("Failed to allocate {} bytes of pages (error {}).", allocationSize, GetLastError()));
+    }
+
+    return memory;
+}
+
+void bEngine::Platform::free_pages(void *const memory, const std::size_t)
+{
+    if (memory)
+        VirtualFree(memory, 0, MEM_RELEASE);
+}
+
 #endif // WIN32
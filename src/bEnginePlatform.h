@@ -4,12 +4,31 @@
 /// @brief the declarations for the platform specific functions which will need to be implemented on a per-platform
 /// basis
 
+#include <cstddef> // for size_t
+
 namespace bEngine
 {
     /// @brief platform specific functions/methods which will be implemented on a per-platform basis
     namespace Platform
     {
+        /// @brief what windows (and their GL contexts) are backed by
+        enum class WindowBackend : unsigned char
+        {
+            /// @brief real, visible windows on the display
+            Native,
+
+            /// @brief headless windows whose contexts are created through OSMesa (software GL, no display or GPU)
+            HeadlessOSMesa,
+
+            /// @brief headless windows whose contexts are created through surfaceless EGL (no display)
+            HeadlessEGL
+        };
+
         /// @brief sets up the "context" for the application to run in
+        ///
+        /// windows are headless if the BENGINE_HEADLESS environment variable is set (to anything but "0"): "egl" uses
+        /// surfaceless EGL and anything else uses OSMesa. Headless windows render into offscreen framebuffers of
+        /// exactly their requested size, and audio runs without a device
         /// @return true if all backends were initialized successfully, false if not (which _should_ lead to the program
         /// terminating)
         const bool initialize_platform_backends();
@@ -17,11 +36,48 @@ namespace bEngine
         /// @brief frees/"releases" the "context" the application runs in
         void free_platform_backends();
 
+        /// @brief gets what windows are backed by, as decided when the platform backends were initialized
+        /// @return the window backend
+        const WindowBackend get_window_backend();
+
         /// @brief gets the program's current timer value
         /// @return the value of the program's timer (in seconds)
         const double get_time();
 
         /// @brief polls the platform for system/platform/window level events
         void poll_platform_events();
+
+        /// @brief gets the number of NUMA nodes (i.e. memory controllers/sockets) the system has
+        /// @return the number of NUMA nodes, which is 1 on a non-NUMA system
+        const unsigned int get_numa_node_count();
+
+        /// @brief gets the NUMA node of the processor the calling thread is currently running on
+        /// @return the NUMA node of the calling thread's current processor
+        const unsigned int get_current_numa_node();
+
+        /// @brief pins the calling thread to the processors of a NUMA node so it stays next to memory allocated on
+        /// that node
+        /// @param numaNode the NUMA node to pin the thread to
+        /// @return true if the thread was pinned, false if not (e.g. the node doesn't exist)
+        const bool pin_current_thread_to_numa_node(const unsigned int numaNode);
+
+        /// @brief gets the size of a large (huge) page
+        /// @return the size of a large page in bytes, or 0 if the platform doesn't support large pages
+        const std::size_t get_large_page_size();
+
+        /// @brief allocates (zeroed) memory directly from the OS in whole pages, intended for large, long-lived arenas
+        ///
+        /// if large pages are requested but can't be used (the platform doesn't support them, the process lacks the
+        /// privilege, or physical memory is too fragmented) regular pages are used instead and a warning is emitted
+        /// @param size the number of bytes to allocate; rounded up to a whole number of (large) pages
+        /// @param numaNode the NUMA node the memory should be physically allocated on, or -1 for no preference
+        /// @param useLargePages true to back the memory with large pages (fewer TLB misses for large arrays)
+        /// @return a pointer to the (page aligned) memory, or nullptr if the allocation failed
+        void *const allocate_pages(const std::size_t size, const int numaNode = -1, const bool useLargePages = false);
+
+        /// @brief frees memory which was allocated with allocate_pages()
+        /// @param memory the memory to be freed (nullptr is ignored)
+        /// @param size the size which was passed to allocate_pages()
+        void free_pages(void *const memory, const std::size_t size);
     } // namespace Platform
 } // namespace bEngine
\ No newline at end of file
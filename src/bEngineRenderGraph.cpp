@@ -0,0 +1,519 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineRenderGraph.h"
+
+/// @file bEngineRenderGraph.cpp
+/// @brief implementations for the bEngineRenderGraph.h file
+
+#include "bEngineGLContext.h" // for the context's function table
+#include "bEngineUtilities.h" // for access to assertions and info messages
+
+#include <algorithm> // for releasing unused pooled textures
+#include <format>    // for formatting the GraphViz dump and info messages
+#include <fstream>   // for writing GraphViz dumps
+
+namespace
+{
+    /// @brief estimates the size of a texel of a format
+    /// @param format the sized internal format
+    /// @return the size of a texel, in bytes (4 for formats not listed)
+    const std::uint64_t get_texel_size(const unsigned int format)
+    {
+        switch (format)
+        {
+        case GL_R8:
+        case GL_R8UI:
+            return 1;
+        case GL_RG8:
+        case GL_R16F:
+        case GL_R16UI:
+        case GL_DEPTH_COMPONENT16:
+            return 2;
+        case GL_RGBA16F:
+        case GL_RG32F:
+        case GL_RGBA16UI:
+        case GL_DEPTH32F_STENCIL8:
+            return 8;
+        case GL_RGBA32F:
+        case GL_RGBA32UI:
+            return 16;
+        default:
+            return 4;
+        }
+    }
+
+    /// @brief estimates the size of a texture
+    /// @param desc the description of the texture
+    /// @return the size of the texture (every mip level), in bytes
+    const std::uint64_t get_texture_size(const bEngine::bEngineRenderGraphTextureDesc &desc)
+    {
+        std::uint64_t size{0};
+        auto          width{desc.m_width};
+        auto          height{desc.m_height};
+        for (int level{0}; level < desc.m_levels; ++level)
+        {
+            size   += static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height);
+            width   = std::max(width / 2, 1);
+            height  = std::max(height / 2, 1);
+        }
+        return size * get_texel_size(desc.m_format);
+    }
+
+    /// @brief finds the attachment point a format is attached to
+    /// @param format the sized internal format
+    /// @return GL_DEPTH_ATTACHMENT or GL_DEPTH_STENCIL_ATTACHMENT for depth (and stencil) formats, otherwise 0 (a
+    /// color attachment)
+    const unsigned int get_depth_attachment(const unsigned int format)
+    {
+        switch (format)
+        {
+        case GL_DEPTH_COMPONENT16:
+        case GL_DEPTH_COMPONENT24:
+        case GL_DEPTH_COMPONENT32:
+        case GL_DEPTH_COMPONENT32F:
+            return GL_DEPTH_ATTACHMENT;
+        case GL_DEPTH24_STENCIL8:
+        case GL_DEPTH32F_STENCIL8:
+            return GL_DEPTH_STENCIL_ATTACHMENT;
+        default:
+            return 0;
+        }
+    }
+} // namespace
+
+bEngine::bEngineRenderGraphBuilder::bEngineRenderGraphBuilder(bEngineRenderGraph &graph, const std::uint32_t pass)
+    : m_graph{graph},
+      m_pass{pass}
+{
+}
+
+const bEngine::bEngineRenderGraphResource bEngine::bEngineRenderGraphBuilder::create_texture(
+    const std::string                   &name,
+    const bEngineRenderGraphTextureDesc &desc)
+{
+    bENGINE_ASSERT(
+        desc.m_width > 0 && desc.m_height > 0 && desc.m_levels > 0 && desc.m_format != 0,
+        "A render graph texture needs a size, a format and at least one level!");
+
+    m_graph.m_textures.push_back({name, desc});
+    return m_graph.add_version(static_cast<std::uint32_t>(m_graph.m_textures.size() - 1), -1);
+}
+
+const bEngine::bEngineRenderGraphResource bEngine::bEngineRenderGraphBuilder::read(
+    const bEngineRenderGraphResource resource)
+{
+    bENGINE_ASSERT(resource.m_index < m_graph.m_versions.size(), "A pass read a resource its graph doesn't have!");
+    const auto &version{m_graph.m_versions[resource.m_index]};
+    bENGINE_ASSERT(
+        version.m_producer >= 0 || m_graph.m_textures[version.m_texture].m_imported,
+        "A pass read a transient texture before any pass wrote it!");
+
+    m_graph.m_passes[m_pass].m_reads.push_back(resource.m_index);
+    return resource;
+}
+
+const bEngine::bEngineRenderGraphResource bEngine::bEngineRenderGraphBuilder::write(
+    const bEngineRenderGraphResource resource)
+{
+    bENGINE_ASSERT(resource.m_index < m_graph.m_versions.size(), "A pass wrote a resource its graph doesn't have!");
+
+    // writing over a version which other passes read orders the write after them, through the reads' refCounts
+    const auto written{m_graph.add_version(m_graph.m_versions[resource.m_index].m_texture, static_cast<int>(m_pass))};
+    m_graph.m_passes[m_pass].m_writes.push_back(written.m_index);
+    return written;
+}
+
+void bEngine::bEngineRenderGraphBuilder::set_has_side_effects()
+{
+    m_graph.m_passes[m_pass].m_hasSideEffects = true;
+}
+
+bEngine::bEngineRenderGraphContext::bEngineRenderGraphContext(
+    const bEngineRenderGraph &graph,
+    const std::uint32_t       pass,
+    const std::uint8_t        order)
+    : m_graph{graph},
+      m_pass{pass},
+      m_order{order}
+{
+}
+
+const bEngine::bEngineGLTexture &bEngine::bEngineRenderGraphContext::get_texture(
+    const bEngineRenderGraphResource resource) const
+{
+    bENGINE_ASSERT(resource.m_index < m_graph.m_versions.size(), "A pass used a resource its graph doesn't have!");
+    const auto &texture{m_graph.m_textures[m_graph.m_versions[resource.m_index].m_texture]};
+    if (texture.m_imported)
+        return *texture.m_imported;
+
+    bENGINE_ASSERT(texture.m_pooled >= 0, "A pass used a texture it didn't declare!");
+    return m_graph.m_pool[texture.m_pooled].m_texture;
+}
+
+const bEngine::bEngineGLFramebuffer *bEngine::bEngineRenderGraphContext::get_framebuffer() const
+{
+    const auto &framebuffer{m_graph.m_framebuffers[m_order]};
+    return framebuffer.m_attachments.empty() ? nullptr : &framebuffer.m_framebuffer;
+}
+
+const bEngine::bEngineViewport bEngine::bEngineRenderGraphContext::get_viewport() const
+{
+    // GL only renders to the area every attachment covers, so the viewport is the smallest of them
+    bEngineViewport viewport{};
+    for (const auto write : m_graph.m_passes[m_pass].m_writes)
+    {
+        const auto &desc{m_graph.m_textures[m_graph.m_versions[write].m_texture].m_desc};
+        viewport.m_width  = viewport.m_width ? std::min(viewport.m_width, desc.m_width) : desc.m_width;
+        viewport.m_height = viewport.m_height ? std::min(viewport.m_height, desc.m_height) : desc.m_height;
+    }
+    return viewport;
+}
+
+const std::uint64_t bEngine::bEngineRenderGraphContext::get_sort_key(
+    const std::uint16_t shader,
+    const std::uint16_t material,
+    const std::uint16_t depth) const
+{
+    return make_sort_key(m_graph.m_layer, m_order, shader, material, depth);
+}
+
+bEngine::bEngineRenderGraph::bEngineRenderGraph(const std::uint8_t layer) : m_layer{layer}
+{
+}
+
+void bEngine::bEngineRenderGraph::reset()
+{
+    m_passes.clear();
+    m_textures.clear();
+    m_versions.clear();
+    m_executionOrder.clear();
+    m_isCompiled = false;
+}
+
+const bEngine::bEngineRenderGraphResource bEngine::bEngineRenderGraph::import_texture(
+    const std::string      &name,
+    const bEngineGLTexture &texture)
+{
+    const bEngineRenderGraphTextureDesc desc{
+        texture.get_width(),
+        texture.get_height(),
+        texture.get_internal_format(),
+        texture.get_levels()};
+    m_textures.push_back({name, desc, &texture});
+    return add_version(static_cast<std::uint32_t>(m_textures.size() - 1), -1);
+}
+
+void bEngine::bEngineRenderGraph::add_pass(const std::string &name, const setup_fn &setup, execute_fn execute)
+{
+    bENGINE_ASSERT(!m_isCompiled, "Passes can't be added to a compiled render graph until it's reset!");
+
+    m_passes.push_back({name, std::move(execute)});
+    bEngineRenderGraphBuilder builder{*this, static_cast<std::uint32_t>(m_passes.size() - 1)};
+    if (setup)
+        setup(builder);
+}
+
+void bEngine::bEngineRenderGraph::compile()
+{
+    ++m_frame;
+    m_stats = {};
+    m_stats.m_passCount = static_cast<std::uint32_t>(m_passes.size());
+
+    // a pass is referenced by every version it writes which is read, and a version by every pass reading it; writes
+    // of imported textures are visible outside of the graph, so they're referenced as well
+    for (auto &pass : m_passes)
+    {
+        pass.m_refCount = pass.m_hasSideEffects ? 1 : 0;
+        pass.m_isCulled = false;
+    }
+    for (auto &texture : m_textures)
+    {
+        texture.m_pooled   = -1;
+        texture.m_firstUse = -1;
+        texture.m_lastUse  = -1;
+    }
+    for (auto &version : m_versions)
+        version.m_refCount = m_textures[version.m_texture].m_imported && version.m_producer >= 0 ? 1 : 0;
+    for (const auto &pass : m_passes)
+    {
+        for (const auto read : pass.m_reads)
+            ++m_versions[read].m_refCount;
+    }
+    for (auto &pass : m_passes)
+    {
+        for (const auto write : pass.m_writes)
+            pass.m_refCount += m_versions[write].m_refCount > 0 ? 1 : 0;
+    }
+
+    // unreferenced passes are culled, which dereferences the versions they read (and in turn their producers)
+    std::vector<std::uint32_t> unreferenced;
+    for (std::uint32_t pass{0}; pass < m_passes.size(); ++pass)
+    {
+        if (m_passes[pass].m_refCount == 0)
+            unreferenced.push_back(pass);
+    }
+    while (!unreferenced.empty())
+    {
+        auto &pass{m_passes[unreferenced.back()]};
+        unreferenced.pop_back();
+        pass.m_isCulled = true;
+        ++m_stats.m_culledPassCount;
+
+        for (const auto read : pass.m_reads)
+        {
+            auto &version{m_versions[read]};
+            if (--version.m_refCount > 0 || version.m_producer < 0)
+                continue;
+
+            auto &producer{m_passes[version.m_producer]};
+            if (--producer.m_refCount == 0)
+                unreferenced.push_back(static_cast<std::uint32_t>(version.m_producer));
+        }
+    }
+
+    // the surviving passes execute in the order they were added, and each texture lives from its first use to its
+    // last
+    m_executionOrder.clear();
+    for (std::uint32_t pass{0}; pass < m_passes.size(); ++pass)
+    {
+        if (m_passes[pass].m_isCulled)
+            continue;
+
+        const auto order{static_cast<int>(m_executionOrder.size())};
+        m_executionOrder.push_back(pass);
+        for (const auto *const versions : {&m_passes[pass].m_reads, &m_passes[pass].m_writes})
+        {
+            for (const auto version : *versions)
+            {
+                auto &texture{m_textures[m_versions[version].m_texture]};
+                if (texture.m_firstUse < 0)
+                    texture.m_firstUse = order;
+                texture.m_lastUse = order;
+            }
+        }
+    }
+    bENGINE_ASSERT(m_executionOrder.size() <= 256, "A render graph can't execute more than 256 passes!");
+
+    alias_textures();
+    m_isCompiled = true;
+
+    if (!m_dumpPath.empty())
+    {
+        auto dump{get_graphviz()};
+        if (dump != m_lastDump)
+        {
+            std::ofstream file{m_dumpPath, std::ios::trunc};
+            file << dump;
+            m_lastDump = std::move(dump);
+            INFO_MSG(std::format("Dumped a changed render graph to \"{}\".", m_dumpPath.string()));
+        }
+    }
+}
+
+void bEngine::bEngineRenderGraph::execute(bEngineCommandBuffer &commands)
+{
+    bENGINE_ASSERT(m_isCompiled, "A render graph has to be compiled before it's executed!");
+
+    if (m_framebuffers.size() < m_executionOrder.size())
+        m_framebuffers.resize(m_executionOrder.size());
+    for (std::size_t order{0}; order < m_executionOrder.size(); ++order)
+    {
+        update_framebuffer(order);
+
+        const auto &pass{m_passes[m_executionOrder[order]]};
+        if (pass.m_execute)
+        {
+            const bEngineRenderGraphContext context{*this, m_executionOrder[order], static_cast<std::uint8_t>(order)};
+            pass.m_execute(context, commands);
+        }
+    }
+}
+
+void bEngine::bEngineRenderGraph::set_dump_path(const std::filesystem::path &path)
+{
+    m_dumpPath = path;
+    m_lastDump.clear();
+}
+
+const std::string bEngine::bEngineRenderGraph::get_graphviz() const
+{
+    std::string dot{"digraph RenderGraph\n{\n    rankdir=LR;\n    node [fontname=\"Helvetica\"];\n"};
+
+    // passes are boxes (culled ones dashed), versions of textures are ellipses (imported ones doubled)
+    for (std::size_t pass{0}; pass < m_passes.size(); ++pass)
+    {
+        const auto &current{m_passes[pass]};
+        dot += std::format(
+            "    p{} [shape=box, style=\"{}\", label=\"{}{}\"];\n",
+            pass,
+            current.m_isCulled ? "dashed" : "filled",
+            current.m_name,
+            current.m_isCulled ? "\\n(culled)" : "");
+    }
+    for (std::size_t version{0}; version < m_versions.size(); ++version)
+    {
+        const auto &current{m_versions[version]};
+        const auto &texture{m_textures[current.m_texture]};
+        std::string backing{texture.m_imported ? "imported" : "unused"};
+        if (texture.m_pooled >= 0)
+            backing = std::format("pool #{}", texture.m_pooled);
+        dot += std::format(
+            "    r{} [shape=ellipse, peripheries={}, label=\"{} v{}\\n{}x{} {:#x}\\n{}\"];\n",
+            version,
+            texture.m_imported ? 2 : 1,
+            texture.m_name,
+            current.m_version,
+            texture.m_desc.m_width,
+            texture.m_desc.m_height,
+            texture.m_desc.m_format,
+            backing);
+    }
+    for (std::size_t pass{0}; pass < m_passes.size(); ++pass)
+    {
+        for (const auto read : m_passes[pass].m_reads)
+            dot += std::format("    r{} -> p{};\n", read, pass);
+        for (const auto write : m_passes[pass].m_writes)
+            dot += std::format("    p{} -> r{};\n", pass, write);
+    }
+    dot += "}\n";
+    return dot;
+}
+
+const bEngine::bEngineRenderGraphStats bEngine::bEngineRenderGraph::get_stats() const
+{
+    return m_stats;
+}
+
+const bEngine::bEngineRenderGraphResource bEngine::bEngineRenderGraph::add_version(
+    const std::uint32_t texture,
+    const int           producer)
+{
+    std::uint32_t number{0};
+    for (auto version{m_versions.rbegin()}; version != m_versions.rend(); ++version)
+    {
+        if (version->m_texture == texture)
+        {
+            number = version->m_version + 1;
+            break;
+        }
+    }
+    m_versions.push_back({texture, number, producer});
+    return {static_cast<std::uint32_t>(m_versions.size() - 1)};
+}
+
+void bEngine::bEngineRenderGraph::alias_textures()
+{
+    for (auto &pooled : m_pool)
+        pooled.m_busyUntil = -1;
+
+    // textures are assigned in order of first use; a pooled texture can be reused once the last use of the texture
+    // it was assigned to has passed, and only by a texture with the same description
+    std::vector<std::uint32_t> transients;
+    for (std::uint32_t texture{0}; texture < m_textures.size(); ++texture)
+    {
+        if (!m_textures[texture].m_imported && m_textures[texture].m_firstUse >= 0)
+            transients.push_back(texture);
+    }
+    std::stable_sort(
+        transients.begin(),
+        transients.end(),
+        [this](const std::uint32_t left, const std::uint32_t right)
+        { return m_textures[left].m_firstUse < m_textures[right].m_firstUse; });
+
+    for (const auto index : transients)
+    {
+        auto &texture{m_textures[index]};
+        int   pooled{-1};
+        for (std::size_t candidate{0}; candidate < m_pool.size(); ++candidate)
+        {
+            const auto &current{m_pool[candidate]};
+            if (current.m_desc == texture.m_desc && current.m_busyUntil < texture.m_firstUse)
+            {
+                pooled = static_cast<int>(candidate);
+                break;
+            }
+        }
+        if (pooled < 0)
+        {
+            const auto &desc{texture.m_desc};
+            m_pool.push_back(
+                {desc,
+                 bEngineGLTexture{GL_TEXTURE_2D, desc.m_levels, desc.m_format, desc.m_width, desc.m_height}});
+            pooled = static_cast<int>(m_pool.size() - 1);
+            ++m_stats.m_createdTextureCount;
+        }
+
+        auto &current{m_pool[pooled]};
+        if (current.m_lastUsedFrame != m_frame)
+        {
+            ++m_stats.m_pooledTextureCount;
+            m_stats.m_pooledBytes += get_texture_size(current.m_desc);
+        }
+        current.m_lastUsedFrame  = m_frame;
+        current.m_busyUntil      = texture.m_lastUse;
+        texture.m_pooled         = pooled;
+        ++m_stats.m_transientTextureCount;
+        m_stats.m_transientBytes += get_texture_size(texture.m_desc);
+    }
+
+    // pooled textures which haven't been used for a few frames are released (the pool is small, so the indices
+    // assigned this frame are patched rather than kept stable)
+    std::vector<int> remapped(m_pool.size(), -1);
+    std::size_t      kept{0};
+    for (std::size_t pooled{0}; pooled < m_pool.size(); ++pooled)
+    {
+        if (m_frame - m_pool[pooled].m_lastUsedFrame >= s_poolFrames)
+            continue;
+
+        if (kept != pooled)
+            m_pool[kept] = std::move(m_pool[pooled]);
+        remapped[pooled] = static_cast<int>(kept++);
+    }
+    if (kept == m_pool.size())
+        return;
+
+    // the framebuffers are matched to their attachments by GL name, and a released texture's name can be handed to a
+    // new texture, so every framebuffer is dropped (a stale one would keep rendering into the released texture)
+    m_pool.erase(m_pool.begin() + static_cast<std::ptrdiff_t>(kept), m_pool.end());
+    m_framebuffers.clear();
+    for (auto &texture : m_textures)
+    {
+        if (texture.m_pooled >= 0)
+            texture.m_pooled = remapped[texture.m_pooled];
+    }
+}
+
+void bEngine::bEngineRenderGraph::update_framebuffer(const std::size_t order)
+{
+    const auto &pass{m_passes[m_executionOrder[order]]};
+    auto       &framebuffer{m_framebuffers[order]};
+
+    // depth/stencil textures go to the depth attachment, the rest to the color attachments in the order written
+    std::vector<unsigned int> attachments;
+    std::vector<unsigned int> points;
+    unsigned int              colorCount{0};
+    const bEngineRenderGraphContext context{*this, m_executionOrder[order], static_cast<std::uint8_t>(order)};
+    for (const auto write : pass.m_writes)
+    {
+        const auto &texture{context.get_texture({write})};
+        const auto  depth{get_depth_attachment(texture.get_internal_format())};
+        attachments.push_back(texture.get_name());
+        points.push_back(depth ? depth : GL_COLOR_ATTACHMENT0 + colorCount++);
+    }
+    if (attachments == framebuffer.m_attachments)
+        return;
+
+    // the attachments only change when the graph (or the pool) does, so the framebuffer is usually left as it is
+    framebuffer.m_framebuffer = bEngineGLFramebuffer::create_framebuffer();
+    for (std::size_t attachment{0}; attachment < attachments.size(); ++attachment)
+        framebuffer.m_framebuffer.attach_texture(points[attachment], context.get_texture({pass.m_writes[attachment]}));
+
+    std::vector<unsigned int> drawBuffers;
+    for (unsigned int color{0}; color < colorCount; ++color)
+        drawBuffers.push_back(GL_COLOR_ATTACHMENT0 + color);
+    GL::require_current_context().m_gl.NamedFramebufferDrawBuffers(
+        framebuffer.m_framebuffer.get_name(),
+        static_cast<GLsizei>(drawBuffers.size()),
+        drawBuffers.data());
+    framebuffer.m_attachments = std::move(attachments);
+}
\ No newline at end of file
@@ -0,0 +1,330 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineSpriteBatch.h"
+
+/// @file bEngineSpriteBatch.cpp
+/// @brief implementations for the bEngineSpriteBatch.h file
+
+#include "bEngineGLContext.h" // for the current context's function table and limits
+#include "bEngineUtilities.h" // for access to assertions and warnings
+
+#include <glm\gtc\packing.hpp>  // for packing sprite instances
+#include <glm\gtc\type_ptr.hpp> // for copying the view projection
+
+#include <algorithm> // for clearing the buckets
+#include <cstring>   // for writing instances into mapped memory
+#include <format>    // for formatting warnings
+
+namespace
+{
+    /// @brief a sprite as the sprite program reads it (one instance of a quad); packed into 32 bytes, so 100K sprites
+    /// stream ~3MB per frame
+    struct SpriteInstance
+    {
+        /// @brief the position of the sprite's center
+        float m_position[2];
+
+        /// @brief the width and height of the sprite (half floats)
+        std::uint16_t m_scale[2];
+
+        /// @brief the rotation of the sprite (half float)
+        std::uint16_t m_rotation;
+
+        /// @brief the atlas page of the sprite's image
+        std::uint16_t m_page;
+
+        /// @brief the sprite's rectangle in its page (16 bit unorm min u, min v, max u, max v)
+        std::uint16_t m_uvRect[4];
+
+        /// @brief the sprite's color (8 bit unorm RGBA)
+        std::uint32_t m_color;
+
+        /// @brief padding up to a power of two, so instance offsets stay aligned to whole instances
+        std::uint32_t m_padding;
+    };
+    static_assert(sizeof(SpriteInstance) == 32, "sprite instances must match the vertex array's layout");
+
+    /// @brief the number of sprite layers
+    constexpr std::uint32_t s_layerCount{256};
+
+    /// @brief the vertex shader, which expands each instance into a (rotated) quad from gl_VertexID
+    constexpr const char *s_vertexShader{R"(#version 460 core
+layout(location = 0) in vec2 a_position;
+layout(location = 1) in vec2 a_scale;
+layout(location = 2) in float a_rotation;
+layout(location = 3) in uint a_page;
+layout(location = 4) in vec4 a_uvRect;
+layout(location = 5) in vec4 a_color;
+
+layout(std140, binding = 0) uniform Sprites
+{
+    mat4 u_viewProjection;
+};
+
+out vec3 v_uv;
+out vec4 v_color;
+
+void main()
+{
+    // the triangle strip's corners are (0, 0), (1, 0), (0, 1), (1, 1)
+    const vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    const vec2 local  = (corner - 0.5) * a_scale;
+    const vec2 along  = vec2(cos(a_rotation), sin(a_rotation));
+    const vec2 world  = a_position + vec2(along.x * local.x - along.y * local.y, along.y * local.x + along.x * local.y);
+
+    gl_Position = u_viewProjection * vec4(world, 0.0, 1.0);
+    v_uv        = vec3(mix(a_uvRect.xy, a_uvRect.zw, corner), float(a_page));
+    v_color     = a_color;
+}
+)"};
+
+    /// @brief the fragment shader, which samples the sprite's image from the atlas and tints it
+    constexpr const char *s_fragmentShader{R"(#version 460 core
+layout(binding = 0) uniform sampler2DArray u_atlas;
+
+in vec3 v_uv;
+in vec4 v_color;
+
+out vec4 o_color;
+
+void main()
+{
+    o_color = texture(u_atlas, v_uv) * v_color;
+}
+)"};
+
+    /// @brief packs a sprite into its instance
+    /// @param sprite the sprite
+    /// @return the sprite's instance
+    SpriteInstance pack_sprite(const bEngine::bEngineSprite &sprite)
+    {
+        // the sprite's rectangle is relative to its image, so it's mapped into the image's rectangle in the page
+        const auto &image{sprite.m_image.m_uvRect};
+        const auto  size{glm::vec2{image.z, image.w} - glm::vec2{image.x, image.y}};
+        const auto  minimum{glm::vec2{image.x, image.y} + glm::vec2{sprite.m_uvRect.x, sprite.m_uvRect.y} * size};
+        const auto  maximum{glm::vec2{image.x, image.y} + glm::vec2{sprite.m_uvRect.z, sprite.m_uvRect.w} * size};
+        const auto  uvRect{glm::packUnorm4x16(glm::vec4{minimum, maximum})};
+
+        SpriteInstance instance{};
+        instance.m_position[0] = sprite.m_position.x;
+        instance.m_position[1] = sprite.m_position.y;
+        instance.m_scale[0]    = glm::packHalf1x16(sprite.m_scale.x);
+        instance.m_scale[1]    = glm::packHalf1x16(sprite.m_scale.y);
+        instance.m_rotation    = glm::packHalf1x16(sprite.m_rotation);
+        instance.m_page        = sprite.m_image.m_page;
+        std::memcpy(instance.m_uvRect, &uvRect, sizeof(instance.m_uvRect));
+        instance.m_color = glm::packUnorm4x8(sprite.m_color);
+        return instance;
+    }
+} // namespace
+
+bEngine::bEngineSpriteAtlas::bEngineSpriteAtlas(const int pageSize, const int pageCount)
+    : m_texture{GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, pageSize, pageSize, pageCount},
+      m_pageSize{pageSize},
+      m_shelves(pageCount)
+{
+    // immutable storage starts out undefined, and the padding around images has to be transparent
+    GL::require_current_context().m_gl.ClearTexImage(m_texture.get_name(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    m_texture.set_parameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    m_texture.set_parameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    m_texture.set_parameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    m_texture.set_parameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+const bool bEngine::bEngineSpriteAtlas::add_image(
+    const int           width,
+    const int           height,
+    const void *const   texels,
+    bEngineSpriteImage &image)
+{
+    // every image keeps a texel of padding on each side
+    const auto paddedWidth{width + 2};
+    const auto paddedHeight{height + 2};
+    if (paddedWidth > m_pageSize || paddedHeight > m_pageSize)
+        return false;
+
+    for (std::size_t page{0}; page < m_shelves.size(); ++page)
+    {
+        auto &shelves{m_shelves[page]};
+
+        // the first shelf which is tall enough and has room wins; otherwise a new shelf is opened on top
+        Shelf *found{nullptr};
+        for (auto &shelf : shelves)
+        {
+            if (shelf.m_height >= paddedHeight && m_pageSize - shelf.m_x >= paddedWidth)
+            {
+                found = &shelf;
+                break;
+            }
+        }
+        if (!found)
+        {
+            const auto top{shelves.empty() ? 0 : shelves.back().m_y + shelves.back().m_height};
+            if (m_pageSize - top < paddedHeight)
+                continue;
+            found = &shelves.emplace_back(Shelf{top, paddedHeight, 0});
+        }
+
+        const auto x{found->m_x + 1};
+        const auto y{found->m_y + 1};
+        found->m_x += paddedWidth;
+        m_texture.upload(0, x, y, static_cast<int>(page), width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, texels);
+
+        const auto pageSize{static_cast<float>(m_pageSize)};
+        image.m_uvRect = {x / pageSize, y / pageSize, (x + width) / pageSize, (y + height) / pageSize};
+        image.m_page   = static_cast<std::uint16_t>(page);
+        return true;
+    }
+    return false;
+}
+
+const bEngine::bEngineGLTexture &bEngine::bEngineSpriteAtlas::get_texture() const
+{
+    return m_texture;
+}
+
+bEngine::bEngineSpriteBatch::bEngineSpriteBatch(bEngineGLStreamBuffer &streamBuffer)
+    : m_streamBuffer{&streamBuffer},
+      m_program{{GL_VERTEX_SHADER, s_vertexShader}, {GL_FRAGMENT_SHADER, s_fragmentShader}},
+      m_vertexArray{bEngineGLVertexArray::create_vertex_array()}
+{
+    bENGINE_ASSERT(
+        m_streamBuffer->get_region_size() % sizeof(SpriteInstance) == 0,
+        "A sprite batch's stream buffer regions must be a multiple of the sprite instance size!");
+
+    GLint alignment{0};
+    GL::require_current_context().m_gl.GetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    m_uniformAlignment = alignment;
+
+    // instances are read from the start of the stream buffer, and each run offsets them with its base instance
+    m_vertexArray.set_vertex_buffer(0, m_streamBuffer->get_buffer(), 0, sizeof(SpriteInstance));
+    m_vertexArray.set_binding_divisor(0, 1);
+    m_vertexArray.set_attribute(0, 0, 2, GL_FLOAT, false, offsetof(SpriteInstance, m_position));
+    m_vertexArray.set_attribute(1, 0, 2, GL_HALF_FLOAT, false, offsetof(SpriteInstance, m_scale));
+    m_vertexArray.set_attribute(2, 0, 1, GL_HALF_FLOAT, false, offsetof(SpriteInstance, m_rotation));
+    m_vertexArray.set_integer_attribute(3, 0, 1, GL_UNSIGNED_SHORT, offsetof(SpriteInstance, m_page));
+    m_vertexArray.set_attribute(4, 0, 4, GL_UNSIGNED_SHORT, true, offsetof(SpriteInstance, m_uvRect));
+    m_vertexArray.set_attribute(5, 0, 4, GL_UNSIGNED_BYTE, true, offsetof(SpriteInstance, m_color));
+}
+
+const std::uint16_t bEngine::bEngineSpriteBatch::add_material(const bEngineSpriteMaterial &material)
+{
+    bENGINE_ASSERT(m_materials.size() < s_maxMaterials, "A sprite batch can't have any more materials!");
+    bENGINE_ASSERT(material.m_atlas, "A sprite material needs an atlas!");
+
+    m_materials.push_back(material);
+    return static_cast<std::uint16_t>(m_materials.size() - 1);
+}
+
+void bEngine::bEngineSpriteBatch::begin()
+{
+    m_sprites.clear();
+}
+
+void bEngine::bEngineSpriteBatch::add_sprite(const bEngineSprite &sprite)
+{
+    m_sprites.push_back(sprite);
+}
+
+void bEngine::bEngineSpriteBatch::add_sprites(std::span<const bEngineSprite> sprites)
+{
+    m_sprites.insert(m_sprites.end(), sprites.begin(), sprites.end());
+}
+
+void bEngine::bEngineSpriteBatch::record(
+    bEngineCommandBuffer       &commands,
+    const std::uint64_t         sortKey,
+    const glm::mat4            &viewProjection,
+    const bEngineGLFramebuffer *framebuffer,
+    const bEngineViewport      &viewport)
+{
+    m_stats = {};
+    if (m_sprites.empty())
+        return;
+
+    const auto spriteCount{static_cast<std::uint32_t>(m_sprites.size())};
+    auto       instances{m_streamBuffer->allocate(spriteCount * sizeof(SpriteInstance), sizeof(SpriteInstance))};
+    auto       uniforms{m_streamBuffer->allocate(sizeof(glm::mat4), m_uniformAlignment)};
+    if (!instances.m_data || !uniforms.m_data)
+    {
+        WARNING_MSG(std::format("Not enough stream buffer space left this frame for {} sprites!", spriteCount));
+        m_stats.m_droppedSprites = spriteCount;
+        return;
+    }
+    std::memcpy(uniforms.m_data, glm::value_ptr(viewProjection), sizeof(glm::mat4));
+
+    // count the sprites of each (layer, material) bucket, then turn the counts into each bucket's first position
+    const auto materialCount{static_cast<std::uint32_t>(m_materials.size())};
+    const auto bucketCount{s_layerCount * materialCount};
+    m_bucketOffsets.assign(bucketCount + 1, 0);
+    for (const auto &sprite : m_sprites)
+    {
+        bENGINE_ASSERT(sprite.m_material < materialCount, "A sprite refers to a material the batch doesn't have!");
+        ++m_bucketOffsets[sprite.m_layer * materialCount + sprite.m_material + 1];
+    }
+    for (std::uint32_t bucket{1}; bucket <= bucketCount; ++bucket)
+        m_bucketOffsets[bucket] += m_bucketOffsets[bucket - 1];
+
+    // scatter each instance straight into its sorted position; sprites keep their order within a bucket, and the
+    // mapping is write-only, so each instance is written with a single copy
+    auto *const destination{static_cast<SpriteInstance *>(instances.m_data)};
+    for (const auto &sprite : m_sprites)
+    {
+        const auto instance{pack_sprite(sprite)};
+        auto      &position{m_bucketOffsets[sprite.m_layer * materialCount + sprite.m_material]};
+        std::memcpy(destination + position++, &instance, sizeof(instance));
+    }
+
+    bEngineDrawItem item{};
+    item.m_program       = &m_program;
+    item.m_vertexArray   = &m_vertexArray;
+    item.m_framebuffer   = framebuffer;
+    item.m_viewport      = viewport;
+    item.m_uniformBuffer = &m_streamBuffer->get_buffer();
+    item.m_uniformOffset = uniforms.m_offset;
+    item.m_uniformSize   = uniforms.m_size;
+    item.m_mode          = GL_TRIANGLE_STRIP;
+    item.m_count         = 4;
+    item.m_state.m_depth = bEngineDepthMode::Disabled;
+    item.m_state.m_cull  = bEngineCullMode::None;
+
+    // after the scatter each bucket's offset is the next bucket's first position, so bucket b spans
+    // [offset[b - 1], offset[b]); consecutive buckets with the same material (i.e. a material alone in its layer and
+    // the next) are merged into one run
+    const auto     baseInstance{static_cast<std::uint32_t>(instances.m_offset / sizeof(SpriteInstance))};
+    std::uint32_t  runFirst{0};
+    std::uint32_t  runMaterial{0};
+    std::uint32_t  bucketFirst{0};
+    const auto     recordRun{[&](const std::uint32_t runLast) {
+        const auto &material{m_materials[runMaterial]};
+        item.m_textures[0]     = &material.m_atlas->get_texture();
+        item.m_state.m_blend   = material.m_blend;
+        item.m_instanceCount   = static_cast<int>(runLast - runFirst);
+        item.m_baseInstance    = baseInstance + runFirst;
+        commands.draw(sortKey, item);
+        ++m_stats.m_drawCount;
+    }};
+    for (std::uint32_t bucket{0}; bucket < bucketCount; ++bucket)
+    {
+        const auto bucketLast{m_bucketOffsets[bucket]};
+        if (bucketLast == bucketFirst)
+            continue;
+
+        const auto material{bucket % materialCount};
+        if (bucketFirst != runFirst && material != runMaterial)
+        {
+            recordRun(bucketFirst);
+            runFirst = bucketFirst;
+        }
+        runMaterial = material;
+        bucketFirst = bucketLast;
+    }
+    recordRun(bucketFirst);
+
+    m_stats.m_spriteCount = spriteCount;
+}
+
+const bEngine::bEngineSpriteStats bEngine::bEngineSpriteBatch::get_stats() const
+{
+    return m_stats;
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineStateArena.h"
+
+/// @file bEngineStateArena.cpp
+/// @brief implementations for the bEngineStateArena.h file
+
+#include "bEngineMemory.h"    // for page/NUMA aware allocation of the arena
+#include "bEngineUtilities.h" // for access to assertions and info messages
+
+#include <cstring> // for memcpy, which is the whole point of the arena
+#include <format>  // for formatting info/assertion messages
+#include <limits>  // for checking the arena and its snapshots fit in memory
+
+void bEngine::bEngineStateArena::PageDeleter::operator()(std::byte *const memory) const
+{
+    Memory::free_pages(memory, m_size);
+}
+
+const std::size_t bEngine::bEngineStateArena::get_checked_capacity(
+    const std::size_t  capacity,
+    const unsigned int snapshotCount)
+{
+    // checked before the arena's members are initialized, since they're allocated from these
+    bENGINE_ASSERT(snapshotCount > 0, "A state arena must keep at least one snapshot!");
+    bENGINE_ASSERT(capacity > 0, "A state arena must be able to hold at least one byte!");
+    bENGINE_ASSERT(
+        capacity <= std::numeric_limits<std::size_t>::max() / (std::size_t{snapshotCount} + 1) - s_alignment,
+        "A state arena and its snapshots must fit in memory!");
+    return (capacity + s_alignment - 1) & ~(s_alignment - 1);
+}
+
+bEngine::bEngineStateArena::bEngineStateArena(
+    const std::size_t  capacity,
+    const unsigned int snapshotCount,
+    const int          numaNode,
+    const bool         useLargePages)
+    : m_capacity{get_checked_capacity(capacity, snapshotCount)},
+      m_snapshotCount{snapshotCount},
+      m_memory{
+          static_cast<std::byte *>(Memory::allocate_pages(m_capacity, numaNode, useLargePages)),
+          PageDeleter{m_capacity}},
+      m_snapshotMemory{
+          static_cast<std::byte *>(Memory::allocate_pages(m_capacity * m_snapshotCount, numaNode, useLargePages)),
+          PageDeleter{m_capacity * m_snapshotCount}},
+      m_snapshots(snapshotCount)
+{
+    bENGINE_ASSERT(m_memory && m_snapshotMemory, "Failed to allocate the state arena's memory!");
+    INFO_MSG(std::format(
+        "Created a {} byte state arena with {} snapshots ({} bytes total)",
+        m_capacity,
+        m_snapshotCount,
+        m_capacity * (m_snapshotCount + 1)));
+}
+
+void *const bEngine::bEngineStateArena::allocate(const std::size_t size, const std::size_t alignment)
+{
+    bENGINE_ASSERT(
+        alignment && (alignment & (alignment - 1)) == 0 && alignment <= s_alignment,
+        "State arena allocations must have a power of two alignment no larger than 64 bytes!");
+
+    const auto offset{(m_usedBytes + alignment - 1) & ~(alignment - 1)};
+    bENGINE_ASSERT(offset + size <= m_capacity, "The state arena is out of memory!");
+
+    m_usedBytes = offset + size;
+    return m_memory.get() + offset;
+}
+
+void bEngine::bEngineStateArena::save_snapshot(const unsigned long long tick)
+{
+    auto &record{m_snapshots[tick % m_snapshotCount]};
+    record.m_tick      = tick;
+    record.m_usedBytes = m_usedBytes;
+    record.m_isValid   = true;
+
+    std::memcpy(m_snapshotMemory.get() + (tick % m_snapshotCount) * m_capacity, m_memory.get(), m_usedBytes);
+}
+
+const bool bEngine::bEngineStateArena::has_snapshot(const unsigned long long tick) const
+{
+    const auto &record{m_snapshots[tick % m_snapshotCount]};
+    return record.m_isValid && record.m_tick == tick;
+}
+
+const bool bEngine::bEngineStateArena::restore_snapshot(const unsigned long long tick)
+{
+    if (!has_snapshot(tick))
+        return false;
+
+    m_usedBytes = m_snapshots[tick % m_snapshotCount].m_usedBytes;
+    std::memcpy(m_memory.get(), m_snapshotMemory.get() + (tick % m_snapshotCount) * m_capacity, m_usedBytes);
+    return true;
+}
+
+const std::size_t bEngine::bEngineStateArena::get_capacity() const
+{
+    return m_capacity;
+}
+
+const std::size_t bEngine::bEngineStateArena::get_used_bytes() const
+{
+    return m_usedBytes;
+}
+
+const unsigned int bEngine::bEngineStateArena::get_snapshot_count() const
+{
+    return m_snapshotCount;
+}
\ No newline at end of file
@@ -0,0 +1,394 @@
+#include "bEnginePCH.h" // include first since we're utilizing the PCH
+
+#include "bEngineText.h"
+
+/// @file bEngineText.cpp
+/// @brief implementations for the bEngineText.h file
+
+#include "bEngineFlatMap.h"      // for the shaping cache
+#include "bEngineGLContext.h"    // for the current context's limits
+#include "bEngineGLGlyphAtlas.h" // for the glyph atlas
+#include "bEngineUtilities.h"    // for access to assertions and warnings
+
+#include <glm\gtc\packing.hpp>  // for packing glyph quads
+#include <glm\gtc\type_ptr.hpp> // for copying the view projection
+
+#include <algorithm> // for measuring the widest line
+#include <cmath>     // for snapping coverage glyphs to whole pixels
+#include <cstring>   // for building cache keys and writing quads into mapped memory
+#include <format>    // for formatting warnings
+#include <string>    // for the shaping cache's keys
+
+namespace
+{
+    /// @brief a glyph as the text program reads it (one instance of a quad)
+    struct GlyphQuad
+    {
+        /// @brief the position of the quad's top left corner
+        float m_position[2];
+
+        /// @brief the width and height of the quad
+        float m_size[2];
+
+        /// @brief the glyph's rectangle in its page (16 bit unorm min u, min v, max u, max v)
+        std::uint16_t m_uvRect[4];
+
+        /// @brief the atlas page the glyph is on
+        std::uint16_t m_page;
+
+        /// @brief how the glyph was rasterized (a bEngineGlyphMode)
+        std::uint16_t m_mode;
+
+        /// @brief the glyph's color (8 bit unorm RGBA)
+        std::uint32_t m_color;
+    };
+    static_assert(sizeof(GlyphQuad) == 32, "glyph quads must match the vertex array's layout");
+
+    /// @brief a glyph of a shaped string
+    struct ShapedGlyph
+    {
+        /// @brief the index of the glyph in its font
+        std::uint32_t m_glyph{0};
+
+        /// @brief the pen position of the glyph, relative to the string's
+        glm::vec2 m_position{0.0f};
+    };
+
+    /// @brief the vertex shader, which expands each instance into a quad from gl_VertexID
+    constexpr const char *s_vertexShader{R"(#version 460 core
+layout(location = 0) in vec2 a_position;
+layout(location = 1) in vec2 a_size;
+layout(location = 2) in vec4 a_uvRect;
+layout(location = 3) in uint a_page;
+layout(location = 4) in uint a_mode;
+layout(location = 5) in vec4 a_color;
+
+layout(std140, binding = 0) uniform Text
+{
+    mat4 u_viewProjection;
+};
+
+out vec3 v_uv;
+flat out uint v_mode;
+out vec4 v_color;
+
+void main()
+{
+    // the triangle strip's corners are (0, 0), (1, 0), (0, 1), (1, 1), with y down like the glyphs' rows
+    const vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+
+    gl_Position = u_viewProjection * vec4(a_position + corner * a_size, 0.0, 1.0);
+    v_uv        = vec3(mix(a_uvRect.xy, a_uvRect.zw, corner), float(a_page));
+    v_mode      = a_mode;
+    v_color     = a_color;
+}
+)"};
+
+    /// @brief the fragment shader, which turns coverage (or a distance field) into the glyph's alpha
+    constexpr const char *s_fragmentShader{R"(#version 460 core
+layout(binding = 0) uniform sampler2DArray u_atlas;
+
+in vec3 v_uv;
+flat in uint v_mode;
+in vec4 v_color;
+
+out vec4 o_color;
+
+void main()
+{
+    const float value = texture(u_atlas, v_uv).r;
+
+    // distance fields are 0.5 on the edge; the edge is antialiased over about a pixel at any scale
+    float alpha = value;
+    if (v_mode == 1u)
+    {
+        const float width = max(fwidth(value) * 0.75, 1e-4);
+        alpha             = smoothstep(0.5 - width, 0.5 + width, value);
+    }
+    o_color = vec4(v_color.rgb, v_color.a * alpha);
+}
+)"};
+
+    /// @brief decodes the next codepoint of a UTF-8 string
+    /// @param text the string
+    /// @param index the index of the codepoint's first byte, which is advanced past it
+    /// @return the codepoint, or U+FFFD if the bytes aren't valid UTF-8
+    const char32_t decode_utf8(const std::string_view text, std::size_t &index)
+    {
+        const auto lead{static_cast<unsigned char>(text[index++])};
+        if (lead < 0x80)
+            return lead;
+
+        const auto length{lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0};
+        if (length == 0 || lead >= 0xF8)
+            return U'\uFFFD';
+
+        char32_t codepoint{static_cast<char32_t>(lead & (0x3F >> length))};
+        for (int continuation{0}; continuation < length; ++continuation)
+        {
+            if (index >= text.size() || (static_cast<unsigned char>(text[index]) & 0xC0) != 0x80)
+                return U'\uFFFD';
+            codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[index++]) & 0x3F);
+        }
+        return codepoint;
+    }
+} // namespace
+
+/// @brief a shaped string: its glyphs and their positions
+struct bEngine::bEngineTextRenderer::ShapedText
+{
+    /// @brief the string's glyphs
+    std::vector<ShapedGlyph> m_glyphs;
+
+    /// @brief the width of the string's widest line and the distance from its first baseline to its last
+    glm::vec2 m_extent{0.0f};
+
+    /// @brief the frame the string was last drawn or measured in
+    unsigned long long m_lastUsedFrame{0};
+};
+
+/// @brief the strings shaped by the renderer, by font, size and content
+struct bEngine::bEngineTextRenderer::ShapingCache
+{
+    /// @brief the shaped strings, keyed by the bytes of their font ID and size followed by their content
+    bEngineFlatMap<std::string, ShapedText> m_texts;
+
+    /// @brief the key of the string being looked up, reused for every string
+    std::string m_key;
+
+    /// @brief the number of shaped strings kept before unused ones are evicted
+    std::size_t m_capacity{0};
+
+    /// @brief the current frame
+    unsigned long long m_frame{1};
+};
+
+bEngine::bEngineTextRenderer::bEngineTextRenderer(
+    bEngineGLStreamBuffer &streamBuffer,
+    const int              pageSize,
+    const int              pageCount,
+    const std::size_t      shapingCapacity)
+    : m_streamBuffer{&streamBuffer},
+      m_program{{GL_VERTEX_SHADER, s_vertexShader}, {GL_FRAGMENT_SHADER, s_fragmentShader}},
+      m_vertexArray{bEngineGLVertexArray::create_vertex_array()},
+      m_atlas{std::make_unique<GL::GlyphAtlas>(pageSize, pageCount)},
+      m_shaping{std::make_unique<ShapingCache>()}
+{
+    bENGINE_ASSERT(
+        m_streamBuffer->get_region_size() % sizeof(GlyphQuad) == 0,
+        "A text renderer's stream buffer regions must be a multiple of the glyph quad size!");
+    m_shaping->m_capacity = shapingCapacity;
+
+    GLint alignment{0};
+    GL::require_current_context().m_gl.GetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    m_uniformAlignment = alignment;
+
+    // quads are read from the start of the stream buffer, and the draw offsets them with its base instance
+    m_vertexArray.set_vertex_buffer(0, m_streamBuffer->get_buffer(), 0, sizeof(GlyphQuad));
+    m_vertexArray.set_binding_divisor(0, 1);
+    m_vertexArray.set_attribute(0, 0, 2, GL_FLOAT, false, offsetof(GlyphQuad, m_position));
+    m_vertexArray.set_attribute(1, 0, 2, GL_FLOAT, false, offsetof(GlyphQuad, m_size));
+    m_vertexArray.set_attribute(2, 0, 4, GL_UNSIGNED_SHORT, true, offsetof(GlyphQuad, m_uvRect));
+    m_vertexArray.set_integer_attribute(3, 0, 1, GL_UNSIGNED_SHORT, offsetof(GlyphQuad, m_page));
+    m_vertexArray.set_integer_attribute(4, 0, 1, GL_UNSIGNED_SHORT, offsetof(GlyphQuad, m_mode));
+    m_vertexArray.set_attribute(5, 0, 4, GL_UNSIGNED_BYTE, true, offsetof(GlyphQuad, m_color));
+}
+
+bEngine::bEngineTextRenderer::~bEngineTextRenderer() = default;
+
+const std::uint16_t bEngine::bEngineTextRenderer::add_font(std::unique_ptr<bEngineFontRasterizer> rasterizer)
+{
+    bENGINE_ASSERT(rasterizer, "A font needs a rasterizer!");
+    bENGINE_ASSERT(m_fonts.size() < 0xFFFF, "A text renderer can't have any more fonts!");
+
+    m_fonts.push_back(std::move(rasterizer));
+    return static_cast<std::uint16_t>(m_fonts.size() - 1);
+}
+
+const bEngine::bEngineFontMetrics bEngine::bEngineTextRenderer::get_metrics(
+    const std::uint16_t font,
+    const float         pixelSize) const
+{
+    bENGINE_ASSERT(font < m_fonts.size(), "Text refers to a font the renderer doesn't have!");
+    return m_fonts[font]->get_metrics(pixelSize);
+}
+
+void bEngine::bEngineTextRenderer::begin()
+{
+    m_quads.clear();
+    m_stats = {};
+    m_atlas->begin_frame();
+
+    // once the cache is over capacity, strings which weren't drawn (or measured) by the last frame are evicted
+    auto &texts{m_shaping->m_texts};
+    if (texts.size() > m_shaping->m_capacity)
+    {
+        for (auto text{texts.begin()}; text != texts.end();)
+        {
+            const auto current{text++};
+            if (current->second.m_lastUsedFrame < m_shaping->m_frame)
+                texts.erase(current);
+        }
+    }
+    ++m_shaping->m_frame;
+}
+
+const glm::vec2 bEngine::bEngineTextRenderer::measure_text(
+    const std::uint16_t    font,
+    const std::string_view text,
+    const float            pixelSize)
+{
+    return shape_text(font, text, pixelSize).m_extent;
+}
+
+void bEngine::bEngineTextRenderer::add_text(
+    const std::uint16_t    font,
+    const std::string_view text,
+    const glm::vec2       &position,
+    const float            pixelSize,
+    const glm::vec4       &color,
+    const bEngineGlyphMode mode)
+{
+    const auto &shaped{shape_text(font, text, pixelSize)};
+    const auto &rasterizer{*m_fonts[font]};
+
+    // distance field glyphs are scaled from the size they were rasterized at; coverage glyphs are drawn 1:1, snapped
+    // to whole pixels so they stay sharp
+    const auto isDistanceField{mode == bEngineGlyphMode::DistanceField};
+    const auto scale{isDistanceField ? pixelSize / GL::GlyphAtlas::s_distanceFieldSize : 1.0f};
+    const auto packedColor{glm::packUnorm4x8(color)};
+    for (const auto &shapedGlyph : shaped.m_glyphs)
+    {
+        const auto *const glyph{m_atlas->get_glyph(font, rasterizer, shapedGlyph.m_glyph, pixelSize, mode, m_stats)};
+        if (!glyph)
+        {
+            ++m_stats.m_droppedGlyphs;
+            continue;
+        }
+        if (glyph->m_isEmpty)
+            continue;
+
+        auto topLeft{position + shapedGlyph.m_position + glyph->m_offset * scale};
+        if (!isDistanceField)
+            topLeft = glm::round(topLeft);
+        const auto size{glyph->m_size * scale};
+        const auto uvRect{glm::packUnorm4x16(glyph->m_uvRect)};
+
+        GlyphQuad quad{};
+        quad.m_position[0] = topLeft.x;
+        quad.m_position[1] = topLeft.y;
+        quad.m_size[0]     = size.x;
+        quad.m_size[1]     = size.y;
+        std::memcpy(quad.m_uvRect, &uvRect, sizeof(quad.m_uvRect));
+        quad.m_page  = glyph->m_page;
+        quad.m_mode  = static_cast<std::uint16_t>(mode);
+        quad.m_color = packedColor;
+
+        const auto offset{m_quads.size()};
+        m_quads.resize(offset + sizeof(quad));
+        std::memcpy(m_quads.data() + offset, &quad, sizeof(quad));
+    }
+}
+
+void bEngine::bEngineTextRenderer::record(
+    bEngineCommandBuffer       &commands,
+    const std::uint64_t         sortKey,
+    const glm::mat4            &viewProjection,
+    const bEngineGLFramebuffer *framebuffer,
+    const bEngineViewport      &viewport)
+{
+    m_lastStats = m_stats;
+    if (m_quads.empty())
+        return;
+
+    const auto quadCount{static_cast<std::uint32_t>(m_quads.size() / sizeof(GlyphQuad))};
+    auto       quads{m_streamBuffer->allocate(static_cast<std::ptrdiff_t>(m_quads.size()), sizeof(GlyphQuad))};
+    auto       uniforms{m_streamBuffer->allocate(sizeof(glm::mat4), m_uniformAlignment)};
+    if (!quads.m_data || !uniforms.m_data)
+    {
+        WARNING_MSG(std::format("Not enough stream buffer space left this frame for {} glyphs!", quadCount));
+        m_lastStats.m_droppedGlyphs += quadCount;
+        return;
+    }
+    std::memcpy(quads.m_data, m_quads.data(), m_quads.size());
+    std::memcpy(uniforms.m_data, glm::value_ptr(viewProjection), sizeof(glm::mat4));
+
+    // every page is a layer of the same texture and both modes share the program, so one draw covers all the text
+    bEngineDrawItem item{};
+    item.m_program       = &m_program;
+    item.m_vertexArray   = &m_vertexArray;
+    item.m_framebuffer   = framebuffer;
+    item.m_viewport      = viewport;
+    item.m_textures[0]   = &m_atlas->get_texture();
+    item.m_uniformBuffer = &m_streamBuffer->get_buffer();
+    item.m_uniformOffset = uniforms.m_offset;
+    item.m_uniformSize   = uniforms.m_size;
+    item.m_mode          = GL_TRIANGLE_STRIP;
+    item.m_count         = 4;
+    item.m_instanceCount = static_cast<int>(quadCount);
+    item.m_baseInstance  = static_cast<std::uint32_t>(quads.m_offset / sizeof(GlyphQuad));
+    item.m_state.m_blend = bEngineBlendMode::Alpha;
+    item.m_state.m_depth = bEngineDepthMode::Disabled;
+    item.m_state.m_cull  = bEngineCullMode::None;
+    commands.draw(sortKey, item);
+
+    m_lastStats.m_glyphCount = quadCount;
+    m_lastStats.m_drawCount  = 1;
+}
+
+const bEngine::bEngineTextStats bEngine::bEngineTextRenderer::get_stats() const
+{
+    return m_lastStats;
+}
+
+const bEngine::bEngineTextRenderer::ShapedText &bEngine::bEngineTextRenderer::shape_text(
+    const std::uint16_t    font,
+    const std::string_view text,
+    const float            pixelSize)
+{
+    bENGINE_ASSERT(font < m_fonts.size(), "Text refers to a font the renderer doesn't have!");
+
+    auto &key{m_shaping->m_key};
+    key.resize(sizeof(font) + sizeof(pixelSize));
+    std::memcpy(key.data(), &font, sizeof(font));
+    std::memcpy(key.data() + sizeof(font), &pixelSize, sizeof(pixelSize));
+    key.append(text);
+    if (auto found{m_shaping->m_texts.find(key)}; found != m_shaping->m_texts.end())
+    {
+        ++m_stats.m_shapingHits;
+        found->second.m_lastUsedFrame = m_shaping->m_frame;
+        return found->second;
+    }
+    ++m_stats.m_shapingMisses;
+
+    // glyphs are laid out along the baseline with their advances and kerning; lines move down by the line height
+    const auto   &rasterizer{*m_fonts[font]};
+    const auto    metrics{rasterizer.get_metrics(pixelSize)};
+    const auto    lineHeight{metrics.m_ascent + metrics.m_descent + metrics.m_lineGap};
+    ShapedText    shaped{};
+    glm::vec2     pen{0.0f};
+    auto          hasPrevious{false};
+    std::uint32_t previous{0};
+    for (std::size_t index{0}; index < text.size();)
+    {
+        const auto codepoint{decode_utf8(text, index)};
+        if (codepoint == U'\n')
+        {
+            shaped.m_extent.x = std::max(shaped.m_extent.x, pen.x);
+            pen               = {0.0f, pen.y + lineHeight};
+            hasPrevious       = false;
+            continue;
+        }
+
+        const auto glyph{rasterizer.get_glyph_index(codepoint)};
+        if (hasPrevious)
+            pen.x += rasterizer.get_kerning(previous, glyph, pixelSize);
+        shaped.m_glyphs.push_back({glyph, pen});
+        pen.x       += rasterizer.get_advance(glyph, pixelSize);
+        previous     = glyph;
+        hasPrevious  = true;
+    }
+    shaped.m_extent        = {std::max(shaped.m_extent.x, pen.x), pen.y};
+    shaped.m_lastUsedFrame = m_shaping->m_frame;
+    return m_shaping->m_texts.insert_or_assign(key, std::move(shaped)).first->second;
+}
\ No newline at end of file
@@ -5,9 +5,20 @@
 /// @file bEngineWindow.cpp
 /// @brief implementations for the bEngineWindow.h file
 
-#include "bEngineUtilities.h" // for access to info messaging, etc.
+#include "bEngineCommandBuffer.h"       // for the command buffers the window executes
+#include "bEngineDebugDraw.h"           // for drawing debug geometry on top of the window
+#include "bEngineGL.h"                  // for the offscreen framebuffer backing a headless window
+#include "bEngineGLContext.h"           // each window owns a GL context
+#include "bEngineGLDebugDraw.h"         // for drawing debug geometry on top of the window
+#include "bEngineGLDynamicResolution.h" // for rendering the window at a dynamic resolution
+#include "bEngineGLFrameCapture.h"      // for capturing the window's frames
+#include "bEnginePlatform.h"            // for whether windows are headless
+#include "bEngineUtilities.h"           // for access to info messaging, etc.
 
-#include <format> // for formatting info messages, etc.
+#include <algorithm> // for tracking the longest present
+#include <chrono>    // for timing renders and presents
+#include <format>    // for formatting info messages, etc.
+#include <memory>    // for sharing the root context between windows
 
 #pragma region PLATFORM_IMPLEMENTATIONS
 
@@ -16,14 +27,24 @@
 
 #    include <GLFW\glfw3.h> // the PlatformWindowImpl holds a GLFWWindow*, using GLFW for window management
 
-struct bEngine::bEngineWindow::PlatformWindowImpl
+namespace
 {
-    /// @brief helper function which creates a GLFW window with the appropriate window hints and the desired size/title
-    /// @param width the desired width of the window (in pixels)
-    /// @param height the desired height of the window (in pixels)
-    /// @param title the desired title for the window
-    /// @return the GLFWwindow* associated with the new window
-    static GLFWwindow *const create_glfw_window_with_hints(const int width, const int height, const char *const title)
+    /// @brief the GLFW window whose context is current on this thread (as far as the window layer knows), so making an
+    /// already current context current again can be skipped
+    thread_local GLFWwindow *s_currentWindow{nullptr};
+
+    /// @brief the weight of the newest sample in the present statistics' moving averages
+    constexpr double s_presentAverageWeight{0.1};
+
+    /// @brief how long a window's size has to stay unchanged before a resize is considered finished, in seconds
+    constexpr double s_resizeSettleSeconds{0.2};
+
+    /// @brief how much larger than the window render targets are allocated while it's being resized, so growing the
+    /// window by dragging it doesn't reallocate them every frame
+    constexpr double s_resizeHeadroom{1.25};
+
+    /// @brief sets the context hints every GLFW window (hidden or not) is created with, so their contexts can share
+    void set_context_hints()
     {
         // only set the debug context to true in debug mode
 #    ifdef DEBUG
@@ -35,29 +56,513 @@ struct bEngine::bEngineWindow::PlatformWindowImpl
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-        // for now, we do NOT want windows to be (freely) resizable BUT this is likely to change in the future!
-        glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+        // headless windows (on glfw's null platform) need a context API which works without a display
+        switch (bEngine::Platform::get_window_backend())
+        {
+        case bEngine::Platform::WindowBackend::Native:
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_NATIVE_CONTEXT_API);
+            break;
+        case bEngine::Platform::WindowBackend::HeadlessOSMesa:
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+            break;
+        case bEngine::Platform::WindowBackend::HeadlessEGL:
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+            break;
+        }
+    }
+
+    /// @brief creates a hidden GLFW window, which exists only for its context
+    /// @param sharedWindow the window whose context the new context shares objects with, or nullptr for none
+    /// @return the GLFWwindow* associated with the new window, or nullptr if it couldn't be created
+    GLFWwindow *const create_hidden_window(GLFWwindow *const sharedWindow)
+    {
+        set_context_hints();
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        auto *const hiddenWindow{glfwCreateWindow(1, 1, "", nullptr, sharedWindow)};
+        glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+        return hiddenWindow;
+    }
+
+    /// @brief the root of the context group every window's context joins: a hidden window whose context is never made
+    /// current (it only anchors the group, so objects outlive the window which created them), the group itself, and
+    /// the hidden window the group's compile thread uses (if it has one); lives as long as any window does
+    struct RootContext
+    {
+        /// @brief the hidden GLFWwindow* whose context every window's context shares objects with
+        GLFWwindow *const m_rootWindow{nullptr};
+
+        /// @brief the hidden GLFWwindow* whose context the compile thread builds programs on, or nullptr if there's no
+        /// compile thread
+        GLFWwindow *m_compileWindow{nullptr};
+
+        /// @brief the library's state for the group
+        bEngine::GL::ContextGroup m_group;
+
+        /// @brief ctor which creates the root window
+        RootContext()
+            : m_rootWindow{create_hidden_window(nullptr)}
+        {
+            bENGINE_ASSERT(m_rootWindow, "Failed to create the root GL context (is GL 4.6 supported?)");
+        };
+
+        /// @brief the root can't be copied
+        RootContext(const RootContext &) = delete;
+
+        /// @brief the root can't be copied
+        RootContext &operator=(const RootContext &) = delete;
 
-        return glfwCreateWindow(width, height, title, nullptr, nullptr);
+        /// @brief dtor stops the compile thread, then destroys the hidden windows
+        ~RootContext()
+        {
+            m_group.m_shaderCompiler.reset();
+            if (m_compileWindow)
+                glfwDestroyWindow(m_compileWindow);
+            glfwDestroyWindow(m_rootWindow);
+        };
+
+        /// @brief starts the compile thread (if it isn't running), for drivers without parallel shader compile;
+        /// programs are built synchronously if the compile thread's context can't be created
+        void start_compile_thread()
+        {
+            if (m_group.m_shaderCompiler)
+                return;
+
+            m_compileWindow = create_hidden_window(m_rootWindow);
+            if (!m_compileWindow)
+            {
+                WARNING_MSG("Failed to create the compile thread's context; programs are built synchronously.");
+                return;
+            }
+
+            auto *const compileWindow{m_compileWindow};
+            m_group.m_shaderCompiler = std::make_unique<bEngine::GL::ShaderCompiler>(
+                [compileWindow](const bool isCurrent) { glfwMakeContextCurrent(isCurrent ? compileWindow : nullptr); },
+                glfwGetProcAddress);
+            INFO_MSG("Building programs on a compile thread.");
+        };
+    };
+
+    /// @brief the root every window shares; expires once the last window is destroyed
+    std::weak_ptr<RootContext> s_rootContext;
+
+    /// @brief gets the root every window shares, creating it for the first window
+    /// @return the (shared) root
+    std::shared_ptr<RootContext> acquire_root_context()
+    {
+        auto rootContext{s_rootContext.lock()};
+        if (!rootContext)
+        {
+            rootContext   = std::make_shared<RootContext>();
+            s_rootContext = rootContext;
+        }
+        return rootContext;
     }
+} // namespace
+
+struct bEngine::bEngineWindow::PlatformWindowImpl
+{
+    /// @brief helper function which creates a GLFW window with the appropriate window hints and the desired size/title
+    /// @param width the desired width of the window (in pixels)
+    /// @param height the desired height of the window (in pixels)
+    /// @param title the desired title for the window
+    /// @param sharedWindow the window whose context the new window's context shares objects with
+    /// @return the GLFWwindow* associated with the new window
+    static GLFWwindow *const create_glfw_window_with_hints(
+        const int         width,
+        const int         height,
+        const char *const title,
+        GLFWwindow *const sharedWindow)
+    {
+        set_context_hints();
+
+        // windows are freely resizable; size changes are picked up (and debounced) as each frame begins
+        glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+
+        return glfwCreateWindow(width, height, title, nullptr, sharedWindow);
+    }
+
+    /// @brief the root of the context group the window's context joins; declared first so it outlives the window
+    const std::shared_ptr<RootContext> m_rootContext{nullptr};
 
     /// @brief the GLFWWindow* associated with this PlatformWindowImpl
     GLFWwindow *const m_glfwWindow{nullptr};
 
+    /// @brief the library's state for the window's GL context (glad's function table, deletion queue, etc.)
+    GL::Context m_context;
+
+    /// @brief the color attachment of the offscreen framebuffer backing a headless window
+    bEngineGLTexture m_offscreenColor{};
+
+    /// @brief the depth/stencil attachment of the offscreen framebuffer backing a headless window
+    bEngineGLTexture m_offscreenDepth{};
+
+    /// @brief the offscreen framebuffer backing a headless window (which is empty for a native window)
+    bEngineGLFramebuffer m_offscreenFramebuffer{};
+
+    /// @brief the size the window's size-dependent render targets are allocated with
+    bEngineRenderTargetSize m_targetSize{};
+
+    /// @brief true while the window's size has changed but the render targets haven't settled at it yet
+    bool m_isResizePending{false};
+
+    /// @brief when the window's size last changed
+    std::chrono::steady_clock::time_point m_lastResize{};
+
+    /// @brief the window's dynamic resolution, if enabled
+    std::unique_ptr<GL::DynamicResolution> m_dynamicResolution{nullptr};
+
+    /// @brief the capture of the window's frames in progress, if any
+    std::unique_ptr<GL::FrameCapture> m_capture{nullptr};
+
+    /// @brief the statistics of the last capture which was stopped
+    bEngineCaptureStats m_captureStats{};
+
+#    ifdef DEBUG
+    /// @brief the renderer drawing debug geometry on top of the window, created the first time there's any to draw
+    std::unique_ptr<GL::DebugDrawRenderer> m_debugDraw{nullptr};
+#    endif // DEBUG
+
+    /// @brief true if the driver supports adaptive sync (negative swap intervals)
+    bool m_hasAdaptiveSync{false};
+
+    /// @brief the swap interval currently set on the window's context
+    int m_swapInterval{1};
+
+    /// @brief the timing instrumentation of the window's presents
+    bEnginePresentStats m_presentStats{};
+
+    /// @brief when the window last presented
+    std::chrono::steady_clock::time_point m_lastPresent{};
+
     /// @brief default ctor is insufficient
     PlatformWindowImpl() = delete;
 
     /// @brief ctor which takes the necessary arguments to actually construct a PlatformWindowImpl
     ///
-    /// creates a GLFWwindow and stores the pointer to the window
+    /// creates a GLFWwindow (whose context shares objects with every other window's) and stores the pointer to the
+    /// window
     /// @param width the desired width of the window (in pixels)
     /// @param height the desired height of the window (in pixels)
     /// @param title the desired title of the window
     PlatformWindowImpl(const int width, const int height, const char *const title)
-        : m_glfwWindow{create_glfw_window_with_hints(width, height, title)} { };
+        : m_rootContext{acquire_root_context()},
+          m_glfwWindow{create_glfw_window_with_hints(width, height, title, m_rootContext->m_rootWindow)},
+          m_targetSize{width, height}
+    {
+        bENGINE_ASSERT(m_glfwWindow, "Failed to create a window (is GL 4.6 supported?)");
+
+        // glad is loaded per-context, so each window loads its own function table
+        glfwMakeContextCurrent(m_glfwWindow);
+        s_currentWindow = m_glfwWindow;
+        bENGINE_ASSERT(
+            gladLoadGLContext(&m_context.m_gl, glfwGetProcAddress),
+            "Failed to load the GL functions for a window's context!");
+        GL::set_current_context(&m_context);
+        GL::join_group(m_context, m_rootContext->m_group);
+        GL::load_extensions(m_context, glfwGetProcAddress);
+
+        // without parallel shader compile programs are built on the group's compile thread
+        if (!m_context.m_hasParallelShaderCompile)
+            m_rootContext->start_compile_thread();
+
+        // a headless window renders into a framebuffer of exactly its requested size, so the results don't depend on
+        // whatever the context API provides
+        if (Platform::get_window_backend() != Platform::WindowBackend::Native)
+        {
+            create_offscreen_framebuffer();
+            INFO_MSG(std::format("Rendering a headless window into a {}x{} offscreen framebuffer.", width, height));
+        }
+
+        // the driver's default swap interval varies, so it's set explicitly
+        m_hasAdaptiveSync =
+            glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear");
+        glfwSwapInterval(m_swapInterval);
+    };
+
+    /// @brief dtor releases the window's local GL objects and deletes any still waiting for deletion, then destroys
+    /// the GLFWwindow associated with this PlatformWindowImpl (and the root, if this was the last window)
+    ~PlatformWindowImpl()
+    {
+        make_current();
+#    ifdef DEBUG
+        m_debugDraw.reset();
+#    endif // DEBUG
+        m_capture.reset();
+        m_dynamicResolution.reset();
+        m_offscreenFramebuffer.reset();
+        m_offscreenColor.reset();
+        m_offscreenDepth.reset();
+        GL::leave_group(m_context);
+        GL::set_current_context(nullptr);
+        glfwMakeContextCurrent(nullptr);
+        s_currentWindow = nullptr;
+        glfwDestroyWindow(m_glfwWindow);
+    };
+
+    /// @brief (re)creates the offscreen framebuffer backing a headless window at the render target size; the
+    /// window's context must be current
+    void create_offscreen_framebuffer()
+    {
+        const auto width{m_targetSize.m_width};
+        const auto height{m_targetSize.m_height};
+        m_offscreenColor       = bEngineGLTexture{GL_TEXTURE_2D, 1, GL_RGBA8, width, height};
+        m_offscreenDepth       = bEngineGLTexture{GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, width, height};
+        m_offscreenFramebuffer = bEngineGLFramebuffer::create_framebuffer();
+        m_offscreenFramebuffer.attach_texture(GL_COLOR_ATTACHMENT0, m_offscreenColor);
+        m_offscreenFramebuffer.attach_texture(GL_DEPTH_STENCIL_ATTACHMENT, m_offscreenDepth);
+        bENGINE_ASSERT(
+            m_offscreenFramebuffer.get_is_complete(),
+            "Failed to create the offscreen framebuffer of a headless window!");
+        m_context.m_windowFramebuffer = m_offscreenFramebuffer.get_name();
+    };
+
+    /// @brief updates the window's size from its framebuffer's, and the render target size from the window's (see
+    /// bEngineRenderTargetSize), recreating the window's own render targets if need be; called once as each frame
+    /// begins, with the window's context current
+    /// @param size the window's size, which is updated in place
+    void update_size(int (&size)[2])
+    {
+        int width{0};
+        int height{0};
+        glfwGetFramebufferSize(m_glfwWindow, &width, &height);
+
+        const auto now{std::chrono::steady_clock::now()};
+        if (width != size[0] || height != size[1])
+        {
+            size[0]           = width;
+            size[1]           = height;
+            m_isResizePending = true;
+            m_lastResize      = now;
+        }
+
+        // a minimized window has no size, and keeps its render targets until it's restored
+        if (!m_isResizePending || width == 0 || height == 0)
+            return;
+
+        // render targets only shrink once the size has settled, and only grow (with headroom) while it hasn't
+        auto      &target{m_targetSize};
+        const auto generation{target.m_generation};
+        if (std::chrono::duration<double>(now - m_lastResize).count() >= s_resizeSettleSeconds)
+        {
+            m_isResizePending   = false;
+            target.m_isResizing = false;
+            if (width != target.m_width || height != target.m_height)
+            {
+                target.m_width  = width;
+                target.m_height = height;
+                ++target.m_generation;
+            }
+        }
+        else
+        {
+            target.m_isResizing = true;
+            if (width > target.m_width || height > target.m_height)
+            {
+                target.m_width  = std::max(target.m_width, static_cast<int>(width * s_resizeHeadroom));
+                target.m_height = std::max(target.m_height, static_cast<int>(height * s_resizeHeadroom));
+                ++target.m_generation;
+            }
+        }
+
+        if (target.m_generation != generation && m_offscreenFramebuffer.get_name() != 0)
+            create_offscreen_framebuffer();
+    };
+
+    /// @brief gets the size the window's size-dependent render targets are allocated with
+    /// @return the render target size
+    const bEngineRenderTargetSize &get_render_target_size() const { return m_targetSize; };
+
+#    ifdef DEBUG
+    /// @brief records the frame's debug geometry (if there's any) on top of the window; the window's context must be
+    /// current
+    /// @param commands the command buffer to record into
+    /// @param window the window (for its debug view projection)
+    /// @param viewportWidth the width of the viewport the window is rendered with, in pixels
+    /// @param viewportHeight the height of the viewport the window is rendered with, in pixels
+    void record_debug_draw(
+        bEngineCommandBuffer &commands,
+        const bEngineWindow  &window,
+        const int             viewportWidth,
+        const int             viewportHeight)
+    {
+        if (!GL::has_debug_draw())
+            return;
+
+        if (!m_debugDraw)
+            m_debugDraw = std::make_unique<GL::DebugDrawRenderer>();
+        m_debugDraw->record(commands, window, viewportWidth, viewportHeight);
+    };
+#    endif // DEBUG
+
+    /// @brief gets the library's state for the window's GL context
+    /// @return a reference to the window's context
+    GL::Context &get_context() { return m_context; };
+
+    /// @brief makes the window's context the current context of the calling thread, unless it already is
+    void make_current()
+    {
+        if (s_currentWindow != m_glfwWindow)
+        {
+            glfwMakeContextCurrent(m_glfwWindow);
+            s_currentWindow = m_glfwWindow;
+            ++m_presentStats.m_contextSwitches;
+        }
+        GL::set_current_context(&m_context);
+    };
 
-    /// @brief dtor destroys the GLFWwindow associated with this PlatformWindowImpl
-    ~PlatformWindowImpl() { glfwDestroyWindow(m_glfwWindow); };
+    /// @brief captures the rendered frame (if capturing) and presents it (timing the present), then deletes any
+    /// released GL objects the GPU is now done with; the window's context must be current
+    /// @param presentMode how the present is synchronized with the display
+    /// @param renderSeconds the CPU time spent recording and executing the frame's commands, in seconds
+    /// @param size the size of the rendered frame, in pixels
+    void present(const bEnginePresentMode presentMode, const double renderSeconds, const int (&size)[2])
+    {
+        if (m_capture)
+            m_capture->capture_frame(size[0], size[1]);
+
+        // the swap interval is context state, so it's only changed when the present mode does
+        int swapInterval{0};
+        switch (presentMode)
+        {
+        case bEnginePresentMode::Immediate:
+            swapInterval = 0;
+            break;
+        case bEnginePresentMode::VSync:
+            swapInterval = 1;
+            break;
+        case bEnginePresentMode::AdaptiveSync:
+            swapInterval = m_hasAdaptiveSync ? -1 : 1;
+            break;
+        }
+        if (swapInterval != m_swapInterval)
+        {
+            glfwSwapInterval(swapInterval);
+            m_swapInterval = swapInterval;
+        }
+
+        const auto presentStart{std::chrono::steady_clock::now()};
+        glfwSwapBuffers(m_glfwWindow);
+        const auto presentEnd{std::chrono::steady_clock::now()};
+
+        auto      &stats{m_presentStats};
+        const auto presentSeconds{std::chrono::duration<double>(presentEnd - presentStart).count()};
+        stats.m_lastRenderSeconds = renderSeconds;
+        stats.m_averageRenderSeconds += (renderSeconds - stats.m_averageRenderSeconds) * s_presentAverageWeight;
+        stats.m_lastPresentSeconds = presentSeconds;
+        stats.m_maxPresentSeconds  = std::max(stats.m_maxPresentSeconds, presentSeconds);
+        stats.m_averagePresentSeconds += (presentSeconds - stats.m_averagePresentSeconds) * s_presentAverageWeight;
+        if (stats.m_presentCount++ > 0)
+        {
+            const auto frameSeconds{std::chrono::duration<double>(presentEnd - m_lastPresent).count()};
+            stats.m_lastFrameSeconds = frameSeconds;
+            stats.m_averageFrameSeconds += (frameSeconds - stats.m_averageFrameSeconds) * s_presentAverageWeight;
+        }
+        m_lastPresent = presentEnd;
+
+        GL::end_frame(m_context);
+    };
+
+    /// @brief reads back the last presented frame; blocks until the GPU has finished it
+    /// @param width the width of the window (in pixels)
+    /// @param height the height of the window (in pixels)
+    /// @return the frame's pixels as tightly packed RGBA8, bottom row first
+    std::vector<unsigned char> read_pixels(const int width, const int height)
+    {
+        make_current();
+        const auto &gl{m_context.m_gl};
+
+        // a native window's last frame has been swapped to its front buffer, a headless window's stays in its
+        // offscreen framebuffer
+        if (m_context.m_windowFramebuffer == 0)
+            gl.NamedFramebufferReadBuffer(0, GL_FRONT);
+        m_context.m_stateCache.set_framebuffer(GL_READ_FRAMEBUFFER, m_context.m_windowFramebuffer);
+        m_context.m_stateCache.flush(gl);
+
+        // RGBA8 rows are always a multiple of the default pack alignment (4)
+        std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 4);
+        gl.ReadnPixels(
+            0,
+            0,
+            width,
+            height,
+            GL_RGBA,
+            GL_UNSIGNED_BYTE,
+            static_cast<GLsizei>(pixels.size()),
+            pixels.data());
+        return pixels;
+    };
+
+    /// @brief starts capturing the window's frames, replacing any capture in progress
+    /// @param settings the settings of the capture
+    /// @param width the width of the window (in pixels)
+    /// @param height the height of the window (in pixels)
+    /// @return true if the capture started, false if its output couldn't be opened
+    const bool start_capture(const bEngineCaptureSettings &settings, const int width, const int height)
+    {
+        stop_capture();
+        make_current();
+        auto capture{std::make_unique<GL::FrameCapture>(m_context, settings, width, height)};
+        if (!capture->get_is_open())
+            return false;
+
+        m_capture = std::move(capture);
+        return true;
+    };
+
+    /// @brief stops the capture in progress, if any, once every frame it has read back is written
+    void stop_capture()
+    {
+        if (!m_capture)
+            return;
+
+        make_current();
+        m_capture->finish();
+        m_captureStats = m_capture->get_stats();
+        m_capture.reset();
+    };
+
+    /// @brief gets the statistics of the capture in progress, or of the last capture if none is in progress
+    /// @return the capture statistics
+    const bEngineCaptureStats get_capture_stats() const
+    {
+        return m_capture ? m_capture->get_stats() : m_captureStats;
+    };
+
+    /// @brief enables (replacing any previous settings) or disables the window's dynamic resolution
+    /// @param settings the settings of the dynamic resolution
+    void set_dynamic_resolution(const bEngineDynamicResolutionSettings &settings)
+    {
+        make_current();
+        m_dynamicResolution.reset();
+        if (settings.m_isEnabled)
+            m_dynamicResolution = std::make_unique<GL::DynamicResolution>(m_context, settings);
+    };
+
+    /// @brief gets the window's dynamic resolution
+    /// @return the window's dynamic resolution, or nullptr if it's disabled
+    GL::DynamicResolution *const get_dynamic_resolution() { return m_dynamicResolution.get(); };
+
+    /// @brief gets the statistics of the window's dynamic resolution
+    /// @param size the window's size, in pixels, which frames are rendered at when dynamic resolution is disabled
+    /// @return the dynamic resolution statistics
+    const bEngineDynamicResolutionStats get_dynamic_resolution_stats(const int (&size)[2]) const
+    {
+        if (m_dynamicResolution)
+            return m_dynamicResolution->get_stats();
+
+        bEngineDynamicResolutionStats stats{};
+        stats.m_renderWidth  = size[0];
+        stats.m_renderHeight = size[1];
+        return stats;
+    };
+
+    /// @brief checks whether the driver supports adaptive sync
+    /// @return true if the AdaptiveSync present mode is supported, false if it falls back to VSync
+    const bool get_has_adaptive_sync() const { return m_hasAdaptiveSync; };
+
+    /// @brief gets the timing instrumentation of the window's presents
+    /// @return the window's present statistics
+    const bEnginePresentStats &get_present_stats() const { return m_presentStats; };
 
     /// @brief gets the window's "should close" state by calling the GLFW provided function
     ///
@@ -87,6 +592,9 @@ bEngine::bEngineWindow::bEngineWindow(
 
 bEngine::bEngineWindow::~bEngineWindow()
 {
+#ifdef DEBUG
+    GL::forget_debug_window(*this);
+#endif // DEBUG
     INFO_MSG(std::format("Destroyed Window #{}", m_windowID));
 }
 
@@ -99,6 +607,21 @@ std::unique_ptr<bEngine::bEngineWindow> bEngine::bEngineWindow::create_window(
     return std::make_unique<bEngine::bEngineWindow>(WindowToken{}, width, height, std::move(title), renderFn);
 }
 
+const int bEngine::bEngineWindow::get_width() const
+{
+    return m_size[0];
+}
+
+const int bEngine::bEngineWindow::get_height() const
+{
+    return m_size[1];
+}
+
+const bEngine::bEngineRenderTargetSize bEngine::bEngineWindow::get_render_target_size() const
+{
+    return m_impl->get_render_target_size();
+}
+
 const bool bEngine::bEngineWindow::get_should_close() const
 {
     return m_impl->get_should_close();
@@ -109,10 +632,122 @@ const unsigned int bEngine::bEngineWindow::get_window_ID() const
     return m_windowID;
 }
 
-void bEngine::bEngineWindow::render() const
+void bEngine::bEngineWindow::submit_commands(bEngineCommandBuffer &&commands) const
+{
+    m_impl->get_context().m_commandQueue.submit(std::move(commands));
+}
+
+void bEngine::bEngineWindow::set_present_mode(const bEnginePresentMode presentMode)
+{
+    if (presentMode == bEnginePresentMode::AdaptiveSync && !m_impl->get_has_adaptive_sync())
+    {
+        WARNING_MSG(std::format("Window #{} doesn't support adaptive sync; using vsync instead.", m_windowID));
+    }
+    m_presentMode = presentMode;
+}
+
+const bEngine::bEnginePresentMode bEngine::bEngineWindow::get_present_mode() const
 {
+    return m_presentMode;
+}
+
+const bEngine::bEnginePresentStats bEngine::bEngineWindow::get_present_stats() const
+{
+    return m_impl->get_present_stats();
+}
+
+void bEngine::bEngineWindow::render_windows(
+    std::span<const std::unique_ptr<bEngineWindow>> windows,
+    const bool                                      isPaced)
+{
+#ifdef DEBUG
+    // every window draws the same debug geometry, so it's collected once for all of them
+    GL::collect_debug_draw();
+#endif // DEBUG
+
+    for (std::size_t window{0}; window < windows.size(); ++window)
+        windows[window]->render_frame(isPaced && window + 1 < windows.size());
+}
+
+void bEngine::bEngineWindow::render()
+{
+#ifdef DEBUG
+    GL::collect_debug_draw();
+#endif // DEBUG
+    render_frame(false);
+}
+
+const std::vector<unsigned char> bEngine::bEngineWindow::read_pixels() const
+{
+    return m_impl->read_pixels(m_size[0], m_size[1]);
+}
+
+void bEngine::bEngineWindow::set_dynamic_resolution(const bEngineDynamicResolutionSettings &settings)
+{
+    m_impl->set_dynamic_resolution(settings);
+}
+
+const bEngine::bEngineDynamicResolutionStats bEngine::bEngineWindow::get_dynamic_resolution_stats() const
+{
+    return m_impl->get_dynamic_resolution_stats(m_size);
+}
+
+const bool bEngine::bEngineWindow::start_capture(const bEngineCaptureSettings &settings)
+{
+    const auto isStarted{m_impl->start_capture(settings, m_size[0], m_size[1])};
+    if (isStarted)
+    {
+        INFO_MSG(std::format("Window #{} started capturing to \"{}\".", m_windowID, settings.m_path.string()));
+    }
+    return isStarted;
+}
+
+void bEngine::bEngineWindow::stop_capture()
+{
+    m_impl->stop_capture();
+}
+
+const bEngine::bEngineCaptureStats bEngine::bEngineWindow::get_capture_stats() const
+{
+    return m_impl->get_capture_stats();
+}
+
+void bEngine::bEngineWindow::render_frame(const bool isPresentImmediate)
+{
+    const auto renderStart{std::chrono::steady_clock::now()};
+    m_impl->make_current();
+    auto &context{m_impl->get_context()};
+    GL::begin_frame(context);
+    m_impl->update_size(m_size);
+
+    // every render starts out drawing to the whole window (which, mid-resize, may be part of an oversized target), or
+    // to the scaled part of the dynamic resolution target
+    auto *const dynamicResolution{m_impl->get_dynamic_resolution()};
+    int         viewport[2]{m_size[0], m_size[1]};
+    if (dynamicResolution)
+    {
+        dynamicResolution->begin_frame(m_impl->get_render_target_size(), m_size);
+        const auto &stats{dynamicResolution->get_stats()};
+        viewport[0] = stats.m_renderWidth;
+        viewport[1] = stats.m_renderHeight;
+    }
+    context.m_stateCache.set_viewport(0, 0, viewport[0], viewport[1]);
+
     if (m_renderFn)
     {
-        m_renderFn(this);
+        m_renderFn(this, context.m_commandQueue.get_frame_buffer());
     }
+
+#ifdef DEBUG
+    m_impl->record_debug_draw(context.m_commandQueue.get_frame_buffer(), *this, viewport[0], viewport[1]);
+#endif // DEBUG
+
+    context.m_commandQueue.execute(context);
+
+    const auto renderSeconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - renderStart).count()};
+    if (dynamicResolution)
+        dynamicResolution->end_frame(m_size, renderSeconds);
+
+    // presenting is also the frame-safe point at which released GL objects are deleted
+    m_impl->present(isPresentImmediate ? bEnginePresentMode::Immediate : m_presentMode, renderSeconds, m_size);
 }